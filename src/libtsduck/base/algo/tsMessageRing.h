@@ -0,0 +1,330 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bounded lock-free multi-producer / single-consumer message ring.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Template bounded message ring for inter-thread communication.
+    //! @ingroup thread
+    //!
+    //! The ts::MessageRing template class is a variant of ts::MessageQueue with a fixed
+    //! capacity, several producer threads and one single consumer thread. Messages are
+    //! moved into slots which are preallocated when the ring is built. Inserting and
+    //! removing messages never allocate memory and never lock a mutex, unless a thread
+    //! needs to sleep, waiting for a message or some free space.
+    //!
+    //! When a message is removed, it is swapped with the message object of the consumer.
+    //! The previous content of this object goes back into the slot. With enqueueInPlace(),
+    //! producers can then reuse the memory resources of the slot (string buffers for instance).
+    //!
+    //! When the ring is full, a producer does not block by default: the message is
+    //! dropped and an overflow counter is incremented. The consumer can later check
+    //! this counter to report how many messages were lost.
+    //!
+    //! The implementation uses a sequence number in each slot, as in Dmitry Vyukov's
+    //! bounded queue. Producers reserve a slot by atomically incrementing the tail
+    //! index. The slot is published to the consumer when its sequence number is updated.
+    //!
+    //! @tparam MSG The type of the messages to exchange. Must be default-constructible
+    //! and swappable. Preferably, moving a message shall not allocate memory.
+    //!
+    template <typename MSG>
+    class MessageRing
+    {
+        TS_NOBUILD_NOCOPY(MessageRing);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] capacity Maximum number of messages in the ring. The actual
+        //! capacity is rounded up to the next power of 2.
+        //!
+        explicit MessageRing(size_t capacity);
+
+        //!
+        //! Get the maximum number of messages in the ring.
+        //! @return The maximum number of messages in the ring.
+        //!
+        size_t capacity() const { return _slots.size(); }
+
+        //!
+        //! Get the number of messages which were dropped because the ring was full.
+        //! @return The number of dropped messages since the creation of the ring.
+        //!
+        size_t overflowCount() const { return _overflow.load(std::memory_order_relaxed); }
+
+        //!
+        //! Insert a message in the ring.
+        //! Can be called from any thread, concurrently.
+        //! @param [in,out] msg The message to enqueue. It is moved into the ring on success
+        //! and left unmodified when the ring is full.
+        //! @param [in] timeout Maximum time to wait in milliseconds when the ring is full.
+        //! By default, do not wait.
+        //! @return True on success, false when the message was dropped (ring still full after timeout).
+        //!
+        bool enqueue(MSG&& msg, MilliSecond timeout = 0) { return enqueueImpl(std::move(msg), timeout); }
+
+        //!
+        //! Insert a copy of a message in the ring.
+        //! Can be called from any thread, concurrently.
+        //! @param [in] msg The message to enqueue.
+        //! @param [in] timeout Maximum time to wait in milliseconds when the ring is full.
+        //! By default, do not wait.
+        //! @return True on success, false when the message was dropped (ring still full after timeout).
+        //!
+        bool enqueue(const MSG& msg, MilliSecond timeout = 0) { return enqueueImpl(msg, timeout); }
+
+        //!
+        //! Build a message in place, directly in a slot of the ring.
+        //! Can be called from any thread, concurrently.
+        //! @tparam FILL A function or function object which is called as @a fill(MSG&).
+        //! @param [in] fill Called once, when a slot is reserved. The slot contains a message
+        //! from a previous round, which shall be completely overwritten. Its memory resources
+        //! can be reused.
+        //! @param [in] timeout Maximum time to wait in milliseconds when the ring is full.
+        //! By default, do not wait.
+        //! @return True on success, false when the message was dropped (ring still full after timeout).
+        //!
+        template <class FILL>
+        bool enqueueInPlace(FILL&& fill, MilliSecond timeout = 0);
+
+        //!
+        //! Remove a message from the ring.
+        //! Must be called from the single consumer thread only.
+        //! @param [out] msg Received message.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the ring is empty, return immediately.
+        //! @return True on success, false on error (ring still empty after timeout).
+        //!
+        bool dequeue(MSG& msg, MilliSecond timeout = Infinite);
+
+    private:
+        // A slot in the ring. The sequence number is the index of the next expected
+        // enqueue in this slot (free slot) or this index plus one (filled slot).
+        struct Slot
+        {
+            std::atomic<size_t> seq {0};
+            MSG msg {};
+        };
+
+        std::vector<Slot>        _slots;                      // Preallocated slots.
+        const size_t             _mask;                       // Index mask, capacity - 1.
+        std::atomic<size_t>      _tail {0};                   // Next index to enqueue (producers).
+        size_t                   _head = 0;                   // Next index to dequeue (consumer only).
+        std::atomic<size_t>      _overflow {0};               // Number of dropped messages.
+        std::atomic<bool>        _consumer_waiting {false};   // The consumer sleeps on _enqueued.
+        std::atomic<size_t>      _producers_waiting {0};      // Number of producers sleeping on _dequeued.
+        std::mutex               _mutex {};                   // Only used to sleep.
+        std::condition_variable  _enqueued {};                // Signaled when a sleeping consumer shall check the ring.
+        std::condition_variable  _dequeued {};                // Signaled when sleeping producers shall check the ring.
+
+        // Compute the actual capacity of the ring.
+        static size_t RingSize(size_t capacity);
+
+        // Non-blocking insertion and removal. The message is filled only on success.
+        template <class FILL> bool tryEnqueue(FILL& fill);
+        bool tryDequeue(MSG& msg);
+
+        // Common code for enqueue() with copy or move.
+        template <typename T> bool enqueueImpl(T&& msg, MilliSecond timeout);
+
+        // Wake up the sleeping threads, if any.
+        void notifyConsumer();
+        void notifyProducers();
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+ts::MessageRing<MSG>::MessageRing(size_t capacity) :
+    _slots(RingSize(capacity)),
+    _mask(_slots.size() - 1)
+{
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        _slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename MSG>
+size_t ts::MessageRing<MSG>::RingSize(size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+
+//----------------------------------------------------------------------------
+// Non-blocking insertion, can be called from several threads.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+template <class FILL>
+bool ts::MessageRing<MSG>::tryEnqueue(FILL& fill)
+{
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot(_slots[pos & _mask]);
+        const size_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq == pos) {
+            // The slot is free, try to reserve it.
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                fill(slot.msg);
+                slot.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // Another producer reserved it, pos was reloaded by compare_exchange_weak().
+        }
+        else if (ptrdiff_t(seq - pos) < 0) {
+            // The slot still contains the message from the previous round: the ring is full.
+            return false;
+        }
+        else {
+            // Another producer filled the slot in the meantime, retry with the new tail.
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Non-blocking removal, in the consumer thread only.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+bool ts::MessageRing<MSG>::tryDequeue(MSG& msg)
+{
+    Slot& slot(_slots[_head & _mask]);
+    if (slot.seq.load(std::memory_order_acquire) != _head + 1) {
+        return false; // empty ring
+    }
+    // Swap, the previous content of msg is recycled in the slot.
+    std::swap(msg, slot.msg);
+    slot.seq.store(_head + _slots.size(), std::memory_order_release);
+    _head++;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up the sleeping threads, if any. The fence guarantees that either the
+// sleeping thread sees the modified slot or we see its waiting indicator.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+void ts::MessageRing<MSG>::notifyConsumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consumer_waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _enqueued.notify_one();
+    }
+}
+
+template <typename MSG>
+void ts::MessageRing<MSG>::notifyProducers()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_producers_waiting.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _dequeued.notify_all();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a message in the ring.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+template <typename T>
+bool ts::MessageRing<MSG>::enqueueImpl(T&& msg, MilliSecond timeout)
+{
+    return enqueueInPlace([&msg](MSG& slot) { slot = std::forward<T>(msg); }, timeout);
+}
+
+template <typename MSG>
+template <class FILL>
+bool ts::MessageRing<MSG>::enqueueInPlace(FILL&& fill, MilliSecond timeout)
+{
+    // Fast path, without lock.
+    bool done = tryEnqueue(fill);
+
+    // Ring full, wait for free space if required.
+    if (!done && timeout > 0) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::chrono::milliseconds::rep(timeout == Infinite ? 0 : timeout));
+        std::unique_lock<std::mutex> lock(_mutex);
+        _producers_waiting++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!(done = tryEnqueue(fill))) {
+            if (timeout == Infinite) {
+                _dequeued.wait(lock);
+            }
+            else if (_dequeued.wait_until(lock, deadline) == std::cv_status::timeout) {
+                done = tryEnqueue(fill);
+                break;
+            }
+        }
+        _producers_waiting--;
+    }
+
+    if (done) {
+        notifyConsumer();
+    }
+    else {
+        _overflow++;
+    }
+    return done;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove a message from the ring.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+bool ts::MessageRing<MSG>::dequeue(MSG& msg, MilliSecond timeout)
+{
+    // Fast path, without lock.
+    bool done = tryDequeue(msg);
+
+    // Ring empty, wait for a message if required.
+    if (!done && timeout > 0) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::chrono::milliseconds::rep(timeout == Infinite ? 0 : timeout));
+        std::unique_lock<std::mutex> lock(_mutex);
+        _consumer_waiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!(done = tryDequeue(msg))) {
+            if (timeout == Infinite) {
+                _enqueued.wait(lock);
+            }
+            else if (_enqueued.wait_until(lock, deadline) == std::cv_status::timeout) {
+                done = tryDequeue(msg);
+                break;
+            }
+        }
+        _consumer_waiting = false;
+    }
+
+    if (done) {
+        notifyProducers();
+    }
+    return done;
+}
@@ -342,6 +342,12 @@ namespace ts {
         //!
         static UString GetLibraryVersion();
 
+        //!
+        //! Check if Web requests are supported in this version of TSDuck.
+        //! @return True if Web requests are supported, false if TSDuck was compiled without Web support.
+        //!
+        static bool IsSupported();
+
     private:
         // System-specific parts are stored in a private structure.
         // This is done to avoid inclusion of specialized headers in this public file.
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsAsyncReport.h"
+#include "tsTime.h"
 
 
 //----------------------------------------------------------------------------
@@ -16,7 +17,7 @@
 ts::AsyncReport::AsyncReport(int max_severity, const AsyncReportArgs& args) :
     Report(max_severity),
     Thread(ThreadAttributes().setPriority(ThreadAttributes::GetMinimumPriority())),
-    _log_queue(args.log_msg_count),
+    _log_queue(args.log_msg_count == 0 ? AsyncReportArgs::MAX_LOG_MESSAGES : args.log_msg_count),
     _time_stamp(args.timed_log),
     _synchronous(args.sync_log)
 {
@@ -44,7 +45,8 @@ void ts::AsyncReport::terminate()
     if (!_terminated) {
         // Insert an "end of report" message in the queue.
         // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage(true, 0, UString()));
+        // Wait for some free space if the queue is full, the message cannot be dropped.
+        _log_queue.enqueue(LogMessage{true, 0, UString()}, Infinite);
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -71,7 +73,12 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
     if (!_terminated) {
         // Enqueue the message immediately (timeout = 0), drop message on overflow.
         // On the contrary, in synchronous mode, wait infinitely until the message is queued.
-        _log_queue.enqueue(new LogMessage(false, severity, msg), _synchronous ? Infinite : 0);
+        // The message is copied in the preallocated slot, reusing its string buffer.
+        _log_queue.enqueueInPlace([&](LogMessage& slot) {
+            slot.terminate = false;
+            slot.severity = severity;
+            slot.message.assign(msg);
+        }, _synchronous ? Infinite : 0);
     }
 }
 
@@ -82,17 +89,25 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    LogMessage msg;
+    size_t dropped = 0;
 
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
-    while (_log_queue.dequeue(msg) && !msg->terminate) {
+    while (_log_queue.dequeue(msg) && !msg.terminate) {
 
-        asyncThreadLog(msg->severity, msg->message);
+        // Report messages which were dropped because the queue was full.
+        const size_t overflow = _log_queue.overflowCount();
+        if (overflow > dropped) {
+            asyncThreadLog(Severity::Warning, UString::Format(u"%'d log messages dropped", {overflow - dropped}));
+            dropped = overflow;
+        }
+
+        asyncThreadLog(msg.severity, msg.message);
 
         // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
+        if (msg.severity == Severity::Fatal) {
             std::exit(EXIT_FAILURE);
         }
     }
@@ -14,7 +14,7 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
+#include "tsMessageRing.h"
 #include "tsThread.h"
 
 namespace ts {
@@ -27,11 +27,18 @@ namespace ts {
     //! to the caller without waiting. The messages are logged later in one single
     //! low-priority thread.
     //!
-    //! In case of a huge amount of errors, there is no avalanche effect. If a caller
-    //! cannot immediately enqueue a message or if the internal queue of messages is
-    //! full, the message is dropped. In other words, reporting messages is guaranteed
-    //! to never block, slow down or crash the application. Messages are dropped when
-    //! necessary to avoid that kind of problem.
+    //! In case of a huge amount of errors, there is no avalanche effect. If the internal
+    //! queue of messages is full, the message is dropped. In other words, reporting messages
+    //! is guaranteed to never block, slow down or crash the application. Messages are dropped
+    //! when necessary to avoid that kind of problem. The number of dropped messages is
+    //! reported by the logging thread when it catches up.
+    //!
+    //! The internal queue is a lock-free ring (see ts::MessageRing). Application threads
+    //! which log messages do not contend on a mutex and do not allocate queue elements.
+    //! The message texts are copied into string buffers which are recycled from one
+    //! message to another. The capacity of the ring is fixed when the report is created.
+    //! A zero log message count in ts::AsyncReportArgs, which meant an unlimited queue
+    //! in previous versions, now means the default capacity.
     //!
     //! Messages are displayed on the standard error device by default.
     //!
@@ -115,17 +122,14 @@ namespace ts {
         // The application threads send that type of message to the logging thread
         struct LogMessage
         {
-            LogMessage(bool t, int s, const UString& m) : terminate(t), severity(s), message(m) {}
-
             bool    terminate = false;  // tell logging thread to terminate
             int     severity = Severity::Info;
             UString message {};
         };
-        typedef SafePtr<LogMessage, ts::null_mutex> LogMessagePtr;
-        typedef MessageQueue<LogMessage, ts::null_mutex> LogMessageQueue;
+        typedef MessageRing<LogMessage> LogMessageQueue;
 
         // Private members:
-        LogMessageQueue _log_queue {};
+        LogMessageQueue _log_queue;
         volatile bool   _time_stamp = false;
         volatile bool   _synchronous = false;
         volatile bool   _terminated = false;
@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsOrderedJobOutput.h"
+
+
+//----------------------------------------------------------------------------
+// Restart with a new set of jobs.
+//----------------------------------------------------------------------------
+
+void ts::OrderedJobOutput::reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _next_output = 0;
+    _outputs.clear();
+}
+
+size_t ts::OrderedJobOutput::nextOutput() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _next_output;
+}
+
+
+//----------------------------------------------------------------------------
+// Report the log and output of a completed job.
+//----------------------------------------------------------------------------
+
+void ts::OrderedJobOutput::jobCompleted(size_t index, MessageList& messages, const std::string& output)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Ignore jobs which were already displayed.
+    if (index < _next_output) {
+        messages.clear();
+        return;
+    }
+
+    auto& job(_outputs[index]);
+    job.first.swap(messages);
+    messages.clear();
+    job.second = output;
+
+    // Display all consecutive completed jobs, starting at the next one to display.
+    // The report is used by the thread which displays the jobs, under the mutex.
+    for (auto it = _outputs.begin(); it != _outputs.end() && it->first == _next_output; it = _outputs.erase(it)) {
+        for (const auto& msg : it->second.first) {
+            _report.log(msg.first, msg.second);
+        }
+        _output << it->second.second;
+        _next_output++;
+    }
+    _output.flush();
+}
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Display the log and output of parallel jobs in the order of the jobs.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+#include "tsUString.h"
+
+namespace ts {
+    //!
+    //! Display the log and output of parallel jobs in the order of the jobs.
+    //! @ingroup log
+    //!
+    //! Jobs are identified by consecutive indexes, starting at zero. They may complete in any
+    //! order, typically when they are executed by several threads. The log messages and the text
+    //! output of a completed job are kept until all previous jobs are completed. They are then
+    //! reported on a Report and written on an output stream, as if the jobs were executed one
+    //! after the other. All methods are thread-safe.
+    //!
+    class TSDUCKDLL OrderedJobOutput
+    {
+        TS_NOBUILD_NOCOPY(OrderedJobOutput);
+    public:
+        //!
+        //! List of log messages of a job, with their severity.
+        //!
+        typedef std::list<std::pair<int, UString>> MessageList;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report the log messages of the jobs.
+        //! @param [in,out] output Where to write the output of the jobs.
+        //!
+        OrderedJobOutput(Report& report, std::ostream& output) : _report(report), _output(output) {}
+
+        //!
+        //! Restart with a new set of jobs, the next job to display has index zero.
+        //! The log and output of jobs which were not yet displayed are dropped.
+        //!
+        void reset();
+
+        //!
+        //! Report the log and output of a completed job.
+        //! If all previous jobs are completed, the log and output of this job are immediately
+        //! displayed, followed by those of the next jobs which already completed.
+        //! @param [in] index Index of the completed job.
+        //! @param [in,out] messages Log messages of the job. The list is moved and left empty.
+        //! @param [in] output Text output of the job.
+        //!
+        void jobCompleted(size_t index, MessageList& messages, const std::string& output);
+
+        //!
+        //! Get the index of the next job to display.
+        //! @return The index of the next job to display, also the number of displayed jobs.
+        //!
+        size_t nextOutput() const;
+
+    private:
+        Report&            _report;
+        std::ostream&      _output;
+        mutable std::mutex _mutex {};         // Protect all fields below.
+        size_t             _next_output = 0;  // Index of next job to display.
+        std::map<size_t, std::pair<MessageList, std::string>> _outputs {}; // Completed jobs, waiting for previous jobs.
+    };
+}
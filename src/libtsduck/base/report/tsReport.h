@@ -15,6 +15,17 @@
 #include "tsUChar.h"
 #include "tsArgMix.h"
 
+//!
+//! Highest debug level which is compiled in calls to ts::Report::trace().
+//! Trace messages with a higher debug level are removed at compile time, including
+//! the evaluation of their arguments. By default, all trace levels are compiled.
+//! Define this symbol on the command line to remove traces from time-critical code,
+//! for instance -DTS_MAX_TRACE_LEVEL=0 to remove all traces.
+//!
+#if !defined(TS_MAX_TRACE_LEVEL)
+    #define TS_MAX_TRACE_LEVEL INT_MAX
+#endif
+
 namespace ts {
 
     class Enumeration;
@@ -55,6 +66,11 @@ namespace ts {
     //! Abstract interface for event reporting and monitoring.
     //! @ingroup log
     //!
+    //! The printf-like methods exist in two forms: with an explicit list of ArgMixIn
+    //! and with variadic template arguments. The variadic forms check the severity inline,
+    //! before building the list of arguments. When a message is dropped, its arguments are
+    //! neither converted nor formatted. Use them in time-critical code.
+    //!
     class TSDUCKDLL Report
     {
     public:
@@ -134,6 +150,59 @@ namespace ts {
         //!
         virtual void log(int severity, const UString& fmt, std::initializer_list<ArgMixIn> args);
 
+        //!
+        //! Report a message with an explicit severity and a printf-like interface.
+        //! @param [in] severity Message severity.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void log(int severity, const UChar* fmt, ARG1&& arg1, ARGS&&... args)
+        {
+            if (severity <= _max_severity) {
+                log(severity, fmt, {ArgMixIn(std::forward<ARG1>(arg1)), ArgMixIn(std::forward<ARGS>(args))...});
+            }
+        }
+
+        //!
+        //! Report a message with an explicit severity and a printf-like interface.
+        //! @param [in] severity Message severity.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void log(int severity, const UString& fmt, ARG1&& arg1, ARGS&&... args)
+        {
+            if (severity <= _max_severity) {
+                log(severity, fmt, {ArgMixIn(std::forward<ARG1>(arg1)), ArgMixIn(std::forward<ARGS>(args))...});
+            }
+        }
+
+        //!
+        //! Report a trace message at a debug level which is known at compile time.
+        //! If @a LEVEL is higher than TS_MAX_TRACE_LEVEL, the call is removed at compile time.
+        //! Otherwise, the severity is checked inline and the message is formatted only when it is reported.
+        //! This is typically used to log traces on time-critical paths, such as per-packet processing.
+        //! @tparam LEVEL Debug level of the message.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] args Arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <int LEVEL, class... ARGS>
+        void trace(const UChar* fmt, ARGS&&... args)
+        {
+            static_assert(LEVEL >= Severity::Debug, "trace() is reserved to debug levels");
+            if constexpr (LEVEL <= TS_MAX_TRACE_LEVEL) {
+                if (LEVEL <= _max_severity) {
+                    log(LEVEL, fmt, std::initializer_list<ArgMixIn>({ArgMixIn(std::forward<ARGS>(args))...}));
+                }
+            }
+        }
+
         //!
         //! Report a fatal error message.
         //! @param [in] msg Message text.
@@ -156,6 +225,26 @@ namespace ts {
         //!
         void fatal(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Fatal, fmt, args); }
 
+        //!
+        //! Report a fatal error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void fatal(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Fatal, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report a fatal error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void fatal(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Fatal, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report a severe error message.
         //! @param [in] msg Message text.
@@ -178,6 +267,26 @@ namespace ts {
         //!
         void severe(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Severe, fmt, args); }
 
+        //!
+        //! Report a severe error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void severe(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Severe, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report a severe error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void severe(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Severe, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report an error message.
         //! @param [in] msg Message text.
@@ -200,6 +309,26 @@ namespace ts {
         //!
         void error(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Error, fmt, args); }
 
+        //!
+        //! Report an error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void error(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Error, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report an error message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void error(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Error, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report a warning message.
         //! @param [in] msg Message text.
@@ -222,6 +351,26 @@ namespace ts {
         //!
         void warning(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Warning, fmt, args); }
 
+        //!
+        //! Report a warning message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void warning(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Warning, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report a warning message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void warning(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Warning, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report an informational message.
         //! @param [in] msg Message text.
@@ -244,6 +393,26 @@ namespace ts {
         //!
         void info(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Info, fmt, args); }
 
+        //!
+        //! Report an informational message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void info(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Info, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report an informational message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void info(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Info, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report a verbose message.
         //! @param [in] msg Message text.
@@ -266,6 +435,26 @@ namespace ts {
         //!
         void verbose(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Verbose, fmt, args); }
 
+        //!
+        //! Report a verbose message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void verbose(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Verbose, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report a verbose message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void verbose(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Verbose, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Report a debug message.
         //! @param [in] msg Message text.
@@ -288,6 +477,26 @@ namespace ts {
         //!
         void debug(const UString& fmt, std::initializer_list<ArgMixIn> args) { log(Severity::Debug, fmt, args); }
 
+        //!
+        //! Report a debug message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void debug(const UChar* fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Debug, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
+        //!
+        //! Report a debug message with a printf-like interface.
+        //! @param [in] fmt Format string with embedded '\%' sequences.
+        //! @param [in] arg1 First argument to substitute in the format string.
+        //! @param [in] args Other arguments to substitute in the format string.
+        //! @see UString::format()
+        //!
+        template <class ARG1, class... ARGS>
+        void debug(const UString& fmt, ARG1&& arg1, ARGS&&... args) { log(Severity::Debug, fmt, std::forward<ARG1>(arg1), std::forward<ARGS>(args)...); }
+
         //!
         //! Check if errors (or worse) were reported through this object.
         //! @return True if errors (or worse) were reported through this object.
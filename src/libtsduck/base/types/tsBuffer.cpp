@@ -1170,6 +1170,18 @@ const uint8_t* ts::Buffer::rdb(size_t bytes)
             _read_error = true;
             return ff;
         }
+        else if (bytes < 8 && _state.rbyte + 8 <= _buffer_size) {
+            // All source bytes fit in one 64-bit window: realign them with one shift.
+            const uint8_t* const buf = _buffer + _state.rbyte;
+            if (_big_endian) {
+                PutUInt64BE(_realigned, GetUInt64BE(buf) << _state.rbit);
+            }
+            else {
+                PutUInt64LE(_realigned, GetUInt64LE(buf) >> _state.rbit);
+            }
+            _state.rbyte += bytes;
+            return _realigned;
+        }
         else {
             for (uint8_t* p = _realigned; p < _realigned + bytes; p++) {
                 if (_big_endian) {
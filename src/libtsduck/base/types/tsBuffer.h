@@ -1499,6 +1499,26 @@ INT ts::Buffer::getBits(size_t bits)
         return 0;
     }
 
+    // Fast path: when the field fits in a 64-bit window which can be loaded from the
+    // buffer, extract it with one load and two shifts instead of a bit-by-bit loop.
+    // Bytes after the write pointer may be loaded but are never part of the result.
+    if (bits > 0 && _state.rbit + bits <= 64 && _state.rbyte + 8 <= _buffer_size) {
+        const uint8_t* const base = _buffer + _state.rbyte;
+        uint64_t window = 0;
+        if (_big_endian) {
+            window = (GetUInt64BE(base) << _state.rbit) >> (64 - bits);
+        }
+        else {
+            window = GetUInt64LE(base) >> _state.rbit;
+            if (bits < 64) {
+                window &= (uint64_t(1) << bits) - 1;
+            }
+        }
+        _state.rbyte += (_state.rbit + bits) >> 3;
+        _state.rbit = (_state.rbit + bits) & 7;
+        return static_cast<INT>(window);
+    }
+
     INT val = 0;
 
     if (_big_endian) {
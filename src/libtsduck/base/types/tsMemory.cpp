@@ -8,6 +8,15 @@
 
 #include "tsMemory.h"
 
+// SSE2 is always available on x86_64 and Neon on Arm64, no need to check the CPU at run time.
+#if defined(TS_X86_64) && !defined(TS_NO_SSE2_INSTRUCTIONS)
+    #define TS_SSE2_INSTRUCTIONS 1
+    #include <emmintrin.h>
+#elif defined(TS_ARM64) && !defined(TS_NO_NEON_INSTRUCTIONS)
+    #define TS_NEON_INSTRUCTIONS 1
+    #include <arm_neon.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // Check if a memory area starts with the specified prefix
@@ -30,15 +39,89 @@ bool ts::StartsWith(const void* area, size_t area_size, const void* prefix, size
 
 const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size)
 {
-    if (pattern_size > 0) {
-        const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
-        const uint8_t* p = reinterpret_cast<const uint8_t*>(pattern);
-        while (area_size >= pattern_size) {
-            if (*a == *p && std::memcmp(a, p, pattern_size) == 0) {
+    if (pattern_size == 0 || area_size < pattern_size) {
+        return nullptr;
+    }
+
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const p = reinterpret_cast<const uint8_t*>(pattern);
+    const uint8_t* const last = a + area_size - pattern_size;  // last possible start of pattern
+
+    if (pattern_size >= 3 && p[0] == 0x00 && p[1] == 0x00) {
+        // Patterns starting with 00 00 (typically video start codes) are frequent, use the
+        // specialized search. Looking for the first byte only would stop on all zeroes.
+        while (a <= last) {
+            a = LocateZeroZero(a, last - a + 3, p[2]);
+            if (a == nullptr || std::memcmp(a + 3, p + 3, pattern_size - 3) == 0) {
+                return a;
+            }
+            ++a;
+        }
+    }
+    else {
+        // Locate the first byte using memchr(), which is usually vectorized by the C library.
+        while (a <= last) {
+            a = reinterpret_cast<const uint8_t*>(std::memchr(a, p[0], last - a + 1));
+            if (a == nullptr || std::memcmp(a + 1, p + 1, pattern_size - 1) == 0) {
                 return a;
             }
             ++a;
-            --area_size;
+        }
+    }
+    return nullptr; // not found
+}
+
+
+//----------------------------------------------------------------------------
+// Locate a 3-byte pattern 00 00 xx into a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(area);
+    const uint8_t* const end = p + area_size;
+
+#if defined(TS_SSE2_INSTRUCTIONS) || defined(TS_NEON_INSTRUCTIONS)
+    // Check 16 positions at a time: compare 16 bytes at p and 16 bytes at p+1 with zero.
+    // The third byte of the 16 candidate positions must remain in the area (p+17 < end).
+    // Two consecutive zeroes are rare in compressed video (except in start codes), so
+    // the candidates are checked one by one, outside the vector registers.
+    while (end - p >= 18) {
+    #if defined(TS_SSE2_INSTRUCTIONS)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i z0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), zero);
+        const __m128i z1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)), zero);
+        const bool found = _mm_movemask_epi8(_mm_and_si128(z0, z1)) != 0;
+    #else
+        const uint8x16_t z0 = vceqzq_u8(vld1q_u8(p));
+        const uint8x16_t z1 = vceqzq_u8(vld1q_u8(p + 1));
+        const bool found = vmaxvq_u8(vandq_u8(z0, z1)) != 0;
+    #endif
+        if (found) {
+            for (size_t i = 0; i < 16; ++i) {
+                if (p[i] == 0x00 && p[i+1] == 0x00 && p[i+2] == third) {
+                    return p + i;
+                }
+            }
+        }
+        p += 16;
+    }
+#endif
+
+    // Portable version and end of area: locate each zero using memchr().
+    while (end - p >= 3) {
+        p = reinterpret_cast<const uint8_t*>(std::memchr(p, 0x00, end - p - 2));
+        if (p == nullptr) {
+            break;
+        }
+        else if (p[1] != 0x00) {
+            p += 2;
+        }
+        else if (p[2] == third) {
+            return p;
+        }
+        else {
+            ++p;
         }
     }
     return nullptr; // not found
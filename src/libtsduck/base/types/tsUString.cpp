@@ -1773,203 +1773,256 @@ void ts::UString::appendDump(const ByteBlock& bb,
 
 //----------------------------------------------------------------------------
 // Build a multi-line string containing the hexadecimal dump of a memory area.
+// Common implementation for UTF-16 and UTF-8 strings. The characters are
+// directly written into the string buffer, one line at a time, using a table
+// of hexadecimal digits, without intermediate string.
 //----------------------------------------------------------------------------
 
-void ts::UString::appendDump(const void *data,
-                             size_type size,
-                             uint32_t flags,
-                             size_type indent,
-                             size_type line_width,
-                             size_type init_offset,
-                             size_type inner_indent)
-{
-    // Do nothing in case of invalid or empty data.
-    if (data == nullptr || size == 0) {
-        return;
-    }
+namespace {
 
-    // Work an area of bytes.
-    const uint8_t* raw = static_cast<const uint8_t*>(data);
+    // Upper case hexadecimal digits.
+    const char HexaDigits[] = "0123456789ABCDEF";
 
-    // Make sure we have something to display (default is hexa)
-    if ((flags & (HEXA | C_STYLE | BINARY | BIN_NIBBLE | ASCII)) == 0) {
-        flags |= HEXA;
-    }
-    if ((flags & COMPACT) != 0) {
-        // COMPACT implies SINGLE_LINE.
-        flags |= SINGLE_LINE;
-    }
+    template <class STRING>
+    void AppendDumpImpl(STRING& str, const uint8_t* raw, size_t size, uint32_t flags, size_t indent, size_t line_width, size_t init_offset, size_t inner_indent)
+    {
+        typedef typename STRING::value_type CHAR;
 
-    // Width of an hexa byte: "XX" (2) or "0xXX," (5)
-    size_type hexa_width = 0;
-    UString byte_prefix;
-    UString byte_suffix;
+        // Do nothing in case of invalid or empty data.
+        if (raw == nullptr || size == 0) {
+            return;
+        }
 
-    if (flags & C_STYLE) {
-        hexa_width  = 5;
-        byte_prefix = u"0x";
-        byte_suffix = u",";
-        flags |= HEXA; // Enforce hexa flag
-    }
-    else if (flags & (HEXA | SINGLE_LINE)) {
-        hexa_width  = 2;
-    }
-    else {
-        hexa_width  = 0;
-    }
+        // Make sure we have something to display (default is hexa)
+        if ((flags & (ts::UString::HEXA | ts::UString::C_STYLE | ts::UString::BINARY | ts::UString::BIN_NIBBLE | ts::UString::ASCII)) == 0) {
+            flags |= ts::UString::HEXA;
+        }
+        if ((flags & ts::UString::COMPACT) != 0) {
+            // COMPACT implies SINGLE_LINE.
+            flags |= ts::UString::SINGLE_LINE;
+        }
 
-    // Specific case: simple dump, everything on one line.
-    if (flags & SINGLE_LINE) {
-        reserve(length() + (hexa_width + 1) * size);
-        for (size_type i = 0; i < size; ++i) {
-            if (i > 0 && (flags & COMPACT) == 0) {
-                append(1, u' ');
-            }
-            append(byte_prefix);
-            append(Hexa(raw[i], 0, UString(), false, true));
-            append(byte_suffix);
+        // Width of an hexa byte: "XX" (2) or "0xXX," (5)
+        size_t hexa_width = 0;
+        bool c_style = false;
+
+        if (flags & ts::UString::C_STYLE) {
+            hexa_width = 5;
+            c_style = true;
+            flags |= ts::UString::HEXA; // Enforce hexa flag
+        }
+        else if (flags & (ts::UString::HEXA | ts::UString::SINGLE_LINE)) {
+            hexa_width = 2;
         }
-        return;
-    }
 
-    // Width of offset field
-    size_type offset_width;
+        // Format one byte in hexadecimal at p, return the address after the byte.
+        auto put_byte = [c_style](CHAR* p, uint8_t b) -> CHAR* {
+            if (c_style) {
+                *p++ = CHAR('0');
+                *p++ = CHAR('x');
+            }
+            *p++ = CHAR(HexaDigits[b >> 4]);
+            *p++ = CHAR(HexaDigits[b & 0x0F]);
+            if (c_style) {
+                *p++ = CHAR(',');
+            }
+            return p;
+        };
+
+        // Specific case: simple dump, everything on one line.
+        if (flags & ts::UString::SINGLE_LINE) {
+            const bool compact = (flags & ts::UString::COMPACT) != 0;
+            const size_t start = str.size();
+            str.resize(start + hexa_width * size + (compact ? 0 : size - 1));
+            CHAR* p = &str[start];
+            for (size_t i = 0; i < size; ++i) {
+                if (i > 0 && !compact) {
+                    *p++ = CHAR(' ');
+                }
+                p = put_byte(p, raw[i]);
+            }
+            return;
+        }
 
-    if ((flags & OFFSET) == 0) {
-        offset_width = 0;
-    }
-    else if (flags & WIDE_OFFSET) {
-        offset_width = 8;
-    }
-    else if (init_offset + size <= 0x10000) {
-        offset_width = 4;
-    }
-    else {
-        offset_width = 8;
-    }
+        // Width of offset field
+        size_t offset_width = 0;
 
-    // Width of a binary byte
-    size_type bin_width;
+        if ((flags & ts::UString::OFFSET) == 0) {
+            offset_width = 0;
+        }
+        else if (flags & ts::UString::WIDE_OFFSET) {
+            offset_width = 8;
+        }
+        else if (init_offset + size <= 0x10000) {
+            offset_width = 4;
+        }
+        else {
+            offset_width = 8;
+        }
 
-    if (flags & BIN_NIBBLE) {
-        bin_width = 9;
-        flags |= BINARY;  // Enforce binary flag
-    }
-    else if (flags & BINARY) {
-        bin_width = 8;
-    }
-    else {
-        bin_width = 0;
-    }
+        // Width of a binary byte
+        size_t bin_width = 0;
 
-    // Pre-allocation to avoid too frequent reallocations.
-    reserve(length() + indent + inner_indent + (hexa_width + bin_width + 5) * size);
+        if (flags & ts::UString::BIN_NIBBLE) {
+            bin_width = 9;
+            flags |= ts::UString::BINARY;  // Enforce binary flag
+        }
+        else if (flags & ts::UString::BINARY) {
+            bin_width = 8;
+        }
 
-    // Number of non-byte characters
-    size_type add_width = indent + inner_indent;
-    if (offset_width != 0) {
-        add_width += offset_width + 3;
-    }
-    if ((flags & HEXA) && (flags & (BINARY | ASCII))) {
-        add_width += 2;
-    }
-    if ((flags & BINARY) && (flags & ASCII)) {
-        add_width += 2;
-    }
+        // Number of non-byte characters
+        size_t add_width = indent + inner_indent;
+        if (offset_width != 0) {
+            add_width += offset_width + 3;
+        }
+        if ((flags & ts::UString::HEXA) && (flags & (ts::UString::BINARY | ts::UString::ASCII))) {
+            add_width += 2;
+        }
+        if ((flags & ts::UString::BINARY) && (flags & ts::UString::ASCII)) {
+            add_width += 2;
+        }
 
-    // Computes max number of dumped bytes per line
-    size_type bytes_per_line;
+        // Computes max number of dumped bytes per line
+        size_t bytes_per_line = 0;
 
-    if (flags & BPL) {
-        bytes_per_line = line_width;
-    }
-    else if (add_width >= line_width) {
-        bytes_per_line = 8;  // arbitrary, if indent is too long
-    }
-    else {
-        bytes_per_line = (line_width - add_width) /
-            (((flags & HEXA) ? (hexa_width + 1) : 0) +
-             ((flags & BINARY) ? (bin_width + 1) : 0) +
-             ((flags & ASCII) ? 1 : 0));
-        if (bytes_per_line > 1) {
-            bytes_per_line = bytes_per_line & ~1; // force even value
+        if (flags & ts::UString::BPL) {
+            bytes_per_line = line_width;
+        }
+        else if (add_width >= line_width) {
+            bytes_per_line = 8;  // arbitrary, if indent is too long
+        }
+        else {
+            bytes_per_line = (line_width - add_width) /
+                (((flags & ts::UString::HEXA) ? (hexa_width + 1) : 0) +
+                 ((flags & ts::UString::BINARY) ? (bin_width + 1) : 0) +
+                 ((flags & ts::UString::ASCII) ? 1 : 0));
+            if (bytes_per_line > 1) {
+                bytes_per_line = bytes_per_line & ~1; // force even value
+            }
+        }
+        if (bytes_per_line == 0) {
+            bytes_per_line = 8;  // arbitrary, if ended up with none
         }
-    }
-    if (bytes_per_line == 0) {
-        bytes_per_line = 8;  // arbitrary, if ended up with none
-    }
 
-    // Display data
-    for (size_type line = 0; line < size; line += bytes_per_line) {
+        // Maximum number of characters in one line, including the new-line.
+        const size_t max_line =
+            add_width +
+            ((flags & ts::UString::HEXA) ? (hexa_width + 1) * bytes_per_line : 0) +
+            ((flags & ts::UString::BINARY) ? (bin_width + 1) * bytes_per_line : 0) +
+            ((flags & ts::UString::ASCII) ? bytes_per_line : 0) + 1;
 
-        // Number of bytes on this line (last line may be shorter)
-        size_type line_size = line + bytes_per_line <= size ? bytes_per_line : size - line;
+        // Pre-allocation of the complete dump, avoid reallocations.
+        str.reserve(str.size() + ((size + bytes_per_line - 1) / bytes_per_line) * max_line);
 
-        // Beginning of line
-        append(indent, u' ');
-        if (flags & OFFSET) {
-            append(Hexa(init_offset + line, offset_width, UString(), false, true));
-            append(u":  ");
-        }
-        append(inner_indent, u' ');
+        // Display data
+        for (size_t line = 0; line < size; line += bytes_per_line) {
+
+            // Number of bytes on this line (last line may be shorter)
+            const size_t line_size = line + bytes_per_line <= size ? bytes_per_line : size - line;
+
+            // Allocate the maximum line size, directly write characters in it.
+            const size_t start = str.size();
+            str.resize(start + max_line);
+            CHAR* const base = &str[start];
+            CHAR* p = base;
 
-        // Hexa dump
-        if (flags & HEXA) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                append(byte_prefix);
-                append(Hexa(raw[line + byte], 0, UString(), false, true));
-                append(byte_suffix);
-                if (byte < bytes_per_line - 1) {
-                    append(1, u' ');
+            // Beginning of line
+            p = std::fill_n(p, indent, CHAR(' '));
+            if (flags & ts::UString::OFFSET) {
+                size_t offset = init_offset + line;
+                for (size_t i = offset_width; i > 0; offset >>= 4) {
+                    p[--i] = CHAR(HexaDigits[offset & 0x0F]);
                 }
+                p += offset_width;
+                *p++ = CHAR(':');
+                *p++ = CHAR(' ');
+                *p++ = CHAR(' ');
             }
-            if (flags & (BINARY | ASCII)) { // more to come
-                if (line_size < bytes_per_line) {
-                    append((hexa_width + 1) * (bytes_per_line - line_size) - 1, u' ');
+            p = std::fill_n(p, inner_indent, CHAR(' '));
+
+            // Hexa dump
+            if (flags & ts::UString::HEXA) {
+                for (size_t byte = 0; byte < line_size; byte++) {
+                    p = put_byte(p, raw[line + byte]);
+                    if (byte < bytes_per_line - 1) {
+                        *p++ = CHAR(' ');
+                    }
+                }
+                if (flags & (ts::UString::BINARY | ts::UString::ASCII)) { // more to come
+                    if (line_size < bytes_per_line) {
+                        p = std::fill_n(p, (hexa_width + 1) * (bytes_per_line - line_size) - 1, CHAR(' '));
+                    }
+                    *p++ = CHAR(' ');
+                    *p++ = CHAR(' ');
                 }
-                append(2, u' ');
             }
-        }
 
-        // Binary dump
-        if (flags & BINARY) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                int b = int(raw[line + byte]);
-                for (int i = 7; i >= 0; i--) {
-                    append(1, UChar(u'0' + ((b >> i) & 0x01)));
-                    if (i == 4 && (flags & BIN_NIBBLE) != 0) {
-                        append(1, u'.');
+            // Binary dump
+            if (flags & ts::UString::BINARY) {
+                for (size_t byte = 0; byte < line_size; byte++) {
+                    const int b = int(raw[line + byte]);
+                    for (int i = 7; i >= 0; i--) {
+                        *p++ = CHAR('0' + ((b >> i) & 0x01));
+                        if (i == 4 && (flags & ts::UString::BIN_NIBBLE) != 0) {
+                            *p++ = CHAR('.');
+                        }
+                    }
+                    if (byte < bytes_per_line - 1) {
+                        *p++ = CHAR(' ');
                     }
                 }
-                if (byte < bytes_per_line - 1) {
-                    append(1, u' ');
+                if (flags & ts::UString::ASCII) { // more to come
+                    if (line_size < bytes_per_line) {
+                        p = std::fill_n(p, (bin_width + 1) * (bytes_per_line - line_size) - 1, CHAR(' '));
+                    }
+                    *p++ = CHAR(' ');
+                    *p++ = CHAR(' ');
                 }
             }
-            if (flags & ASCII) { // more to come
-                if (line_size < bytes_per_line) {
-                    append((bin_width + 1) * (bytes_per_line - line_size) - 1, u' ');
+
+            // ASCII dump
+            if (flags & ts::UString::ASCII) {
+                for (size_t byte = 0; byte < line_size; byte++) {
+                    // Display only ASCII characters. Other encodings don't make sense on one bytes.
+                    const uint8_t c = raw[line + byte];
+                    *p++ = c >= 0x20 && c <= 0x7E ? CHAR(c) : CHAR('.');
                 }
-                append(2, u' ');
             }
-        }
 
-        // ASCII dump
-        if (flags & ASCII) {
-            for (size_type byte = 0; byte < line_size; byte++) {
-                // Display only ASCII characters. Other encodings don't make sense on one bytes.
-                const UChar c = UChar(raw[line + byte]);
-                push_back(c >= 0x20 && c <= 0x7E ? c : u'.');
+            // Insert a new-line, cleanup spurious spaces.
+            str.resize(start + size_t(p - base));
+            while (!str.empty() && str.back() == CHAR(' ')) {
+                str.pop_back();
             }
+            str.push_back(CHAR('\n'));
         }
-
-        // Insert a new-line, cleanup spurious spaces.
-        while (!empty() && back() == u' ') {
-            pop_back();
-        }
-        push_back(u'\n');
     }
 }
 
+void ts::UString::appendDump(const void *data,
+                             size_type size,
+                             uint32_t flags,
+                             size_type indent,
+                             size_type line_width,
+                             size_type init_offset,
+                             size_type inner_indent)
+{
+    AppendDumpImpl(*this, static_cast<const uint8_t*>(data), size, flags, indent, line_width, init_offset, inner_indent);
+}
+
+void ts::UString::AppendDump(std::string& str,
+                             const void *data,
+                             size_type size,
+                             uint32_t flags,
+                             size_type indent,
+                             size_type line_width,
+                             size_type init_offset,
+                             size_type inner_indent)
+{
+    AppendDumpImpl(str, static_cast<const uint8_t*>(data), size, flags, indent, line_width, init_offset, inner_indent);
+}
+
 
 //----------------------------------------------------------------------------
 // Format a string using a template and arguments.
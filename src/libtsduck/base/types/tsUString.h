@@ -2113,6 +2113,33 @@ namespace ts {
                         size_type init_offset = 0,
                         size_type inner_indent = 0);
 
+        //!
+        //! Append a multi-line hexadecimal dump of a memory area to an UTF-8 string.
+        //! The result is identical to the UTF-8 conversion of Dump() but the characters are
+        //! directly written in the UTF-8 string, without intermediate UTF-16 string. This is
+        //! the preferred method to dump large volumes of data on a text stream.
+        //! @param [in,out] str The UTF-8 string where the dump is appended.
+        //! @param [in] data Starting address of the memory area to dump.
+        //! @param [in] size Size in bytes of the memory area to dump.
+        //! @param [in] flags A combination of option flags indicating how to format the data.
+        //! This is typically the result of or'ed values from the enum type HexaFlags.
+        //! @param [in] indent Each line is indented by this number of characters.
+        //! @param [in] line_width Maximum number of characters per line.
+        //! If the flag BPL is specified, @a line_width is interpreted as the number of displayed byte values per line.
+        //! @param [in] init_offset If the flag OFFSET is specified, an offset in the memory area is displayed at the beginning of each line.
+        //! In this case, @a init_offset specified the offset value for the first byte.
+        //! @param [in] inner_indent Add this indentation before hexa/ascii dump, after offset.
+        //! @see HexaFlags
+        //!
+        static void AppendDump(std::string& str,
+                               const void *data,
+                               size_type size,
+                               uint32_t flags = HEXA,
+                               size_type indent = 0,
+                               size_type line_width = DEFAULT_HEXA_LINE_WIDTH,
+                               size_type init_offset = 0,
+                               size_type inner_indent = 0);
+
         //!
         //! Interpret this string as a sequence of hexadecimal digits (ignore blanks).
         //! @param [out] result Decoded bytes.
@@ -21,6 +21,15 @@
 //  Also note that using curl_multi before version 7.66 is not very
 //  efficient since there is some sort of sleep/wait cycles.
 //
+//  CONNECTION REUSE:
+//  The curl_multi and curl_easy handles of a WebRequest are kept from one
+//  transfer to the next one. Thus, successive downloads using the same
+//  WebRequest object reuse the same connection to the server when possible
+//  (HTTP keep-alive). Additionally, the DNS cache and the SSL/TLS session
+//  cache are shared by all WebRequest objects, in all threads. Thus, a new
+//  connection to a known server avoids the DNS resolution and a full TLS
+//  handshake.
+//
 //  RETRY POLICY:
 //  In rare cases, it has been noted that curl fails with "connection reset
 //  by peer" right after sending SSL client hello. Retrying may either
@@ -59,6 +68,7 @@ bool ts::WebRequest::receive(void*, size_t, size_t&) { _report.error(TS_NO_CURL_
 bool ts::WebRequest::close() { return true; }
 void ts::WebRequest::abort() {}
 ts::UString ts::WebRequest::GetLibraryVersion() { return UString(); }
+bool ts::WebRequest::IsSupported() { return false; }
 
 #else
 
@@ -86,6 +96,11 @@ TS_LLVM_NOWARNING(old-style-cast)
 #define TS_CURL_POLL 1
 #endif
 
+// Check if the SSL session cache can be shared.
+#if CURL_AT_LEAST_VERSION(7,23,0)
+#define TS_CURL_SHARE_SSL 1
+#endif
+
 // Check if curl_multi_perform() can return CURLM_CALL_MULTI_PERFORM.
 #if ! CURL_AT_LEAST_VERSION(7,20,0)
 #define TS_CURL_CALLAGAIN 1
@@ -128,7 +143,17 @@ namespace {
         // Get number of retries for an URL.
         void getRetry(const ts::UString& url, size_t& retries, std::chrono::milliseconds& interval);
 
+        // Share handle for DNS and SSL session caches between all requests (null if unavailable).
+        ::CURLSH* share() const { return _share; }
+
     private:
+        ::CURLSH*  _share = nullptr;
+        std::mutex _shareLocks[CURL_LOCK_DATA_LAST] {};
+
+        // Libcurl callbacks to lock/unlock shared data. The userptr points to the LibCurlInit object.
+        static void ShareLock(::CURL* handle, ::curl_lock_data data, ::curl_lock_access access, void* userptr);
+        static void ShareUnlock(::CURL* handle, ::curl_lock_data data, void* userptr);
+
         // Per-host retry policy.
         struct Retry {
             size_t retries = 0;
@@ -163,6 +188,40 @@ namespace {
                 }
             }
         }
+
+        // Create the share handle. Without it, each request has its own caches, this is not an error.
+        if (initStatus == ::CURLE_OK && (_share = ::curl_share_init()) != nullptr) {
+            TS_PUSH_WARNING()
+            TS_LLVM_NOWARNING(disabled-macro-expansion)
+            if (::curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, &LibCurlInit::ShareLock) != ::CURLSHE_OK ||
+                ::curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, &LibCurlInit::ShareUnlock) != ::CURLSHE_OK ||
+                ::curl_share_setopt(_share, CURLSHOPT_USERDATA, this) != ::CURLSHE_OK ||
+                ::curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS) != ::CURLSHE_OK
+#if defined(TS_CURL_SHARE_SSL)
+                || ::curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION) != ::CURLSHE_OK
+#endif
+                )
+            {
+                ::curl_share_cleanup(_share);
+                _share = nullptr;
+            }
+            TS_POP_WARNING()
+        }
+    }
+
+    // Libcurl callbacks to lock/unlock shared data.
+    void LibCurlInit::ShareLock(::CURL*, ::curl_lock_data data, ::curl_lock_access, void* userptr)
+    {
+        if (userptr != nullptr && size_t(data) < size_t(CURL_LOCK_DATA_LAST)) {
+            reinterpret_cast<LibCurlInit*>(userptr)->_shareLocks[data].lock();
+        }
+    }
+
+    void LibCurlInit::ShareUnlock(::CURL*, ::curl_lock_data data, void* userptr)
+    {
+        if (userptr != nullptr && size_t(data) < size_t(CURL_LOCK_DATA_LAST)) {
+            reinterpret_cast<LibCurlInit*>(userptr)->_shareLocks[data].unlock();
+        }
     }
 
     // Get number of retries for an URL.
@@ -199,8 +258,9 @@ public:
     // Start the transfer using WebRequest parameters.
     bool startTransfer(CertState certState);
 
-    // Close and cleanup everything.
-    void clear();
+    // Close and cleanup everything. When reuse is true, keep the curl handles with
+    // their connection cache for the next transfer (the transfer itself is closed).
+    void clear(bool reuse = false);
 
     // Wait for data to be present in the reception buffer.
     // If maxSize is zero, wait until something is present in data buffer
@@ -312,7 +372,7 @@ bool ts::WebRequest::receive(void* buffer, size_t maxSize, size_t& retSize)
 bool ts::WebRequest::close()
 {
     bool success = _isOpen;
-    _guts->clear();
+    _guts->clear(true);
     _isOpen = false;
     return success;
 }
@@ -343,10 +403,11 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
     _request._report.debug(u"curl retries: %d, interval: %s", {retries, UString::Chrono(retryInterval, true)});
 
     // Loop until all retries are exhausted.
-    for (;;) {
+    for (bool first = true; ; first = false) {
 
-        // Make sure we start from a clean state.
-        clear();
+        // Make sure we start from a clean state. On first attempt, reuse the existing
+        // connections from previous transfers. On retry, restart from scratch.
+        clear(first);
         _canRetry = retries > 0;
 
         // If no CA certificate file is specified, bypass certificate processing.
@@ -386,12 +447,12 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
 #if defined(TS_CURL_WAKEUP)
             std::lock_guard<std::mutex> lock(_mutex);
 #endif
-            // Initialize curl_multi and curl_easy
-            if ((_curlm = ::curl_multi_init()) == nullptr) {
+            // Initialize curl_multi and curl_easy, if not kept from a previous transfer.
+            if (_curlm == nullptr && (_curlm = ::curl_multi_init()) == nullptr) {
                 _request._report.error(u"libcurl 'curl_multi' initialization error");
                 return false;
             }
-            if ((_curl = ::curl_easy_init()) == nullptr) {
+            if (_curl == nullptr && (_curl = ::curl_easy_init()) == nullptr) {
                 _request._report.error(u"libcurl 'curl_easy' initialization error");
                 clear();
                 return false;
@@ -412,6 +473,9 @@ bool ts::WebRequest::SystemGuts::startTransfer(CertState certState)
 
         // Setup the error message buffer.
         ::CURLcode status = ::curl_easy_setopt(_curl, CURLOPT_ERRORBUFFER, _error);
+        if (status == ::CURLE_OK && LibCurlInit::Instance().share() != nullptr) {
+            status = ::curl_easy_setopt(_curl, CURLOPT_SHARE, LibCurlInit::Instance().share());
+        }
 
         // Set the user agent.
         if (status == ::CURLE_OK && !_request._userAgent.empty()) {
@@ -689,7 +753,7 @@ void ts::WebRequest::SystemGuts::abort()
 // Close and cleanup everything.
 //----------------------------------------------------------------------------
 
-void ts::WebRequest::SystemGuts::clear()
+void ts::WebRequest::SystemGuts::clear(bool reuse)
 {
 #if defined(TS_CURL_WAKEUP)
     // Make sure we don't call curl_multi_wakeup() while deallocating.
@@ -707,14 +771,27 @@ void ts::WebRequest::SystemGuts::clear()
         ::curl_multi_remove_handle(_curlm, _curl);
     }
 
-    // Make sure the curl_easy is clean.
-    if (_curl != nullptr) {
+    if (reuse && _curl != nullptr) {
+        // Cookies are normally written when the curl_easy is cleaned up.
+        // Write them now, they may be used by other requests.
+        if (_request._useCookies) {
+            TS_PUSH_WARNING()
+            TS_LLVM_NOWARNING(disabled-macro-expansion)
+            ::curl_easy_setopt(_curl, CURLOPT_COOKIELIST, "FLUSH");
+            TS_POP_WARNING()
+        }
+        // Reset all options but keep live connections for the next transfer.
+        ::curl_easy_reset(_curl);
+    }
+    else if (_curl != nullptr) {
+        // Make sure the curl_easy is clean.
         ::curl_easy_cleanup(_curl);
         _curl = nullptr;
     }
 
-    // Make sure the curl_multi is clean.
-    if (_curlm != nullptr) {
+    // Make sure the curl_multi is clean. When the curl_easy is kept, the curl_multi
+    // is kept as well because it owns the connection cache.
+    if (_curlm != nullptr && _curl == nullptr) {
         ::curl_multi_cleanup(_curlm);
         _curlm = nullptr;
     }
@@ -771,9 +848,14 @@ size_t ts::WebRequest::SystemGuts::WriteCallback(char *ptr, size_t size, size_t
 
 
 //----------------------------------------------------------------------------
-// Get the version of the underlying HTTP library.
+// Check Web support and get the version of the underlying HTTP library.
 //----------------------------------------------------------------------------
 
+bool ts::WebRequest::IsSupported()
+{
+    return true;
+}
+
 ts::UString ts::WebRequest::GetLibraryVersion()
 {
     UString result(u"libcurl");
@@ -376,9 +376,14 @@ void ts::WebRequest::SystemGuts::transmitResponseHeaders()
 
 
 //----------------------------------------------------------------------------
-// Get the version of the underlying HTTP library.
+// Check Web support and get the version of the underlying HTTP library.
 //----------------------------------------------------------------------------
 
+bool ts::WebRequest::IsSupported()
+{
+    return true;
+}
+
 ts::UString ts::WebRequest::GetLibraryVersion()
 {
     // Do not know which version...
@@ -73,6 +73,13 @@ namespace ts {
         //!
         void reset() { _fcs = 0xFFFFFFFF; }
 
+        //!
+        //! Reset the CRC32 computation with a zero initial value instead of all ones.
+        //! Unlike the MPEG CRC32, a CRC32 with a zero initial value is linear: the CRC32 of the
+        //! XOR of two data areas of the same size is the XOR of their CRC32 values.
+        //!
+        void resetZero() { _fcs = 0; }
+
         //!
         //! What to do with a CRC32.
         //! Used when building MPEG sections.
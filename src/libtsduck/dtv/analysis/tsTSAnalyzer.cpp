@@ -404,7 +404,7 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
     // Process specific tables
     switch (tid) {
         case TID_PAT: {
-            const PAT pat(_duck, table);
+            const PATView pat(table);
             if (pid == PID_PAT && pat.isValid()) {
                 analyzePAT(pat);
             }
@@ -484,15 +484,15 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
 // Analyze a PAT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzePAT(const PAT& pat)
+void ts::TSAnalyzer::analyzePAT(const PATView& pat)
 {
     // Get the transport stream id
-    _ts_id = pat.ts_id;
+    _ts_id = pat.tsId();
 
     // Get all PMT PID's for all services
-    for (auto& it : pat.pmts) {
-        uint16_t service_id(it.first);
-        PID pmt_pid(it.second);
+    for (const auto& it : pat.programs()) {
+        const uint16_t service_id = it.serviceId();
+        const PID pmt_pid = it.pmtPID();
         // Register the PMT PID
         PIDContextPtr ps(getPID(pmt_pid));
         ps->description = u"PMT";
@@ -17,7 +17,7 @@
 #include "tsPESDemux.h"
 #include "tsT2MIDemux.h"
 #include "tsLogicalChannelNumbers.h"
-#include "tsPAT.h"
+#include "tsPATView.h"
 #include "tsCAT.h"
 #include "tsPMT.h"
 #include "tsNIT.h"
@@ -485,7 +485,7 @@ namespace ts {
         void resetSectionDemux();
 
         // Analyze the various PSI tables
-        void analyzePAT(const PAT&);
+        void analyzePAT(const PATView&);
         void analyzeCAT(const CAT&);
         void analyzePMT(PID pid, const PMT&);
         void analyzeNIT(PID pid, const NIT&);
@@ -8,7 +8,7 @@
 
 #include "tsCASMapper.h"
 #include "tsBinaryTable.h"
-#include "tsPAT.h"
+#include "tsPATView.h"
 #include "tsPMT.h"
 #include "tsCAT.h"
 #include "tsNames.h"
@@ -49,11 +49,11 @@ void ts::CASMapper::handleTable(SectionDemux&, const BinaryTable& table)
 {
     switch (table.tableId()) {
         case TID_PAT: {
-            const PAT pat(_duck, table);
+            const PATView pat(table);
             if (pat.isValid()) {
                 // Add a filter on each referenced PID to get all PMT's.
-                for (auto pid : pat.pmts) {
-                    _demux.addPID(pid.second);
+                for (const auto& it : pat.programs()) {
+                    _demux.addPID(it.pmtPID());
                 }
             }
             break;
@@ -205,3 +205,74 @@ size_t ts::DVBCharTable::encodeTableCode(uint8_t*& buffer, size_t& size) const
     size -= codeSize;
     return codeSize;
 }
+
+
+//----------------------------------------------------------------------------
+// Fast paths for ASCII runs. The bytes are loaded 8 by 8 in a 64-bit word
+// and all bytes in the word are checked at once (SIMD within a register).
+//----------------------------------------------------------------------------
+
+namespace {
+    constexpr uint64_t BYTES_01 = 0x0101010101010101;
+    constexpr uint64_t BYTES_80 = 0x8080808080808080;
+
+    // Non-zero if at least one byte in the word has its most significant bit set.
+    inline uint64_t HasNonASCII(uint64_t w)
+    {
+        return w & BYTES_80;
+    }
+
+    // Non-zero if at least one byte in the word is not in the range 0x20 to 0x7E.
+    inline uint64_t HasNonPrintable(uint64_t w)
+    {
+        const uint64_t below_20 = (w - 0x20 * BYTES_01) & ~w & BYTES_80;
+        const uint64_t x = w ^ (0x7F * BYTES_01);
+        const uint64_t equal_7F = (x - BYTES_01) & ~x & BYTES_80;
+        return (w & BYTES_80) | below_20 | equal_7F;
+    }
+
+    // Get the length of the leading run of bytes in a word which pass a test.
+    template <uint64_t (*TEST)(uint64_t), bool (*IS_VALID)(uint8_t)>
+    size_t RunLength(const uint8_t* data, size_t size)
+    {
+        size_t len = 0;
+        while (len + 8 <= size) {
+            uint64_t w = 0;
+            std::memcpy(&w, data + len, 8);
+            if (TEST(w) != 0) {
+                break;
+            }
+            len += 8;
+        }
+        while (len < size && IS_VALID(data[len])) {
+            len++;
+        }
+        return len;
+    }
+
+    bool IsASCII(uint8_t b) { return b < 0x80; }
+    bool IsPrintableASCII(uint8_t b) { return b >= 0x20 && b <= 0x7E; }
+}
+
+size_t ts::DVBCharTable::PrintableASCIILength(const uint8_t* data, size_t size)
+{
+    return data == nullptr ? 0 : RunLength<HasNonPrintable, IsPrintableASCII>(data, size);
+}
+
+size_t ts::DVBCharTable::ASCIILength(const uint8_t* data, size_t size)
+{
+    return data == nullptr ? 0 : RunLength<HasNonASCII, IsASCII>(data, size);
+}
+
+void ts::DVBCharTable::AppendASCII(UString& str, const uint8_t* data, size_t size)
+{
+    if (size > 0) {
+        const size_t base = str.size();
+        str.resize(base + size);
+        UChar* out = &str[base];
+        // Simple widening loop, easily vectorized by the compiler.
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = UChar(data[i]);
+        }
+    }
+}
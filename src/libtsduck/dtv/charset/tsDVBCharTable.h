@@ -125,6 +125,32 @@ namespace ts {
         //!
         DVBCharTable(const UChar* name, uint32_t tableCode);
 
+        //!
+        //! Get the length of the leading run of printable ASCII characters (0x20 to 0x7E) in a byte area.
+        //! The bytes are checked 8 by 8 in the fast path.
+        //! @param [in] data Address of the byte area.
+        //! @param [in] size Size in bytes of the byte area.
+        //! @return The number of leading bytes in the range 0x20 to 0x7E.
+        //!
+        static size_t PrintableASCIILength(const uint8_t* data, size_t size);
+
+        //!
+        //! Get the length of the leading run of 7-bit ASCII bytes (0x00 to 0x7F) in a byte area.
+        //! The bytes are checked 8 by 8 in the fast path.
+        //! @param [in] data Address of the byte area.
+        //! @param [in] size Size in bytes of the byte area.
+        //! @return The number of leading bytes in the range 0x00 to 0x7F.
+        //!
+        static size_t ASCIILength(const uint8_t* data, size_t size);
+
+        //!
+        //! Append 7-bit ASCII bytes to a string, one character per byte.
+        //! @param [in,out] str The string to update.
+        //! @param [in] data Address of the ASCII bytes.
+        //! @param [in] size Number of bytes to append.
+        //!
+        static void AppendASCII(UString& str, const uint8_t* data, size_t size);
+
     private:
         // Repository of DVB character tables by table code.
         class TableCodeRepository
@@ -78,9 +78,21 @@ bool ts::DVBCharTableSingleByte::decode(UString& str, const uint8_t* dvb, size_t
     bool reverseNext = false;  // after decoding next character, it shall be swapped with previous one.
     bool hasDiacritical = false;
 
-    for (; dvb != nullptr && dvbSize > 0; --dvbSize) {
+    while (dvb != nullptr && dvbSize > 0) {
+        // Fast path: a run of printable ASCII characters is copied as is, without lookup.
+        // Not applicable to the letter after a reversable diacritical mark.
+        if (!reverseNext) {
+            const size_t count = PrintableASCIILength(dvb, dvbSize);
+            if (count > 0) {
+                AppendASCII(str, dvb, count);
+                dvb += count;
+                dvbSize -= count;
+                continue;
+            }
+        }
         // Get next byte
         const uint8_t b = *dvb++;
+        --dvbSize;
         // Convert it to a code point
         uint16_t cp = 0;
         if (b >= 0x20 && b <= 0x7E) {
@@ -30,7 +30,21 @@ ts::DVBCharTableUTF8::DVBCharTableUTF8(const UChar* name) :
 
 bool ts::DVBCharTableUTF8::decode(UString& str, const uint8_t* dvb, size_t dvbSize) const
 {
-    str = UString::FromUTF8(reinterpret_cast<const char*>(dvb), dvbSize);
+    str.clear();
+    if (dvb != nullptr) {
+        // Fast path: the leading ASCII characters are directly copied. In most strings,
+        // this is the complete string. Otherwise, the rest starts on a character boundary.
+        const size_t count = ASCIILength(dvb, dvbSize);
+        if (count == 0) {
+            str.assignFromUTF8(reinterpret_cast<const char*>(dvb), dvbSize);
+        }
+        else {
+            AppendASCII(str, dvb, count);
+            if (count < dvbSize) {
+                str.append(UString::FromUTF8(reinterpret_cast<const char*>(dvb + count), dvbSize - count));
+            }
+        }
+    }
     return true;
 }
 
@@ -74,6 +74,7 @@ namespace ts {
 
         //!
         //! Reload from full binary content.
+        //! When the previous content is not shared with another object, its memory is reused.
         //! @param [in] content Address of the binary packet data.
         //! @param [in] content_size Size in bytes of the packet.
         //! @param [in] source_pid PID from which the data were read.
@@ -39,6 +39,7 @@ ts::ECMGClient::~ECMGClient()
         // Notify receiver thread to terminate
         _state = DESTRUCTING;
         _work_to_do.notify_one();
+        _request_done.notify_all();
     }
     waitForTermination();
 }
@@ -59,6 +60,7 @@ bool ts::ECMGClient::abortConnection(const UString& message)
     _connection.disconnect(_logger.report());
     _connection.close(_logger.report());
     _work_to_do.notify_one();
+    _request_done.notify_all();
 
     _logger.setReport(&NULLREP);
     return false;
@@ -303,10 +305,18 @@ bool ts::ECMGClient::submitECM(uint16_t cp_number,
     ecmgscs::CWProvision msg(_protocol);
     buildCWProvision(msg, cp_number, current_cw, next_cw, ac, cp_duration);
 
-    // Register an asynchronous request
+    // Register an asynchronous request, waiting for a free slot in the pipeline if necessary.
+    AsyncRequests::iterator req;
     {
-        std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _async_requests.insert(std::make_pair(cp_number, ecm_handler));
+        std::unique_lock<std::recursive_mutex> lock(_mutex);
+        if (_max_pending > 0) {
+            const auto timeout = std::chrono::milliseconds(std::chrono::milliseconds::rep(std::max(RESPONSE_TIMEOUT, 2 * MilliSecond(_channel_status.max_comp_time))));
+            if (!_request_done.wait_for(lock, timeout, [this]() { return _async_requests.size() < _max_pending || _state != CONNECTED; })) {
+                _logger.report().error(u"ECM generation timeout, %d pending requests", {_async_requests.size()});
+                return false;
+            }
+        }
+        req = _async_requests.insert(std::make_pair(cp_number, ecm_handler));
     }
 
     // Send the CW_provision message
@@ -315,13 +325,32 @@ bool ts::ECMGClient::submitECM(uint16_t cp_number,
     // Clear asynchronous request on error
     if (!ok) {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _async_requests.erase(cp_number);
+        _async_requests.erase(req);
+        _request_done.notify_all();
     }
 
     return ok;
 }
 
 
+//----------------------------------------------------------------------------
+// Maximum number of pending asynchronous ECM requests.
+//----------------------------------------------------------------------------
+
+void ts::ECMGClient::setMaxPendingRequests(size_t count)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _max_pending = count;
+    _request_done.notify_all();
+}
+
+size_t ts::ECMGClient::pendingRequests() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _async_requests.size();
+}
+
+
 //----------------------------------------------------------------------------
 // Receiver thread main code
 //----------------------------------------------------------------------------
@@ -373,10 +402,13 @@ void ts::ECMGClient::main()
                     ECMGClientHandlerInterface* handler = nullptr;
                     {
                         std::lock_guard<std::recursive_mutex> lock(_mutex);
-                        auto it = _async_requests.find(resp->CP_number);
-                        if (it != _async_requests.end()) {
+                        // With a multimap, lower_bound() returns the first request which was
+                        // submitted with this cp_number (insertion order is preserved).
+                        auto it = _async_requests.lower_bound(resp->CP_number);
+                        if (it != _async_requests.end() && it->first == resp->CP_number) {
                             handler = it->second;
-                            _async_requests.erase(resp->CP_number);
+                            _async_requests.erase(it);
+                            _request_done.notify_all();
                         }
                     }
                     if (handler == nullptr) {
@@ -408,6 +440,7 @@ void ts::ECMGClient::main()
                 _connection.disconnect(NULLREP);
                 _connection.close(NULLREP);
             }
+            _request_done.notify_all();
         }
     }
 }
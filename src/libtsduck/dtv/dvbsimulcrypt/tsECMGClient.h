@@ -91,6 +91,12 @@ namespace ts {
         //! Submit the ECM request and return immediately.
         //! The notification of the ECM generation or error is performed through the specified handler.
         //!
+        //! Several requests can be submitted without waiting for the previous responses. They are
+        //! pipelined over the same TCP connection and the responses are dispatched to the handlers
+        //! in order of submission for the same @a cp_number. When the maximum number of pending
+        //! requests is reached, this method waits for a response before sending the new request.
+        //! @see setMaxPendingRequests()
+        //!
         //! @param [in] cp_number Current crypto-period number.
         //! @param [in] current_cw Control word for current crypto-period.
         //! @param [in] next_cw Control word for next crypto-period.
@@ -107,6 +113,20 @@ namespace ts {
                        uint16_t cp_duration,
                        ECMGClientHandlerInterface* handler);
 
+        //!
+        //! Set the maximum number of pending asynchronous ECM requests.
+        //! @param [in] count Maximum number of requests which were submitted using submitECM()
+        //! and are still waiting for a response. Zero means unlimited (the default).
+        //!
+        void setMaxPendingRequests(size_t count);
+
+        //!
+        //! Get the number of pending asynchronous ECM requests.
+        //! @return The number of requests which were submitted using submitECM() and are
+        //! still waiting for a response.
+        //!
+        size_t pendingRequests() const;
+
         //!
         //! Disconnect from remote ECMG.
         //! Close stream and channel.
@@ -140,8 +160,9 @@ namespace ts {
         // Timeout for responses from ECMG (except ECM generation)
         static constexpr MilliSecond RESPONSE_TIMEOUT = 5000;
 
-        // List of asynchronous ECM requests: key=cp_number, value=handler
-        typedef std::map <uint16_t, ECMGClientHandlerInterface*> AsyncRequests;
+        // List of asynchronous ECM requests: key=cp_number, value=handler.
+        // Requests for the same cp_number are served in order of submission.
+        typedef std::multimap<uint16_t, ECMGClientHandlerInterface*> AsyncRequests;
 
         // Private members
         const ecmgscs::Protocol&    _protocol;
@@ -151,9 +172,11 @@ namespace ts {
         tlv::Connection<>           _connection {_protocol, true, 3}; // connection with ECMG server
         ecmgscs::ChannelStatus      _channel_status {_protocol};      // initial response to channel_setup
         ecmgscs::StreamStatus       _stream_status {_protocol};       // initial response to stream_setup
-        std::recursive_mutex        _mutex {};                        // exclusive access to protected fields
+        mutable std::recursive_mutex _mutex {};                       // exclusive access to protected fields
         std::condition_variable_any _work_to_do {};                   // notify receiver thread to do some work
+        std::condition_variable_any _request_done {};                 // notify submitters that a pending request completed
         AsyncRequests               _async_requests {};
+        size_t                      _max_pending = 0;                 // max number of pending async requests, 0 = unlimited
         MessageQueue <tlv::Message, ts::null_mutex> _response_queue {RESPONSE_QUEUE_SIZE};
 
         // Build a CW_provision message.
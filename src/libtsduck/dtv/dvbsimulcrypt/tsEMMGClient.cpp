@@ -380,12 +380,13 @@ bool ts::EMMGClient::dataProvision(const std::vector<ByteBlockPtr>& data)
             _logger.report().error(u"MUX is disconnected");
             return false;
         }
-        // Manually serialize the data_provision message.
-        ByteBlockPtr bbp(new ByteBlock);
-        tlv::Serializer serial(bbp);
+        // Manually serialize the data_provision message, always in the same buffer.
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _udp_buffer.clear();
+        tlv::Serializer serial(_udp_buffer);
         request.serialize(serial);
         _logger.log(request, u"sending UDP message to " + _udp_address.toString());
-        return _udp_socket.send(bbp->data(), bbp->size(), _udp_address, _logger.report());
+        return _udp_socket.send(_udp_buffer.data(), _udp_buffer.size(), _udp_address, _logger.report());
     }
     else {
         // Send data_provision messages using UDP.
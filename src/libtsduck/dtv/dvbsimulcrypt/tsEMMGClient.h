@@ -190,6 +190,7 @@ namespace ts {
         tlv::Logger              _logger {};
         tlv::Connection<>        _connection {_protocol, true, 3};  // connection with MUX server
         UDPSocket                _udp_socket {};                    // where to send data_provision if UDP is used
+        ByteBlock                _udp_buffer {};                    // reused serialization buffer for UDP, protected by _mutex
         emmgmux::ChannelStatus   _channel_status {_protocol};       // automatic response to channel_test
         emmgmux::StreamStatus    _stream_status {_protocol};        // automatic response to stream_test
         std::recursive_mutex     _mutex {};            // exclusive access to protected fields
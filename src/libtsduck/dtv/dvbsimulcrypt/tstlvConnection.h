@@ -131,6 +131,8 @@ namespace ts {
             size_t          _invalid_msg_count = 0;
             MUTEX           _send_mutex {};
             MUTEX           _receive_mutex {};
+            ByteBlock       _send_buffer {};     // Reused serialization buffer, protected by _send_mutex.
+            ByteBlock       _receive_buffer {};  // Reused reception buffer, protected by _receive_mutex.
         };
     }
 }
@@ -177,12 +179,13 @@ bool ts::tlv::Connection<MUTEX>::send(const Message& msg, Logger& logger)
 {
     logger.log(msg, u"sending message to " + peerName());
 
-    ByteBlockPtr bbp(new ByteBlock);
-    Serializer serial(bbp);
-    msg.serialize(serial);
-
+    // Serialize in the same buffer, message after message. After the first messages,
+    // the buffer is large enough and there is no more memory allocation.
     std::lock_guard<MUTEX> lock(_send_mutex);
-    return SuperClass::send(bbp->data(), bbp->size(), logger.report());
+    _send_buffer.clear();
+    Serializer serial(_send_buffer);
+    msg.serialize(serial);
+    return SuperClass::send(_send_buffer.data(), _send_buffer.size(), logger.report());
 }
 
 // Receive a TLV message (wait for the message, deserialize it and validate it)
@@ -201,25 +204,25 @@ bool ts::tlv::Connection<MUTEX>::receive(MessagePtr& msg, const AbortInterface*
     const size_t header_size(has_version ? 5 : 4);
     const size_t length_offset(has_version ? 3 : 2);
 
+    // The reception buffer is reused, message after message, and must remain
+    // locked until the message is analyzed.
+    std::lock_guard<MUTEX> lock(_receive_mutex);
+    ByteBlock& bb(_receive_buffer);
+
     // Loop until a valid message is received
     for (;;) {
-        ByteBlock bb(header_size);
 
-        // Receive complete message
-        {
-            std::lock_guard<MUTEX> lock(_receive_mutex);
-
-            // Read message header
-            if (!SuperClass::receive(bb.data(), header_size, abort, logger.report())) {
-                return false;
-            }
+        // Read message header
+        bb.resize(header_size);
+        if (!SuperClass::receive(bb.data(), header_size, abort, logger.report())) {
+            return false;
+        }
 
-            // Get message length and read message payload
-            const size_t length = GetUInt16(bb.data() + length_offset);
-            bb.resize(header_size + length);
-            if (!SuperClass::receive(bb.data() + header_size, length, abort, logger.report())) {
-                return false;
-            }
+        // Get message length and read message payload
+        const size_t length = GetUInt16(bb.data() + length_offset);
+        bb.resize(header_size + length);
+        if (!SuperClass::receive(bb.data() + header_size, length, abort, logger.report())) {
+            return false;
         }
 
         // Analyze the message
@@ -131,8 +131,8 @@ void ts::tlv::Serializer::putBool(TAG tag, const std::vector<bool>& val)
 
 void ts::tlv::Serializer::put(TAG tag, const std::vector<std::string>& val)
 {
-    for (auto i : val) {
-        put(tag, i);
+    for (const auto& str : val) {
+        put(tag, str);
     }
 }
 
@@ -144,7 +144,7 @@ void ts::tlv::Serializer::put(TAG tag, const std::vector<std::string>& val)
 ts::UString ts::tlv::Serializer::toString() const
 {
     UString prefix;
-    if (_bb.isNull()) {
+    if (_bb == nullptr) {
         return u"(null)";
     }
     prefix = UString::Format(u"{%d bytes, ", {_bb->size()});
@@ -24,13 +24,29 @@ namespace ts {
         //! A DVB message is serialized in TLV into a ByteBlock.
         //! A Serializer is always associated to a ByteBlock.
         //!
+        //! The ByteBlock is never reallocated by the Serializer itself, only enlarged.
+        //! To serialize many messages without memory allocation, the application can
+        //! reuse the same ByteBlock, clearing it between messages, and let its capacity
+        //! grow to the size of the largest message.
+        //!
         class TSDUCKDLL Serializer
         {
         private:
             // Private members:
-            ByteBlockPtr _bb {};      // Associated binary block
+            ByteBlockPtr _bb_ptr {};  // Owner of the associated binary block, if built from a safe pointer
+            ByteBlock* _bb = nullptr; // Associated binary block
             int _length_offset {-1};  // Location of TLV "length" field
 
+            // Insert a TLV header with the specified value length.
+            // Return the address of the value field, where the caller shall write exactly length bytes.
+            uint8_t* putHeader(TAG tag, size_t length)
+            {
+                uint8_t* const p = _bb->enlarge(2 * sizeof(uint16_t) + length);
+                PutUInt16(p, tag);
+                PutUInt16(p + sizeof(uint16_t), uint16_t(length));
+                return p + 2 * sizeof(uint16_t);
+            }
+
         public:
             //!
             //! Constructor.
@@ -38,12 +54,22 @@ namespace ts {
             //! @param [in] bb Safe pointer to an existing message block.
             //! The messages will be serialized in this block.
             //!
-            Serializer(const ByteBlockPtr& bb) : _bb(bb) {}
+            Serializer(const ByteBlockPtr& bb) : _bb_ptr(bb), _bb(bb.pointer()) {}
+
+            //!
+            //! Constructor.
+            //! Associates an existing message block, without safe pointer.
+            //! @param [in,out] bb An existing message block. The messages will be serialized
+            //! at the end of this block. The block must remain valid as long as the
+            //! Serializer is used.
+            //!
+            explicit Serializer(ByteBlock& bb) : _bb(&bb) {}
 
             //!
             //! Constructor.
             //! Use the same message block as another Serializer.
             //! Useful to nest serializer when building compound TLV parameters.
+            //! The nested serializer shall not outlive @a s.
             //! @param [in] s Another serializer, will use the same byte block for serialization.
             //!
             Serializer(const Serializer& s) : _bb(s._bb) {}
@@ -133,56 +159,56 @@ namespace ts {
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putUInt8(TAG tag, uint8_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(1); _bb->appendUInt8 (i);}
+            void putUInt8(TAG tag, uint8_t i) {PutUInt8(putHeader(tag, 1), i);}
 
             //!
             //! Insert a TLV field containing an unsigned 16-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putUInt16(TAG tag, uint16_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(2); _bb->appendUInt16(i);}
+            void putUInt16(TAG tag, uint16_t i) {PutUInt16(putHeader(tag, 2), i);}
 
             //!
             //! Insert a TLV field containing an unsigned 32-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putUInt32(TAG tag, uint32_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(4); _bb->appendUInt32(i);}
+            void putUInt32(TAG tag, uint32_t i) {PutUInt32(putHeader(tag, 4), i);}
 
             //!
             //! Insert a TLV field containing an unsigned 64-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putUInt64(TAG tag, uint64_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(8); _bb->appendUInt64(i);}
+            void putUInt64(TAG tag, uint64_t i) {PutUInt64(putHeader(tag, 8), i);}
 
             //!
             //! Insert a TLV field containing a signed 8-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putInt8(TAG tag, int8_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(1); _bb->appendInt8 (i);}
+            void putInt8(TAG tag, int8_t i) {PutInt8(putHeader(tag, 1), i);}
 
             //!
             //! Insert a TLV field containing a signed 16-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putInt16(TAG tag, int16_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(2); _bb->appendInt16(i);}
+            void putInt16(TAG tag, int16_t i) {PutInt16(putHeader(tag, 2), i);}
 
             //!
             //! Insert a TLV field containing a signed 32-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putInt32(TAG tag, int32_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(4); _bb->appendInt32(i);}
+            void putInt32(TAG tag, int32_t i) {PutInt32(putHeader(tag, 4), i);}
 
             //!
             //! Insert a TLV field containing a signed 64-bit integer value in the stream.
             //! @param [in] tag Message or parameter tag.
             //! @param [in] i Integer value to insert.
             //!
-            void putInt64(TAG tag, int64_t i) {_bb->appendUInt16(tag); _bb->appendUInt16(8); _bb->appendInt64(i);}
+            void putInt64(TAG tag, int64_t i) {PutInt64(putHeader(tag, 8), i);}
 
             //!
             //! Insert a TLV field containing a vector of unsigned 8-bit integer values in the stream.
@@ -275,7 +301,7 @@ namespace ts {
             //! @param [in] i Integer value to insert.
             //!
             template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
-            void put(TAG tag, INT i) {_bb->appendUInt16(tag); _bb->appendUInt16(sizeof(INT)); _bb->append<INT>(i);}
+            void put(TAG tag, INT i) {PutInt<INT>(putHeader(tag, sizeof(INT)), i);}
 
             //!
             //! Insert a TLV field containing a vector of integer values in the stream (template variant).
@@ -307,9 +333,7 @@ namespace ts {
             //!
             void put(TAG tag, const std::string& val)
             {
-                _bb->appendUInt16(tag);
-                _bb->appendUInt16(uint16_t(val.size()));
-                _bb->append(val.data(), val.size());
+                put(tag, val.data(), val.size());
             }
 
             //!
@@ -335,9 +359,7 @@ namespace ts {
             //!
             void put(TAG tag, const ByteBlock& bl)
             {
-                _bb->appendUInt16(tag);
-                _bb->appendUInt16(uint16_t(bl.size()));
-                _bb->append(bl.data(), bl.size());
+                put(tag, bl.data(), bl.size());
             }
 
             //!
@@ -358,9 +380,10 @@ namespace ts {
             //!
             void put(TAG tag, const void *pval, size_t len)
             {
-                _bb->appendUInt16(tag);
-                _bb->appendUInt16(uint16_t(len));
-                _bb->append(pval, len);
+                uint8_t* const p = putHeader(tag, len);
+                if (len > 0) {
+                    std::memcpy(p, pval, len);  // Flawfinder: ignore: memcpy()
+                }
             }
 
             //!
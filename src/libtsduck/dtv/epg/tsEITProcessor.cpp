@@ -13,6 +13,7 @@
 #include "tsMJD.h"
 #include "tsFatal.h"
 #include "tsAlgorithm.h"
+#include "tsCRC32.h"
 
 
 //----------------------------------------------------------------------------
@@ -40,6 +41,11 @@ void ts::EITProcessor::reset()
     _removed.clear();
     _kept.clear();
     _renamed.clear();
+    _input_sections = 0;
+    _modified_sections = 0;
+    _removed_sections = 0;
+    _reset_time = Time::CurrentUTC();
+    resetInPlace();
 }
 
 
@@ -106,8 +112,356 @@ void ts::EITProcessor::setMaxBufferedSections(size_t count)
 void ts::EITProcessor::processPacket(TSPacket& pkt)
 {
     if (_input_pids.test(pkt.getPID())) {
-        _demux.feedPacket(pkt);
-        _packetizer.getNextPacket(pkt);
+
+        // Switch between in-place processing and repacketization when the conditions change.
+        const bool in_place = _in_place && _input_pids.count() == 1 && _start_time_offset == 0;
+        if (in_place != _in_place_active) {
+            _in_place_active = in_place;
+            _demux.reset();
+            _sections.clear();
+            if (in_place) {
+                // Continue the continuity counters of the packetizer.
+                _ip_out_cc = _packetizer.nextContinuityCounter();
+                _ip_has_cc = false;
+            }
+            else {
+                // The section which is parsed in place is truncated. The delayed packets
+                // of the previous sections are output before the repacketized ones.
+                _ip_sec.active = false;
+            }
+            _packetizer.reset();
+        }
+
+        if (_in_place_active) {
+            processPacketInPlace(pkt);
+        }
+        else {
+            _demux.feedPacket(pkt);
+            if (!releaseInPlace(pkt, false)) {
+                _packetizer.getNextPacket(pkt);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next packet which was delayed by the in-place processing.
+//----------------------------------------------------------------------------
+
+bool ts::EITProcessor::flushPacket(TSPacket& pkt, bool end_of_stream)
+{
+    if (end_of_stream) {
+        // The incomplete section is truncated, its packets are no longer held.
+        _ip_sec.active = false;
+    }
+    return releaseInPlace(pkt, false);
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable the in-place processing of the EIT sections.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::setInPlace(bool on)
+{
+    _in_place = on;
+}
+
+void ts::EITProcessor::resetInPlace()
+{
+    _ip_has_cc = false;
+    _ip_first = _ip_next = 0;
+    _ip_sec = InPlaceSection();
+}
+
+
+//----------------------------------------------------------------------------
+// Report the numbers of processed sections and the processing throughput.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::reportStatistics(int severity) const
+{
+    const MilliSecond duration = Time::CurrentUTC() - _reset_time;
+    _duck.report().log(severity, u"EIT processing: %'d sections, %'d modified, %'d removed, %'d sections/s (%s)",
+                       {_input_sections, _modified_sections, _removed_sections,
+                        duration <= 0 ? 0 : (_input_sections * MilliSecPerSec) / duration,
+                        _in_place_active ? u"in place" : u"repacketized"});
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet from the input PID in in-place mode.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::processPacketInPlace(TSPacket& pkt)
+{
+    // When the ring buffer is full, the oldest packet must be released first.
+    TSPacket out;
+    bool has_out = false;
+    if (_ip_next - _ip_first >= IP_MAX_PACKETS) {
+        has_out = releaseInPlace(out, true);
+    }
+
+    // Store the input packet in the ring buffer.
+    const size_t cur = size_t(_ip_next++ % IP_MAX_PACKETS);
+    TSPacket& ipkt(_ip_pkt[cur]);
+    ipkt = pkt;
+    _ip_useful[cur] = false;
+
+    // Parse the sections in the packet payload. Duplicate and scrambled packets are dropped.
+    if (ipkt.hasPayload()) {
+        const uint8_t cc = ipkt.getCC();
+        const bool duplicate = _ip_has_cc && cc == _ip_last_cc;
+        if (ipkt.getDiscontinuityIndicator() || (_ip_has_cc && !duplicate && cc != ((_ip_last_cc + 1) & CC_MASK))) {
+            // Lost packets, the current section is truncated.
+            _ip_sec.active = false;
+        }
+        _ip_last_cc = cc;
+        _ip_has_cc = true;
+
+        uint8_t* data = ipkt.getPayload();
+        size_t size = ipkt.getPayloadSize();
+
+        if (duplicate || ipkt.isScrambled()) {
+            // Ignore packet.
+        }
+        else if (!ipkt.getPUSI()) {
+            // No section starts in this packet, bytes after the end of the current section are stuffing.
+            if (_ip_sec.active) {
+                parseInPlace(data, size);
+            }
+        }
+        else if (size == 0 || 1 + size_t(data[0]) > size) {
+            // Invalid pointer field.
+            _ip_sec.active = false;
+        }
+        else {
+            // The pointer field is the size of the end of the current section.
+            const size_t pf = data[0];
+            data++;
+            size--;
+            if (_ip_sec.active) {
+                parseInPlace(data, pf);
+                // If the section is not complete, it is truncated.
+                _ip_sec.active = false;
+            }
+            data += pf;
+            size -= pf;
+
+            // Parse all sections which start in this packet, up to stuffing.
+            while (size > 0 && data[0] != 0xFF) {
+                _ip_sec = InPlaceSection();
+                _ip_sec.active = true;
+                _ip_sec.first_packet = _ip_next - 1;
+                const size_t count = parseInPlace(data, size);
+                data += count;
+                size -= count;
+                if (_ip_sec.active) {
+                    // The section continues in the next packet (or is invalid).
+                    break;
+                }
+            }
+        }
+    }
+
+    // Output the oldest delayed packet which is ready, a null packet otherwise.
+    if (has_out || releaseInPlace(out, false)) {
+        pkt = out;
+    }
+    else {
+        pkt = NullPacket;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Release the oldest delayed packets, up to the first useful one.
+// Packets containing bytes from the current section are released only when
+// forced to and the section can no longer be modified or dropped.
+// Return true when a useful packet is returned.
+//----------------------------------------------------------------------------
+
+bool ts::EITProcessor::releaseInPlace(TSPacket& pkt, bool force)
+{
+    while (_ip_first < _ip_next) {
+        const size_t index = size_t(_ip_first % IP_MAX_PACKETS);
+        if (_ip_sec.active && _ip_first >= _ip_sec.first_packet) {
+            if (!force) {
+                break;
+            }
+            _ip_sec.frozen = true;
+            _ip_useful[index] = _ip_useful[index] || _ip_sec.keep;
+        }
+        _ip_first++;
+        if (_ip_useful[index]) {
+            pkt = _ip_pkt[index];
+            pkt.setPID(_output_pid);
+            pkt.setCC(_ip_out_cc);
+            _ip_out_cc = (_ip_out_cc + 1) & CC_MASK;
+            _packetizer.setNextContinuityCounter(_ip_out_cc);
+            return true;
+        }
+        // One slot is free, don't release the current section if not necessary.
+        force = false;
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the bytes of the current section in the last input packet.
+// Return the number of bytes which belong to the section.
+//----------------------------------------------------------------------------
+
+size_t ts::EITProcessor::parseInPlace(uint8_t* data, size_t size)
+{
+    InPlaceSection& sec(_ip_sec);
+    size_t count = 0;
+
+    // Collect the addresses and values of the header bytes.
+    while (count < size && sec.offset < DECISION_HEADER_SIZE && (sec.size == 0 || sec.offset < sec.size)) {
+        sec.header[sec.offset] = data + count;
+        sec.value[sec.offset++] = data[count++];
+        if (sec.offset == 3) {
+            sec.size = 3 + (GetUInt16(sec.value + 1) & 0x0FFF);
+            if (sec.size > MAX_PRIVATE_SECTION_SIZE) {
+                // Invalid section, ignore the rest of the packet.
+                sec.active = false;
+                return size;
+            }
+        }
+    }
+    sec.crc.add(data, count);
+
+    if (!sec.decided) {
+        if (sec.size == 0 || sec.offset < std::min(DECISION_HEADER_SIZE, sec.size)) {
+            // Not enough header bytes to decide, wait for the next packet.
+            return count;
+        }
+        decideInPlace();
+    }
+
+    // Remaining bytes of the section in the packet. The CRC32 of removed sections is not checked.
+    const size_t remain = std::min(size - count, sec.size - sec.offset);
+    if (sec.keep) {
+        sec.crc.add(data + count, remain);
+    }
+
+    // Incremental update of the CRC32 bytes, at the end of the section.
+    if (sec.crc_xor != 0 && sec.offset + remain > sec.size - SECTION_CRC32_SIZE) {
+        for (size_t off = std::max(sec.offset, sec.size - SECTION_CRC32_SIZE); off < sec.offset + remain; ++off) {
+            data[count + off - sec.offset] ^= uint8_t(sec.crc_xor >> (8 * (sec.size - 1 - off)));
+        }
+    }
+
+    sec.offset += remain;
+    count += remain;
+    if (sec.offset >= sec.size) {
+        completeInPlace();
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Decide what to do with the current section, when its header is complete.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::decideInPlace()
+{
+    InPlaceSection& sec(_ip_sec);
+    sec.decided = true;
+
+    // If the first bytes of the section were already sent, pass it unmodified.
+    if (sec.frozen) {
+        sec.keep = true;
+        return;
+    }
+
+    // Get the section characteristics from the header.
+    const uint8_t* const hdr = sec.value;
+    const TID tid = hdr[0];
+    const bool is_long = Section::StartLongSection(hdr, sec.size);
+    const size_t header_size = is_long ? LONG_SECTION_HEADER_SIZE : SHORT_SECTION_HEADER_SIZE;
+    const size_t min_size = is_long ? MIN_LONG_SECTION_SIZE : SHORT_SECTION_HEADER_SIZE;
+    const size_t pl_size = sec.size < min_size ? 0 : sec.size - min_size;
+    const uint16_t srv_id = is_long ? GetUInt16(hdr + 3) : 0;
+    const uint16_t ts_id  = pl_size < 2 ? 0 : GetUInt16(hdr + header_size);
+    const uint16_t net_id = pl_size < 4 ? 0 : GetUInt16(hdr + header_size + 2);
+
+    sec.keep = keepSection(tid, pl_size, srv_id, ts_id, net_id);
+
+    if (!sec.keep) {
+        // Invalidate the section as a DVB stuffing section. This is visible only when the
+        // section shares a packet with a kept section, other packets are nullified.
+        *sec.header[0] = TID_ST;
+        *sec.header[1] &= 0x7F;
+    }
+    else {
+        // Rename EIT's. The long header and the first payload fields are all in the decision header.
+        uint16_t new_srv_id = srv_id;
+        uint16_t new_ts_id = ts_id;
+        uint16_t new_net_id = net_id;
+        if (is_long && pl_size >= 4 && tid >= TID_EIT_PF_ACT && tid <= TID_EIT_S_OTH_MAX && renameIds(srv_id, ts_id, net_id, new_srv_id, new_ts_id, new_net_id)) {
+            uint8_t new_hdr[DECISION_HEADER_SIZE];
+            std::memcpy(new_hdr, hdr, sizeof(new_hdr));
+            PutUInt16(new_hdr + 3, new_srv_id);
+            PutUInt16(new_hdr + 8, new_ts_id);
+            PutUInt16(new_hdr + 10, new_net_id);
+            for (size_t i = 0; i < DECISION_HEADER_SIZE; ++i) {
+                *sec.header[i] = new_hdr[i];
+            }
+
+            // The XOR of the old and new CRC32 values is the CRC32 with a zero initial value of
+            // the XOR of the old and new contents. Only the header is modified: this content
+            // difference is the XOR of the two headers, followed by zeroes up to the CRC32.
+            static const uint8_t zeroes[MAX_PRIVATE_SECTION_SIZE] = {};
+            uint8_t diff[DECISION_HEADER_SIZE];
+            for (size_t i = 0; i < DECISION_HEADER_SIZE; ++i) {
+                diff[i] = hdr[i] ^ new_hdr[i];
+            }
+            CRC32 crc;
+            crc.resetZero();
+            crc.add(diff, DECISION_HEADER_SIZE);
+            crc.add(zeroes, sec.size - DECISION_HEADER_SIZE - SECTION_CRC32_SIZE);
+            sec.crc_xor = crc.value();
+            sec.modified = true;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Complete the current section, when its last byte is parsed.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::completeInPlace()
+{
+    InPlaceSection& sec(_ip_sec);
+    sec.active = false;
+
+    // The CRC32 of a complete long section, including its CRC32 field, is zero.
+    // A kept section with an invalid CRC32 is dropped like a removed section,
+    // unless some of its packets were already output.
+    if (sec.keep && !sec.frozen && Section::StartLongSection(sec.value, sec.size) && sec.crc.value() != 0) {
+        *sec.header[0] = TID_ST;
+        *sec.header[1] &= 0x7F;
+        return;
+    }
+
+    _input_sections++;
+    if (!sec.keep) {
+        _removed_sections++;
+    }
+    else {
+        if (sec.modified) {
+            _modified_sections++;
+        }
+        // Mark all delayed packets containing bytes of the section as useful.
+        for (PacketCounter i = std::max(sec.first_packet, _ip_first); i < _ip_next; ++i) {
+            _ip_useful[i % IP_MAX_PACKETS] = true;
+        }
     }
 }
 
@@ -282,83 +636,125 @@ bool ts::EITProcessor::Match(const Service& srv, uint16_t srv_id, uint16_t ts_id
 
 
 //----------------------------------------------------------------------------
-// Implementation of SectionHandlerInterface.
+// Check if a section shall be kept.
 //----------------------------------------------------------------------------
 
-void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section)
+bool ts::EITProcessor::keepSection(TID tid, size_t payload_size, uint16_t srv_id, uint16_t ts_id, uint16_t net_id) const
 {
-    const TID tid = section.tableId();
-    const size_t pl_size = section.payloadSize();
-
     // Eliminate sections by table id.
     if (Contains(_removed_tids, tid)) {
         // This table id is part of tables to be removed.
-        return;
+        return false;
     }
 
-    // Check if the table is an EIT. Use the fact that all EIT ids are contiguous.
-    const bool is_eit = tid >= TID_EIT_PF_ACT && tid <= TID_EIT_S_OTH_MAX;
+    // Keep all other non-EIT sections. Use the fact that all EIT ids are contiguous.
+    if (tid < TID_EIT_PF_ACT || tid > TID_EIT_S_OTH_MAX) {
+        return true;
+    }
 
     // The minimal payload size for EIT's is 6 bytes. Eliminate invalid EIT's.
-    if (is_eit && pl_size < 6) {
-        return;
+    if (payload_size < 6) {
+        return false;
+    }
+
+    // Look for EIT's in services to keep or remove.
+    bool keep = false;
+    if (_kept.empty()) {
+        // No service to keep, only check services to remove.
+        keep = true;
+        for (auto it = _removed.begin(); keep && it != _removed.end(); ++it) {
+            keep = !Match(*it, srv_id, ts_id, net_id);
+        }
+    }
+    else {
+        // There are some services to keep, remove any other service.
+        keep = false;
+        for (auto it = _kept.begin(); !keep && it != _kept.end(); ++it) {
+            keep = Match(*it, srv_id, ts_id, net_id);
+        }
     }
+    return keep;
+}
+
+
+//----------------------------------------------------------------------------
+// Apply the renaming rules to the identifiers of an EIT.
+//----------------------------------------------------------------------------
+
+bool ts::EITProcessor::renameIds(uint16_t srv_id, uint16_t ts_id, uint16_t net_id, uint16_t& new_srv_id, uint16_t& new_ts_id, uint16_t& new_net_id) const
+{
+    bool modified = false;
+    new_srv_id = srv_id;
+    new_ts_id = ts_id;
+    new_net_id = net_id;
+    for (const auto& it : _renamed) {
+        if (Match(it.first, srv_id, ts_id, net_id)) {
+            // Rename the specified fields.
+            if (it.second.hasId()) {
+                modified = true;
+                new_srv_id = it.second.getId();
+            }
+            if (it.second.hasTSId()) {
+                modified = true;
+                new_ts_id = it.second.getTSId();
+            }
+            if (it.second.hasONId()) {
+                modified = true;
+                new_net_id = it.second.getONId();
+            }
+        }
+    }
+    return modified;
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of SectionHandlerInterface.
+//----------------------------------------------------------------------------
+
+void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section)
+{
+    const TID tid = section.tableId();
+    const size_t pl_size = section.payloadSize();
+    _input_sections++;
 
     // Get EIT's characteristics.
     const uint16_t srv_id = section.tableIdExtension();
     const uint16_t ts_id  = pl_size < 2 ? 0 : GetUInt16(section.payload());
     const uint16_t net_id = pl_size < 4 ? 0 : GetUInt16(section.payload() + 2);
 
-    // Look for EIT's in services to keep or remove.
-    if (is_eit) {
-        bool keep = false;
-        if (_kept.empty()) {
-            // No service to keep, only check services to remove.
-            keep = true;
-            for (auto it = _removed.begin(); keep && it != _removed.end(); ++it) {
-                keep = !Match(*it, srv_id, ts_id, net_id);
-            }
-        }
-        else {
-            // There are some services to keep, remove any other service.
-            keep = false;
-            for (auto it = _kept.begin(); !keep && it != _kept.end(); ++it) {
-                keep = Match(*it, srv_id, ts_id, net_id);
-            }
-        }
-        if (!keep) {
-            // Ignore all EIT's for services to remove.
-            return;
-        }
+    // Eliminate sections by table id, invalid EIT's and EIT's for services to remove.
+    if (!keepSection(tid, pl_size, srv_id, ts_id, net_id)) {
+        _removed_sections++;
+        return;
     }
 
-    // At this point, we need to keep the section.
-    // Build a copy of it for insertion in the queue.
-    const SectionPtr sp(new Section(section, ShareMode::COPY));
+    // Check if the table is an EIT. Use the fact that all EIT ids are contiguous.
+    const bool is_eit = tid >= TID_EIT_PF_ACT && tid <= TID_EIT_S_OTH_MAX;
+
+    // Compute the renamed identifiers of the EIT.
+    uint16_t new_srv_id = srv_id;
+    uint16_t new_ts_id = ts_id;
+    uint16_t new_net_id = net_id;
+    const bool renamed = is_eit && renameIds(srv_id, ts_id, net_id, new_srv_id, new_ts_id, new_net_id);
+
+    // At this point, we need to keep the section. Build a copy of it for insertion in the queue
+    // if it must be modified. Otherwise, simply share the section content.
+    const bool modify = renamed || (is_eit && _start_time_offset != 0);
+    const SectionPtr sp(new Section(section, modify ? ShareMode::COPY : ShareMode::SHARE));
     CheckNonNull(sp.pointer());
 
     // Update the section if this is an EIT.
-    if (is_eit) {
+    if (modify) {
         // Recompute CRC at end only.
         bool modified = false;
 
         // Rename EIT's.
-        for (const auto& it : _renamed) {
-            if (Match(it.first, srv_id, ts_id, net_id)) {
-                // Rename the specified fields.
-                if (it.second.hasId()) {
-                    modified = true;
-                    sp->setTableIdExtension(it.second.getId(), false);
-                }
-                if (it.second.hasTSId()) {
-                    modified = true;
-                    sp->setUInt16(0, it.second.getTSId(), false);
-                }
-                if (it.second.hasONId()) {
-                    modified = true;
-                    sp->setUInt16(2, it.second.getONId(), false);
-                }
-            }
+        if (renamed) {
+            modified = true;
+            sp->setTableIdExtension(new_srv_id, false);
+            sp->setUInt16(0, new_ts_id, false);
+            sp->setUInt16(2, new_net_id, false);
         }
 
         // Update all events start times.
@@ -387,6 +783,7 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
         // Update CRC if the section was modified.
         if (modified) {
             sp->recomputeCRC();
+            _modified_sections++;
         }
     }
 
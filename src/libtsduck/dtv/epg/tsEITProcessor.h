@@ -17,6 +17,8 @@
 #include "tsTSPacket.h"
 #include "tsService.h"
 #include "tsTransportStreamId.h"
+#include "tsTime.h"
+#include "tsCRC32.h"
 
 namespace ts {
     //!
@@ -82,6 +84,8 @@ namespace ts {
         //!
         //! Reset the EIT processor to default state.
         //! The input and output PID's are unchanged.
+        //! Packets which are delayed by the in-place processing are dropped.
+        //! Use flushPacket() first to get them.
         //!
         void reset();
 
@@ -92,6 +96,22 @@ namespace ts {
         //!
         void processPacket(TSPacket& pkt);
 
+        //!
+        //! Get the next packet which was delayed by the in-place processing.
+        //!
+        //! With in-place processing, the packets of a section are delayed until the section is complete.
+        //! Each packet from an input PID is replaced by the oldest delayed packet, when there is one.
+        //! This method shall be called when an additional packet can be output, typically to replace
+        //! a null packet from the stream, and at end of stream.
+        //!
+        //! @param [out] pkt The next delayed packet on the output PID.
+        //! @param [in] end_of_stream If true, the input is terminated. The incomplete section which is
+        //! currently parsed, if any, is dropped and all other delayed packets can be returned.
+        //! @return True if a packet was returned in @a pkt, false if there is no delayed packet to output.
+        //! @see setInPlace()
+        //!
+        bool flushPacket(TSPacket& pkt, bool end_of_stream = false);
+
         //!
         //! Remove all EIT's for a given transport stream.
         //! @param [in] ts_id Id of the transport stream to remove (any original network id).
@@ -238,6 +258,61 @@ namespace ts {
         //!
         size_t getCurrentBufferedSections() const { return _sections.size(); }
 
+        //!
+        //! Enable or disable the in-place processing of the EIT sections.
+        //!
+        //! By default, all EIT sections are demuxed, modified when necessary and repacketized.
+        //! With in-place processing, the sections are directly updated inside the TS packets,
+        //! without copy and without repacketization. This is much faster on large EPG's.
+        //!
+        //! - Renamed sections are updated in their packets. Their CRC32 is incrementally updated.
+        //! - Packets which contain only removed sections are replaced with null packets.
+        //! - A removed section which shares a TS packet with a kept section is invalidated as a
+        //!   DVB stuffing section (table id 0x72), as defined by ETSI EN 300 468.
+        //! - Sections with an invalid CRC32 and truncated sections are dropped in the same way.
+        //! - The packets of a section are delayed until the section is complete. Null packets are
+        //!   output meanwhile. Use flushPacket() to get the delayed packets, replacing null packets
+        //!   of the stream and at end of stream. When a section is larger than the delay buffer,
+        //!   its first packets are output unmodified before its end and its CRC32 is not checked.
+        //!
+        //! In-place processing is used only when there is one single input PID and no start time
+        //! offset. Otherwise, the sections are repacketized, even if in-place processing is enabled.
+        //!
+        //! @param [in] on True to enable in-place processing, false to repacketize all sections.
+        //!
+        void setInPlace(bool on);
+
+        //!
+        //! Check if in-place processing of the EIT sections is enabled.
+        //! @return True if in-place processing is enabled.
+        //! @see setInPlace()
+        //!
+        bool inPlace() const { return _in_place; }
+
+        //!
+        //! Get the number of input sections since the last reset.
+        //! @return The number of input sections since the last reset.
+        //!
+        SectionCounter inputSectionCount() const { return _input_sections; }
+
+        //!
+        //! Get the number of modified sections since the last reset.
+        //! @return The number of modified sections since the last reset.
+        //!
+        SectionCounter modifiedSectionCount() const { return _modified_sections; }
+
+        //!
+        //! Get the number of removed sections since the last reset.
+        //! @return The number of removed sections since the last reset.
+        //!
+        SectionCounter removedSectionCount() const { return _removed_sections; }
+
+        //!
+        //! Report the numbers of processed sections and the processing throughput since the last reset.
+        //! @param [in] severity Severity level of the report message.
+        //!
+        void reportStatistics(int severity = Severity::Verbose) const;
+
     private:
         DuckContext&          _duck;
         PIDSet                _input_pids {};
@@ -252,11 +327,66 @@ namespace ts {
         std::list<Service>    _removed {};
         std::list<Service>    _kept {};
         std::list<std::pair<Service,Service>> _renamed {};
+        SectionCounter        _input_sections = 0;
+        SectionCounter        _modified_sections = 0;
+        SectionCounter        _removed_sections = 0;
+        Time                  _reset_time {Time::CurrentUTC()};
+
+        // Number of bytes in the header of a section which are needed to decide what to do with it.
+        static constexpr size_t DECISION_HEADER_SIZE = 12;
+
+        // In-place processing state of the section which is currently parsed.
+        struct InPlaceSection
+        {
+            bool          active = false;    // A section is being parsed.
+            bool          decided = false;   // The decision to keep or remove the section is done.
+            bool          frozen = false;    // Some packets of the section were already output, the section is passed as is.
+            bool          keep = true;       // The section is kept (possibly modified).
+            bool          modified = false;  // The section is renamed.
+            size_t        offset = 0;        // Number of bytes of the section which were already parsed.
+            size_t        size = 0;          // Total section size, zero when not yet known.
+            PacketCounter first_packet = 0;  // Index of the input packet containing the start of the section.
+            uint32_t      crc_xor = 0;       // XOR mask to apply to the CRC32 of the section.
+            CRC32         crc {};            // CRC32 of the input section, including its CRC32 field.
+            uint8_t       value[DECISION_HEADER_SIZE] {};  // Values of the first bytes of the section.
+            uint8_t*      header[DECISION_HEADER_SIZE] {}; // Addresses of the first bytes of the section in the packet buffers.
+        };
+
+        // Maximum number of delayed packets in in-place processing. A section of maximum size fits in 24 packets.
+        static constexpr size_t IP_MAX_PACKETS = 32;
+
+        // In-place processing. The input packets are stored in a ring buffer until the sections they
+        // contain are complete. Packets are identified by their index in the input PID. The slot of
+        // packet N in the ring buffer is N % IP_MAX_PACKETS.
+        bool           _in_place = false;         // In-place processing is enabled.
+        bool           _in_place_active = false;  // In-place processing is currently used.
+        bool           _ip_has_cc = false;        // _ip_last_cc is valid.
+        uint8_t        _ip_last_cc = 0;           // Last input continuity counter.
+        uint8_t        _ip_out_cc = 0;            // Next output continuity counter.
+        PacketCounter  _ip_first = 0;             // Index of the oldest delayed packet.
+        PacketCounter  _ip_next = 0;              // Index of the next input packet.
+        TSPacket       _ip_pkt[IP_MAX_PACKETS] {};   // Delayed packets.
+        bool           _ip_useful[IP_MAX_PACKETS] {}; // The delayed packet contains bytes from kept sections.
+        InPlaceSection _ip_sec {};                // Section which is currently parsed.
 
         // Check if a service matches a DVB triplet.
         // The service must have at least a service id or transport id.
         static bool Match(const Service& srv, uint16_t srv_id, uint16_t ts_id, uint16_t net_id);
 
+        // Check if a section shall be kept.
+        bool keepSection(TID tid, size_t payload_size, uint16_t srv_id, uint16_t ts_id, uint16_t net_id) const;
+
+        // Apply the renaming rules to the identifiers of an EIT. Return true if the EIT shall be modified.
+        bool renameIds(uint16_t srv_id, uint16_t ts_id, uint16_t net_id, uint16_t& new_srv_id, uint16_t& new_ts_id, uint16_t& new_net_id) const;
+
+        // In-place processing of packets and sections.
+        void resetInPlace();
+        void processPacketInPlace(TSPacket& pkt);
+        bool releaseInPlace(TSPacket& pkt, bool force);
+        size_t parseInPlace(uint8_t* data, size_t size);
+        void decideInPlace();
+        void completeInPlace();
+
         // Implementation of SectionHandlerInterface.
         virtual void handleSection(SectionDemux& demux, const Section& section) override;
 
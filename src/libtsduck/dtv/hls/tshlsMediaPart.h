@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Description of a partial segment in a low-latency HLS playlist.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tshlsMediaElement.h"
+
+namespace ts {
+    namespace hls {
+        //!
+        //! Description of a partial segment in a low-latency HLS playlist (EXT-X-PART).
+        //! @ingroup hls
+        //!
+        class TSDUCKDLL MediaPart : public MediaElement
+        {
+            TS_RULE_OF_FIVE(MediaPart, override);
+        public:
+            //!
+            //! Constructor.
+            //!
+            MediaPart() = default;
+
+            MilliSecond duration = 0;       //!< Partial segment duration in milliseconds.
+            bool        independent = false; //!< The partial segment contains an independent frame.
+        };
+    }
+}
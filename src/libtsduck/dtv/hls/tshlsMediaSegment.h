@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tshlsMediaElement.h"
+#include "tshlsMediaPart.h"
 #include "tsBitRate.h"
 
 namespace ts {
@@ -30,10 +31,11 @@ namespace ts {
             //!
             MediaSegment() = default;
 
-            UString     title {};      //!< Optional segment title.
-            MilliSecond duration = 0;  //!< Segment duration in milliseconds.
-            BitRate     bitrate = 0;   //!< Indicative bitrate.
-            bool        gap = false;   //!< Media is a "gap", should not be loaded by clients.
+            UString                title {};      //!< Optional segment title.
+            MilliSecond            duration = 0;  //!< Segment duration in milliseconds.
+            BitRate                bitrate = 0;   //!< Indicative bitrate.
+            bool                   gap = false;   //!< Media is a "gap", should not be loaded by clients.
+            std::vector<MediaPart> parts {};      //!< Partial segments, in low-latency playlists.
         };
     }
 }
@@ -28,9 +28,12 @@ void ts::hls::PlayList::clear()
     _targetDuration = 0;
     _mediaSequence = 0;
     _endList = false;
+    _partTarget = 0;
     _utcDownload = Time::Epoch;
     _utcTermination = Time::Epoch;
     _segments.clear();
+    _pendingParts.clear();
+    _preloadHint.clear();
     _playlists.clear();
     _altPlaylists.clear();
     _loadedContent.clear();
@@ -156,6 +159,17 @@ bool ts::hls::PlayList::setMediaSequence(size_t seq, Report& report)
     }
 }
 
+bool ts::hls::PlayList::setPartTarget(MilliSecond duration, Report& report)
+{
+    if (setTypeMedia(report)) {
+        _partTarget = duration;
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
 bool ts::hls::PlayList::setEndList(bool end, Report& report)
 {
     if (setTypeMedia(report)) {
@@ -251,9 +265,11 @@ bool ts::hls::PlayList::addSegment(const MediaSegment& seg, Report& report)
         // Add the segment.
         _segments.push_back(seg);
         // Build a relative URI.
-        if (!_isURL && !_original.empty()) {
-            // The playlist's URI is a file name, update the segment's URI.
-            _segments.back().relativeURI = RelativeFilePath(seg.relativeURI, _fileBase, FILE_SYSTEM_CASE_SENSITVITY, true);
+        _segments.back().relativeURI = relativeURI(seg.relativeURI);
+        // The partial segments of the segment in progress now belong to this segment.
+        if (!_pendingParts.empty()) {
+            _segments.back().parts.insert(_segments.back().parts.end(), _pendingParts.begin(), _pendingParts.end());
+            _pendingParts.clear();
         }
         return true;
     }
@@ -262,6 +278,38 @@ bool ts::hls::PlayList::addSegment(const MediaSegment& seg, Report& report)
     }
 }
 
+bool ts::hls::PlayList::addPendingPart(const MediaPart& part, Report& report)
+{
+    if (part.relativeURI.empty()) {
+        report.error(u"empty partial segment URI");
+        return false;
+    }
+    else if (setTypeMedia(report)) {
+        _pendingParts.push_back(part);
+        _pendingParts.back().relativeURI = relativeURI(part.relativeURI);
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+void ts::hls::PlayList::setPreloadHint(const UString& uri)
+{
+    _preloadHint = uri.empty() ? uri : relativeURI(uri);
+}
+
+ts::UString ts::hls::PlayList::relativeURI(const UString& uri) const
+{
+    if (!_isURL && !_original.empty()) {
+        // The playlist's URI is a file name, build a relative URI.
+        return RelativeFilePath(uri, _fileBase, FILE_SYSTEM_CASE_SENSITVITY, true);
+    }
+    else {
+        return uri;
+    }
+}
+
 
 bool ts::hls::PlayList::addPlayList(const MediaPlayList& pl, Report& report)
 {
@@ -1007,8 +1055,19 @@ bool ts::hls::PlayList::saveFile(const ts::UString &filename, ts::Report &report
         return false;
     }
 
-    // Save the file.
+    // Save the file. First write a temporary file and then rename it. This way, clients which
+    // reload the playlist while it is updated never see a truncated playlist. If the rename
+    // fails (on Windows, when the playlist is open by the HTTP server), directly overwrite it.
     const UString& name(filename.empty() ? _original : filename);
+    const UString tmpName(name + u".tmp");
+    bool renamed = text.save(tmpName, false, true);
+    if (renamed) {
+        fs::rename(tmpName, name, &ErrCodeReport(renamed));
+    }
+    if (renamed) {
+        return true;
+    }
+    fs::remove(tmpName, &ErrCodeReport());
     if (!text.save(name, false, true)) {
         report.error(u"error saving HLS playlist in %s", {name});
         return false;
@@ -1030,9 +1089,10 @@ ts::UString ts::hls::PlayList::textContent(ts::Report &report) const
         return UString();
     }
 
-    // Start building the content.
+    // Start building the content. Low-latency HLS tags require at least version 6 of the protocol.
+    const int version = isMedia() && _partTarget > 0 ? std::max(_version, 6) : _version;
     UString text;
-    text.format(u"#%s\n#%s:%d\n", {TagNames.name(Tag::EXTM3U), TagNames.name(Tag::VERSION), _version});
+    text.format(u"#%s\n#%s:%d\n", {TagNames.name(Tag::EXTM3U), TagNames.name(Tag::VERSION), version});
 
     // Insert application-specific tags before standard tags.
     for (const auto& tag : _extraTags) {
@@ -1139,9 +1199,28 @@ ts::UString ts::hls::PlayList::textContent(ts::Report &report) const
             text.format(u"#%s:EVENT\n", {TagNames.name(Tag::PLAYLIST_TYPE)});
         }
 
+        // Low-latency HLS: clients shall remain at least three partial segments behind the live edge.
+        if (_partTarget > 0) {
+            text.format(u"#%s:PART-TARGET=%d.%03d\n", {TagNames.name(Tag::PART_INF), _partTarget / MilliSecPerSec, _partTarget % MilliSecPerSec});
+            text.format(u"#%s:PART-HOLD-BACK=%d.%03d\n", {TagNames.name(Tag::SERVER_CONTROL), (3 * _partTarget) / MilliSecPerSec, (3 * _partTarget) % MilliSecPerSec});
+        }
+
+        // Partial segments are only listed in the segments which are less than
+        // three target durations from the end of the playlist.
+        size_t firstParts = _segments.size();
+        for (MilliSecond duration = 0; firstParts > 0 && duration < 3 * _targetDuration * MilliSecPerSec; ) {
+            duration += _segments[--firstParts].duration;
+        }
+
         // Loop on all media segments.
-        for (const auto& seg : _segments) {
+        for (size_t index = 0; index < _segments.size(); ++index) {
+            const MediaSegment& seg(_segments[index]);
             if (!seg.relativeURI.empty()) {
+                if (index >= firstParts) {
+                    for (const auto& part : seg.parts) {
+                        FormatPart(text, part);
+                    }
+                }
                 text.format(u"#%s:%d.%03d,%s\n", {TagNames.name(Tag::EXTINF), seg.duration / MilliSecPerSec, seg.duration % MilliSecPerSec, seg.title});
                 if (seg.bitrate > 1024) {
                     text.format(u"#%s:%d\n", {TagNames.name(Tag::BITRATE), (seg.bitrate / 1024).toInt()});
@@ -1153,6 +1232,14 @@ ts::UString ts::hls::PlayList::textContent(ts::Report &report) const
             }
         }
 
+        // Partial segments of the segment in progress and hint for the next one.
+        for (const auto& part : _pendingParts) {
+            FormatPart(text, part);
+        }
+        if (!_preloadHint.empty()) {
+            text.format(u"#%s:TYPE=PART,URI=\"%s\"\n", {TagNames.name(Tag::PRELOAD_HINT), _preloadHint});
+        }
+
         // Mark end of list when necessary.
         if (_endList) {
             text.format(u"#%s\n", {TagNames.name(Tag::ENDLIST)});
@@ -1165,3 +1252,17 @@ ts::UString ts::hls::PlayList::textContent(ts::Report &report) const
 
     return text;
 }
+
+
+//----------------------------------------------------------------------------
+// Format an EXT-X-PART tag.
+//----------------------------------------------------------------------------
+
+void ts::hls::PlayList::FormatPart(UString& text, const MediaPart& part)
+{
+    text.format(u"#%s:DURATION=%d.%03d,URI=\"%s\"", {TagNames.name(Tag::PART), part.duration / MilliSecPerSec, part.duration % MilliSecPerSec, part.relativeURI});
+    if (part.independent) {
+        text.append(u",INDEPENDENT=YES");
+    }
+    text.append(u'\n');
+}
@@ -233,6 +233,22 @@ namespace ts {
             //!
             bool setTargetDuration(Second duration, Report& report = CERR);
 
+            //!
+            //! Get the partial segment target duration (in low-latency media playlist).
+            //! @return The partial segment target duration in milliseconds.
+            //! Zero when the playlist does not use partial segments.
+            //!
+            MilliSecond partTarget() const { return _partTarget; }
+
+            //!
+            //! Set the partial segment target duration in a low-latency media playlist.
+            //! When not zero, the playlist contains EXT-X-PART-INF and EXT-X-SERVER-CONTROL tags.
+            //! @param [in] duration The partial segment target duration in milliseconds.
+            //! @param [in,out] report Where to report errors.
+            //! @return True on success, false on error.
+            //!
+            bool setPartTarget(MilliSecond duration, Report& report = CERR);
+
             //!
             //! Get the sequence number of first segment (in media playlist).
             //! @return The sequence number of first segment.
@@ -309,6 +325,31 @@ namespace ts {
             //!
             bool addSegment(const MediaSegment& seg, Report& report = CERR);
 
+            //!
+            //! Add a partial segment of the media segment in progress (in low-latency media playlist).
+            //! The pending partial segments are listed after the last complete segment. They are
+            //! moved into the next segment which is added using addSegment().
+            //! @param [in] part The new partial segment to append. If the playlist's URI is a file
+            //! name, the URI of the part is transformed into a relative URI from the playlist's path.
+            //! @param [in,out] report Where to report errors.
+            //! @return True on success, false on error.
+            //!
+            bool addPendingPart(const MediaPart& part, Report& report = CERR);
+
+            //!
+            //! Get the number of partial segments of the media segment in progress.
+            //! @return The number of pending partial segments.
+            //!
+            size_t pendingPartCount() const { return _pendingParts.size(); }
+
+            //!
+            //! Set the URI of the next partial segment, announced in an EXT-X-PRELOAD-HINT tag.
+            //! @param [in] uri The URI of the next partial segment. If the playlist's URI is a file
+            //! name, the URI is transformed into a relative URI from the playlist's path. When empty,
+            //! there is no EXT-X-PRELOAD-HINT tag.
+            //!
+            void setPreloadHint(const UString& uri);
+
             //!
             //! Get the download UTC time of the playlist.
             //! @return The download UTC time of the playlist.
@@ -443,9 +484,12 @@ namespace ts {
             Second             _targetDuration = 0;  // Segment target duration (media playlist).
             size_t             _mediaSequence = 0;   // Sequence number of first segment (media playlist).
             bool               _endList = false;     // End of list indicator (media playlist).
+            MilliSecond        _partTarget = 0;      // Partial segment target duration (low-latency media playlist).
             Time               _utcDownload {};      // UTC time of download.
             Time               _utcTermination {};   // UTC time of termination (download + all segment durations).
             MediaSegmentQueue  _segments {};         // List of media segments (media playlist).
+            std::vector<MediaPart> _pendingParts {}; // Partial segments of the segment in progress (low-latency media playlist).
+            UString            _preloadHint {};      // URI of next partial segment (low-latency media playlist).
             MediaPlayListQueue _playlists {};        // List of media playlists (master playlist).
             AltPlayListQueue   _altPlaylists {};     // List of alternative rendition media playlists (master playlist).
             UStringList        _loadedContent {};    // Loaded text content (can be different from current content).
@@ -467,6 +511,12 @@ namespace ts {
 
             // Perform automatic save of the loaded playlist.
             bool autoSave(Report& report);
+
+            // Build the URI of a media element from the playlist's location.
+            UString relativeURI(const UString& uri) const;
+
+            // Format an EXT-X-PART tag.
+            static void FormatPart(UString& text, const MediaPart& part);
         };
     }
 }
@@ -20,20 +20,24 @@
 // Note that the max size of a descriptor is 257 bytes: 2 (header) + 255
 //----------------------------------------------------------------------------
 
-ts::Descriptor::Descriptor(const void* addr, size_t size) :
-    _data(size >= 2 && size < 258 && (reinterpret_cast<const uint8_t*>(addr))[1] == size - 2 ? new ByteBlock(addr, size) : nullptr)
+ts::Descriptor::Descriptor(const void* addr, size_t size)
 {
+    if (size >= 2 && size < 258 && (reinterpret_cast<const uint8_t*>(addr))[1] == size - 2) {
+        setData(addr, size);
+    }
 }
 
-ts::Descriptor::Descriptor(const ByteBlock& bb) :
-    _data(bb.size() >= 2 && bb.size() < 258 && bb[1] == bb.size() - 2 ? new ByteBlock(bb) : nullptr)
+ts::Descriptor::Descriptor(const ByteBlock& bb)
 {
+    if (bb.size() >= 2 && bb.size() < 258 && bb[1] == bb.size() - 2) {
+        setData(bb.data(), bb.size());
+    }
 }
 
-ts::Descriptor::Descriptor(DID tag, const void* data, size_t size) :
-    _data(size < 256 ? new ByteBlock(size + 2) : nullptr)
+ts::Descriptor::Descriptor(DID tag, const void* data, size_t size)
 {
-    if (!_data.isNull()) {
+    if (size < 256) {
+        _data = new ByteBlock(size + 2);
         (*_data)[0] = tag;
         (*_data)[1] = uint8_t(size);
         std::memcpy(_data->data() + 2, data, size);
@@ -41,13 +45,8 @@ ts::Descriptor::Descriptor(DID tag, const void* data, size_t size) :
 }
 
 ts::Descriptor::Descriptor(DID tag, const ByteBlock& data) :
-    _data(data.size() < 256 ? new ByteBlock(2) : nullptr)
+    Descriptor(tag, data.data(), data.size())
 {
-    if (!_data.isNull()) {
-        (*_data)[0] = tag;
-        (*_data)[1] = uint8_t(data.size());
-        _data->append(data);
-    }
 }
 
 ts::Descriptor::Descriptor(const ByteBlockPtr& bbp, ShareMode mode)
@@ -58,7 +57,7 @@ ts::Descriptor::Descriptor(const ByteBlockPtr& bbp, ShareMode mode)
                 _data = bbp;
                 break;
             case ShareMode::COPY:
-                _data = new ByteBlock(*bbp);
+                setData(bbp->data(), bbp->size());
                 break;
             default:
                 // should not get there
@@ -67,14 +66,27 @@ ts::Descriptor::Descriptor(const ByteBlockPtr& bbp, ShareMode mode)
     }
 }
 
+ts::Descriptor::Descriptor(const ByteBlockPtr& area, size_t offset, size_t size)
+{
+    if (!area.isNull() && offset + size <= area->size() && size >= 2 && size < 258 && (*area)[offset + 1] == size - 2) {
+        _data = area;
+        _offset = offset;
+        _size = size;
+    }
+}
+
 ts::Descriptor::Descriptor(const Descriptor& desc, ShareMode mode)
 {
     switch (mode) {
         case ShareMode::SHARE:
             _data = desc._data;
+            _offset = desc._offset;
+            _size = desc._size;
             break;
         case ShareMode::COPY:
-            _data = new ByteBlock(*desc._data);
+            if (!desc._data.isNull()) {
+                setData(desc.content(), desc.size());
+            }
             break;
         default:
             // should not get there
@@ -83,8 +95,22 @@ ts::Descriptor::Descriptor(const Descriptor& desc, ShareMode mode)
 }
 
 ts::Descriptor::Descriptor(Descriptor&& desc) noexcept :
-    _data(std::move(desc._data))
+    _data(std::move(desc._data)),
+    _offset(desc._offset),
+    _size(desc._size)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Set the content as a new private copy of some data.
+//----------------------------------------------------------------------------
+
+void ts::Descriptor::setData(const void* addr, size_t size)
 {
+    _data = new ByteBlock(addr, size);
+    _offset = 0;
+    _size = NPOS;
 }
 
 
@@ -96,6 +122,8 @@ ts::Descriptor& ts::Descriptor::operator=(const Descriptor& desc)
 {
     if (&desc != this) {
         _data = desc._data;
+        _offset = desc._offset;
+        _size = desc._size;
     }
     return *this;
 }
@@ -104,6 +132,8 @@ ts::Descriptor& ts::Descriptor::operator=(Descriptor&& desc) noexcept
 {
     if (&desc != this) {
         _data = std::move(desc._data);
+        _offset = desc._offset;
+        _size = desc._size;
     }
     return *this;
 }
@@ -111,7 +141,12 @@ ts::Descriptor& ts::Descriptor::operator=(Descriptor&& desc) noexcept
 ts::Descriptor& ts::Descriptor::copy(const Descriptor& desc)
 {
     if (&desc != this) {
-        _data = new ByteBlock(*desc._data);
+        if (desc._data.isNull()) {
+            invalidate();
+        }
+        else {
+            setData(desc.content(), desc.size());
+        }
     }
     return *this;
 }
@@ -164,16 +199,24 @@ void ts::Descriptor::replacePayload(const void* addr, size_t size)
 {
     if (size > 255) {
         // Payload size too long, invalidate descriptor
-        _data.clear();
+        invalidate();
     }
     else if (!_data.isNull()) {
-        assert(_data->size() >= 2);
-        // Erase previous payload
-        _data->erase(2, _data->size() - 2);
+        assert(this->size() >= 2);
+        if (_size != NPOS) {
+            // View in a shared area, build a private copy with the header only.
+            _data = new ByteBlock(content(), 2);
+            _offset = 0;
+            _size = NPOS;
+        }
+        else {
+            // Erase previous payload
+            _data->erase(2, _data->size() - 2);
+        }
         // Add new payload
-        _data->append (addr, size);
+        _data->append(addr, size);
         // Adjust descriptor size
-        (*_data)[1] = uint8_t (_data->size() - 2);
+        (*_data)[1] = uint8_t(_data->size() - 2);
     }
 }
 
@@ -188,18 +231,19 @@ void ts::Descriptor::resizePayload(size_t new_size)
 {
     if (new_size > 255) {
         // Payload size too long, invalidate descriptor
-        _data.clear();
+        invalidate();
     }
     else if (!_data.isNull()) {
-        assert(_data->size() >= 2);
+        assert(size() >= 2);
+        unshareArea();
         size_t old_size = _data->size() - 2;
-        _data->resize (new_size + 2);
+        _data->resize(new_size + 2);
         // If payload extended, zero additional bytes
         if (new_size > old_size) {
             Zero(_data->data() + 2 + old_size, new_size - old_size);
         }
         // Adjust descriptor size
-        (*_data)[1] = uint8_t (_data->size() - 2);
+        (*_data)[1] = uint8_t(new_size);
     }
 }
 
@@ -210,9 +254,9 @@ void ts::Descriptor::resizePayload(size_t new_size)
 
 bool ts::Descriptor::operator== (const Descriptor& desc) const
 {
-    return _data == desc._data ||
+    return (_data == desc._data && _offset == desc._offset && _size == desc._size) ||
         (_data.isNull() && desc._data.isNull()) ||
-        (!_data.isNull() && !desc._data.isNull() && *_data == *desc._data);
+        (!_data.isNull() && !desc._data.isNull() && size() == desc.size() && std::memcmp(content(), desc.content(), size()) == 0);
 }
 
 
@@ -324,10 +368,7 @@ bool ts::Descriptor::fromXML(DuckContext& duck, const xml::Element* node, TID ti
         ByteBlock payload;
         if (node->getIntAttribute<DID>(tag, u"tag", true, 0xFF, 0x00, 0xFF) && node->getHexaText(payload, 0, 255)) {
             // Build descriptor.
-            _data = new ByteBlock(2);
-            (*_data)[0] = tag;
-            (*_data)[1] = uint8_t(payload.size());
-            _data->append(payload);
+            *this = Descriptor(tag, payload);
             return true;
         }
         else {
@@ -88,6 +88,18 @@ namespace ts {
         //!
         Descriptor(const ByteBlockPtr& bb, ShareMode mode);
 
+        //!
+        //! Constructor from a descriptor inside a shared memory area.
+        //! The descriptor is a view inside the memory area, its content is not copied.
+        //! This is used to deserialize lists of descriptors with one single allocation
+        //! for all descriptors. The content is privately duplicated when the descriptor
+        //! is modified.
+        //! @param [in] area A shared memory area containing the descriptor.
+        //! @param [in] offset Offset of the descriptor in @a area.
+        //! @param [in] size Size in bytes of the descriptor data.
+        //!
+        Descriptor(const ByteBlockPtr& area, size_t offset, size_t size);
+
         //!
         //! Assignment operator.
         //! The content is referenced, and thus shared between the two objects.
@@ -120,13 +132,13 @@ namespace ts {
         //!
         //! Invalidate descriptor content.
         //!
-        void invalidate() { _data.clear(); }
+        void invalidate() { _data.clear(); _offset = 0; _size = NPOS; }
 
         //!
         //! Get the descriptor tag.
         //! @return The descriptor tag or the reserved value 0 if the descriptor is invalid.
         //!
-        DID tag() const { return _data.isNull() ? 0 : _data->at(0); }
+        DID tag() const { return _data.isNull() ? 0 : _data->at(_offset); }
 
         //!
         //! Get the extended descriptor id.
@@ -148,31 +160,31 @@ namespace ts {
         //! Access to the full binary content of the descriptor.
         //! @return Address of the full binary content of the descriptor.
         //!
-        const uint8_t* content() const { return _data->data(); }
+        const uint8_t* content() const { return _data->data() + _offset; }
 
         //!
         //! Size of the binary content of the descriptor.
         //! @return Size of the binary content of the descriptor.
         //!
-        size_t size() const { return _data->size(); }
+        size_t size() const { return _size != NPOS ? _size : (_data.isNull() ? 0 : _data->size()); }
 
         //!
         //! Access to the payload of the descriptor.
         //! @return Address of the payload of the descriptor.
         //!
-        const uint8_t* payload() const { return _data->data() + 2; }
+        const uint8_t* payload() const { return _data->data() + _offset + 2; }
 
         //!
         //! Access to the payload of the descriptor.
         //! @return Address of the payload of the descriptor.
         //!
-        uint8_t* payload() { return _data->data() + 2; }
+        uint8_t* payload() { unshareArea(); return _data->data() + 2; }
 
         //!
         //! Size of the payload of the descriptor.
         //! @return Size in bytes of the payload of the descriptor.
         //!
-        size_t payloadSize() const { return _data->size() - 2; }
+        size_t payloadSize() const { return size() - 2; }
 
         //!
         //! Replace the payload of the descriptor.
@@ -253,6 +265,19 @@ namespace ts {
     private:
         Descriptor(const Descriptor&) = delete;
 
-        ByteBlockPtr _data {}; // full binary content of the descriptor
+        ByteBlockPtr _data {};     // full binary content of the descriptor or shared area containing the descriptor
+        size_t       _offset = 0;  // offset of the descriptor in _data
+        size_t       _size = NPOS; // size of the descriptor in a shared area, NPOS when the descriptor is the complete _data
+
+        // Set the content as a new private copy of some data.
+        void setData(const void* addr, size_t size);
+
+        // When the descriptor is a view in a shared area, make a private copy of the content.
+        void unshareArea()
+        {
+            if (!_data.isNull() && _size != NPOS) {
+                setData(content(), _size);
+            }
+        }
     };
 }
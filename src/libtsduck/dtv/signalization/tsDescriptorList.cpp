@@ -135,17 +135,31 @@ bool ts::DescriptorList::add(DuckContext& duck, const AbstractDescriptor& desc)
 
 bool ts::DescriptorList::add(const void* data, size_t size)
 {
-    const uint8_t* desc = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* const base = reinterpret_cast<const uint8_t*>(data);
+    size_t offset = 0;
     size_t length = 0;
+    size_t count = 0;
     bool success = true;
 
-    while (size >= 2 && (length = size_t(desc[1]) + 2) <= size) {
-        success = add(DescriptorPtr(new Descriptor(desc, length))) && success;
-        desc += length;
-        size -= length;
+    // Compute the number and total size of all complete descriptors.
+    while (offset + 2 <= size && offset + (length = size_t(base[offset + 1]) + 2) <= size) {
+        offset += length;
+        count++;
+    }
+    if (count == 0) {
+        return size == 0;
+    }
+
+    // All descriptors are views in one single shared area.
+    const ByteBlockPtr area(new ByteBlock(base, offset));
+    CheckNonNull(area.pointer());
+    _list.reserve(_list.size() + count);
+    for (size_t index = 0; index < area->size(); index += length) {
+        length = size_t((*area)[index + 1]) + 2;
+        success = add(DescriptorPtr(new Descriptor(area, index, length))) && success;
     }
 
-    return success && size == 0;
+    return success && offset == size;
 }
 
 
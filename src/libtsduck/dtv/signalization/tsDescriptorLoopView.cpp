@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsDescriptorLoopView.h"
+
+
+//----------------------------------------------------------------------------
+// Get the number of complete descriptors in the loop.
+//----------------------------------------------------------------------------
+
+size_t ts::DescriptorLoopView::count() const
+{
+    size_t count = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        count++;
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Search a descriptor with the specified tag.
+//----------------------------------------------------------------------------
+
+ts::DescriptorLoopView::const_iterator ts::DescriptorLoopView::search(DID tag, const_iterator start) const
+{
+    while (start != end() && (*start).tag() != tag) {
+        ++start;
+    }
+    return start;
+}
@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary descriptor loop.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorList.h"
+
+namespace ts {
+    //!
+    //! Read-only view on a binary descriptor loop, without deserialization.
+    //! @ingroup mpeg
+    //!
+    //! A descriptor loop view references memory which belongs to someone else, typically a
+    //! section in a binary table. The view is valid as long as this memory is unchanged.
+    //! Iterating over the descriptors of the loop never allocates memory. The iteration
+    //! stops at the first truncated descriptor, if any.
+    //!
+    //! This is the common contract of all binary views on tables (ts::TableEntriesView,
+    //! ts::PATView, ts::PMTView, etc.): the fields are read in place in the binary sections,
+    //! nothing is copied or allocated, and the views, entries and descriptors they return are
+    //! only valid as long as the binary table is neither modified nor destroyed. A view is
+    //! faster than a full deserialization when only a few fields are used.
+    //!
+    class TSDUCKDLL DescriptorLoopView
+    {
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the descriptor loop.
+        //! @param [in] size Size in bytes of the descriptor loop.
+        //!
+        DescriptorLoopView(const uint8_t* data = nullptr, size_t size = 0) : _data(data), _size(data == nullptr ? 0 : size) {}
+
+        //!
+        //! Read-only view on one binary descriptor.
+        //!
+        class TSDUCKDLL DescriptorView
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the complete descriptor. Must be valid.
+            //!
+            explicit DescriptorView(const uint8_t* data) : _data(data) {}
+            //!
+            //! Get the descriptor tag.
+            //! @return The descriptor tag.
+            //!
+            DID tag() const { return _data[0]; }
+            //!
+            //! Access to the full binary content of the descriptor.
+            //! @return Address of the full binary content of the descriptor.
+            //!
+            const uint8_t* content() const { return _data; }
+            //!
+            //! Size of the binary content of the descriptor.
+            //! @return Size of the binary content of the descriptor.
+            //!
+            size_t size() const { return size_t(_data[1]) + 2; }
+            //!
+            //! Access to the payload of the descriptor.
+            //! @return Address of the payload of the descriptor.
+            //!
+            const uint8_t* payload() const { return _data + 2; }
+            //!
+            //! Size of the payload of the descriptor.
+            //! @return Size in bytes of the payload of the descriptor.
+            //!
+            size_t payloadSize() const { return _data[1]; }
+        private:
+            const uint8_t* _data;
+        };
+
+        //!
+        //! Constant forward iterator over the descriptors of the loop.
+        //!
+        class TSDUCKDLL const_iterator
+        {
+        public:
+            //! @cond nodoxygen
+            typedef std::forward_iterator_tag iterator_category;
+            typedef DescriptorView value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DescriptorView* pointer;
+            typedef const DescriptorView& reference;
+            //! @endcond
+
+            //!
+            //! Constructor.
+            //! @param [in] cur Address of the current descriptor.
+            //! @param [in] end End of the descriptor loop.
+            //!
+            const_iterator(const uint8_t* cur = nullptr, const uint8_t* end = nullptr) : _cur(cur), _end(end) { check(); }
+            //! @cond nodoxygen
+            DescriptorView operator*() const { return DescriptorView(_cur); }
+            const_iterator& operator++() { _cur += size_t(_cur[1]) + 2; check(); return *this; }
+            const_iterator operator++(int) { const_iterator it(*this); ++*this; return it; }
+            bool operator==(const const_iterator& other) const { return _cur == other._cur; }
+            bool operator!=(const const_iterator& other) const { return _cur != other._cur; }
+            //! @endcond
+        private:
+            const uint8_t* _cur;
+            const uint8_t* _end;
+            // Move to the end if the current descriptor is truncated.
+            void check() { if (_cur != _end && (_end - _cur < 2 || size_t(_end - _cur) < size_t(_cur[1]) + 2)) { _cur = _end; } }
+        };
+
+        //!
+        //! Get an iterator to the first descriptor.
+        //! @return An iterator to the first descriptor.
+        //!
+        const_iterator begin() const { return const_iterator(_data, _data + _size); }
+
+        //!
+        //! Get an iterator after the last descriptor.
+        //! @return An iterator after the last descriptor.
+        //!
+        const_iterator end() const { return const_iterator(_data + _size, _data + _size); }
+
+        //!
+        //! Check if the descriptor loop is empty.
+        //! @return True if the descriptor loop is empty.
+        //!
+        bool empty() const { return begin() == end(); }
+
+        //!
+        //! Get the number of complete descriptors in the loop.
+        //! @return The number of complete descriptors in the loop.
+        //!
+        size_t count() const;
+
+        //!
+        //! Address of the binary descriptor loop.
+        //! @return The address of the binary descriptor loop.
+        //!
+        const uint8_t* data() const { return _data; }
+
+        //!
+        //! Size of the binary descriptor loop.
+        //! @return The size in bytes of the binary descriptor loop.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Search a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @param [in] start Iterator to the descriptor where to start the search.
+        //! @return An iterator to the first descriptor with @a tag, starting at @a start, or end() if not found.
+        //!
+        const_iterator search(DID tag, const_iterator start) const;
+
+        //!
+        //! Search a descriptor with the specified tag from the beginning of the loop.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @return An iterator to the first descriptor with @a tag or end() if not found.
+        //!
+        const_iterator search(DID tag) const { return search(tag, begin()); }
+
+        //!
+        //! Deserialize the descriptor loop into a descriptor list.
+        //! @param [in,out] list The descriptor list where descriptors are added.
+        //! @return True on success, false if the descriptor loop is invalid.
+        //!
+        bool addTo(DescriptorList& list) const { return list.add(_data, _size); }
+
+    private:
+        const uint8_t* _data;
+        size_t         _size;
+    };
+}
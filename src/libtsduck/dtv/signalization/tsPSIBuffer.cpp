@@ -201,7 +201,7 @@ bool ts::PSIBuffer::getString(ts::UString& str, size_t size, const Charset* char
     }
 
     // Decode characters. Ignore decoding errors since it could be simply an unsupported character.
-    _duck.charsetIn(charset)->decode(str, currentReadAddress(), size);
+    _duck.decode(str, currentReadAddress(), size, charset);
 
     // Include the deserialized bytes in the read part.
     readSeek(currentReadByteOffset() + size);
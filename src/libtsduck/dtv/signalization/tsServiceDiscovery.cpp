@@ -9,8 +9,6 @@
 #include "tsServiceDiscovery.h"
 #include "tsDuckContext.h"
 #include "tsBinaryTable.h"
-#include "tsPAT.h"
-#include "tsSDT.h"
 #include "tsMGT.h"
 #include "tsCVCT.h"
 #include "tsTVCT.h"
@@ -90,7 +88,7 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
     switch (table.tableId()) {
         case TID_PAT: {
             if (table.sourcePID() == PID_PAT) {
-                PAT pat(_duck, table);
+                const PATView pat(table);
                 if (pat.isValid()) {
                     processPAT(pat);
                 }
@@ -99,7 +97,7 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
         }
         case TID_SDT_ACT: {
             if (table.sourcePID() == PID_SDT) {
-                SDT sdt(_duck, table);
+                const SDTView sdt(table);
                 if (sdt.isValid()) {
                     processSDT(sdt);
                 }
@@ -128,9 +126,12 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
             break;
         }
         case TID_PMT: {
-            PMT pmt(_duck, table);
-            if (pmt.isValid() && hasId(pmt.service_id)) {
-                processPMT(pmt, table.sourcePID());
+            // Do not deserialize the PMT of other services.
+            if (hasId(table.tableIdExtension())) {
+                const PMT pmt(_duck, table);
+                if (pmt.isValid()) {
+                    processPMT(pmt, table.sourcePID());
+                }
             }
             break;
         }
@@ -145,36 +146,39 @@ void ts::ServiceDiscovery::handleTable(SectionDemux& demux, const BinaryTable& t
 // This method processes a Service Description Table (SDT).
 //----------------------------------------------------------------------------
 
-void ts::ServiceDiscovery::processSDT(const SDT& sdt)
+void ts::ServiceDiscovery::processSDT(const SDTView& sdt)
 {
-    // Look for the service by name or by service
-    uint16_t service_id = 0;
-    auto srv = sdt.services.end();
+    // Look for the service by name or by service id. Only the service names are decoded, not the complete SDT.
+    const auto services(sdt.services());
+    auto srv = services.begin();
 
     if (!hasName()) {
         // Service is known by id only.
         assert(hasId());
-        service_id = getId();
-        srv = sdt.services.find(service_id);
-        if (srv == sdt.services.end()) {
+        while (srv != services.end() && (*srv).serviceId() != getId()) {
+            ++srv;
+        }
+        if (srv == services.end()) {
             // Service not referenced in the SDT, not a problem, we already know the service id.
             return;
         }
     }
-    else if (sdt.findService(_duck, getName(), service_id)) {
-        // Service is found by name in the SDT.
-        srv = sdt.services.find(service_id);
-        assert(srv != sdt.services.end());
-    }
     else {
-        // Service not found by name in SDT. If we already know the service id, this is fine.
-        // If we do not know the service id, then there is no way to find the service.
-        if (!hasId()) {
-            _duck.report().error(u"service \"%s\" not found in SDT", {getName()});
-            _notFound = true;
+        while (srv != services.end() && !(*srv).name(_duck).similar(getName())) {
+            ++srv;
+        }
+        if (srv == services.end()) {
+            // Service not found by name in SDT. If we already know the service id, this is fine.
+            // If we do not know the service id, then there is no way to find the service.
+            if (!hasId()) {
+                _duck.report().error(u"service \"%s\" not found in SDT", {getName()});
+                _notFound = true;
+            }
+            return;
         }
-        return;
     }
+    const SDTView::Service service(*srv);
+    const uint16_t service_id = service.serviceId();
 
     // If the service id was previously unknown wait for the PAT.
     // If a service id was known but was different, we need to rescan the PAT.
@@ -200,15 +204,15 @@ void ts::ServiceDiscovery::processSDT(const SDT& sdt)
     }
 
     // Now collect suitable information from the SDT.
-    setTSId(sdt.ts_id);
-    setONId(sdt.onetw_id);
-    setCAControlled(srv->second.CA_controlled);
-    setEITpfPresent(srv->second.EITpf_present);
-    setEITsPresent(srv->second.EITs_present);
-    setRunningStatus(srv->second.running_status);
-    setTypeDVB(srv->second.serviceType(_duck));
-    setName(srv->second.serviceName(_duck));
-    setProvider(srv->second.providerName(_duck));
+    setTSId(sdt.tsId());
+    setONId(sdt.onetwId());
+    setCAControlled(service.CAControlled());
+    setEITpfPresent(service.EITpf());
+    setEITsPresent(service.EITs());
+    setRunningStatus(service.runningStatus());
+    setTypeDVB(service.serviceType());
+    setName(service.name(_duck));
+    setProvider(service.provider(_duck));
 }
 
 
@@ -295,42 +299,53 @@ void ts::ServiceDiscovery::analyzeVCT(const VCT& vct)
 // This method processes a Program Association Table (PAT).
 //----------------------------------------------------------------------------
 
-void ts::ServiceDiscovery::processPAT(const PAT& pat)
+void ts::ServiceDiscovery::processPAT(const PATView& pat)
 {
     // Locate the service in the PAT.
-    auto it = pat.pmts.end();
+    PID pmt_pid = PID_NULL;
     if (hasId()) {
         // A service id was known, locate the service in the PAT.
-        it = pat.pmts.find(getId());
-        if (it == pat.pmts.end()) {
+        for (const auto& it : pat.programs()) {
+            if (it.serviceId() == getId()) {
+                pmt_pid = it.pmtPID();
+                break;
+            }
+        }
+        if (pmt_pid == PID_NULL) {
             _duck.report().error(u"service id 0x%X (%d) not found in PAT", {getId(), getId()});
             _notFound = true;
             return;
         }
     }
     else {
-        // If no service was specified, use the first service from the PAT.
-        if (pat.pmts.empty()) {
+        // If no service was specified, use the first service from the PAT (lowest service id).
+        uint16_t service_id = 0;
+        for (const auto& it : pat.programs()) {
+            if (pmt_pid == PID_NULL || it.serviceId() < service_id) {
+                service_id = it.serviceId();
+                pmt_pid = it.pmtPID();
+            }
+        }
+        if (pmt_pid == PID_NULL) {
             _duck.report().error(u"no service found in PAT");
             _notFound = true;
             return;
         }
-        it = pat.pmts.begin();
         // Now, we have a service id.
-        setId(it->first);
+        setId(service_id);
         // Intercept the SDT for more details.
         _demux.addPID(PID_SDT);
     }
 
     // If the PMT PID was previously unknown wait for the PMT.
     // If the PMT PID was known but was different, we need to rescan the PMT.
-    if (!hasPMTPID(it->second)) {
+    if (!hasPMTPID(pmt_pid)) {
         // Store new PMT PID.
-        setPMTPID(it->second);
+        setPMTPID(pmt_pid);
 
         // (Re)scan the PMT.
-        _demux.resetPID(it->second);
-        _demux.addPID(it->second);
+        _demux.resetPID(pmt_pid);
+        _demux.addPID(pmt_pid);
 
         // Invalidate out PMT.
         _pmt.invalidate();
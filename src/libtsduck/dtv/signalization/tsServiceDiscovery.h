@@ -17,6 +17,8 @@
 #include "tsSectionDemux.h"
 #include "tsSignalizationHandlerInterface.h"
 #include "tsPMT.h"
+#include "tsPATView.h"
+#include "tsSDTView.h"
 
 namespace ts {
     //!
@@ -93,9 +95,9 @@ namespace ts {
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
         // Process specific tables
-        void processPAT(const PAT&);
+        void processPAT(const PATView&);
         void processPMT(const PMT&, PID pid);
-        void processSDT(const SDT&);
+        void processSDT(const SDTView&);
         void analyzeMGT(const MGT&);
         void analyzeVCT(const VCT&);
     };
@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on the entries of a binary table.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsBinaryTable.h"
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! Read-only view on the entries of a binary table, across all its sections.
+    //! @ingroup mpeg
+    //!
+    //! Many tables are made of a list of entries with the same layout in each section
+    //! (programs in a PAT, services in a SDT, events in an EIT, etc.) Iterating over
+    //! a TableEntriesView returns light views on each entry, directly in the binary
+    //! sections, without deserialization and without memory allocation.
+    //!
+    //! The view references the binary table. It is valid as long as the binary table
+    //! is unchanged. Iterations stop at the first truncated entry in each section.
+    //!
+    //! @tparam ENTRY A class which describes one entry. It must define:
+    //! - A constructor <code>ENTRY(const uint8_t* data, size_t size)</code>.
+    //! - A static method <code>bool Area(const Section&, const uint8_t*& begin, const uint8_t*& end)</code>
+    //!   which locates the area of the entries in a section. It returns false if the section
+    //!   contains no valid entry area.
+    //! - A static method <code>size_t EntrySize(const uint8_t* data, size_t max_size)</code>
+    //!   which returns the size of the entry at @a data or zero if it is truncated.
+    //! - A static method <code>bool Skip(const uint8_t* data, size_t size)</code>
+    //!   which returns true if the entry shall not be returned by the iteration.
+    //!
+    template <class ENTRY>
+    class TableEntriesView
+    {
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table Address of the binary table. If null, the view is empty.
+        //!
+        explicit TableEntriesView(const BinaryTable* table = nullptr) : _table(table) {}
+
+        //!
+        //! Constant forward iterator over the entries of the table.
+        //!
+        class const_iterator
+        {
+        public:
+            //! @cond nodoxygen
+            typedef std::forward_iterator_tag iterator_category;
+            typedef ENTRY value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const ENTRY* pointer;
+            typedef const ENTRY& reference;
+            //! @endcond
+
+            //!
+            //! Constructor.
+            //! @param [in] table Address of the binary table.
+            //! @param [in] section Index of the section where to start.
+            //!
+            const_iterator(const BinaryTable* table = nullptr, size_t section = 0) : _table(table), _section(section) { loadSection(); }
+
+            //! @cond nodoxygen
+            ENTRY operator*() const { return ENTRY(_cur, _size); }
+            const_iterator& operator++() { _cur += _size; if (!findEntry()) { _section++; loadSection(); } return *this; }
+            const_iterator operator++(int) { const_iterator it(*this); ++*this; return it; }
+            bool operator==(const const_iterator& other) const { return _section == other._section && _cur == other._cur; }
+            bool operator!=(const const_iterator& other) const { return !operator==(other); }
+            //! @endcond
+
+        private:
+            const BinaryTable* _table;
+            size_t             _section;
+            const uint8_t*     _cur = nullptr;
+            const uint8_t*     _end = nullptr;
+            size_t             _size = 0;
+
+            // Find the next entry to return in the current section, starting at _cur.
+            bool findEntry()
+            {
+                while (_cur < _end && (_size = ENTRY::EntrySize(_cur, size_t(_end - _cur))) > 0) {
+                    if (!ENTRY::Skip(_cur, _size)) {
+                        return true;
+                    }
+                    _cur += _size;
+                }
+                return false;
+            }
+
+            // Find the first entry to return, starting at the beginning of the current section.
+            void loadSection()
+            {
+                while (_table != nullptr && _section < _table->sectionCount()) {
+                    const SectionPtr& sp(_table->sectionAt(_section));
+                    if (!sp.isNull() && sp->isValid() && ENTRY::Area(*sp, _cur, _end) && findEntry()) {
+                        return;
+                    }
+                    _section++;
+                }
+                _cur = _end = nullptr;
+                _size = 0;
+            }
+        };
+
+        //!
+        //! Get an iterator to the first entry.
+        //! @return An iterator to the first entry.
+        //!
+        const_iterator begin() const { return const_iterator(_table, 0); }
+
+        //!
+        //! Get an iterator after the last entry.
+        //! @return An iterator after the last entry.
+        //!
+        const_iterator end() const { return const_iterator(_table, _table == nullptr ? 0 : _table->sectionCount()); }
+
+        //!
+        //! Check if there is no entry in the table.
+        //! @return True if there is no entry in the table.
+        //!
+        bool empty() const { return begin() == end(); }
+
+        //!
+        //! Get the number of entries in the table.
+        //! @return The number of entries in the table.
+        //!
+        size_t count() const
+        {
+            size_t count = 0;
+            for (auto it = begin(); it != end(); ++it) {
+                count++;
+            }
+            return count;
+        }
+
+    private:
+        const BinaryTable* _table;
+    };
+}
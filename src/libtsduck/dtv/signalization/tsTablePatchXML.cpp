@@ -23,6 +23,20 @@ void ts::TablePatchXML::clear()
 {
     _patchFiles.clear();
     _patches.clear();
+    _cache.clear();
+    _cacheOld.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum number of patched tables in the cache.
+//----------------------------------------------------------------------------
+
+void ts::TablePatchXML::setCacheSize(size_t size)
+{
+    _cacheSize = size;
+    _cache.clear();
+    _cacheOld.clear();
 }
 
 
@@ -38,6 +52,14 @@ void ts::TablePatchXML::defineArgs(Args& args)
               u"If the name starts with \"<?xml\", it is considered as \"inline XML content\". "
               u"Several --patch-xml options can be specified. "
               u"Patch files are sequentially applied on each table.");
+
+    args.option(u"patch-xml-cache", 0, Args::UNSIGNED);
+    args.help(u"patch-xml-cache", u"count",
+              u"With --patch-xml, keep the specified number of patched tables in a cache. "
+              u"When a table is repeated without modification, the patched table is reused "
+              u"from the cache, without conversion to XML. Do not use it when the character "
+              u"sets or other table decoding options may change during the processing. "
+              u"By default, there is no cache.");
 }
 
 
@@ -48,6 +70,7 @@ void ts::TablePatchXML::defineArgs(Args& args)
 bool ts::TablePatchXML::loadArgs(DuckContext& duck, Args& args)
 {
     args.getValues(_patchFiles, u"patch-xml");
+    setCacheSize(args.intValue<size_t>(u"patch-xml-cache", 0));
     return true;
 }
 
@@ -73,8 +96,10 @@ void ts::TablePatchXML::addPatchFileNames(const UStringList& filenames)
 
 bool ts::TablePatchXML::loadPatchFiles(const xml::Tweaks& tweaks)
 {
-    // Clear previously loaded files.
+    // Clear previously loaded files and previous patch results.
     _patches.clear();
+    _cache.clear();
+    _cacheOld.clear();
 
     // Load Xml files one by one.
     bool ok = true;
@@ -83,7 +108,27 @@ bool ts::TablePatchXML::loadPatchFiles(const xml::Tweaks& tweaks)
         CheckNonNull(doc.pointer());
         doc->setTweaks(tweaks);
         if (doc->load(_patchFiles[i], false)) {
-            _patches.push_back(doc);
+            // Compile the patch: collect the types of tables it may modify. The first-level
+            // elements in the patch document are table names. Generic tables, unknown names,
+            // attributes on the root element or added tables may apply to any table.
+            CompiledPatch patch;
+            patch.doc = doc;
+            const xml::Element* root = doc->rootElement();
+            UStringList attributes;
+            if (root != nullptr) {
+                root->getAttributesNames(attributes);
+            }
+            patch.any = root == nullptr || !attributes.empty();
+            for (const xml::Element* e = root == nullptr ? nullptr : root->firstChildElement(); e != nullptr && !patch.any; e = e->nextSiblingElement()) {
+                const PSIRepository::TableFactory fac = PSIRepository::Instance().getTableFactory(e->name());
+                if (fac == nullptr || e->hasAttribute(u"x-node")) {
+                    patch.any = true;
+                }
+                else {
+                    patch.targets.insert(fac);
+                }
+            }
+            _patches.push_back(patch);
         }
         else {
             ok = false;
@@ -101,22 +146,121 @@ bool ts::TablePatchXML::loadPatchFiles(const xml::Tweaks& tweaks)
 void ts::TablePatchXML::applyPatches(xml::Document& doc) const
 {
     for (size_t i = 0; i < _patches.size(); ++i) {
-        _patches[i]->patch(doc);
+        _patches[i].doc->patch(doc);
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Check if at least one patch file may modify a table.
+//----------------------------------------------------------------------------
+
+bool ts::TablePatchXML::mayPatch(const BinaryTable& table) const
+{
+    // Same lookup as in BinaryTable::toXML(). Unknown tables are converted as generic tables.
+    const PSIRepository::TableFactory fac = PSIRepository::Instance().getTableFactory(table.tableId(), _duck.standards(), table.sourcePID());
+    for (const auto& patch : _patches) {
+        if (patch.any || fac == nullptr || patch.targets.find(fac) != patch.targets.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 //----------------------------------------------------------------------------
 // Apply the XML patch files to a binary table.
 //----------------------------------------------------------------------------
 
 bool ts::TablePatchXML::applyPatches(BinaryTable& table) const
 {
-    // If no patch is loaded, nothing to do.
-    if (_patches.empty()) {
+    // If no patch is loaded or no patch can modify this type of table, nothing to do.
+    if (_patches.empty() || (table.isValid() && !mayPatch(table))) {
         return true;
     }
 
+    // Without cache or with an incomplete table, always use the XML conversion.
+    if (_cacheSize == 0 || !table.isValid()) {
+        return applyPatchesXML(table);
+    }
+
+    // Build the cache key: table id, PID, active standards, size and CRC32 of each section.
+    // All sections of a valid table have a CRC32, except a few short sections which are
+    // only identified by their size here. The full input is compared anyway.
+    _cacheKey.clear();
+    _cacheKey.appendUInt8(table.tableId());
+    _cacheKey.appendUInt16(table.sourcePID());
+    _cacheKey.appendUInt16(uint16_t(_duck.standards()));
+    size_t input_size = 0;
+    for (size_t i = 0; i < table.sectionCount(); ++i) {
+        const SectionPtr& sp(table.sectionAt(i));
+        const size_t size = sp->size();
+        input_size += size;
+        _cacheKey.appendUInt16(uint16_t(size));
+        _cacheKey.append(sp->content() + size - std::min<size_t>(size, 4), std::min<size_t>(size, 4));
+    }
+
+    // Check if the input sections match a cached entry.
+    const auto matches = [&table, input_size](const CachedPatch& entry) {
+        if (entry.input.size() != input_size) {
+            return false;
+        }
+        size_t offset = 0;
+        for (size_t i = 0; i < table.sectionCount(); ++i) {
+            const SectionPtr& sp(table.sectionAt(i));
+            if (std::memcmp(entry.input.data() + offset, sp->content(), sp->size()) != 0) {
+                return false;
+            }
+            offset += sp->size();
+        }
+        return true;
+    };
+
+    // Lookup the current generation first.
+    const auto it = _cache.find(_cacheKey);
+    if (it != _cache.end() && matches(it->second)) {
+        table.copy(it->second.output);
+        return it->second.valid;
+    }
+
+    // Then lookup the previous generation. If not found, apply the patches using XML.
+    ByteBlock input;
+    bool valid = false;
+    const auto old = _cacheOld.find(_cacheKey);
+    if (old != _cacheOld.end() && matches(old->second)) {
+        table.copy(old->second.output);
+        valid = old->second.valid;
+        input.swap(old->second.input);
+        _cacheOld.erase(old);
+    }
+    else {
+        input.reserve(input_size);
+        for (size_t i = 0; i < table.sectionCount(); ++i) {
+            input.append(table.sectionAt(i)->content(), table.sectionAt(i)->size());
+        }
+        valid = applyPatchesXML(table);
+    }
+
+    // Store the result in the current generation. When the current generation is full,
+    // it becomes the previous generation and the old previous generation is dropped.
+    if (it == _cache.end() && _cache.size() >= std::max<size_t>(1, _cacheSize / 2)) {
+        _cacheOld.swap(_cache);
+        _cache.clear();
+    }
+    CachedPatch& entry(_cache[_cacheKey]);
+    entry.input.swap(input);
+    entry.valid = valid;
+    entry.output.copy(table);
+    return valid;
+}
+
+
+//----------------------------------------------------------------------------
+// Apply the XML patch files to a binary table using XML conversion.
+//----------------------------------------------------------------------------
+
+bool ts::TablePatchXML::applyPatchesXML(BinaryTable& table) const
+{
     // Initialize the document structure.
     xml::Document doc(_duck.report());
     xml::Element* root = doc.initialize(u"tsduck");
@@ -13,6 +13,8 @@
 
 #pragma once
 #include "tsBinaryTable.h"
+#include "tsPSIRepository.h"
+#include "tsByteBlock.h"
 #include "tsUString.h"
 #include "tsSafePtr.h"
 #include "tsxmlPatchDocument.h"
@@ -26,6 +28,19 @@ namespace ts {
     //!
     //! Implementation of on-the-fly table patching using XML.
     //! This class is typically used to handle -\-patch-xml command line options.
+    //!
+    //! Converting a binary table to XML and back is expensive. To avoid it as much as possible,
+    //! the patch files are precompiled when they are loaded: the list of table types they can
+    //! modify is computed once. Tables which cannot be modified by any patch file are left
+    //! unchanged, without XML conversion.
+    //!
+    //! Optionally, the result of recent patches is kept in a cache, indexed by the CRC32 of the
+    //! input sections. When a table is repeated without modification, the patched sections are
+    //! directly reused from the cache. The cache is disabled by default: the conversion to and
+    //! from XML also depends on settings of the DuckContext, such as the character sets, which
+    //! are not part of the cache key. Enable it only when these settings do not change after
+    //! the patch files are loaded.
+    //!
     //! @ingroup mpeg
     //!
     class TSDUCKDLL TablePatchXML
@@ -123,12 +138,56 @@ namespace ts {
         //!
         bool applyPatches(SectionPtr& section) const;
 
+        //!
+        //! Set the maximum number of patched tables which are kept in the cache.
+        //! The cache is cleared. It is also cleared when the patch files are reloaded.
+        //! @param [in] size Maximum number of patched tables in the cache. Zero disables the cache (the default).
+        //!
+        void setCacheSize(size_t size);
+
+        //!
+        //! Get the maximum number of patched tables which are kept in the cache.
+        //! @return The maximum number of patched tables in the cache.
+        //!
+        size_t cacheSize() const { return _cacheSize; }
+
     private:
         typedef ts::SafePtr<ts::xml::PatchDocument> PatchDocumentPtr;
-        typedef std::vector<PatchDocumentPtr> PatchDocumentVector;
+
+        // A loaded patch file with its precompiled information.
+        class CompiledPatch
+        {
+        public:
+            PatchDocumentPtr doc {};        // XML patch file as loaded document.
+            bool             any = false;   // The patch may apply to any table (generic or unknown table names).
+            std::set<PSIRepository::TableFactory> targets {};  // Types of tables which may be patched.
+        };
+        typedef std::vector<CompiledPatch> CompiledPatchVector;
+
+        // A cached result of patching. The key is made of the table id, the PID and the
+        // CRC32 of all input sections. The complete input sections are kept to check the
+        // match since different tables may have the same key.
+        class CachedPatch
+        {
+        public:
+            ByteBlock   input {};       // Content of all input sections.
+            bool        valid = false;  // The patch was successful.
+            BinaryTable output {};      // Patched table, invalid if deleted by the patch.
+        };
+        typedef std::map<ByteBlock, CachedPatch> PatchCache;
 
         DuckContext&        _duck;           // TSDuck execution context.
         UStringVector       _patchFiles {};  // XML patch file names.
-        PatchDocumentVector _patches {};     // XML patch files as loaded documents
+        CompiledPatchVector _patches {};     // XML patch files as loaded and compiled documents.
+        size_t              _cacheSize = 0;  // Max number of cached tables, zero means no cache.
+        mutable PatchCache  _cache {};       // Current generation of cached patches.
+        mutable PatchCache  _cacheOld {};    // Previous generation of cached patches.
+        mutable ByteBlock   _cacheKey {};    // Reused lookup key, avoid reallocation.
+
+        // Check if at least one patch file may modify a table.
+        bool mayPatch(const BinaryTable& table) const;
+
+        // Apply the patches to a binary table using XML conversion.
+        bool applyPatchesXML(BinaryTable& table) const;
     };
 }
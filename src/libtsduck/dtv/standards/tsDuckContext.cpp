@@ -68,6 +68,7 @@ void ts::DuckContext::reset()
     _cmdStandards = _accStandards = Standards::NONE;
     _hfDefaultRegion.clear();
     _timeReference = 0;
+    setDecodeCacheSize(0);
 }
 
 
@@ -96,6 +97,55 @@ void ts::DuckContext::setDefaultCharsetOut(const Charset* charset)
 }
 
 
+//----------------------------------------------------------------------------
+// Convert a signalization string into UTF-16, using the cache if enabled.
+//----------------------------------------------------------------------------
+
+void ts::DuckContext::setDecodeCacheSize(size_t size)
+{
+    _decodeCacheSize = size;
+    _decodeCache.clear();
+    _decodeCacheOld.clear();
+}
+
+bool ts::DuckContext::decode(UString& str, const uint8_t* data, size_t size, const Charset* charset) const
+{
+    const Charset* const cset = charsetIn(charset);
+
+    // Without cache, directly decode.
+    if (_decodeCacheSize == 0 || data == nullptr || size == 0) {
+        return cset->decode(str, data, size);
+    }
+
+    // Look for the binary string in the current generation of the cache.
+    _decodeKey.assign(reinterpret_cast<const char*>(data), size);
+    auto it = _decodeCache.find(_decodeKey);
+    if (it != _decodeCache.end() && it->second.charset == cset) {
+        str = it->second.value;
+        return true;
+    }
+
+    // Then look in the previous generation or decode the string. Only successfully decoded strings are cached.
+    const auto old = _decodeCacheOld.find(_decodeKey);
+    if (old != _decodeCacheOld.end() && old->second.charset == cset) {
+        str = old->second.value;
+    }
+    else if (!cset->decode(str, data, size)) {
+        return false;
+    }
+
+    // Insert the string in the current generation. When full, the current generation becomes the previous one.
+    if (it == _decodeCache.end() && _decodeCache.size() >= std::max<size_t>(1, _decodeCacheSize / 2)) {
+        _decodeCacheOld.swap(_decodeCache);
+        _decodeCache.clear();
+    }
+    DecodedString& entry(_decodeCache[_decodeKey]);
+    entry.charset = cset;
+    entry.value = str;
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Update the list of standards which are present in the context.
 //----------------------------------------------------------------------------
@@ -386,6 +436,13 @@ void ts::DuckContext::defineOptions(Args& args, int cmdOptionsMask)
                   u"The available table names are " +
                   UString::Join(DVBCharset::GetAllNames()) + u".");
 
+        args.option(u"decode-cache", 0, Args::UNSIGNED);
+        args.help(u"decode-cache", u"count",
+                  u"Cache the specified number of decoded strings from tables and descriptors. "
+                  u"In EPG-heavy streams, the same event and service names are repeated in each "
+                  u"occurence of the EIT and SDT. With a cache, each distinct string is decoded "
+                  u"only once. By default, there is no cache.");
+
         args.option(u"europe");
         args.help(u"europe",
                   u"A synonym for '--default-charset ISO-8859-15'. This is a handy shortcut "
@@ -598,6 +655,7 @@ bool ts::DuckContext::loadArgs(Args& args)
         else if (args.present(u"japan")) {
             _charsetIn = _charsetOut = &ARIBCharset::B24;
         }
+        setDecodeCacheSize(args.intValue<size_t>(u"decode-cache", 0));
     }
 
     // Options relating to default UHF/VHF region.
@@ -687,6 +745,7 @@ ts::DuckContext::SavedArgs::SavedArgs() :
     _cmdStandards(Standards::NONE),
     _charsetInName(),
     _charsetOutName(),
+    _decodeCacheSize(0),
     _casId(CASID_NULL),
     _defaultPDS(0),
     _hfDefaultRegion(),
@@ -700,6 +759,7 @@ void ts::DuckContext::saveArgs(SavedArgs& args) const
     args._cmdStandards = _cmdStandards;
     args._charsetInName = _charsetIn->name();
     args._charsetOutName = _charsetOut->name();
+    args._decodeCacheSize = _decodeCacheSize;
     args._casId = _casId;
     args._defaultPDS = _defaultPDS;
     args._hfDefaultRegion = _hfDefaultRegion;
@@ -721,6 +781,7 @@ void ts::DuckContext::restoreArgs(const SavedArgs& args)
         if (out != nullptr) {
             _charsetOut = out;
         }
+        setDecodeCacheSize(args._decodeCacheSize);
     }
     if (_definedCmdOptions & CMD_CAS) {
         _casId = args._casId;
@@ -134,16 +134,16 @@ namespace ts {
 
         //!
         //! Convert a signalization string into UTF-16 using the default input character set.
+        //! When the decoding cache is enabled, the string is first searched in the cache.
         //! @param [out] str Returned decoded string.
         //! @param [in] data Address of an encoded string.
         //! @param [in] size Size in bytes of the encoded string.
+        //! @param [in] charset An optional specific character set to use instead of the default one.
         //! @return True on success, false on error (truncated, unsupported format, etc.)
         //! @see ETSI EN 300 468, Annex A.
+        //! @see setDecodeCacheSize()
         //!
-        bool decode(UString& str, const uint8_t* data, size_t size) const
-        {
-            return _charsetIn->decode(str, data, size);
-        }
+        bool decode(UString& str, const uint8_t* data, size_t size, const Charset* charset = nullptr) const;
 
         //!
         //! Convert a signalization string into UTF-16 using the default input character set.
@@ -154,9 +154,30 @@ namespace ts {
         //!
         UString decoded(const uint8_t* data, size_t size) const
         {
-            return _charsetIn->decoded(data, size);
+            UString str;
+            decode(str, data, size);
+            return str;
         }
 
+        //!
+        //! Set the maximum number of entries in the cache of decoded strings.
+        //!
+        //! In EPG-heavy applications, the same event and service names are decoded again and
+        //! again from each repetition of the EIT and SDT. With a cache, each distinct binary
+        //! string is decoded only once. The cache is keyed on the binary string, including its
+        //! leading character table code. When the cache is full, the least recently used half
+        //! of the cache is dropped. The cache is not thread-safe, like the rest of DuckContext.
+        //!
+        //! @param [in] size Maximum number of cached strings. Zero disables the cache (the default).
+        //!
+        void setDecodeCacheSize(size_t size);
+
+        //!
+        //! Get the maximum number of entries in the cache of decoded strings.
+        //! @return The maximum number of cached strings. Zero means that the cache is disabled.
+        //!
+        size_t decodeCacheSize() const { return _decodeCacheSize; }
+
         //!
         //! Convert a signalization string (preceded by its one-byte length) into UTF-16 using the default input character set.
         //! @param [out] str Returned decoded string.
@@ -480,6 +501,7 @@ namespace ts {
             Standards   _cmdStandards;      // Forced standards from the command line.
             UString     _charsetInName;     // Character set to interpret strings without prefix code.
             UString     _charsetOutName;    // Preferred character set to generate strings.
+            size_t      _decodeCacheSize;   // Maximum number of cached decoded strings.
             uint16_t    _casId;             // Preferred CAS id.
             PDS         _defaultPDS;        // Default PDS value if undefined.
             UString     _hfDefaultRegion;   // Default region for UHF/VHF band.
@@ -518,6 +540,22 @@ namespace ts {
         std::set<uint32_t> _registrationIds {};          // Set of all registration ids.
         const std::map<uint16_t, const UChar*> _predefined_cas {};  // Predefined CAS names, index by CAS id (first in range).
 
+        // Cache of decoded strings, indexed by binary string. There are two generations of entries.
+        // New entries are inserted in the current generation. When it is full, it becomes the
+        // previous generation and the old previous generation is dropped. An entry which is found
+        // in the previous generation is moved back into the current one.
+        class DecodedString
+        {
+        public:
+            const Charset* charset = nullptr;  // Character set which was used to decode.
+            UString        value {};           // Decoded string.
+        };
+        typedef std::map<std::string, DecodedString> DecodeCache;
+        size_t              _decodeCacheSize = 0;   // Max number of cached strings, zero means no cache.
+        mutable DecodeCache _decodeCache {};        // Current generation.
+        mutable DecodeCache _decodeCacheOld {};     // Previous generation.
+        mutable std::string _decodeKey {};          // Reused lookup key, avoid reallocation.
+
         // List of command line options to define and analyze.
         enum CmdOptions {
             CMD_CHARSET   = 0x0001,
@@ -7,7 +7,6 @@
 //----------------------------------------------------------------------------
 
 #include "tsT2MIDemux.h"
-#include "tsT2MIPacket.h"
 #include "tsT2MIDescriptor.h"
 #include "tsBinaryTable.h"
 #include "tsPAT.h"
@@ -18,21 +17,6 @@
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::T2MIDemux::PLPContext::PLPContext() :
-    first_packet(true),
-    ts(),
-    ts_next(0)
-{
-}
-
-ts::T2MIDemux::PIDContext::PIDContext() :
-    continuity(0),
-    sync(false),
-    t2mi(),
-    plps()
-{
-}
-
 ts::T2MIDemux::T2MIDemux(DuckContext& duck, T2MIHandlerInterface* t2mi_handler, const PIDSet& pid_filter) :
     SuperClass(duck, pid_filter),
     _handler(t2mi_handler),
@@ -160,7 +144,7 @@ void ts::T2MIDemux::feedPacket(const TSPacket& pkt)
 void ts::T2MIDemux::PIDContext::lostSync()
 {
     t2mi.clear();   // accumulated T2-MI packet buffer.
-    plps.clear();   // we also lose partially demuxed PLP's.
+    plps.fill(PLPContext());   // we also lose partially demuxed PLP's.
     sync = false;
 }
 
@@ -191,17 +175,17 @@ void ts::T2MIDemux::processT2MI(PID pid, PIDContext& pc)
                 break;
             }
 
-            // Build a T2-MI packet.
-            T2MIPacket pkt(pc.t2mi.data() + start, packet_size, pid);
-            if (pkt.isValid()) {
+            // Build a T2-MI packet. The same packet object is reused, without reallocation.
+            _packet.reload(pc.t2mi.data() + start, packet_size, pid);
+            if (_packet.isValid()) {
 
                 // Notify the application.
                 if (_handler != nullptr) {
-                    _handler->handleT2MIPacket(*this, pkt);
+                    _handler->handleT2MIPacket(*this, _packet);
                 }
 
                 // Demux TS packets from the T2-MI packet.
-                demuxTS(pid, pc, pkt);
+                demuxTS(pc, _packet);
             }
 
             // Point to next T2-MI packet.
@@ -223,7 +207,7 @@ void ts::T2MIDemux::processT2MI(PID pid, PIDContext& pc)
 // Demux all encapsulated TS packets from a T2-MI packet.
 //----------------------------------------------------------------------------
 
-void ts::T2MIDemux::demuxTS(PID pid, PIDContext& pc, const T2MIPacket& pkt)
+void ts::T2MIDemux::demuxTS(PIDContext& pc, const T2MIPacket& pkt)
 {
     // Keep only baseband frames.
     const uint8_t* data = pkt.basebandFrame();
@@ -265,73 +249,72 @@ void ts::T2MIDemux::demuxTS(PID pid, PIDContext& pc, const T2MIPacket& pkt)
         dfl = size;
     }
 
-    // Get / create PLP context.
-    const uint8_t plp = pkt.plp();
-    PLPContextPtr& plpp(pc.plps[plp]);
-    if (plpp.isNull()) {
-        plpp = new PLPContext;
-        CheckNonNull(plpp.pointer());
-    }
+    // Get PLP context.
+    PLPContext& plp(pc.plps[pkt.plp()]);
+    static const uint8_t sync_byte = SYNC_BYTE;
 
     if (syncd == 0xFFFF) {
-        // No user packet in data field
-        plpp->ts.append(data, dfl);
+        // No user packet in data field. Before the first packet start, this is the
+        // end of a packet which was not received, the data field is dropped.
+        if (!plp.first_packet) {
+            appendTS(plp, pkt, data, dfl);
+        }
     }
     else {
         // Synchronization distance in bytes, bounded by data field size.
         syncd = std::min(syncd / 8, dfl);
 
         // Process end of previous packet.
-        if (!plpp->first_packet && syncd > 0) {
-            if (plpp->ts.size() % PKT_SIZE == 0) {
-                plpp->ts.append(SYNC_BYTE);
+        if (!plp.first_packet && syncd > 0) {
+            if (plp.ts_size == 0) {
+                appendTS(plp, pkt, &sync_byte, 1);
             }
-            plpp->ts.append(data, syncd - npd);
+            appendTS(plp, pkt, data, syncd - npd);
         }
-        plpp->first_packet = false;
+        plp.first_packet = false;
         data += syncd;
         dfl -= syncd;
 
         // Process subsequent complete packets.
         while (dfl >= PKT_SIZE - 1) {
-            plpp->ts.append(SYNC_BYTE);
-            plpp->ts.append(data, PKT_SIZE - 1);
+            appendTS(plp, pkt, &sync_byte, 1);
+            appendTS(plp, pkt, data, PKT_SIZE - 1);
             data += PKT_SIZE - 1;
             dfl -= PKT_SIZE - 1;
         }
 
         // Process optional trailing truncated packet.
         if (dfl > 0) {
-            plpp->ts.append(SYNC_BYTE);
-            plpp->ts.append(data, dfl);
+            appendTS(plp, pkt, &sync_byte, 1);
+            appendTS(plp, pkt, data, dfl);
         }
     }
+}
 
-    // Now process each complete TS packet.
-    while (plpp->ts_next + PKT_SIZE <= plpp->ts.size()) {
 
-        // Build the TS packet.
-        TSPacket tsPkt;
-        std::memcpy(tsPkt.b, &plpp->ts[plpp->ts_next], PKT_SIZE);
-        plpp->ts_next += PKT_SIZE;
+//----------------------------------------------------------------------------
+// Append data to the reassembled TS packets of a PLP.
+//----------------------------------------------------------------------------
 
-        // Notify the application. Note that we are already in a protected section.
-        if (_handler != nullptr) {
-            _handler->handleTSPacket(*this, pkt, tsPkt);
+void ts::T2MIDemux::appendTS(PLPContext& plp, const T2MIPacket& pkt, const uint8_t* data, size_t size)
+{
+    while (size > 0) {
+        // Fill the current TS packet.
+        const size_t chunk = std::min(size, PKT_SIZE - plp.ts_size);
+        std::memcpy(plp.ts.b + plp.ts_size, data, chunk);
+        plp.ts_size += chunk;
+        data += chunk;
+        size -= chunk;
+
+        // Notify the application when the TS packet is complete.
+        // Note that we are already in a protected section.
+        if (plp.ts_size == PKT_SIZE) {
+            plp.ts_size = 0;
+            if (_handler != nullptr) {
+                _handler->handleTSPacket(*this, pkt, plp.ts);
+            }
         }
     }
-
-    // Compress or cleanup the TS buffer.
-    if (plpp->ts_next >= plpp->ts.size()) {
-        // No more packet to output, cleanup.
-        plpp->ts.clear();
-        plpp->ts_next = 0;
-    }
-    else if (plpp->ts_next >= 100 * PKT_SIZE) {
-        // TS buffer has many unused packets, compress it.
-        plpp->ts.erase(0, plpp->ts_next);
-        plpp->ts_next = 0;
-    }
 }
 
 
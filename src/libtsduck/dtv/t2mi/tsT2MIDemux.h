@@ -16,6 +16,7 @@
 #include "tsSectionDemux.h"
 #include "tsPMT.h"
 #include "tsT2MIHandlerInterface.h"
+#include "tsT2MIPacket.h"
 
 namespace ts {
     //!
@@ -73,30 +74,21 @@ namespace ts {
 
     private:
         // Analysis context for one PLP inside one T2-MI stream.
+        // Extracted TS packets are directly reassembled in a TS packet, without intermediate buffer.
         struct PLPContext
         {
-            bool      first_packet;  // First T2-MI packet not yet processed
-            ByteBlock ts;            // Buffer to accumulate extracted TS packets.
-            size_t    ts_next;       // Next packet to output.
-
-            // Default constructor
-            PLPContext();
+            bool     first_packet = true;  // First T2-MI packet not yet processed
+            size_t   ts_size = 0;          // Number of bytes in the partially reassembled TS packet.
+            TSPacket ts {};                // Partially reassembled TS packet.
         };
 
-        // Map of safe pointers to PLPContext, indexed by PLP id.
-        typedef SafePtr<PLPContext, ts::null_mutex> PLPContextPtr;
-        typedef std::map<uint8_t, PLPContextPtr> PLPContextMap;
-
         // Analysis context for one PID.
         struct PIDContext
         {
-            uint8_t       continuity;  // Last continuity counter
-            bool          sync;        // We are synchronous in this PID
-            ByteBlock     t2mi;        // Buffer containing the T2-MI data.
-            PLPContextMap plps;        // Map of PLP context per PID.
-
-            // Default constructor
-            PIDContext();
+            uint8_t   continuity = 0;  // Last continuity counter
+            bool      sync = false;    // We are synchronous in this PID
+            ByteBlock t2mi {};         // Buffer containing the T2-MI data.
+            std::array<PLPContext, 256> plps {};  // PLP contexts, dense array indexed by PLP id.
 
             // Reset after lost of synchronization.
             void lostSync();
@@ -113,7 +105,10 @@ namespace ts {
         void processT2MI(PID pid, PIDContext& pc);
 
         // Demux all encapsulated TS packets from a T2-MI packet.
-        void demuxTS(PID pid, PIDContext& pc, const T2MIPacket& pkt);
+        void demuxTS(PIDContext& pc, const T2MIPacket& pkt);
+
+        // Append data to the reassembled TS packets of a PLP, notify all complete TS packets.
+        void appendTS(PLPContext& plp, const T2MIPacket& pkt, const uint8_t* data, size_t size);
 
         // Process a PMT.
         void processPMT(const PMT& pmt);
@@ -122,5 +117,6 @@ namespace ts {
         T2MIHandlerInterface* _handler;    // Application-defined handler
         PIDContextMap         _pids;       // Map of PID contexts.
         SectionDemux          _psi_demux;  // Demux for PSI parsing.
+        T2MIPacket            _packet {};  // Current T2-MI packet, reused to avoid reallocations.
     };
 }
@@ -43,6 +43,8 @@ namespace ts {
 
         //!
         //! This hook is invoked when a new T2-MI packet is available.
+        //! The T2-MI packet object is reused by the demux for the next packet. To keep it after
+        //! returning from the handler, make a copy of it.
         //! @param [in,out] demux A reference to the T2-MI demux.
         //! @param [in] pkt The T2-MI packet.
         //!
@@ -50,6 +52,7 @@ namespace ts {
 
         //!
         //! This hook is invoked when a new TS packet is extracted.
+        //! The TS packet is directly reassembled in the demux and is valid only during the call.
         //! @param [in,out] demux A reference to the T2-MI demux.
         //! @param [in] t2mi The T2-MI packet from which @a ts was extracted.
         //! @param [in] ts The extracted TS packet.
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITView.h"
+#include "tsEIT.h"
+#include "tsDuckContext.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::EITView::EITView(const BinaryTable& table) :
+    _table(table)
+{
+    if (table.isValid() && EIT::IsEIT(table.tableId()) && table.sectionCount() > 0) {
+        const SectionPtr& sp(table.sectionAt(0));
+        if (!sp.isNull() && sp->isValid() && sp->payloadSize() >= EIT::EIT_PAYLOAD_FIXED_SIZE) {
+            _first = sp.pointer();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Interface for TableEntriesView.
+//----------------------------------------------------------------------------
+
+bool ts::EITView::Event::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    if (section.payloadSize() < EIT::EIT_PAYLOAD_FIXED_SIZE) {
+        return false;
+    }
+    begin = section.payload() + EIT::EIT_PAYLOAD_FIXED_SIZE;
+    end = section.payload() + section.payloadSize();
+    return true;
+}
+
+size_t ts::EITView::Event::EntrySize(const uint8_t* data, size_t max_size)
+{
+    if (max_size < EIT::EIT_EVENT_FIXED_SIZE) {
+        return 0;
+    }
+    const size_t size = EIT::EIT_EVENT_FIXED_SIZE + (GetUInt16(data + EIT::EIT_EVENT_FIXED_SIZE - 2) & 0x0FFF);
+    return size <= max_size ? size : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Event fields.
+//----------------------------------------------------------------------------
+
+ts::Time ts::EITView::Event::startTime() const
+{
+    Time start;
+    DecodeMJD(_data + 2, 5, start);
+    return start;
+}
+
+ts::Second ts::EITView::Event::duration() const
+{
+    return Second(DecodeBCD(_data[7])) * 3600 + Second(DecodeBCD(_data[8])) * 60 + Second(DecodeBCD(_data[9]));
+}
+
+ts::UString ts::EITView::Event::title(const DuckContext& duck) const
+{
+    UString str;
+    const DescriptorLoopView descs(descriptors());
+    const auto it = descs.search(DID_SHORT_EVENT);
+    if (it != descs.end() && (*it).payloadSize() >= 4) {
+        // Payload: 3-byte language code, event name with length, text with length.
+        const uint8_t* const data = (*it).payload() + 3;
+        duck.decode(str, data + 1, std::min<size_t>(data[0], (*it).payloadSize() - 4));
+    }
+    return str;
+}
@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary Event Information Table (EIT)
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTableEntriesView.h"
+#include "tsDescriptorLoopView.h"
+#include "tsTime.h"
+
+namespace ts {
+
+    class DuckContext;
+
+    //!
+    //! Read-only view on a binary Event Information Table (EIT).
+    //! @ingroup table
+    //!
+    //! The view exposes the service id, transport stream id, original network id and last
+    //! table id, and the events of all sections with their event id, start time, duration,
+    //! running status, CA mode and descriptor loop. The event title is decoded on demand
+    //! from the first short_event_descriptor. The constructor locates the first section,
+    //! a new view must be built when the table is modified. See ts::DescriptorLoopView for
+    //! the common contract of binary views.
+    //!
+    class TSDUCKDLL EITView
+    {
+        TS_NOBUILD_NOCOPY(EITView);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table A binary EIT (present/following or schedule, actual or other).
+        //!
+        explicit EITView(const BinaryTable& table);
+
+        //!
+        //! Check if the binary table is a valid EIT.
+        //! @return True if the binary table is a valid EIT.
+        //!
+        bool isValid() const { return _first != nullptr; }
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return _table.tableIdExtension(); }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return _first == nullptr ? 0 : GetUInt16(_first->payload()); }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id.
+        //!
+        uint16_t onetwId() const { return _first == nullptr ? 0 : GetUInt16(_first->payload() + 2); }
+
+        //!
+        //! Get the last table id.
+        //! @return The last table id.
+        //!
+        TID lastTableId() const { return _first == nullptr ? TID(TID_NULL) : _first->payload()[5]; }
+
+        //!
+        //! View on one event in an EIT.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Event(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+            //!
+            //! Get the event id.
+            //! @return The event id.
+            //!
+            uint16_t eventId() const { return GetUInt16(_data); }
+            //!
+            //! Get the event start time.
+            //! @return The event start time (UTC or JST in Japan).
+            //!
+            Time startTime() const;
+            //!
+            //! Get the event duration.
+            //! @return The event duration in seconds.
+            //!
+            Second duration() const;
+            //!
+            //! Get the running status of the event.
+            //! @return The running status of the event.
+            //!
+            uint8_t runningStatus() const { return (_data[10] >> 5) & 0x07; }
+            //!
+            //! Check if the event is controlled by a CA system.
+            //! @return True if the event is controlled by a CA system.
+            //!
+            bool CAControlled() const { return (_data[10] & 0x10) != 0; }
+            //!
+            //! Get a view on the descriptor loop of the event.
+            //! @return A view on the descriptor loop of the event.
+            //!
+            DescriptorLoopView descriptors() const { return DescriptorLoopView(_data + 12, _size - 12); }
+            //!
+            //! Get the event name from the first short_event_descriptor, if any.
+            //! @param [in] duck TSDuck execution context, used to decode the string.
+            //! @return The event name or an empty string if there is no short_event_descriptor.
+            //!
+            UString title(const DuckContext& duck) const;
+
+            //! @cond nodoxygen
+            // Interface for TableEntriesView.
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            static size_t EntrySize(const uint8_t* data, size_t max_size);
+            static bool Skip(const uint8_t* data, size_t size) { return false; }
+            //! @endcond
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Get a view on the list of events.
+        //! @return A view on the list of events.
+        //!
+        TableEntriesView<Event> events() const { return TableEntriesView<Event>(isValid() ? &_table : nullptr); }
+
+    private:
+        const BinaryTable& _table;
+        const Section*     _first = nullptr;  // First section, null if the table is not a valid EIT.
+    };
+}
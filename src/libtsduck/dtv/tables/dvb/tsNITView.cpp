@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsNITView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::NITView::NITView(const BinaryTable& table) :
+    _table(table)
+{
+    if (table.isValid() && (table.tableId() == TID_NIT_ACT || table.tableId() == TID_NIT_OTH) && table.sectionCount() > 0) {
+        const SectionPtr& sp(table.sectionAt(0));
+        if (!sp.isNull() && sp->isValid() && sp->payloadSize() >= 2) {
+            _first = sp.pointer();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a view on the network-level descriptor loop in the first section.
+//----------------------------------------------------------------------------
+
+ts::DescriptorLoopView ts::NITView::descriptors() const
+{
+    if (_first == nullptr) {
+        return DescriptorLoopView();
+    }
+    const uint8_t* data = _first->payload();
+    return DescriptorLoopView(data + 2, std::min<size_t>(GetUInt16(data) & 0x0FFF, _first->payloadSize() - 2));
+}
+
+
+//----------------------------------------------------------------------------
+// Interface for TableEntriesView.
+//----------------------------------------------------------------------------
+
+bool ts::NITView::TransportStream::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    // Payload: network descriptors with 12-bit length, transport streams loop with 12-bit length.
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+    if (size < 2) {
+        return false;
+    }
+    const size_t loop_offset = 2 + (GetUInt16(data) & 0x0FFF);
+    if (loop_offset + 2 > size) {
+        return false;
+    }
+    begin = data + loop_offset + 2;
+    end = begin + std::min<size_t>(GetUInt16(data + loop_offset) & 0x0FFF, size - loop_offset - 2);
+    return true;
+}
+
+size_t ts::NITView::TransportStream::EntrySize(const uint8_t* data, size_t max_size)
+{
+    if (max_size < 6) {
+        return 0;
+    }
+    const size_t size = 6 + (GetUInt16(data + 4) & 0x0FFF);
+    return size <= max_size ? size : 0;
+}
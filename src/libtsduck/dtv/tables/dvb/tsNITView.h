@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary Network Information Table (NIT)
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTableEntriesView.h"
+#include "tsDescriptorLoopView.h"
+
+namespace ts {
+    //!
+    //! Read-only view on a binary Network Information Table (NIT).
+    //! @ingroup table
+    //!
+    //! The view exposes the network id, the network descriptor loop of the first section
+    //! and the transport streams of all sections, with their ids and descriptor loops.
+    //! The network descriptors in subsequent sections are not returned. The constructor
+    //! locates the first section, a new view must be built when the table is modified.
+    //! See ts::DescriptorLoopView for the common contract of binary views.
+    //!
+    class TSDUCKDLL NITView
+    {
+        TS_NOBUILD_NOCOPY(NITView);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table A binary NIT (actual or other).
+        //!
+        explicit NITView(const BinaryTable& table);
+
+        //!
+        //! Check if the binary table is a valid NIT.
+        //! @return True if the binary table is a valid NIT.
+        //!
+        bool isValid() const { return _first != nullptr; }
+
+        //!
+        //! Check if this is an "actual" NIT.
+        //! @return True for an NIT Actual network, false for an NIT Other network.
+        //!
+        bool isActual() const { return _table.tableId() == TID_NIT_ACT; }
+
+        //!
+        //! Get the network id.
+        //! @return The network id.
+        //!
+        uint16_t networkId() const { return _table.tableIdExtension(); }
+
+        //!
+        //! Get a view on the network-level descriptor loop in the first section.
+        //! @return A view on the network-level descriptor loop.
+        //!
+        DescriptorLoopView descriptors() const;
+
+        //!
+        //! View on one transport stream in a NIT.
+        //!
+        class TSDUCKDLL TransportStream
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            TransportStream(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+            //!
+            //! Get the transport stream id.
+            //! @return The transport stream id.
+            //!
+            uint16_t tsId() const { return GetUInt16(_data); }
+            //!
+            //! Get the original network id.
+            //! @return The original network id.
+            //!
+            uint16_t onetwId() const { return GetUInt16(_data + 2); }
+            //!
+            //! Get a view on the descriptor loop of the transport stream.
+            //! @return A view on the descriptor loop of the transport stream.
+            //!
+            DescriptorLoopView descriptors() const { return DescriptorLoopView(_data + 6, _size - 6); }
+
+            //! @cond nodoxygen
+            // Interface for TableEntriesView.
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            static size_t EntrySize(const uint8_t* data, size_t max_size);
+            static bool Skip(const uint8_t* data, size_t size) { return false; }
+            //! @endcond
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Get a view on the list of transport streams.
+        //! @return A view on the list of transport streams.
+        //!
+        TableEntriesView<TransportStream> transportStreams() const { return TableEntriesView<TransportStream>(isValid() ? &_table : nullptr); }
+
+    private:
+        const BinaryTable& _table;
+        const Section*     _first = nullptr;  // First section, null if the table is not a valid NIT.
+    };
+}
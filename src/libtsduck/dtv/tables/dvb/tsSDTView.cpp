@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsSDTView.h"
+#include "tsDuckContext.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::SDTView::SDTView(const BinaryTable& table) :
+    _table(table)
+{
+    if (table.isValid() && (table.tableId() == TID_SDT_ACT || table.tableId() == TID_SDT_OTH) && table.sectionCount() > 0) {
+        const SectionPtr& sp(table.sectionAt(0));
+        if (!sp.isNull() && sp->isValid() && sp->payloadSize() >= 3) {
+            _first = sp.pointer();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Interface for TableEntriesView.
+//----------------------------------------------------------------------------
+
+bool ts::SDTView::Service::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    if (section.payloadSize() < 3) {
+        return false;
+    }
+    begin = section.payload() + 3;
+    end = section.payload() + section.payloadSize();
+    return true;
+}
+
+size_t ts::SDTView::Service::EntrySize(const uint8_t* data, size_t max_size)
+{
+    if (max_size < 5) {
+        return 0;
+    }
+    const size_t size = 5 + (GetUInt16(data + 3) & 0x0FFF);
+    return size <= max_size ? size : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Lazy access to the service_descriptor.
+//----------------------------------------------------------------------------
+
+uint8_t ts::SDTView::Service::serviceType() const
+{
+    const DescriptorLoopView descs(descriptors());
+    const auto it = descs.search(DID_SERVICE);
+    return it == descs.end() || (*it).payloadSize() == 0 ? 0 : (*it).payload()[0];
+}
+
+ts::UString ts::SDTView::Service::name(const DuckContext& duck) const
+{
+    return serviceDescriptorString(duck, true);
+}
+
+ts::UString ts::SDTView::Service::provider(const DuckContext& duck) const
+{
+    return serviceDescriptorString(duck, false);
+}
+
+ts::UString ts::SDTView::Service::serviceDescriptorString(const DuckContext& duck, bool get_name) const
+{
+    UString str;
+    const DescriptorLoopView descs(descriptors());
+    const auto it = descs.search(DID_SERVICE);
+    if (it != descs.end() && (*it).payloadSize() >= 2) {
+        // Payload: service_type, provider name with length, service name with length.
+        const uint8_t* data = (*it).payload() + 1;
+        const uint8_t* const end = (*it).payload() + (*it).payloadSize();
+        if (get_name) {
+            data += 1 + size_t(data[0]);
+        }
+        if (data < end) {
+            duck.decode(str, data + 1, std::min<size_t>(data[0], end - data - 1));
+        }
+    }
+    return str;
+}
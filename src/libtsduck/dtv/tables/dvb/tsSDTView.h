@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary Service Description Table (SDT)
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTableEntriesView.h"
+#include "tsDescriptorLoopView.h"
+#include "tsUString.h"
+
+namespace ts {
+
+    class DuckContext;
+
+    //!
+    //! Read-only view on a binary Service Description Table (SDT).
+    //! @ingroup table
+    //!
+    //! The view exposes the transport stream id, the original network id and the services
+    //! of all sections, with their EIT flags, running status, CA mode and descriptor loop.
+    //! The service type, name and provider name are extracted from the service_descriptor
+    //! and the names are decoded only when requested, using the character sets of the
+    //! DuckContext at that time. The constructor locates the first section, a new view must
+    //! be built when the table is modified. See ts::DescriptorLoopView for the common
+    //! contract of binary views.
+    //!
+    class TSDUCKDLL SDTView
+    {
+        TS_NOBUILD_NOCOPY(SDTView);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table A binary SDT (actual or other).
+        //!
+        explicit SDTView(const BinaryTable& table);
+
+        //!
+        //! Check if the binary table is a valid SDT.
+        //! @return True if the binary table is a valid SDT.
+        //!
+        bool isValid() const { return _first != nullptr; }
+
+        //!
+        //! Check if this is an "actual" SDT.
+        //! @return True for an SDT Actual TS, false for an SDT Other TS.
+        //!
+        bool isActual() const { return _table.tableId() == TID_SDT_ACT; }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return _table.tableIdExtension(); }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id.
+        //!
+        uint16_t onetwId() const { return _first == nullptr ? 0 : GetUInt16(_first->payload()); }
+
+        //!
+        //! View on one service in an SDT.
+        //!
+        class TSDUCKDLL Service
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Service(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+            //!
+            //! Get the service id.
+            //! @return The service id.
+            //!
+            uint16_t serviceId() const { return GetUInt16(_data); }
+            //!
+            //! Check if an EIT schedule is present for the service.
+            //! @return True if an EIT schedule is present for the service.
+            //!
+            bool EITs() const { return (_data[2] & 0x02) != 0; }
+            //!
+            //! Check if an EIT present/following is present for the service.
+            //! @return True if an EIT present/following is present for the service.
+            //!
+            bool EITpf() const { return (_data[2] & 0x01) != 0; }
+            //!
+            //! Get the running status.
+            //! @return The running status code.
+            //!
+            uint8_t runningStatus() const { return _data[3] >> 5; }
+            //!
+            //! Check if the service is controlled by a CA system.
+            //! @return True if the service is controlled by a CA system.
+            //!
+            bool CAControlled() const { return (_data[3] & 0x10) != 0; }
+            //!
+            //! Get a view on the descriptor loop of the service.
+            //! @return A view on the descriptor loop of the service.
+            //!
+            DescriptorLoopView descriptors() const { return DescriptorLoopView(_data + 5, _size - 5); }
+            //!
+            //! Get the service type from the first service_descriptor.
+            //! @return The service type or zero if there is no service_descriptor.
+            //!
+            uint8_t serviceType() const;
+            //!
+            //! Decode the service name from the first service_descriptor.
+            //! @param [in] duck TSDuck execution context, used to decode the string.
+            //! @return The service name or an empty string if there is no service_descriptor.
+            //!
+            UString name(const DuckContext& duck) const;
+            //!
+            //! Decode the provider name from the first service_descriptor.
+            //! @param [in] duck TSDuck execution context, used to decode the string.
+            //! @return The provider name or an empty string if there is no service_descriptor.
+            //!
+            UString provider(const DuckContext& duck) const;
+
+            //! @cond nodoxygen
+            // Interface for TableEntriesView.
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            static size_t EntrySize(const uint8_t* data, size_t max_size);
+            static bool Skip(const uint8_t* data, size_t size) { return false; }
+            //! @endcond
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+            // Decode one of the two strings of the service_descriptor.
+            UString serviceDescriptorString(const DuckContext& duck, bool get_name) const;
+        };
+
+        //!
+        //! Get a view on the list of services.
+        //! @return A view on the list of services.
+        //!
+        TableEntriesView<Service> services() const { return TableEntriesView<Service>(isValid() ? &_table : nullptr); }
+
+    private:
+        const BinaryTable& _table;
+        const Section*     _first = nullptr;  // First section, null if the table is not a valid SDT.
+    };
+}
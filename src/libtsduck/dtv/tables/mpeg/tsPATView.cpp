@@ -0,0 +1,43 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPATView.h"
+
+
+//----------------------------------------------------------------------------
+// Location of the list of programs in a section.
+//----------------------------------------------------------------------------
+
+bool ts::PATView::Program::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    begin = section.payload();
+    end = begin + section.payloadSize();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the PID of the NIT.
+//----------------------------------------------------------------------------
+
+ts::PID ts::PATView::nitPID() const
+{
+    if (isValid()) {
+        for (size_t si = 0; si < _table.sectionCount(); ++si) {
+            const SectionPtr& sp(_table.sectionAt(si));
+            if (!sp.isNull() && sp->isValid()) {
+                for (const uint8_t* data = sp->payload(); data + 4 <= sp->payload() + sp->payloadSize(); data += 4) {
+                    if (GetUInt16(data) == 0) {
+                        return GetUInt16(data + 2) & 0x1FFF;
+                    }
+                }
+            }
+        }
+    }
+    return PID_NULL;
+}
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary Program Association Table (PAT)
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTableEntriesView.h"
+#include "tsTS.h"
+
+namespace ts {
+    //!
+    //! Read-only view on a binary Program Association Table (PAT).
+    //! @ingroup table
+    //!
+    //! The view exposes the transport stream id, the PID of the NIT (entry for program zero)
+    //! and the list of programs of all sections, with their service id and PMT PID. The
+    //! program zero is not returned by programs(). The view keeps no pointer inside the
+    //! sections: it can be kept while the table is reloaded, only the Program entries and
+    //! iterators from programs() become invalid. See ts::DescriptorLoopView for the common
+    //! contract of binary views.
+    //!
+    class TSDUCKDLL PATView
+    {
+        TS_NOBUILD_NOCOPY(PATView);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table A binary PAT.
+        //!
+        explicit PATView(const BinaryTable& table) : _table(table) {}
+
+        //!
+        //! Check if the binary table is a valid PAT.
+        //! @return True if the binary table is a valid PAT.
+        //!
+        bool isValid() const { return _table.isValid() && _table.tableId() == TID_PAT; }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return _table.tableIdExtension(); }
+
+        //!
+        //! Get the PID of the NIT.
+        //! @return The PID of the NIT or PID_NULL if there is none.
+        //!
+        PID nitPID() const;
+
+        //!
+        //! View on one program in a PAT. The NIT entry (program number zero) is not a program.
+        //!
+        class TSDUCKDLL Program
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Program(const uint8_t* data, size_t size) : _data(data) {}
+            //!
+            //! Get the program number, aka service id.
+            //! @return The service id.
+            //!
+            uint16_t serviceId() const { return GetUInt16(_data); }
+            //!
+            //! Get the PMT PID.
+            //! @return The PMT PID.
+            //!
+            PID pmtPID() const { return GetUInt16(_data + 2) & 0x1FFF; }
+
+            //! @cond nodoxygen
+            // Interface for TableEntriesView.
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            static size_t EntrySize(const uint8_t* data, size_t max_size) { return max_size < 4 ? 0 : 4; }
+            static bool Skip(const uint8_t* data, size_t size) { return GetUInt16(data) == 0; }
+            //! @endcond
+        private:
+            const uint8_t* _data;
+        };
+
+        //!
+        //! Get a view on the list of programs.
+        //! @return A view on the list of programs.
+        //!
+        TableEntriesView<Program> programs() const { return TableEntriesView<Program>(isValid() ? &_table : nullptr); }
+
+    private:
+        const BinaryTable& _table;
+    };
+}
@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPMTView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::PMTView::PMTView(const BinaryTable& table) :
+    _table(table)
+{
+    if (table.isValid() && table.tableId() == TID_PMT && table.sectionCount() > 0) {
+        const SectionPtr& sp(table.sectionAt(0));
+        if (!sp.isNull() && sp->isValid() && sp->payloadSize() >= 4) {
+            _first = sp.pointer();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a view on the program-level descriptor loop in the first section.
+//----------------------------------------------------------------------------
+
+ts::DescriptorLoopView ts::PMTView::descriptors() const
+{
+    if (_first == nullptr) {
+        return DescriptorLoopView();
+    }
+    const uint8_t* data = _first->payload();
+    return DescriptorLoopView(data + 4, std::min<size_t>(GetUInt16(data + 2) & 0x0FFF, _first->payloadSize() - 4));
+}
+
+
+//----------------------------------------------------------------------------
+// Interface for TableEntriesView.
+//----------------------------------------------------------------------------
+
+bool ts::PMTView::Stream::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+    if (size < 4 || 4 + size_t(GetUInt16(data + 2) & 0x0FFF) > size) {
+        return false;
+    }
+    begin = data + 4 + (GetUInt16(data + 2) & 0x0FFF);
+    end = data + size;
+    return true;
+}
+
+size_t ts::PMTView::Stream::EntrySize(const uint8_t* data, size_t max_size)
+{
+    if (max_size < 5) {
+        return 0;
+    }
+    const size_t size = 5 + (GetUInt16(data + 3) & 0x0FFF);
+    return size <= max_size ? size : 0;
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view on a binary Program Map Table (PMT)
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTableEntriesView.h"
+#include "tsDescriptorLoopView.h"
+#include "tsTS.h"
+
+namespace ts {
+    //!
+    //! Read-only view on a binary Program Map Table (PMT).
+    //! @ingroup table
+    //!
+    //! The view exposes the service id, the PCR PID and the program-level descriptor loop,
+    //! and the elementary streams with their stream type, PID and descriptor loop. The PCR
+    //! PID and program-level descriptors are read in the first section (a PMT normally has
+    //! only one). The constructor locates this section, a new view must be built when the
+    //! table is modified. See ts::DescriptorLoopView for the common contract of binary views.
+    //!
+    class TSDUCKDLL PMTView
+    {
+        TS_NOBUILD_NOCOPY(PMTView);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] table A binary PMT.
+        //!
+        explicit PMTView(const BinaryTable& table);
+
+        //!
+        //! Check if the binary table is a valid PMT.
+        //! @return True if the binary table is a valid PMT.
+        //!
+        bool isValid() const { return _first != nullptr; }
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return _table.tableIdExtension(); }
+
+        //!
+        //! Get the PCR PID.
+        //! @return The PCR PID or PID_NULL if there is none.
+        //!
+        PID pcrPID() const { return _first == nullptr ? PID(PID_NULL) : PID(GetUInt16(_first->payload()) & 0x1FFF); }
+
+        //!
+        //! Get a view on the program-level descriptor loop in the first section.
+        //! @return A view on the program-level descriptor loop.
+        //!
+        DescriptorLoopView descriptors() const;
+
+        //!
+        //! View on one elementary stream in a PMT.
+        //!
+        class TSDUCKDLL Stream
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the entry.
+            //! @param [in] size Size of the entry.
+            //!
+            Stream(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+            //!
+            //! Get the stream type.
+            //! @return The stream type.
+            //!
+            uint8_t streamType() const { return _data[0]; }
+            //!
+            //! Get the elementary stream PID.
+            //! @return The elementary stream PID.
+            //!
+            PID pid() const { return GetUInt16(_data + 1) & 0x1FFF; }
+            //!
+            //! Get a view on the stream-level descriptor loop.
+            //! @return A view on the stream-level descriptor loop.
+            //!
+            DescriptorLoopView descriptors() const { return DescriptorLoopView(_data + 5, _size - 5); }
+
+            //! @cond nodoxygen
+            // Interface for TableEntriesView.
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            static size_t EntrySize(const uint8_t* data, size_t max_size);
+            static bool Skip(const uint8_t* data, size_t size) { return false; }
+            //! @endcond
+        private:
+            const uint8_t* _data;
+            size_t         _size;
+        };
+
+        //!
+        //! Get a view on the list of elementary streams.
+        //! @return A view on the list of elementary streams.
+        //!
+        TableEntriesView<Stream> streams() const { return TableEntriesView<Stream>(isValid() ? &_table : nullptr); }
+
+    private:
+        const BinaryTable& _table;
+        const Section*     _first = nullptr;  // First section, null if the table is not a valid PMT.
+    };
+}
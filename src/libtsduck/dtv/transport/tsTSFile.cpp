@@ -10,6 +10,7 @@
 #include "tsTSPacketMetadata.h"
 #include "tsNullReport.h"
 #include "tsSysUtils.h"
+#include "tsErrCodeReport.h"
 
 #if defined(TS_WINDOWS)
     #include "tsBeforeStandardHeaders.h"
@@ -386,6 +387,14 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         _total_read = _total_write = 0;
     }
 
+    // When appending to a non-empty file, do not write a new stream header (compact format).
+    if (append_access && _regular && !_std_inout) {
+        const std::uintmax_t size = fs::file_size(_filename, &ErrCodeReport());
+        if (size != 0 && size != FS_ERROR) {
+            appendPacketStream();
+        }
+    }
+
     // Clean initial state.
     _aborted = false;
     _at_eof = false;
@@ -432,6 +441,11 @@ bool ts::TSFile::seekCheck(Report& report)
 
 bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 {
+    // With the compact format, the stream header is read again at the beginning.
+    if (index == 0) {
+        rewindPacketStream();
+    }
+
     // If seeking at the beginning and REOPEN is set, close and reopen the file.
     if (index == 0 && (_flags & REOPEN) != 0) {
         return openInternal(true, report);
@@ -471,6 +485,10 @@ bool ts::TSFile::seek(PacketCounter packet_index, Report& report)
         report.log(_severity, u"file %s is not rewindable", {getDisplayFileName()});
         return false;
     }
+    else if (packet_index != 0 && packetFormat() == TSPacketFormat::COMPACT) {
+        report.log(_severity, u"cannot seek to a packet index in compact file %s", {getDisplayFileName()});
+        return false;
+    }
     else {
         return seekInternal(packet_index * (packetHeaderSize() + PKT_SIZE), report);
     }
@@ -171,7 +171,7 @@ namespace ts {
         //! Seek the file at a specified packet index.
         //! The file must have been opened in rewindable mode.
         //! @param [in] packet_index Seek the file to this specified packet index
-        //! (plus the specified @a start_offset from open()).
+        //! (plus the specified @a start_offset from open()). With the compact format, only zero is allowed.
         //! @param [in,out] report Where to report errors.
         //! @return True on success, false on error.
         //!
@@ -0,0 +1,164 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndex.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Serialization of entries and header.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::Entry::serialize(uint8_t* data) const
+{
+    PutUInt64(data, packet);
+    PutUInt64(data + 8, pcr);
+    PutUInt64(data + 16, pts);
+    PutInt64(data + 24, utc < 0 ? -1 : utc);
+}
+
+void ts::TSFileIndex::Entry::deserialize(const uint8_t* data)
+{
+    packet = GetUInt64(data);
+    pcr = GetUInt64(data + 8);
+    pts = GetUInt64(data + 16);
+    utc = GetInt64(data + 24);
+}
+
+void ts::TSFileIndex::SerializeHeader(uint8_t* data, size_t packet_size)
+{
+    std::memset(data, 0, HEADER_SIZE);
+    std::memcpy(data, "TSIX", 4);
+    data[4] = FORMAT_VERSION;
+    PutUInt16(data + 6, uint16_t(packet_size));
+}
+
+
+//----------------------------------------------------------------------------
+// Get the name of the time index file which is associated with a TS file.
+//----------------------------------------------------------------------------
+
+fs::path ts::TSFileIndex::IndexFileName(const fs::path& ts_file)
+{
+    fs::path name(ts_file);
+    name += FILE_EXTENSION;
+    return name;
+}
+
+
+//----------------------------------------------------------------------------
+// Load a time index file.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::clear()
+{
+    _packet_size = PKT_SIZE;
+    _entries.clear();
+}
+
+bool ts::TSFileIndex::load(const fs::path& filename, Report& report)
+{
+    clear();
+
+    std::ifstream strm(filename, std::ios::in | std::ios::binary);
+    if (!strm) {
+        report.error(u"cannot open time index file %s", {filename});
+        return false;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    if (!strm.read(reinterpret_cast<char*>(header), HEADER_SIZE) || std::memcmp(header, "TSIX", 4) != 0 || header[4] != FORMAT_VERSION) {
+        report.error(u"invalid time index file %s", {filename});
+        return false;
+    }
+    _packet_size = GetUInt16(header + 6);
+    if (_packet_size < PKT_SIZE) {
+        report.error(u"invalid packet size %d in time index file %s", {_packet_size, filename});
+        return false;
+    }
+
+    // Read all complete entries. A truncated last entry is ignored (index being written).
+    uint8_t data[ENTRY_SIZE];
+    Entry entry;
+    while (strm.read(reinterpret_cast<char*>(data), ENTRY_SIZE)) {
+        entry.deserialize(data);
+        _entries.push_back(entry);
+    }
+
+    report.debug(u"loaded %d entries from %s", {_entries.size(), filename});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Search entry points.
+//----------------------------------------------------------------------------
+
+// The values (PCR or UTC time) are increasing between discontinuities only. The index is a
+// list of segments with increasing values. We use the first segment which contains the value.
+// If no segment contains the value, use the first segment which starts before the value.
+namespace {
+    template <typename T, class GET>
+    bool SearchEntry(const ts::TSFileIndex::EntryVector& entries, T value, ts::TSFileIndex::Entry& entry, GET get)
+    {
+        const ts::TSFileIndex::Entry* candidate = nullptr;  // last entry before value in current segment
+        const ts::TSFileIndex::Entry* fallback = nullptr;   // first segment which starts before value
+        bool has_previous = false;
+        T previous = 0;
+        for (const auto& e : entries) {
+            T current = 0;
+            if (!get(e, current)) {
+                continue;  // no value in this entry
+            }
+            if (has_previous && current < previous) {
+                // Discontinuity, the previous segment does not contain the value.
+                if (fallback == nullptr) {
+                    fallback = candidate;
+                }
+                candidate = nullptr;
+            }
+            if (current <= value) {
+                candidate = &e;
+            }
+            else if (candidate != nullptr) {
+                // The value is inside the current segment.
+                entry = *candidate;
+                return true;
+            }
+            has_previous = true;
+            previous = current;
+        }
+        if (fallback == nullptr) {
+            fallback = candidate;
+        }
+        if (fallback != nullptr) {
+            entry = *fallback;
+        }
+        return fallback != nullptr;
+    }
+}
+
+bool ts::TSFileIndex::searchPCR(uint64_t pcr, Entry& entry) const
+{
+    return SearchEntry(_entries, pcr, entry, [](const Entry& e, uint64_t& value) { value = e.pcr; return e.pcr != INVALID_PCR; });
+}
+
+bool ts::TSFileIndex::searchTime(const Time& utc, Entry& entry) const
+{
+    return SearchEntry(_entries, utc - Time::UnixEpoch, entry, [](const Entry& e, MilliSecond& value) { value = e.utc; return e.utc >= 0; });
+}
+
+ts::Time ts::TSFileIndex::firstTime() const
+{
+    for (const auto& e : _entries) {
+        if (e.utc >= 0) {
+            return e.utcTime();
+        }
+    }
+    return Time::Epoch;
+}
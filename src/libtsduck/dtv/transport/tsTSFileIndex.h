@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Time index of a transport stream file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTS.h"
+#include "tsTime.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Time index of a transport stream file.
+    //! @ingroup mpeg
+    //!
+    //! A time index is a sidecar binary file, next to a TS file, with the same name plus
+    //! a ".tsidx" extension. It contains a list of entry points in the TS file. Each entry
+    //! point associates a packet index in the file with a PCR, a PTS and a UTC time.
+    //! Entry points are chosen on random access points of the PCR PID when the stream
+    //! signals them, on PCR's otherwise. A time index is built by ts::TSFileIndexer.
+    //!
+    //! Binary format, all integers are big endian:
+    //! - Header (16 bytes): "TSIX" (4 bytes), format version (1 byte), reserved (1 byte),
+    //!   size in bytes of each packet in the TS file (2 bytes), reserved (8 bytes).
+    //! - Any number of 32-byte entries: packet index (8 bytes), PCR (8 bytes), PTS (8 bytes),
+    //!   UTC time in milliseconds since 1970-01-01 (8 bytes, signed). The PCR and PTS are
+    //!   all ones when unknown. The UTC time is negative when unknown.
+    //!
+    class TSDUCKDLL TSFileIndex
+    {
+    public:
+        //!
+        //! Default file extension of time index files.
+        //!
+        static constexpr const UChar* FILE_EXTENSION = u".tsidx";
+        //!
+        //! Current version of the binary format.
+        //!
+        static constexpr uint8_t FORMAT_VERSION = 1;
+        //!
+        //! Size in bytes of the header of a time index file.
+        //!
+        static constexpr size_t HEADER_SIZE = 16;
+        //!
+        //! Size in bytes of an entry in a time index file.
+        //!
+        static constexpr size_t ENTRY_SIZE = 32;
+
+        //!
+        //! One entry point in a time index.
+        //!
+        class TSDUCKDLL Entry
+        {
+        public:
+            PacketCounter packet = 0;            //!< Index of the packet in the TS file.
+            uint64_t      pcr = INVALID_PCR;     //!< PCR value at this packet.
+            uint64_t      pts = INVALID_PTS;     //!< Last PTS in the PCR PID before this packet.
+            MilliSecond   utc = -1;              //!< UTC time in milliseconds since 1970-01-01, negative if unknown.
+
+            //!
+            //! Get the UTC time of the entry as a Time object.
+            //! @return The UTC time of the entry or Time::Epoch if unknown.
+            //!
+            Time utcTime() const { return utc < 0 ? Time::Epoch : Time::UnixEpoch + utc; }
+
+            //!
+            //! Serialize the entry.
+            //! @param [out] data Address of an ENTRY_SIZE-byte area.
+            //!
+            void serialize(uint8_t* data) const;
+
+            //!
+            //! Deserialize the entry.
+            //! @param [in] data Address of an ENTRY_SIZE-byte area.
+            //!
+            void deserialize(const uint8_t* data);
+        };
+
+        //!
+        //! Vector of time index entries.
+        //!
+        typedef std::vector<Entry> EntryVector;
+
+        //!
+        //! Default constructor.
+        //!
+        TSFileIndex() = default;
+
+        //!
+        //! Get the name of the time index file which is associated with a TS file.
+        //! @param [in] ts_file Name of the TS file.
+        //! @return Name of the associated time index file.
+        //!
+        static fs::path IndexFileName(const fs::path& ts_file);
+
+        //!
+        //! Load a time index file.
+        //! @param [in] filename Name of the time index file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool load(const fs::path& filename, Report& report);
+
+        //!
+        //! Serialize the header of a time index file.
+        //! @param [out] data Address of a HEADER_SIZE-byte area.
+        //! @param [in] packet_size Size in bytes of each packet in the TS file.
+        //!
+        static void SerializeHeader(uint8_t* data, size_t packet_size);
+
+        //!
+        //! Clear the content of the index.
+        //!
+        void clear();
+
+        //!
+        //! Get the size in bytes of each packet in the TS file.
+        //! @return The size in bytes of each packet in the TS file.
+        //!
+        size_t packetSize() const { return _packet_size; }
+
+        //!
+        //! Get the list of entries.
+        //! @return A constant reference to the list of entries in the index.
+        //!
+        const EntryVector& entries() const { return _entries; }
+
+        //!
+        //! Search the last entry point with a PCR lower than or equal to a given value.
+        //! In case of PCR discontinuity, the entries are split in segments of increasing PCR's.
+        //! The search uses the first segment which contains the PCR value or, if there is none,
+        //! the first segment which starts before that value. A segment contains a value when it has
+        //! entries before and after that value. Only backward PCR jumps are detected as discontinuities.
+        //! @param [in] pcr The PCR value to search.
+        //! @param [out] entry The found entry.
+        //! @return True if found, false if the PCR is before the first entry or there is no entry with a PCR.
+        //!
+        bool searchPCR(uint64_t pcr, Entry& entry) const;
+
+        //!
+        //! Search the last entry point with a UTC time lower than or equal to a given value.
+        //! Time discontinuities are processed the same way as PCR discontinuities in searchPCR().
+        //! @param [in] utc The UTC time to search.
+        //! @param [out] entry The found entry.
+        //! @return True if found, false if the time is before the first entry or there is no entry with a time.
+        //!
+        bool searchTime(const Time& utc, Entry& entry) const;
+
+        //!
+        //! Get the UTC time of the first entry with a known time.
+        //! @return The UTC time of the first entry with a known time or Time::Epoch if there is none.
+        //!
+        Time firstTime() const;
+
+    private:
+        size_t      _packet_size = PKT_SIZE;
+        EntryVector _entries {};
+    };
+}
@@ -0,0 +1,170 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndexer.h"
+#include "tsPSI.h"
+#include "tsMJD.h"
+#include "tsNullReport.h"
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::TSFileIndexer::~TSFileIndexer()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Reset stream analysis state.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::reset()
+{
+    _count = 0;
+    _pcr_pid = PID_NULL;
+    _use_rai = false;
+    _last_pcr = INVALID_PCR;
+    _last_pts = INVALID_PTS;
+    _entry_pcr = INVALID_PCR;
+    _tdt_time = Time::Epoch;
+    _tdt_pcr = INVALID_PCR;
+}
+
+
+//----------------------------------------------------------------------------
+// Open / close the index file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndexer::open(const fs::path& filename, size_t packet_size, bool append, Report& report)
+{
+    close();
+    reset();
+    _filename = filename;
+
+    // In append mode, reuse an existing index file with the same packet size.
+    if (append && fs::exists(filename)) {
+        TSFileIndex index;
+        if (index.load(filename, NULLREP) && index.packetSize() == packet_size) {
+            _strm.open(filename, std::ios::out | std::ios::binary | std::ios::app);
+            if (!_strm) {
+                report.error(u"cannot open time index file %s", {filename});
+                return false;
+            }
+            return true;
+        }
+        report.warning(u"incompatible time index file %s, rebuilding a new one", {filename});
+    }
+
+    // Create a new index file with its header.
+    _strm.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    uint8_t header[TSFileIndex::HEADER_SIZE];
+    TSFileIndex::SerializeHeader(header, packet_size);
+    if (!_strm || !_strm.write(reinterpret_cast<const char*>(header), sizeof(header)).flush()) {
+        report.error(u"error creating time index file %s", {filename});
+        _strm.close();
+        return false;
+    }
+    return true;
+}
+
+void ts::TSFileIndexer::close()
+{
+    if (_strm.is_open()) {
+        _strm.close();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a packet from the TDT/TOT PID.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::analyzeTDT(const TSPacket& pkt)
+{
+    // TDT and TOT are short sections, always in one packet, the UTC time immediately follows the header.
+    const uint8_t* payload = pkt.getPayload();
+    const size_t size = pkt.getPayloadSize();
+    if (pkt.getPUSI() && size > 0 && size_t(payload[0]) + 1 + 3 + MJD_SIZE <= size) {
+        const uint8_t* section = payload + 1 + payload[0];
+        Time utc;
+        if ((section[0] == TID_TDT || section[0] == TID_TOT) && DecodeMJD(section + 3, MJD_SIZE, utc)) {
+            _tdt_time = utc;
+            _tdt_pcr = _last_pcr;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pass the next packet of the TS file.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndexer::feedPacket(const TSPacket& pkt, PacketCounter index, const Time& utc)
+{
+    if (!_strm.is_open()) {
+        return;
+    }
+
+    const PID pid = pkt.getPID();
+    if (pid == PID_TDT) {
+        analyzeTDT(pkt);
+        return;
+    }
+
+    // The reference PID is the first one with PCR's.
+    const bool has_pcr = pkt.hasPCR();
+    if (_pcr_pid == PID_NULL && has_pcr) {
+        _pcr_pid = pid;
+    }
+    if (pid != _pcr_pid) {
+        return;
+    }
+
+    // Track last PCR and PTS on the reference PID.
+    if (has_pcr) {
+        _last_pcr = pkt.getPCR();
+    }
+    if (pkt.hasPTS()) {
+        _last_pts = pkt.getPTS();
+    }
+
+    // Once random access points are signalled, only index them.
+    const bool rai = pkt.getRandomAccessIndicator();
+    _use_rai = _use_rai || rai;
+    if (_last_pcr == INVALID_PCR || !(_use_rai ? rai : has_pcr)) {
+        return;
+    }
+
+    // At most one entry per interval, except after a PCR discontinuity.
+    if (_entry_pcr != INVALID_PCR && _last_pcr >= _entry_pcr && _last_pcr - _entry_pcr < uint64_t(_interval) * (SYSTEM_CLOCK_FREQ / MilliSecPerSec)) {
+        return;
+    }
+
+    TSFileIndex::Entry entry;
+    entry.packet = index;
+    entry.pcr = _last_pcr;
+    entry.pts = _last_pts;
+    if (utc != Time::Epoch) {
+        entry.utc = utc - Time::UnixEpoch;
+    }
+    else if (_tdt_time != Time::Epoch) {
+        entry.utc = _tdt_time - Time::UnixEpoch;
+        if (_tdt_pcr != INVALID_PCR && _last_pcr >= _tdt_pcr) {
+            entry.utc += MilliSecond((_last_pcr - _tdt_pcr) / (SYSTEM_CLOCK_FREQ / MilliSecPerSec));
+        }
+    }
+
+    uint8_t data[TSFileIndex::ENTRY_SIZE];
+    entry.serialize(data);
+    _strm.write(reinterpret_cast<const char*>(data), sizeof(data)).flush();
+    _entry_pcr = _last_pcr;
+    _count++;
+}
@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Incremental builder of a time index of a transport stream file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSFileIndex.h"
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! Incremental builder of a time index of a transport stream file.
+    //! @ingroup mpeg
+    //!
+    //! Packets are passed one by one, in the order of the TS file, while the TS file is written
+    //! or read. Entry points are added on the first PID carrying PCR's. When this PID signals
+    //! random access points, only random access points are indexed. Otherwise, PCR's are indexed.
+    //! At most one entry point is added per interval of PCR time, unless a PCR discontinuity occurs.
+    //! Each entry is immediately written in the index file so that a TS file which is being recorded
+    //! can be searched at any time.
+    //!
+    //! When the caller does not provide a UTC time for the packets, the UTC time of entry points
+    //! is computed from the last TDT or TOT in the stream, extrapolated using the PCR.
+    //! @see TSFileIndex
+    //!
+    class TSDUCKDLL TSFileIndexer
+    {
+        TS_NOCOPY(TSFileIndexer);
+    public:
+        //!
+        //! Default minimum interval between two entry points in milliseconds.
+        //!
+        static constexpr MilliSecond DEFAULT_INTERVAL = 1000;
+
+        //!
+        //! Default constructor.
+        //!
+        TSFileIndexer() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~TSFileIndexer();
+
+        //!
+        //! Set the minimum interval between two entry points.
+        //! @param [in] interval Minimum interval in milliseconds of PCR time.
+        //!
+        void setInterval(MilliSecond interval) { _interval = interval; }
+
+        //!
+        //! Open the index file.
+        //! @param [in] filename Name of the time index file.
+        //! @param [in] packet_size Size in bytes of each packet in the TS file.
+        //! @param [in] append If true and the index file already exists, append new entries to it.
+        //! The packet size of the existing index file must be the same. Otherwise, the index file is
+        //! overwritten.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool open(const fs::path& filename, size_t packet_size, bool append, Report& report);
+
+        //!
+        //! Check if the index file is open.
+        //! @return True if the index file is open.
+        //!
+        bool isOpen() const { return _strm.is_open(); }
+
+        //!
+        //! Close the index file.
+        //!
+        void close();
+
+        //!
+        //! Pass the next packet of the TS file.
+        //! @param [in] pkt The TS packet.
+        //! @param [in] index Index of the packet in the TS file.
+        //! @param [in] utc UTC time of the packet. If Time::Epoch, the UTC time is computed from the TDT or TOT.
+        //!
+        void feedPacket(const TSPacket& pkt, PacketCounter index, const Time& utc = Time::Epoch);
+
+        //!
+        //! Get the number of entry points which were added since the index was open.
+        //! @return The number of entry points which were added since the index was open.
+        //!
+        size_t entryCount() const { return _count; }
+
+    private:
+        fs::path      _filename {};
+        std::ofstream _strm {};
+        MilliSecond   _interval = DEFAULT_INTERVAL;
+        size_t        _count = 0;           // Number of written entries.
+        PID           _pcr_pid = PID_NULL;  // Reference PID, first one with PCR's.
+        bool          _use_rai = false;     // Random access indicators were found in the reference PID.
+        uint64_t      _last_pcr = INVALID_PCR;
+        uint64_t      _last_pts = INVALID_PTS;
+        uint64_t      _entry_pcr = INVALID_PCR; // PCR of last entry.
+        Time          _tdt_time {};             // UTC time in last TDT or TOT.
+        uint64_t      _tdt_pcr = INVALID_PCR;   // Last PCR when the TDT or TOT was received.
+
+        // Reset stream analysis state.
+        void reset();
+
+        // Analyze a packet from the TDT/TOT PID.
+        void analyzeTDT(const TSPacket& pkt);
+    };
+}
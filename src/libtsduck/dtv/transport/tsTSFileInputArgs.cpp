@@ -75,6 +75,23 @@ void ts::TSFileInputArgs::defineArgs(Args& args)
               u"Start reading each file at the specified TS packet (default: 0). "
               u"This option is allowed only if all input files are regular files.");
 
+    args.option(u"start-pcr", 0, Args::UNSIGNED);
+    args.help(u"start-pcr",
+              u"Start reading each file at the last entry point with a PCR lower than or equal to the specified value. "
+              u"The PCR value is in units of 27 MHz. "
+              u"The file must have a time index, as built by the option --index of the file output plugin or by the command tsindex. "
+              u"This option is allowed only if all input files are regular files.");
+
+    args.option(u"start-time", 0, Args::STRING);
+    args.help(u"start-time", u"time",
+              u"Start reading each file at the last entry point with a UTC time lower than or equal to the specified value. "
+              u"The time is either a full date and time in the format \"year/month/day:hour:minute:second\" "
+              u"or a time of day in the format \"hour:minute[:second]\". "
+              u"A time of day is relative to the date of the first entry in the time index of the file, "
+              u"or the following day if it is earlier than this first entry. "
+              u"The file must have a time index, as built by the option --index of the file output plugin or by the command tsindex. "
+              u"This option is allowed only if all input files are regular files.");
+
     args.option(u"repeat", 'r', Args::POSITIVE);
     args.help(u"repeat",
               u"Repeat the playout of each file the specified number of times (default: only once). "
@@ -98,6 +115,27 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValues(_start_stuffing, u"add-start-stuffing");
     args.getIntValues(_stop_stuffing, u"add-stop-stuffing");
     _file_format = LoadTSPacketFormatInputOption(args);
+    args.getIntValue(_start_pcr, u"start-pcr", INVALID_PCR);
+
+    // Start time, either a full date and time or a time of day.
+    _start_time = Time::Epoch;
+    _start_time_of_day = -1;
+    if (args.present(u"start-time")) {
+        const UString str(args.value(u"start-time"));
+        int hour = 0, minute = 0, second = 0;
+        if (!_start_time.decode(str, Time::DATETIME) && !_start_time.decode(str, Time::DATE | Time::HOUR | Time::MINUTE)) {
+            _start_time = Time::Epoch;
+            if ((str.scan(u"%d:%d:%d", {&hour, &minute, &second}) || str.scan(u"%d:%d", {&hour, &minute})) &&
+                hour >= 0 && hour < 24 && minute >= 0 && minute < 60 && second >= 0 && second < 60)
+            {
+                _start_time_of_day = ((hour * 60 + minute) * 60 + second) * MilliSecPerSec;
+            }
+            else {
+                args.error(u"invalid --start-time value \"%s\"", {str});
+                return false;
+            }
+        }
+    }
 
     // If there is no file, then this is the standard input, an empty file name.
     if (_filenames.empty()) {
@@ -112,6 +150,15 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
     }
 
     // Check option consistency.
+    const bool indexed = _start_pcr != INVALID_PCR || args.present(u"start-time");
+    if (indexed && (args.present(u"start-time") + args.present(u"start-pcr") + args.present(u"byte-offset") + args.present(u"packet-offset")) > 1) {
+        args.error(u"--start-time, --start-pcr, --byte-offset, --packet-offset are mutually exclusive");
+        return false;
+    }
+    if (indexed && std::any_of(_filenames.begin(), _filenames.end(), [](const fs::path& name) { return name.empty(); })) {
+        args.error(u"--start-time and --start-pcr cannot be used on standard input");
+        return false;
+    }
     if (_filenames.size() > 1 && _repeat_count == 0 && !_interleave) {
         args.error(u"specifying --infinite is meaningless with more than one file");
         return false;
@@ -126,6 +173,46 @@ bool ts::TSFileInputArgs::loadArgs(DuckContext& duck, Args& args)
 }
 
 
+//----------------------------------------------------------------------------
+// Compute the start offset of a file from its time index.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileInputArgs::indexedStartOffset(const fs::path& name, uint64_t& offset, Report& report) const
+{
+    TSFileIndex index;
+    if (!index.load(TSFileIndex::IndexFileName(name), report)) {
+        return false;
+    }
+
+    // Without entry before the requested position, start at the beginning of the file.
+    TSFileIndex::Entry entry;
+    bool found = false;
+    if (_start_pcr != INVALID_PCR) {
+        found = index.searchPCR(_start_pcr, entry);
+    }
+    else if (_start_time_of_day < 0) {
+        found = index.searchTime(_start_time, entry);
+    }
+    else {
+        // Time of day, relative to the first day in the index.
+        const Time first(index.firstTime());
+        if (first == Time::Epoch) {
+            report.error(u"no UTC time in time index of %s", {name});
+            return false;
+        }
+        Time start(first.thisDay() + _start_time_of_day);
+        if (start < first) {
+            start += MilliSecPerDay;
+        }
+        found = index.searchTime(start, entry);
+    }
+
+    offset = found ? entry.packet * index.packetSize() : 0;
+    report.debug(u"starting %s at packet %'d, offset %'d", {name, found ? entry.packet : 0, offset});
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Open one input file.
 //----------------------------------------------------------------------------
@@ -145,8 +232,14 @@ bool ts::TSFileInputArgs::openFile(size_t name_index, size_t file_index, Report&
     // Preset artificial stuffing.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
 
+    // With --start-pcr or --start-time, the start offset is computed from the time index.
+    uint64_t start_offset = _start_offset;
+    if ((_start_pcr != INVALID_PCR || _start_time != Time::Epoch || _start_time_of_day >= 0) && !indexedStartOffset(name, start_offset, report)) {
+        return false;
+    }
+
     // Actually open the file.
-    return _files[file_index].openRead(name, _repeat_count, _start_offset, report, _file_format);
+    return _files[file_index].openRead(name, _repeat_count, start_offset, report, _file_format);
 }
 
 
@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsTSFile.h"
+#include "tsTSFileIndex.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsDuckContext.h"
@@ -90,6 +91,9 @@ namespace ts {
         size_t              _current_file = 0;        // Current file index in _files. Depends on _interleave.
         size_t              _repeat_count = 1;
         uint64_t            _start_offset = 0;
+        uint64_t            _start_pcr = INVALID_PCR;    // Start at this PCR, using the time index.
+        Time                _start_time {};              // Start at this UTC time, using the time index.
+        MilliSecond         _start_time_of_day = -1;     // Start at this time of day, using the time index.
         size_t              _base_label = 0;
         TSPacketFormat      _file_format = TSPacketFormat::AUTODETECT;
         std::vector<fs::path> _filenames {};
@@ -98,6 +102,9 @@ namespace ts {
         std::set<size_t>    _eof {};                  // Set of file indexes having reached end of file.
         std::vector<TSFile> _files {};                // Array of open files, only one without interleave.
 
+        // Compute the start offset of a file from its time index.
+        bool indexedStartOffset(const fs::path& name, uint64_t& offset, Report& report) const;
+
         // Open one input file.
         bool openFile(size_t name_index, size_t file_index, Report& report);
 
@@ -49,6 +49,15 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
     args.option(u"append", 'a');
     args.help(u"append", u"If the file already exists, append to the end of the file. By default, existing files are overwritten.");
 
+    args.option(u"index");
+    args.help(u"index",
+              u"Build a time index of the output file while it is written. "
+              u"The index is a binary file with the same name as the output file plus a \".tsidx\" extension. "
+              u"It contains the packet positions of random access points or PCR's, about one per second, "
+              u"with their PCR and wall-clock time of recording. "
+              u"It can be used with the options --start-time and --start-pcr of the input file plugin "
+              u"to quickly seek into the file. See also the command tsindex.");
+
     args.option(u"keep", 'k');
     args.help(u"keep", u"Keep existing file (abort if the specified file already exists). By default, existing files are overwritten.");
 
@@ -114,6 +123,7 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_max_duration, u"max-duration", 0);
     _file_format = LoadTSPacketFormatOutputOption(args);
     _multiple_files = _max_size > 0 || _max_duration > 0;
+    _index = args.present(u"index");
 
     _flags = TSFile::WRITE | TSFile::SHARED;
     if (args.present(u"append")) {
@@ -131,6 +141,14 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"--max-duration and --max-size cannot be used on standard output");
         return false;
     }
+    if (_name.empty() && _index) {
+        args.error(u"--index cannot be used on standard output");
+        return false;
+    }
+    if (_index && _file_format == TSPacketFormat::COMPACT) {
+        args.error(u"--index cannot be used with the compact format");
+        return false;
+    }
 
     return true;
 }
@@ -188,8 +206,16 @@ bool ts::TSFileOutputArgs::openAndRetry(bool initial_wait, size_t& retry_allowed
         // Try to open the file.
         const fs::path name(_multiple_files ? _name_gen.newFileName() : _name);
         report.verbose(u"creating file %s", {name});
+        const uint64_t previous_size = _index && (_flags & TSFile::APPEND) != 0 && fs::exists(name) ? fs::file_size(name, &ErrCodeReport()) : 0;
         const bool success = _file.open(name, _flags, report, _file_format);
 
+        // Start the time index of the file. An index error is not an error on the file.
+        if (success && _index) {
+            const size_t packet_size = _file.packetHeaderSize() + PKT_SIZE + _file.packetTrailerSize();
+            _index_base = previous_size / packet_size;
+            _indexer.open(TSFileIndex::IndexFileName(name), packet_size, previous_size > 0, report);
+        }
+
         // Remember the list of created files if we need to limit their number.
         if (success && _multiple_files && _max_files > 0) {
             _current_files.push_back(name);
@@ -227,6 +253,7 @@ bool ts::TSFileOutputArgs::openAndRetry(bool initial_wait, size_t& retry_allowed
 bool ts::TSFileOutputArgs::closeAndCleanup(Report& report)
 {
     // Close the current file.
+    _indexer.close();
     if (_file.isOpen() && !_file.close(report)) {
         return false;
     }
@@ -247,6 +274,9 @@ bool ts::TSFileOutputArgs::closeAndCleanup(Report& report)
             // Failed to delete, keep it to retry later.
             failed_delete.push_back(name);
         }
+        else if (_index) {
+            fs::remove(TSFileIndex::IndexFileName(name), &ErrCodeReport());
+        }
     }
 
     // Re-insert files we failed to delete at head of list so that we will retry to delete them next time.
@@ -284,6 +314,14 @@ bool ts::TSFileOutputArgs::write(const TSPacket* buffer, const TSPacketMetadata*
         const size_t written = std::min(size_t(_file.writePacketsCount() - where), packet_count);
         _current_size += written * PKT_SIZE;
 
+        // Index the written packets using the wall-clock time.
+        if (_indexer.isOpen()) {
+            const Time now(Time::CurrentUTC());
+            for (size_t i = 0; i < written; ++i) {
+                _indexer.feedPacket(buffer[i], _index_base + where + i, now);
+            }
+        }
+
         // In case of success or no retry, return now.
         if (success || !_reopen || (abort != nullptr && abort->aborting())) {
             return success;
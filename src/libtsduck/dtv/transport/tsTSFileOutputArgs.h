@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsTSFile.h"
+#include "tsTSFileIndexer.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsFileNameGenerator.h"
@@ -98,6 +99,7 @@ namespace ts {
         Second            _max_duration = 0;
         size_t            _max_files = 0;
         bool              _multiple_files = false;
+        bool              _index = false;
 
         // Working data:
         TSFile            _file {};
@@ -105,6 +107,8 @@ namespace ts {
         uint64_t          _current_size = 0;
         Time              _next_open_time {};
         UStringList       _current_files {};
+        TSFileIndexer     _indexer {};
+        PacketCounter     _index_base = 0;    // Index of first written packet in current file (with --append).
 
         // Open the file, retry on error if necessary.
         // Use max number of retries. Updated with remaining number of retries.
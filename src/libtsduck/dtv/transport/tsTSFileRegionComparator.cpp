@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileRegionComparator.h"
+#include "tsByteBlock.h"
+#include "tsSafePtr.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Thread which compares one chunk.
+//----------------------------------------------------------------------------
+
+class ts::TSFileRegionComparator::Worker: public Thread
+{
+    TS_NOBUILD_NOCOPY(Worker);
+public:
+    // Constructor: compare count packets at the specified byte offsets.
+    // The index is the rank of the chunk in the round. The comparison is aborted when
+    // a difference is found in a chunk with a lower rank, as reported in first_diff.
+    Worker(size_t index, std::atomic<size_t>& first_diff, const fs::path& name0, uint64_t offset0, const fs::path& name1, uint64_t offset1, PacketCounter count);
+    virtual ~Worker() override;
+
+    // Result: number of identical packets from the start of the chunk, count of these packets per PID.
+    PacketCounter              equal_count = 0;
+    std::vector<PacketCounter> pid_count;
+
+private:
+    size_t               _index;
+    std::atomic<size_t>& _first_diff;
+    fs::path             _name0;
+    fs::path             _name1;
+    uint64_t             _offset0;
+    uint64_t             _offset1;
+    PacketCounter        _count;
+
+    // Count identical packets per PID.
+    void countPIDs(const uint8_t* data, size_t count);
+
+    // Report a difference in this chunk to the other threads.
+    void setDifference();
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+// Constructor.
+ts::TSFileRegionComparator::Worker::Worker(size_t index, std::atomic<size_t>& first_diff, const fs::path& name0, uint64_t offset0, const fs::path& name1, uint64_t offset1, PacketCounter count) :
+    pid_count(PID_MAX, 0),
+    _index(index),
+    _first_diff(first_diff),
+    _name0(name0),
+    _name1(name1),
+    _offset0(offset0),
+    _offset1(offset1),
+    _count(count)
+{
+}
+
+// Destructor.
+ts::TSFileRegionComparator::Worker::~Worker()
+{
+    waitForTermination();
+}
+
+// Count identical packets per PID.
+void ts::TSFileRegionComparator::Worker::countPIDs(const uint8_t* data, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, data += PKT_SIZE) {
+        pid_count[GetUInt16(data + 1) & 0x1FFF]++;
+    }
+    equal_count += count;
+}
+
+// Report a difference in this chunk to the other threads.
+void ts::TSFileRegionComparator::Worker::setDifference()
+{
+    size_t first = _first_diff.load();
+    while (_index < first && !_first_diff.compare_exchange_weak(first, _index)) {
+    }
+}
+
+// Thread main code.
+void ts::TSFileRegionComparator::Worker::main()
+{
+    std::ifstream file0(_name0, std::ios::in | std::ios::binary);
+    std::ifstream file1(_name1, std::ios::in | std::ios::binary);
+    file0.seekg(std::streamoff(_offset0));
+    file1.seekg(std::streamoff(_offset1));
+
+    const size_t block_packets = size_t(std::min<PacketCounter>(BLOCK_PACKETS, _count));
+    ByteBlock data0(block_packets * PKT_SIZE);
+    ByteBlock data1(block_packets * PKT_SIZE);
+
+    // Chunks after a difference are useless, stop as soon as a previous chunk differs.
+    while (equal_count < _count && _first_diff.load(std::memory_order_relaxed) > _index) {
+        // Read a block of packets in each file, compare the packets which are present in both files.
+        const size_t count = size_t(std::min<PacketCounter>(block_packets, _count - equal_count));
+        const size_t size = count * PKT_SIZE;
+        file0.read(reinterpret_cast<char*>(data0.data()), std::streamsize(size));
+        file1.read(reinterpret_cast<char*>(data1.data()), std::streamsize(size));
+        const size_t available = size_t(std::min(file0.gcount(), file1.gcount())) / PKT_SIZE;
+
+        // Compare the complete block first, which is the most frequent case.
+        if (available == count && std::memcmp(data0.data(), data1.data(), size) == 0) {
+            countPIDs(data0.data(), count);
+        }
+        else {
+            // Locate the first differing packet. Also stop on read error or truncated file.
+            size_t same = 0;
+            while (same < available && std::memcmp(data0.data() + same * PKT_SIZE, data1.data() + same * PKT_SIZE, PKT_SIZE) == 0) {
+                same++;
+            }
+            countPIDs(data0.data(), same);
+            setDifference();
+            break;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::TSFileRegionComparator::TSFileRegionComparator(size_t threads, PacketCounter chunk_packets) :
+    _threads(std::max<size_t>(1, threads)),
+    _chunk_packets(std::max<PacketCounter>(1, chunk_packets))
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Count the number of identical packets at the start of two regions.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::TSFileRegionComparator::compare(const fs::path& file0, uint64_t offset0, const fs::path& file1, uint64_t offset1, PacketCounter max_count, std::vector<PacketCounter>* pid_count) const
+{
+    if (pid_count != nullptr) {
+        pid_count->assign(PID_MAX, 0);
+    }
+
+    // Compare by rounds of one chunk per thread, until a difference is found.
+    PacketCounter equal_count = 0;
+    bool same = true;
+    while (same && equal_count < max_count) {
+        std::atomic<size_t> first_diff(_threads);
+        std::vector<SafePtr<Worker, ts::null_mutex>> workers;
+        std::vector<PacketCounter> counts;
+        for (size_t i = 0; i < _threads && equal_count + i * _chunk_packets < max_count; ++i) {
+            const PacketCounter first = equal_count + i * _chunk_packets;
+            counts.push_back(std::min<PacketCounter>(_chunk_packets, max_count - first));
+            workers.push_back(new Worker(i, first_diff, file0, offset0 + first * PKT_SIZE, file1, offset1 + first * PKT_SIZE, counts.back()));
+            workers.back()->start();
+        }
+        // Collect results in order, stop at the first difference.
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i]->waitForTermination();
+            if (same) {
+                equal_count += workers[i]->equal_count;
+                if (pid_count != nullptr) {
+                    for (size_t pid = 0; pid < PID_MAX; ++pid) {
+                        (*pid_count)[pid] += workers[i]->pid_count[pid];
+                    }
+                }
+                same = workers[i]->equal_count == counts[i];
+            }
+        }
+    }
+    return equal_count;
+}
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Parallel comparison of identical regions in two transport stream files.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTS.h"
+#include "tsThread.h"
+
+namespace ts {
+    //!
+    //! Parallel comparison of identical regions in two transport stream files.
+    //! @ingroup mpeg
+    //!
+    //! The two files must contain raw 188-byte TS packets from the specified offsets.
+    //! The files are compared by rounds. In each round, each thread compares one chunk
+    //! of consecutive packets, by large blocks. The comparison stops at the first
+    //! differing packet. The threads which compare chunks after a difference abort
+    //! as soon as the difference is found.
+    //!
+    class TSDUCKDLL TSFileRegionComparator
+    {
+        TS_NOCOPY(TSFileRegionComparator);
+    public:
+        //!
+        //! Default number of threads.
+        //!
+        static constexpr size_t DEFAULT_THREADS = 4;
+        //!
+        //! Default number of packets per thread and per round.
+        //!
+        static constexpr PacketCounter DEFAULT_CHUNK_PACKETS = 65536;
+        //!
+        //! Maximum number of packets per read operation.
+        //!
+        static constexpr size_t BLOCK_PACKETS = 4096;
+
+        //!
+        //! Constructor.
+        //! @param [in] threads Number of threads which compare chunks in parallel.
+        //! @param [in] chunk_packets Number of packets per thread and per round.
+        //!
+        TSFileRegionComparator(size_t threads = DEFAULT_THREADS, PacketCounter chunk_packets = DEFAULT_CHUNK_PACKETS);
+
+        //!
+        //! Count the number of identical packets at the start of two regions of two files.
+        //! @param [in] file0 Name of the first file.
+        //! @param [in] offset0 Byte offset of the region in the first file.
+        //! @param [in] file1 Name of the second file.
+        //! @param [in] offset1 Byte offset of the region in the second file.
+        //! @param [in] max_count Maximum number of packets to compare.
+        //! @param [out] pid_count If not null, receive the number of identical packets per PID.
+        //! The vector is resized to PID_MAX elements.
+        //! @return The number of identical packets from the start of the two regions. When it is
+        //! lower than @a max_count, the next packet is different or cannot be read in one file.
+        //!
+        PacketCounter compare(const fs::path& file0, uint64_t offset0, const fs::path& file1, uint64_t offset1, PacketCounter max_count, std::vector<PacketCounter>* pid_count = nullptr) const;
+
+    private:
+        size_t        _threads;
+        PacketCounter _chunk_packets;
+
+        // Thread which compares one chunk.
+        class Worker;
+    };
+}
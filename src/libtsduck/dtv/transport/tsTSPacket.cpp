@@ -1030,6 +1030,19 @@ namespace {
         }
         return str;
     }
+
+    // Hexadecimal dump, directly formatted in UTF-8, without intermediate UTF-16 string.
+    std::string dumpString(const void* data, size_t size, uint32_t flags, size_t indent = 0, size_t line_width = ts::UString::DEFAULT_HEXA_LINE_WIDTH)
+    {
+        std::string str;
+        ts::UString::AppendDump(str, data, size, flags, indent, line_width);
+        return str;
+    }
+
+    std::string dumpString(const ts::ByteBlock& data, uint32_t flags, size_t indent, size_t line_width)
+    {
+        return dumpString(data.data(), data.size(), flags, indent, line_width);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -1049,7 +1062,7 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
 
     // Filter invalid packets
     if (!hasValidSync()) {
-        strm << margin << "**** INVALID PACKET ****" << std::endl;
+        strm << margin << "**** INVALID PACKET ****" << '\n';
         flags = (flags & 0x0000FFFF) | DUMP_RAW;
     }
 
@@ -1065,7 +1078,7 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
         if (flags & DUMP_TS_HEADER) {
             strm << UString::Format(u"PID: 0x%X, PUSI: %d, ", {getPID(), getPUSI()});
         }
-        strm << UString::Dump(display_data, display_size, flags & 0x0000FFFF) << std::endl;
+        strm << dumpString(display_data, display_size, flags & 0x0000FFFF) << '\n';
         return strm;
     }
 
@@ -1078,23 +1091,23 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
 
     // Display TS header
     if (flags & DUMP_TS_HEADER) {
-        strm << margin << "---- TS Header ----" << std::endl
-             << margin << UString::Format(u"PID: %d (0x%X), header size: %d, sync: 0x%X", {getPID(), getPID(), header_size, b[0]}) << std::endl
-             << margin << "Error: " << getTEI() << ", unit start: " << getPUSI() << ", priority: " << getPriority() << std::endl
-             << margin << "Scrambling: " << int(getScrambling()) << ", continuity counter: " << int(getCC()) << std::endl
+        strm << margin << "---- TS Header ----" << '\n'
+             << margin << UString::Format(u"PID: %d (0x%X), header size: %d, sync: 0x%X", {getPID(), getPID(), header_size, b[0]}) << '\n'
+             << margin << "Error: " << getTEI() << ", unit start: " << getPUSI() << ", priority: " << getPriority() << '\n'
+             << margin << "Scrambling: " << int(getScrambling()) << ", continuity counter: " << int(getCC()) << '\n'
              << margin << "Adaptation field: " << UString::YesNo(hasAF()) << " (" << getAFSize() << " bytes)"
-             << ", payload: " << UString::YesNo(hasPayload()) << " (" << getPayloadSize() << " bytes)" << std::endl;
+             << ", payload: " << UString::YesNo(hasPayload()) << " (" << getPayloadSize() << " bytes)" << '\n';
 
         // Without explicit adaptation field analysis, just display the most important info from AF.
         if (hasAF() && !(flags & DUMP_AF)) {
             strm << margin << "Discontinuity: " << getDiscontinuityIndicator()
                  << ", random access: " << getRandomAccessIndicator()
-                 << ", ES priority: " << getESPI() << std::endl;
+                 << ", ES priority: " << getESPI() << '\n';
             if (hasSpliceCountdown()) {
-                strm << margin << "Splice countdown: " << int(getSpliceCountdown()) << std::endl;
+                strm << margin << "Splice countdown: " << int(getSpliceCountdown()) << '\n';
             }
             if (pcr != INVALID_PCR || opcr != INVALID_PCR) {
-                strm << margin << timeStampsString(pcr, opcr) << std::endl;
+                strm << margin << timeStampsString(pcr, opcr) << '\n';
             }
         }
     }
@@ -1102,23 +1115,23 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
     // Display adaptation field.
     size_t afsize = getAFSize();
     if (hasAF() && (flags & DUMP_AF) && afsize > 1) {
-        strm << margin << "---- Adaptation field (" << afsize << " bytes) ----" << std::endl;
+        strm << margin << "---- Adaptation field (" << afsize << " bytes) ----" << '\n';
         if (4 + afsize > PKT_SIZE) {
-            strm << margin << "*** invalid adaptation field size" << std::endl;
+            strm << margin << "*** invalid adaptation field size" << '\n';
             afsize = PKT_SIZE - 4;
         }
         // Deserialization buffer over AF payload (skip initial length field).
         Buffer buf(b + 5, afsize - 1);
         strm << margin << "Discontinuity: " << int(buf.getBit());
         strm << ", random access: " << int(buf.getBit());
-        strm << ", ES priority: " << int(buf.getBit()) << std::endl;
+        strm << ", ES priority: " << int(buf.getBit()) << '\n';
         const bool PCR_flag = buf.getBool();
         const bool OPCR_flag = buf.getBool();
         const bool splicing_point_flag = buf.getBool();
         const bool transport_private_data_flag = buf.getBool();
         const bool adaptation_field_extension_flag = buf.getBool();
         if (pcr != INVALID_PCR || opcr != INVALID_PCR) {
-            strm << margin << timeStampsString(pcr, opcr) << std::endl;
+            strm << margin << timeStampsString(pcr, opcr) << '\n';
         }
         if (PCR_flag) {
             buf.skipBits(48);
@@ -1127,13 +1140,13 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
             buf.skipBits(48);
         }
         if (splicing_point_flag && buf.canReadBits(8)) {
-            strm << margin << "Splice countdown: " << int(buf.getUInt8()) << std::endl;
+            strm << margin << "Splice countdown: " << int(buf.getUInt8()) << '\n';
         }
         if (transport_private_data_flag && buf.canReadBits(8)) {
             buf.pushReadSizeFromLength(8);
-            strm << margin << "Private data (" << buf.remainingReadBytes() << " bytes): " << std::endl;
+            strm << margin << "Private data (" << buf.remainingReadBytes() << " bytes): " << '\n';
             if (buf.canRead()) {
-                strm << UString::Dump(buf.getBytes(), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
+                strm << dumpString(buf.getBytes(), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
             }
             buf.popState();
         }
@@ -1146,36 +1159,36 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
             buf.skipBits(4);
             if (ltw_flag && buf.canReadBits(16)) {
                 strm << margin << "LTW valid: " << int(buf.getBit());
-                strm << ", offset: " << UString::Decimal(buf.getBits<uint16_t>(15)) << std::endl;
+                strm << ", offset: " << UString::Decimal(buf.getBits<uint16_t>(15)) << '\n';
             }
             if (piecewise_rate_flag && buf.canReadBits(24)) {
                 buf.skipBits(2);
-                strm << margin << "Piecewise rate: " << UString::Decimal(buf.getBits<uint16_t>(22)) << std::endl;
+                strm << margin << "Piecewise rate: " << UString::Decimal(buf.getBits<uint16_t>(22)) << '\n';
             }
             if (seamless_splice_flag && buf.canReadBits(40)) {
-                strm << margin << "Splice type: " << buf.getBits<int>(4) << std::endl;
+                strm << margin << "Splice type: " << buf.getBits<int>(4) << '\n';
                 uint64_t dts_next_au = buf.getBits<uint64_t>(3) << 30;
                 buf.skipBits(1);
                 dts_next_au |= buf.getBits<uint64_t>(15) << 15;
                 buf.skipBits(1);
                 dts_next_au |= buf.getBits<uint64_t>(15);
                 buf.skipBits(1);
-                strm << UString::Format(u"DTS next AU: 0x%09X", {dts_next_au}) << std::endl;
+                strm << UString::Format(u"DTS next AU: 0x%09X", {dts_next_au}) << '\n';
             }
             if (!af_descriptor_not_present_flag) {
-                strm << margin << "AF descriptors (" << buf.remainingReadBytes() << " bytes): " << std::endl;
+                strm << margin << "AF descriptors (" << buf.remainingReadBytes() << " bytes): " << '\n';
                 while (buf.canReadBytes(2)) {
-                    strm << margin << "- Tag: " << NameFromDTV(u"ts.af_descriptor_tag", buf.getUInt8(), NamesFlags::FIRST) << std::endl;
+                    strm << margin << "- Tag: " << NameFromDTV(u"ts.af_descriptor_tag", buf.getUInt8(), NamesFlags::FIRST) << '\n';
                     const size_t len = buf.getUInt8();
-                    strm << margin << "  Length: " << len << " bytes" << std::endl
-                         << UString::Dump(buf.getBytes(len), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
+                    strm << margin << "  Length: " << len << " bytes" << '\n'
+                         << dumpString(buf.getBytes(len), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
                 }
             }
             buf.popState();
         }
         if (buf.canRead()) {
-            strm << margin << "Stuffing (" << buf.remainingReadBytes() << " bytes): " << std::endl
-                 << UString::Dump(buf.getBytes(), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
+            strm << margin << "Stuffing (" << buf.remainingReadBytes() << " bytes): " << '\n'
+                 << dumpString(buf.getBytes(), UString::HEXA | UString::ASCII | UString::OFFSET | UString::BPL, margin.size() + 2, 16);
         }
     }
 
@@ -1183,13 +1196,13 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
     if (startPES() && (flags & DUMP_PES_HEADER)) {
         uint8_t sid = b[header_size + 3];
         uint16_t length = GetUInt16(b + header_size + 4);
-        strm << margin << "---- PES Header ----" << std::endl
-             << margin << "Stream id: " << NameFromDTV(u"pes.stream_id", sid, NamesFlags::FIRST) << std::endl
+        strm << margin << "---- PES Header ----" << '\n'
+             << margin << "Stream id: " << NameFromDTV(u"pes.stream_id", sid, NamesFlags::FIRST) << '\n'
              << margin << "PES packet length: " << length;
         if (length == 0) {
             strm << " (unbounded)";
         }
-        strm << std::endl;
+        strm << '\n';
         if (dts != INVALID_DTS || pts != INVALID_PTS) {
             strm << margin;
             if (dts != INVALID_DTS) {
@@ -1219,20 +1232,20 @@ std::ostream& ts::TSPacket::display(std::ostream& strm, uint32_t flags, size_t i
                     strm << ")";
                 }
             }
-            strm << std::endl;
+            strm << '\n';
         }
     }
 
     // Display full packet or payload in hexa
     if (flags & (DUMP_RAW | DUMP_PAYLOAD)) {
         if (flags & DUMP_RAW) {
-            strm << margin << "---- Full TS Packet Content ----" << std::endl;
+            strm << margin << "---- Full TS Packet Content ----" << '\n';
         }
         else {
-            strm << margin << "---- TS Packet Payload (" << payload_size << " bytes) ----" << std::endl;
+            strm << margin << "---- TS Packet Payload (" << payload_size << " bytes) ----" << '\n';
         }
         // The 16 LSB contains flags for Hexa.
-        strm << UString::Dump(display_data, display_size, flags & 0x0000FFFF, indent);
+        strm << dumpString(display_data, display_size, flags & 0x0000FFFF, indent);
     }
 
     return strm;
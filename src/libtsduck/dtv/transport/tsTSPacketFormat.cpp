@@ -20,6 +20,7 @@ const ts::Enumeration ts::TSPacketFormatEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"compact",    ts::TSPacketFormat::COMPACT},
 });
 
 const ts::Enumeration ts::TSPacketFormatInputEnum({
@@ -28,6 +29,7 @@ const ts::Enumeration ts::TSPacketFormatInputEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"compact",    ts::TSPacketFormat::COMPACT},
 });
 
 const ts::Enumeration ts::TSPacketFormatOutputEnum({
@@ -35,6 +37,7 @@ const ts::Enumeration ts::TSPacketFormatOutputEnum({
     {u"M2TS",       ts::TSPacketFormat::M2TS},
     {u"RS204",      ts::TSPacketFormat::RS204},
     {u"duck",       ts::TSPacketFormat::DUCK},
+    {u"compact",    ts::TSPacketFormat::COMPACT},
 });
 
 
@@ -66,7 +69,9 @@ void ts::DefineTSPacketFormatOutputOption(Args& args, UChar short_name, const UC
     args.option(name, short_name, TSPacketFormatOutputEnum);
     args.help(name, u"name",
               u"Specify the format of the output TS file. "
-              u"By default, the format is a standard TS file.");
+              u"By default, the format is a standard TS file. "
+              u"The format \"compact\" stores runs of stuffing packets as counts and keeps the packet metadata. "
+              u"It is recommended for long recordings of multiplexes with a lot of stuffing.");
 }
 
 ts::TSPacketFormat ts::LoadTSPacketFormatOutputOption(const Args& args, const UChar* name)
@@ -38,6 +38,22 @@ void ts::TSPacketStream::resetPacketStream(TSPacketFormat format, AbstractReadSt
     _writer = writer;
     _last_timestamp = 0;
     _trail_size = 0;
+    _compact_wheader = false;
+    rewindPacketStream();
+}
+
+
+//----------------------------------------------------------------------------
+// Notify that the reader was repositioned at the beginning of the stream.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketStream::rewindPacketStream()
+{
+    _compact_rheader = false;
+    _compact_type = 0;
+    _compact_remain = 0;
+    _pending.clear();
+    _pending_index = 0;
 }
 
 
@@ -53,6 +69,7 @@ size_t ts::TSPacketStream::packetHeaderSize() const
         case TSPacketFormat::M2TS:       return 4;
         case TSPacketFormat::RS204:      return 0;
         case TSPacketFormat::DUCK:       return TSPacketMetadata::SERIALIZATION_SIZE;
+        case TSPacketFormat::COMPACT:    return 0;
         default:                         return 0;
     }
 }
@@ -65,6 +82,7 @@ size_t ts::TSPacketStream::packetTrailerSize() const
         case TSPacketFormat::M2TS:       return 0;
         case TSPacketFormat::RS204:      return RS_SIZE;
         case TSPacketFormat::DUCK:       return 0;
+        case TSPacketFormat::COMPACT:    return 0;
         default:                         return 0;
     }
 }
@@ -94,9 +112,34 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
     if (_format == TSPacketFormat::AUTODETECT) {
 
         // Read one packet.
-        if (!_reader->readStreamComplete(buffer, PKT_SIZE, read_size, report) || read_size < PKT_SIZE) {
+        const bool read_ok = _reader->readStreamComplete(buffer, PKT_SIZE, read_size, report);
+
+        // A compact stream starts with its own header and can be shorter than one packet.
+        if (read_ok && read_size >= COMPACT_HEADER_SIZE && std::memcmp(buffer->b, "TSDC", 4) == 0) {
+            _format = TSPacketFormat::COMPACT;
+            if (buffer->b[4] != COMPACT_VERSION) {
+                report.error(u"unsupported compact TS format version %d", {buffer->b[4]});
+                return 0;
+            }
+            _compact_rheader = true;
+            _pending.copy(buffer->b + COMPACT_HEADER_SIZE, read_size - COMPACT_HEADER_SIZE);
+            _pending_index = 0;
+            report.debug(u"detected TS file format %s", {packetFormatString()});
+        }
+        else if (!read_ok || read_size < PKT_SIZE) {
             return 0; // less than one packet in that file
         }
+    }
+
+    // The compact format is record-based, not packet-based.
+    if (_format == TSPacketFormat::COMPACT) {
+        read_packets = readCompactPackets(buffer, metadata, max_packets, report);
+        _total_read += read_packets;
+        return read_packets;
+    }
+
+    // Autodetect from the first packet.
+    if (_format == TSPacketFormat::AUTODETECT) {
 
         // Metadata for first packet (if there is a header).
         TSPacketMetadata mdata;
@@ -164,7 +207,8 @@ size_t ts::TSPacketStream::readPackets(TSPacket *buffer, TSPacketMetadata *metad
     while (success && max_packets > 0 && !_reader->endOfStream()) {
 
         switch (_format) {
-            case TSPacketFormat::AUTODETECT: {
+            case TSPacketFormat::AUTODETECT:
+            case TSPacketFormat::COMPACT: {
                 // Should not get there.
                 assert(false);
                 return 0;
@@ -317,6 +361,10 @@ bool ts::TSPacketStream::writePackets(const TSPacket *buffer, const TSPacketMeta
             }
             break;
         }
+        case TSPacketFormat::COMPACT: {
+            success = writeCompactPackets(buffer, metadata, packet_count, report);
+            break;
+        }
         default: {
             report.error(u"internal error, invalid TS file format %s", {packetFormatString()});
             return false;
@@ -325,3 +373,212 @@ bool ts::TSPacketStream::writePackets(const TSPacket *buffer, const TSPacketMeta
 
     return success;
 }
+
+
+//----------------------------------------------------------------------------
+// Compact format: check if a packet can be stored in a stuffing record.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketStream::IsCompactStuffing(const TSPacket& pkt)
+{
+    // Null PID, payload only, all payload bytes are identical.
+    return pkt.b[1] == 0x1F && pkt.b[2] == 0xFF && (pkt.b[3] & 0x30) == 0x10 && std::memcmp(pkt.b + 4, pkt.b + 5, PKT_SIZE - 5) == 0;
+}
+
+bool ts::TSPacketStream::SameCompactStuffing(const TSPacket& pkt1, const TSPacket& pkt2)
+{
+    // Both packets are assumed to be valid stuffing: same header and same payload byte.
+    return std::memcmp(pkt1.b, pkt2.b, 5) == 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Compact format: read data, starting with data from auto-detection.
+// Set eof when the end of stream is reached before the first byte.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketStream::readCompact(void* data, size_t size, bool& eof, Report& report)
+{
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    size_t done = 0;
+    eof = false;
+
+    // Use pending data first.
+    if (_pending_index < _pending.size()) {
+        done = std::min(size, _pending.size() - _pending_index);
+        std::memcpy(bytes, _pending.data() + _pending_index, done);
+        _pending_index += done;
+        if (_pending_index >= _pending.size()) {
+            _pending.clear();
+            _pending_index = 0;
+        }
+    }
+
+    // Then read from the stream. Errors are reported by the reader, end of stream is checked below.
+    if (done < size) {
+        size_t read_size = 0;
+        _reader->readStreamComplete(bytes + done, size - done, read_size, report);
+        done += read_size;
+    }
+
+    if (done == 0 && size > 0) {
+        eof = true;
+        return false;
+    }
+    else if (done < size) {
+        report.error(u"truncated compact TS stream");
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Compact format: read packets.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketStream::readCompactPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report)
+{
+    size_t read_packets = 0;
+    bool eof = false;
+
+    // Read and check the stream header when the format was not auto-detected.
+    if (!_compact_rheader) {
+        uint8_t header[COMPACT_HEADER_SIZE];
+        if (!readCompact(header, sizeof(header), eof, report)) {
+            return 0;
+        }
+        if (std::memcmp(header, "TSDC", 4) != 0 || header[4] != COMPACT_VERSION) {
+            report.error(u"invalid compact TS stream header");
+            return 0;
+        }
+        _compact_rheader = true;
+    }
+
+    uint8_t mdata[TSPacketMetadata::SERIALIZATION_SIZE];
+    while (read_packets < max_packets) {
+
+        // Read next record header when the current one is exhausted.
+        if (_compact_remain == 0) {
+            if (!readCompact(&_compact_type, 1, eof, report)) {
+                break;
+            }
+            uint8_t rec[9];
+            if (_compact_type == COMPACT_DATA && readCompact(rec, 2, eof, report)) {
+                _compact_remain = GetUInt16(rec);
+            }
+            else if (_compact_type == COMPACT_STUFFING && readCompact(rec, 9, eof, report)) {
+                _compact_remain = GetUInt32(rec);
+                std::memcpy(_compact_stuffing.b, rec + 4, 4);
+                std::memset(_compact_stuffing.b + 4, rec[8], PKT_SIZE - 4);
+            }
+            else {
+                if (_compact_type != COMPACT_DATA && _compact_type != COMPACT_STUFFING) {
+                    report.error(u"invalid record type 0x%X in compact TS stream", {_compact_type});
+                }
+                else if (eof) {
+                    report.error(u"truncated compact TS stream");
+                }
+                break;
+            }
+            continue;
+        }
+
+        // Read one packet from the current record.
+        if (!readCompact(mdata, sizeof(mdata), eof, report)) {
+            if (eof) {
+                report.error(u"truncated compact TS stream");
+            }
+            break;
+        }
+        if (_compact_type == COMPACT_STUFFING) {
+            *buffer = _compact_stuffing;
+        }
+        else if (!readCompact(buffer, PKT_SIZE, eof, report)) {
+            if (eof) {
+                report.error(u"truncated compact TS stream");
+            }
+            break;
+        }
+        if (metadata != nullptr) {
+            metadata->deserialize(mdata, sizeof(mdata));
+            metadata++;
+        }
+        buffer++;
+        read_packets++;
+        _compact_remain--;
+    }
+
+    return read_packets;
+}
+
+
+//----------------------------------------------------------------------------
+// Compact format: write packets.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketStream::writeCompactPackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report)
+{
+    size_t written_size = 0;
+
+    // Write the stream header first.
+    if (!_compact_wheader) {
+        uint8_t header[COMPACT_HEADER_SIZE] = {'T', 'S', 'D', 'C', COMPACT_VERSION, 0, 0, 0};
+        if (!_writer->writeStream(header, sizeof(header), written_size, report)) {
+            return false;
+        }
+        _compact_wheader = true;
+    }
+
+    // Build complete records in memory, write each record in one operation.
+    const TSPacketMetadata default_mdata;
+    ByteBlock rec;
+    size_t index = 0;
+    while (index < packet_count) {
+
+        // Find the end of the current run of packets.
+        const bool stuffing = IsCompactStuffing(buffer[index]);
+        size_t end = index + 1;
+        if (stuffing) {
+            while (end < packet_count && IsCompactStuffing(buffer[end]) && SameCompactStuffing(buffer[index], buffer[end])) {
+                end++;
+            }
+        }
+        else {
+            while (end < packet_count && end - index < COMPACT_MAX_DATA_COUNT && !IsCompactStuffing(buffer[end])) {
+                end++;
+            }
+        }
+        const size_t count = end - index;
+
+        // Build the record.
+        rec.clear();
+        if (stuffing) {
+            rec.reserve(10 + count * TSPacketMetadata::SERIALIZATION_SIZE);
+            rec.appendUInt8(COMPACT_STUFFING);
+            rec.appendUInt32(uint32_t(count));
+            rec.append(buffer[index].b, 5);
+        }
+        else {
+            rec.reserve(3 + count * (TSPacketMetadata::SERIALIZATION_SIZE + PKT_SIZE));
+            rec.appendUInt8(COMPACT_DATA);
+            rec.appendUInt16(uint16_t(count));
+        }
+        for (size_t i = index; i < end; ++i) {
+            const size_t pos = rec.size();
+            rec.resize(pos + TSPacketMetadata::SERIALIZATION_SIZE);
+            (metadata != nullptr ? metadata[i] : default_mdata).serialize(rec.data() + pos, TSPacketMetadata::SERIALIZATION_SIZE);
+            if (!stuffing) {
+                rec.append(buffer[i].b, PKT_SIZE);
+            }
+        }
+
+        // Write the record.
+        if (!_writer->writeStream(rec.data(), rec.size(), written_size, report)) {
+            return false;
+        }
+        _total_write += count;
+        index = end;
+    }
+    return true;
+}
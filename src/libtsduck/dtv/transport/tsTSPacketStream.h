@@ -18,6 +18,7 @@
 #include "tsTSPacketMetadata.h"
 #include "tsTSPacket.h"
 #include "tsEnumeration.h"
+#include "tsByteBlock.h"
 
 namespace ts {
 
@@ -94,6 +95,17 @@ namespace ts {
         //!
         static constexpr size_t MAX_TRAILER_SIZE = ts::RS_SIZE;
 
+        //!
+        //! Size in bytes of the stream header in compact format.
+        //! The stream header is "TSDC" followed by the format version (one byte) and 3 reserved bytes.
+        //!
+        static constexpr size_t COMPACT_HEADER_SIZE = 8;
+
+        //!
+        //! Maximum number of packets in one data record in compact format.
+        //!
+        static constexpr size_t COMPACT_MAX_DATA_COUNT = 0xFFFF;
+
         //!
         //! Get the packet header size, based on the packet format.
         //! This "header" comes before the classical 188-byte TS packet.
@@ -129,6 +141,18 @@ namespace ts {
         //!
         void resetPacketStream(TSPacketFormat format, AbstractReadStreamInterface* reader, AbstractWriteStreamInterface* writer);
 
+        //!
+        //! Notify that the reader was repositioned at the beginning of the stream.
+        //! With the compact format, the stream header is expected again.
+        //!
+        void rewindPacketStream();
+
+        //!
+        //! Notify that the writer appends to an existing non-empty stream.
+        //! With the compact format, the stream header is not written again.
+        //!
+        void appendPacketStream() { _compact_wheader = true; }
+
         PacketCounter _total_read = 0;   //!< Total read packets.
         PacketCounter _total_write = 0;  //!< Total written packets.
 
@@ -139,5 +163,28 @@ namespace ts {
         uint64_t _last_timestamp = 0;             // Last write time stamp in PCR units (M2TS files).
         size_t   _trail_size = 0;                 // Number of meaningful bytes in _trail
         uint8_t  _trail[MAX_TRAILER_SIZE+1] {};   // Transient buffer for auto-detection of trailer
+
+        // Compact format. The stream starts with a COMPACT_HEADER_SIZE-byte header. Then, each record starts with one type byte.
+        // - COMPACT_DATA: 2-byte packet count, then, for each packet, its serialized metadata and the 188-byte packet.
+        // - COMPACT_STUFFING: 4-byte packet count, 4-byte TS header and one payload byte, then the serialized metadata
+        //   of each packet. All packets have the same TS header and a 184-byte payload which is made of the same byte.
+        static constexpr uint8_t COMPACT_VERSION = 1;
+        static constexpr uint8_t COMPACT_DATA = 0x01;
+        static constexpr uint8_t COMPACT_STUFFING = 0x02;
+
+        bool      _compact_rheader = false;  // Compact stream header already read.
+        bool      _compact_wheader = false;  // Compact stream header already written.
+        uint8_t   _compact_type = 0;         // Type of current record on read.
+        size_t    _compact_remain = 0;       // Remaining packets in current record on read.
+        TSPacket  _compact_stuffing {};      // Stuffing packet of current record on read.
+        ByteBlock _pending {};               // Data read during auto-detection and not yet used.
+        size_t    _pending_index = 0;        // Index of next byte to read in _pending.
+
+        // Compact format implementation.
+        static bool IsCompactStuffing(const TSPacket& pkt);
+        static bool SameCompactStuffing(const TSPacket& pkt1, const TSPacket& pkt2);
+        bool readCompact(void* data, size_t size, bool& eof, Report& report);
+        size_t readCompactPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report);
+        bool writeCompactPackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report);
     };
 }
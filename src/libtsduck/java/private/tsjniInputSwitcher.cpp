@@ -131,6 +131,16 @@ TSDUCKJNI jboolean JNICALL Java_io_tsduck_InputSwitcher_start(JNIEnv* env, jobje
     args.terminate = ts::jni::GetBoolField(env, obj, "terminate");
     args.fastSwitch = ts::jni::GetBoolField(env, obj, "fastSwitch");
     args.delayedSwitch = ts::jni::GetBoolField(env, obj, "delayedSwitch");
+    args.hotStandby = ts::jni::GetBoolField(env, obj, "hotStandby");
+    const ts::UString sync(ts::jni::GetStringField(env, obj, "switchSync"));
+    if (!sync.empty()) {
+        const int value = ts::InputSwitcherArgs::SwitchSyncNames.value(sync);
+        if (value == ts::Enumeration::UNKNOWN) {
+            isw->report().error(u"invalid switch synchronization \"%s\"", {sync});
+            return false;
+        }
+        args.switchSync = ts::InputSwitcherArgs::SwitchSync(value);
+    }
     args.reusePort = ts::jni::GetBoolField(env, obj, "reusePort");
     args.firstInput = size_t(std::max<jint>(0, ts::jni::GetIntField(env, obj, "firstInput")));
     const jint primaryInput = ts::jni::GetIntField(env, obj, "firstInput");
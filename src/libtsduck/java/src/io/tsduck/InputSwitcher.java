@@ -24,6 +24,8 @@ public final class InputSwitcher extends PluginEventHandlerRegistry {
      */
     public boolean fastSwitch = false;     //!< Fast switch between input plugins.
     public boolean delayedSwitch = false;  //!< Delayed switch between input plugins.
+    public boolean hotStandby = false;     //!< Lock-free switch in the output thread (implies fastSwitch).
+    public String switchSync = "packet";   //!< With hotStandby, switch synchronization point: "packet", "pat-pmt" or "random-access".
     public boolean terminate = false;      //!< Terminate when one input plugin completes.
     public boolean reusePort = false;      //!< Reuse-port socket option.
     public int firstInput = 0;             //!< Index of first input plugin.
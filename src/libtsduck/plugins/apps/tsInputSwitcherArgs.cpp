@@ -9,6 +9,12 @@
 #include "tsInputSwitcherArgs.h"
 #include "tsArgsWithPlugins.h"
 
+const ts::Enumeration ts::InputSwitcherArgs::SwitchSyncNames({
+    {u"packet",        int(SwitchSync::PACKET)},
+    {u"pat-pmt",       int(SwitchSync::PAT_PMT)},
+    {u"random-access", int(SwitchSync::RANDOM_ACCESS)},
+});
+
 
 //----------------------------------------------------------------------------
 // Enforce default or minimum values.
@@ -27,6 +33,7 @@ void ts::InputSwitcherArgs::enforceDefaults()
         receiveTimeout = DEFAULT_RECEIVE_TIMEOUT;
     }
 
+    fastSwitch = fastSwitch || hotStandby;
     firstInput = std::min(firstInput, inputs.size() - 1);
     bufferedPackets = std::max(bufferedPackets, MIN_BUFFERED_PACKETS);
     maxInputPackets = std::max(maxInputPackets, MIN_INPUT_PACKETS);
@@ -114,6 +121,14 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
               u"Specify the index of the first input plugin to start. "
               u"By default, the first plugin (index 0) is used.");
 
+    args.option(u"hot-standby");
+    args.help(u"hot-standby",
+              u"Keep all input plugins running and switch in the output thread, at a packet boundary, without lock. "
+              u"Each input plugin writes in its own lock-free buffer. The output thread sends the packets of the "
+              u"current input plugin and drops the packets from the other ones. This is typically used with redundant "
+              u"live inputs (1+1 contribution links) where the switch latency must be minimal. "
+              u"The latency of each switch is reported in verbose mode. This option implies --fast-switch.");
+
     args.option(u"infinite", 'i');
     args.help(u"infinite", u"Infinitely repeat the cycle through all input plugins in sequence.");
 
@@ -158,6 +173,17 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
               u"If an optional address is specified, it must be a local IP address of the system. "
               u"By default, there is no remote control.");
 
+    args.option(u"switch-sync", 0, SwitchSyncNames);
+    args.help(u"switch-sync", u"name",
+              u"With --hot-standby, specify where the output switches in the stream of the new input plugin. "
+              u"With \"packet\", the switch occurs at the next received packet. "
+              u"With \"pat-pmt\", the output switches at the start of the next PAT in the new input plugin, "
+              u"when the start of a PMT from this PAT is received before the next PAT. "
+              u"With \"random-access\", the output switches at the next packet with the random access indicator "
+              u"set in its adaptation field (typically the start of an intra-coded video frame). "
+              u"Until then, the output continues on the previous input plugin. "
+              u"The default is \"packet\".");
+
     args.option(u"terminate", 't');
     args.help(u"terminate", u"Terminate execution when the current input plugin terminates.");
 
@@ -174,8 +200,10 @@ void ts::InputSwitcherArgs::defineArgs(Args& args)
 bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
 {
     appName = args.appName();
-    fastSwitch = args.present(u"fast-switch");
+    hotStandby = args.present(u"hot-standby");
+    fastSwitch = hotStandby || args.present(u"fast-switch");
     delayedSwitch = args.present(u"delayed-switch");
+    args.getIntValue(switchSync, u"switch-sync", SwitchSync::PACKET);
     terminate = args.present(u"terminate");
     args.getIntValue(cycleCount, u"cycle", args.present(u"infinite") ? 0 : 1);
     args.getIntValue(bufferedPackets, u"buffer-packets", DEFAULT_BUFFERED_PACKETS);
@@ -200,7 +228,10 @@ bool ts::InputSwitcherArgs::loadArgs(DuckContext& duck, Args& args)
         args.error(u"options --cycle, --infinite and --terminate are mutually exclusive");
     }
     if (fastSwitch && delayedSwitch) {
-        args.error(u"options --delayed-switch and --fast-switch are mutually exclusive");
+        args.error(u"options --delayed-switch and --fast-switch (or --hot-standby) are mutually exclusive");
+    }
+    if (!hotStandby && args.present(u"switch-sync")) {
+        args.error(u"option --switch-sync requires --hot-standby");
     }
 
     // Resolve all allowed remote.
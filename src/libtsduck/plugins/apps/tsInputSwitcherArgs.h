@@ -14,6 +14,7 @@
 #pragma once
 #include "tsPluginOptions.h"
 #include "tsIPv4SocketAddress.h"
+#include "tsEnumeration.h"
 
 namespace ts {
 
@@ -27,9 +28,25 @@ namespace ts {
     class TSDUCKDLL InputSwitcherArgs
     {
     public:
+        //!
+        //! Alignment of the switch point in the new input plugin, with hot standby.
+        //!
+        enum class SwitchSync {
+            PACKET,         //!< Switch at the next packet.
+            PAT_PMT,        //!< Switch at the start of the next PAT which is followed by a PMT.
+            RANDOM_ACCESS,  //!< Switch at the next packet with the random access indicator.
+        };
+
+        //!
+        //! Names of the SwitchSync values, as used in the command line option --switch-sync.
+        //!
+        static const Enumeration SwitchSyncNames;
+
         UString             appName {};            //!< Application name, for help messages.
         bool                fastSwitch = false;    //!< Fast switch between input plugins.
         bool                delayedSwitch = false; //!< Delayed switch between input plugins.
+        bool                hotStandby = false;    //!< Lock-free fast switch in the output thread (implies fastSwitch).
+        SwitchSync          switchSync = SwitchSync::PACKET; //!< Alignment of the switch point with hot standby.
         bool                terminate = false;     //!< Terminate when one input plugin completes.
         bool                reusePort = false;     //!< Reuse-port socket option.
         size_t              firstInput = 0;        //!< Index of first input plugin.
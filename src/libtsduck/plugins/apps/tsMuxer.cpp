@@ -57,7 +57,7 @@ bool ts::Muxer::start(const MuxerArgs& args)
     }
 
     // Allocate a muxer core object.
-    _core = new tsmux::Core(args, *this, _report);
+    _core = new tsmux::Core(_args, *this, _report);
     CheckNonNull(_core);
     return _core->start();
 }
@@ -50,6 +50,24 @@ void ts::TSProcessor::cleanupInternal()
         proc->setAbort();
         proc->waitForTermination();
     } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
+    for (auto br : _branch_outputs) {
+        proc = br;
+        do {
+            proc->setAbort();
+            proc->waitForTermination();
+        } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != br);
+    }
+
+    // Deallocate parallel output branches and their packet processors.
+    for (auto br : _branch_outputs) {
+        while (!br->ringAlone()) {
+            proc = br->ringNext<tsp::PluginExecutor>();
+            proc->ringRemove();
+            delete proc;
+        }
+        delete br;
+    }
+    _branch_outputs.clear();
 
     // Deallocate all plugin executors.
     bool last = false;
@@ -74,6 +92,14 @@ void ts::TSProcessor::cleanupInternal()
         delete _metadata_buffer;
         _metadata_buffer = nullptr;
     }
+    for (auto buf : _branch_buffers) {
+        delete buf;
+    }
+    for (auto buf : _branch_metadata) {
+        delete buf;
+    }
+    _branch_buffers.clear();
+    _branch_metadata.clear();
 }
 
 
@@ -112,7 +138,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _global_mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, *this, _args.output, _args.plugins.size() + 1, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -121,12 +147,30 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::True || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _global_mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, _args.plugins[i], i + 1, ThreadAttributes(), _global_mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
         }
 
+        // Additional output plugins are not part of the ring. They are parallel branches of the main output
+        // plugin. Each of them is preceded by its specific packet processors, if any, in a separate ring.
+        size_t plugin_index = _args.plugins.size() + 2;
+        for (size_t i = 0; i < _args.branch_outputs.size(); ++i) {
+            const size_t proc_count = i < _args.branch_plugins.size() ? _args.branch_plugins[i].size() : 0;
+            tsp::OutputExecutor* br = new tsp::OutputExecutor(_args, *this, _args.branch_outputs[i], plugin_index + proc_count, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
+            CheckNonNull(br);
+            _branch_outputs.push_back(br);
+            realtime = realtime || br->isRealTime();
+            for (size_t j = 0; j < proc_count; ++j) {
+                tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, _args.branch_plugins[i][j], plugin_index++, ThreadAttributes(), _global_mutex, &_report);
+                CheckNonNull(p);
+                p->ringInsertBefore(br);
+                realtime = realtime || p->isRealTime();
+            }
+            plugin_index++;
+        }
+
         // Check if realtime defaults are explicitly disabled.
         if (_args.realtime == Tristate::False) {
             realtime = false;
@@ -155,6 +199,17 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
                 return false;
             }
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
+        for (auto br : _branch_outputs) {
+            proc = br;
+            do {
+                proc->setRealTimeForAll(realtime);
+                if (!proc->plugin()->getOptions()) {
+                    _report.debug(u"getOptions() error in plugin %s", {proc->pluginName()});
+                    cleanupInternal();
+                    return false;
+                }
+            } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != br);
+        }
 
         // Allocate a memory-resident buffer of TS packets
         _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
@@ -170,6 +225,22 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
         CheckNonNull(_metadata_buffer);
 
+        // Attach the parallel branches to the main output. A branch with packet processors needs private buffers
+        // to get a copy of the packets. They have the same size as the global buffers, packets use the same index.
+        for (auto br : _branch_outputs) {
+            PacketBuffer* buffer = nullptr;
+            PacketMetadataBuffer* metadata = nullptr;
+            if (!br->ringAlone()) {
+                buffer = new PacketBuffer(_packet_buffer->count());
+                CheckNonNull(buffer);
+                metadata = new PacketMetadataBuffer(_packet_buffer->count());
+                CheckNonNull(metadata);
+            }
+            _branch_buffers.push_back(buffer);
+            _branch_metadata.push_back(metadata);
+            _output->addBranch(br->ringNext<tsp::PluginExecutor>(), buffer, metadata);
+        }
+
         // End of locked section.
     }
 
@@ -182,6 +253,15 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
             return false;
         }
     }
+    for (auto br : _branch_outputs) {
+        for (tsp::PluginExecutor* proc = br->ringPrevious<tsp::PluginExecutor>(); proc != br; proc = proc->ringPrevious<tsp::PluginExecutor>()) {
+            if (!proc->plugin()->start()) {
+                _report.debug(u"start() error in plugin %s", {proc->pluginName()});
+                cleanupInternal();
+                return false;
+            }
+        }
+    }
 
     // Initialize packet buffer in the ring of executors.
     // Exit application in case of error.
@@ -198,12 +278,25 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         cleanupInternal();
         return false;
     }
+    for (auto br : _branch_outputs) {
+        if (!br->plugin()->start()) {
+            _report.debug(u"start() error in output plugin %s", {br->pluginName()});
+            cleanupInternal();
+            return false;
+        }
+    }
 
     // Start all plugin executors threads.
     tsp::PluginExecutor* proc = _input;
     do {
         proc->start();
     } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
+    for (auto br : _branch_outputs) {
+        proc = br;
+        do {
+            proc->start();
+        } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != br);
+    }
 
     // Create a control server thread. Display but ignore errors (not a fatal error).
     _control = new tsp::ControlServer(_args, _report, _global_mutex, _input);
@@ -259,6 +352,12 @@ void ts::TSProcessor::waitForTermination()
         do {
             proc->waitForTermination();
         } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != _input);
+        for (auto br : _branch_outputs) {
+            proc = br;
+            do {
+                proc->waitForTermination();
+            } while ((proc = proc->ringNext<tsp::PluginExecutor>()) != br);
+        }
 
         // Make sure the control server thread is terminated before deleting plugins.
         _control->close();
@@ -93,9 +93,12 @@ namespace ts {
         TSProcessorArgs       _args {};                    // Processing options.
         tsp::InputExecutor*   _input = nullptr;            // Input processor execution thread.
         tsp::OutputExecutor*  _output = nullptr;           // Output processor execution thread.
+        std::vector<tsp::OutputExecutor*> _branch_outputs {};  // Additional output processors, parallel branches of _output, each in the ring of its specific processors.
         tsp::ControlServer*   _control = nullptr;          // TSP control command server thread.
         PacketBuffer*         _packet_buffer = nullptr;    // Global TS packet buffer.
         PacketMetadataBuffer* _metadata_buffer = nullptr;  // Global packet metabata buffer.
+        std::vector<PacketBuffer*> _branch_buffers {};     // Private TS packet buffers of parallel branches with packet processors (null if none).
+        std::vector<PacketMetadataBuffer*> _branch_metadata {};  // Private packet metabata buffers of parallel branches.
 
         // Deallocate and cleanup internal resources.
         void cleanupInternal();
@@ -213,12 +213,46 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     if (pargs != nullptr) {
         pargs->getPlugin(input, PluginType::INPUT, u"file");
         pargs->getPlugin(output, PluginType::OUTPUT, u"file");
-        pargs->getPlugins(plugins, PluginType::PROCESSOR);
+        PluginOptionsVector all_plugins;
+        pargs->getPlugins(all_plugins, PluginType::PROCESSOR);
+        // All output plugins after the first one are parallel branches.
+        pargs->getPlugins(branch_outputs, PluginType::OUTPUT);
+        if (!branch_outputs.empty()) {
+            branch_outputs.erase(branch_outputs.begin());
+        }
+        // The packet processors which are placed between two output plugins are specific to the second one.
+        // All other packet processors, before the first output or after the last one, are common to all outputs.
+        std::vector<PluginType> types;
+        pargs->getPluginTypes(types);
+        plugins.clear();
+        branch_plugins.clear();
+        size_t proc_index = 0;
+        size_t out_count = 0;
+        PluginOptionsVector pending;
+        for (auto type : types) {
+            if (type == PluginType::PROCESSOR && proc_index < all_plugins.size()) {
+                pending.push_back(all_plugins[proc_index++]);
+            }
+            else if (type == PluginType::OUTPUT) {
+                if (out_count++ == 0) {
+                    plugins.insert(plugins.end(), pending.begin(), pending.end());
+                }
+                else {
+                    branch_plugins.push_back(pending);
+                }
+                pending.clear();
+            }
+        }
+        // Trailing processors and default ones from the configuration file.
+        plugins.insert(plugins.end(), pending.begin(), pending.end());
+        plugins.insert(plugins.end(), all_plugins.begin() + proc_index, all_plugins.end());
     }
     else {
         input.set(u"file");
         output.set(u"file");
         plugins.clear();
+        branch_outputs.clear();
+        branch_plugins.clear();
     }
 
     // Get default options for TSDuck contexts in each plugin.
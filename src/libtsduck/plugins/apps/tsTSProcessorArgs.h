@@ -54,6 +54,8 @@ namespace ts {
         PluginOptions          input {};            //!< Input plugin description.
         PluginOptionsVector    plugins {};          //!< Packet processor plugins descriptions.
         PluginOptions          output {};           //!< Output plugin description.
+        PluginOptionsVector    branch_outputs {};   //!< Additional output plugins, receiving the same packets as @a output.
+        std::vector<PluginOptionsVector> branch_plugins {}; //!< Packet processor plugins which are specific to each additional output, index by index. Missing entries mean no specific processor.
 
         static constexpr size_t DEFAULT_BUFFER_SIZE = 16 * 1000000;               //!< Default size in bytes of global TS buffer.
         static constexpr size_t MIN_BUFFER_SIZE = 18800;                          //!< Minimum size in bytes of global TS buffer.
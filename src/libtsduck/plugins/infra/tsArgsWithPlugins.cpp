@@ -169,6 +169,7 @@ bool ts::ArgsWithPlugins::analyze(const UString& app_name, const UStringVector&
 {
     // Clear plugins.
     _plugins.clear();
+    _plugin_types.clear();
 
     // Process redirections.
     ts::UStringVector args(arguments);
@@ -206,6 +207,7 @@ bool ts::ArgsWithPlugins::analyze(const UString& app_name, const UStringVector&
 
         // Record plugin name and parameters.
         options.resize(options.size() + 1);
+        _plugin_types.push_back(plugin_type);
         PluginOptions& opt(options[options.size() - 1]);
         opt.name = args[plugin_index + 1];
         opt.args.clear();
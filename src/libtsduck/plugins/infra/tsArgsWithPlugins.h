@@ -82,6 +82,14 @@ namespace ts {
         //!
         void getPlugins(PluginOptionsVector& plugins, PluginType type) const;
 
+        //!
+        //! Get the types of all plugins in their order on the command line, after command line analysis.
+        //! This is used to find the relative position of plugins of different types.
+        //! Default plugins which are loaded from the configuration file are not included.
+        //! @param [out] types Returned types of all plugins which are specified on the command line.
+        //!
+        void getPluginTypes(std::vector<PluginType>& types) const { types = _plugin_types; }
+
     private:
         const size_t _min_inputs;
         const size_t _max_inputs;
@@ -90,6 +98,7 @@ namespace ts {
         const size_t _min_outputs;
         const size_t _max_outputs;
         std::map<PluginType,PluginOptionsVector> _plugins {};
+        std::vector<PluginType> _plugin_types {};  // Types of all plugins in command line order.
 
         // Non-virtual version of setSyntax(), can be called in constructor.
         void setDirectSyntax(const UString& syntax);
@@ -11,6 +11,10 @@
 #include "tsAlgorithm.h"
 #include "tsCerrReport.h"
 #include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsEnvironment.h"
+#include "tsCRC32.h"
+#include "tsTime.h"
 
 TS_DEFINE_SINGLETON(ts::PluginRepository);
 
@@ -32,6 +36,7 @@ const ts::Enumeration ts::PluginRepository::ListProcessorEnum({
 
 ts::PluginRepository::PluginRepository()
 {
+    setIndexDirectory(UString());
 }
 
 
@@ -45,8 +50,10 @@ void ts::PluginRepository::registerInput(const UString& name, InputPluginFactory
     if (allocator != nullptr) {
         if (_inputPlugins[name] == nullptr) {
             _inputPlugins[name] = allocator;
+            registerFile(PluginType::INPUT, name, true);
         }
         else {
+            registerFile(PluginType::INPUT, name, false);
             CERR.debug(u"duplicated input plugin \"%s\" ignored", {name});
         }
     }
@@ -58,8 +65,10 @@ void ts::PluginRepository::registerProcessor(const UString& name, ProcessorPlugi
     if (allocator != nullptr) {
         if (_processorPlugins[name] == nullptr) {
             _processorPlugins[name] = allocator;
+            registerFile(PluginType::PROCESSOR, name, true);
         }
         else {
+            registerFile(PluginType::PROCESSOR, name, false);
             CERR.debug(u"duplicated packet processor plugin \"%s\" ignored", {name});
         }
     }
@@ -71,13 +80,25 @@ void ts::PluginRepository::registerOutput(const UString& name, OutputPluginFacto
     if (allocator != nullptr) {
         if (_outputPlugins[name] == nullptr) {
             _outputPlugins[name] = allocator;
+            registerFile(PluginType::OUTPUT, name, true);
         }
         else {
+            registerFile(PluginType::OUTPUT, name, false);
             CERR.debug(u"duplicated output plugin \"%s\" ignored", {name});
         }
     }
 }
 
+void ts::PluginRepository::registerFile(PluginType type, const UString& name, bool added)
+{
+    if (_loading) {
+        _loadRegistrations++;
+        if (added) {
+            _loadPlugins.push_back(std::make_pair(type, name));
+        }
+    }
+}
+
 ts::PluginRepository::Register::Register(const UString& name, InputPluginFactory allocator)
 {
     PluginRepository::Instance().registerInput(name, allocator);
@@ -99,18 +120,31 @@ ts::PluginRepository::Register::Register(const UString& name, OutputPluginFactor
 //----------------------------------------------------------------------------
 
 template<typename FACTORY>
-FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UString& plugin_type, const std::map<UString,FACTORY>& plugin_map, Report& report)
+FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, PluginType plugin_type, const std::map<UString,FACTORY>& plugin_map, Report& report)
 {
     // Search plugin in current cache.
     auto it = plugin_map.find(plugin_name);
 
-    // Load a shared library if not found and allowed.
+    // If not found and a plugin index describes it, directly load the right shared library.
+    if (it == plugin_map.end() && _sharedLibraryAllowed) {
+        loadIndex(report);
+        const auto& descs(_index[plugin_type]);
+        const auto desc = descs.find(plugin_name);
+        if (desc != descs.end() && !desc->second.file.empty()) {
+            loadPluginFile(desc->second.file, report);
+            it = plugin_map.find(plugin_name);
+        }
+    }
+
+    // Otherwise, search a shared library if allowed.
     if (it == plugin_map.end() && _sharedLibraryAllowed) {
         // Load shareable library. Use name resolution. Use permanent mapping to keep
         // the shareable image in memory after returning from this function. Also make
         // sure to include the plugin's directory in the shared library search path:
         // an extension may install a library in the same directory as the plugin.
+        startLoad();
         ApplicationSharedLibrary shlib(plugin_name, u"tsplugin_", PLUGINS_PATH_ENVIRONMENT_VARIABLE, SharedLibraryFlags::PERMANENT, report);
+        endLoad(shlib);
         if (shlib.isLoaded()) {
             // Search again if the shareable library was loaded.
             // The shareable library is supposed to register its plugins on initialization.
@@ -131,24 +165,24 @@ FACTORY ts::PluginRepository::getFactory(const UString& plugin_name, const UStri
         return it->second;
     }
     else {
-        report.error(u"%s plugin %s not found", {plugin_type, plugin_name});
+        report.error(u"%s plugin %s not found", {PluginTypeNames.name(int(plugin_type)), plugin_name});
         return nullptr;
     }
 }
 
 ts::PluginRepository::InputPluginFactory ts::PluginRepository::getInput(const UString& name, Report& report)
 {
-    return getFactory(name, u"input", _inputPlugins, report);
+    return getFactory(name, PluginType::INPUT, _inputPlugins, report);
 }
 
 ts::PluginRepository::ProcessorPluginFactory ts::PluginRepository::getProcessor(const UString& name, Report& report)
 {
-    return getFactory(name, u"processor", _processorPlugins, report);
+    return getFactory(name, PluginType::PROCESSOR, _processorPlugins, report);
 }
 
 ts::PluginRepository::OutputPluginFactory ts::PluginRepository::getOutput(const UString& name, Report& report)
 {
-    return getFactory(name, u"output", _outputPlugins, report);
+    return getFactory(name, PluginType::OUTPUT, _outputPlugins, report);
 }
 
 
@@ -199,6 +233,47 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Load a shared library, keep track of the plugins it registers.
+//----------------------------------------------------------------------------
+
+void ts::PluginRepository::startLoad()
+{
+    _loading = true;
+    _loadRegistrations = 0;
+    _loadPlugins.clear();
+}
+
+bool ts::PluginRepository::endLoad(const SharedLibrary& shlib)
+{
+    _loading = false;
+    if (!shlib.isLoaded()) {
+        return false;
+    }
+    // When the shared library was already loaded, nothing was registered. Its list of
+    // plugins is known only if it was previously loaded by this repository.
+    const UString file(shlib.fileName());
+    for (const auto& key : _loadPlugins) {
+        _pluginFiles[key] = file;
+    }
+    _loadPlugins.clear();
+    if (_loadRegistrations > 0) {
+        _knownFiles.insert(file);
+    }
+    return _knownFiles.find(file) != _knownFiles.end();
+}
+
+bool ts::PluginRepository::loadPluginFile(const UString& file, Report& report)
+{
+    // Permanent load.
+    startLoad();
+    SharedLibrary shlib(file, SharedLibraryFlags::PERMANENT, report);
+    const bool known = endLoad(shlib);
+    CERR.debug(u"loaded plugin file \"%s\", status: %s, known plugins: %s", {file, shlib.isLoaded(), known});
+    return known;
+}
+
+
 //----------------------------------------------------------------------------
 // Load all available tsp processors.
 //----------------------------------------------------------------------------
@@ -215,10 +290,197 @@ void ts::PluginRepository::loadAllPlugins(Report& report)
     ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", PLUGINS_PATH_ENVIRONMENT_VARIABLE);
 
     // Load all plugins, let them register their plugins.
-    for (size_t i = 0; i < files.size(); ++i) {
-        // Permanent load.
-        SharedLibrary shlib(files[i], SharedLibraryFlags::PERMANENT, report);
-        CERR.debug(u"loaded plugin file \"%s\", status: %s", {files[i], shlib.isLoaded()});
+    for (const auto& file : files) {
+        loadPluginFile(file, report);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Load all valid plugin index files, only once.
+//----------------------------------------------------------------------------
+
+void ts::PluginRepository::setIndexDirectory(const UString& dir)
+{
+    if (!dir.empty()) {
+        _indexDirectory = dir;
+    }
+    else {
+        // Default user-specific cache directory.
+#if defined(TS_WINDOWS)
+        UString root(GetEnvironment(u"LOCALAPPDATA"));
+        if (root.empty()) {
+            root = UserHomeDirectory();
+        }
+        _indexDirectory = root + u"\\tsduck";
+#elif defined(TS_MAC)
+        _indexDirectory = UserHomeDirectory() + u"/Library/Caches/tsduck";
+#else
+        UString root(GetEnvironment(u"XDG_CACHE_HOME"));
+        if (root.empty()) {
+            root = UserHomeDirectory() + u"/.cache";
+        }
+        _indexDirectory = root + u"/tsduck";
+#endif
+    }
+
+    // Forget the content of the previous index files.
+    _indexLoaded = false;
+    _index.clear();
+    _indexedFiles.clear();
+}
+
+ts::UString ts::PluginRepository::indexFileName(const UString& plugin_dir) const
+{
+    const std::string dir(plugin_dir.toUTF8());
+    return UString::Format(u"%s%ctsplugins-%08X.idx", {_indexDirectory, fs::path::preferred_separator, CRC32(dir.data(), dir.size()).value()});
+}
+
+void ts::PluginRepository::loadIndex(Report& report)
+{
+    if (!_indexLoaded) {
+        _indexLoaded = true;
+        UStringList dirs;
+        ApplicationSharedLibrary::GetSearchPath(dirs, PLUGINS_PATH_ENVIRONMENT_VARIABLE);
+        for (const auto& dir : dirs) {
+            if (fs::exists(indexFileName(dir), &ErrCodeReport()) && !loadIndexFile(dir, report)) {
+                CERR.debug(u"ignoring obsolete plugin index in %s", {dir});
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Names of plugin types in index files.
+//----------------------------------------------------------------------------
+
+namespace {
+    const ts::Enumeration IndexTypeNames({
+        {u"input",  ts::PluginType::INPUT},
+        {u"output", ts::PluginType::OUTPUT},
+        {u"packet", ts::PluginType::PROCESSOR},
+    });
+}
+
+
+//----------------------------------------------------------------------------
+// Load one plugin index file, return false if the index is invalid.
+//----------------------------------------------------------------------------
+
+bool ts::PluginRepository::loadIndexFile(const UString& dir, Report& report)
+{
+    const UString index_file(indexFileName(dir));
+
+    // The index must be more recent than the directory and all shared libraries in it.
+    const Time index_time(GetFileModificationTimeUTC(index_file));
+    if (GetFileModificationTimeUTC(dir) > index_time) {
+        return false;
+    }
+    UStringVector files;
+    ExpandWildcard(files, dir + fs::path::preferred_separator + u"tsplugin_*" + SHARED_LIBRARY_SUFFIX);
+    for (const auto& file : files) {
+        if (GetFileModificationTimeUTC(file) > index_time) {
+            return false;
+        }
+    }
+
+    // The first lines must contain the same TSDuck version and directory of plugins.
+    UStringVector lines;
+    if (!UString::Load(lines, index_file) || lines.size() < 2 || lines[0] != u"# TSDuck plugin index " + VersionInfo::GetVersion() || lines[1] != u"# directory " + dir) {
+        return false;
+    }
+
+    // Other lines: shared library or type, name, file, description, separated by tabs.
+    PluginIndex index;
+    std::set<UString> indexed_files;
+    for (size_t i = 2; i < lines.size(); ++i) {
+        UStringVector fields;
+        lines[i].split(fields, u'\t', false, false);
+        if (fields.size() == 2 && fields[0] == u"library" && !fields[1].empty()) {
+            indexed_files.insert(dir + fs::path::preferred_separator + fields[1]);
+            continue;
+        }
+        const int type = IndexTypeNames.value(fields.empty() ? UString() : fields[0], true, false);
+        if (fields.size() < 4 || type == Enumeration::UNKNOWN || fields[1].empty() || fields[2].empty()) {
+            report.debug(u"invalid line %d in %s", {i + 1, index_file});
+            return false;
+        }
+        PluginDesc& desc(index[PluginType(type)][fields[1]]);
+        desc.file = dir + fs::path::preferred_separator + fields[2];
+        desc.description = fields[3];
+        indexed_files.insert(desc.file);
+    }
+
+    // Valid index, merge it. In case of duplicates, the first directory in the search path wins.
+    CERR.debug(u"using plugin index %s", {index_file});
+    for (const auto& it1 : index) {
+        for (const auto& it2 : it1.second) {
+            _index[it1.first].insert(it2);
+        }
+    }
+    _indexedFiles.insert(indexed_files.begin(), indexed_files.end());
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Save the index file of one directory.
+//----------------------------------------------------------------------------
+
+void ts::PluginRepository::saveIndexFile(const UString& dir, const UStringList& libraries, const PluginIndex& index, Report& report)
+{
+    UStringList lines;
+    lines.push_back(u"# TSDuck plugin index " + VersionInfo::GetVersion());
+    lines.push_back(u"# directory " + dir);
+    for (const auto& lib : libraries) {
+        lines.push_back(u"library\t" + BaseName(lib));
+    }
+    for (const auto& it1 : index) {
+        for (const auto& it2 : it1.second) {
+            if (!it2.second.file.empty() && DirectoryName(it2.second.file) == dir) {
+                UString desc(it2.second.description);
+                desc.substitute(u"\t", u" ");
+                desc.substitute(u"\n", u" ");
+                lines.push_back(UString::Format(u"%s\t%s\t%s\t%s", {IndexTypeNames.name(int(it1.first)), it2.first, BaseName(it2.second.file), desc}));
+            }
+        }
+    }
+
+    // Failing to create an index is not an error, the index is only a cache.
+    const UString index_file(indexFileName(dir));
+    fs::create_directories(_indexDirectory, &ErrCodeReport());
+    if (UString::Save(lines, index_file)) {
+        report.debug(u"created plugin index %s", {index_file});
+    }
+    else {
+        report.debug(u"cannot create plugin index %s", {index_file});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Build the list of plugins of one type, from registered plugins and index.
+//----------------------------------------------------------------------------
+
+template<typename FACTORY>
+void ts::PluginRepository::buildDescriptions(PluginDescMap& descs, PluginType type, const std::map<UString,FACTORY>& plugin_map, TSP& tsp)
+{
+    // Registered plugins: instantiate them to get the description.
+    for (const auto& it : plugin_map) {
+        Plugin* p = it.second(&tsp);
+        PluginDesc& desc(descs[it.first]);
+        desc.description = p->getDescription();
+        const auto file = _pluginFiles.find(std::make_pair(type, it.first));
+        if (file != _pluginFiles.end()) {
+            desc.file = file->second;
+        }
+        delete p;
+    }
+
+    // Plugins from valid index files which are not loaded.
+    for (const auto& it : _index[type]) {
+        descs.insert(it);
     }
 }
 
@@ -233,43 +495,79 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
     UString out;
     out.reserve(5000);
 
-    // Load all shareable plugins first.
-    if (loadAll) {
-        loadAllPlugins(report);
+    // Load all shareable plugins first, except those which are described in a valid index.
+    // Keep track of the shared libraries of directories which need a new index. A directory
+    // cannot be indexed when one of its shared libraries was already loaded by other means.
+    std::map<UString, UStringList> unindexed_dirs;
+    std::set<UString> incomplete_dirs;
+    if (loadAll && _sharedLibraryAllowed) {
+        loadIndex(report);
+        UStringVector files;
+        ApplicationSharedLibrary::GetPluginList(files, u"tsplugin_", PLUGINS_PATH_ENVIRONMENT_VARIABLE);
+        for (const auto& file : files) {
+            const UString dir(DirectoryName(file));
+            if (_indexedFiles.find(file) == _indexedFiles.end()) {
+                unindexed_dirs[dir];
+                if (!loadPluginFile(file, report)) {
+                    incomplete_dirs.insert(dir);
+                }
+            }
+        }
+        // List all shared libraries of the directories to index, including the indexed ones.
+        for (const auto& file : files) {
+            const auto it = unindexed_dirs.find(DirectoryName(file));
+            if (it != unindexed_dirs.end()) {
+                it->second.push_back(file);
+            }
+        }
+    }
+
+    // A minimal TSP, used to build temporary plugins.
+    ReportTSP tsp(report);
+
+    // Collect the description of all plugins.
+    PluginIndex descs;
+    buildDescriptions(descs[PluginType::INPUT], PluginType::INPUT, _inputPlugins, tsp);
+    buildDescriptions(descs[PluginType::OUTPUT], PluginType::OUTPUT, _outputPlugins, tsp);
+    buildDescriptions(descs[PluginType::PROCESSOR], PluginType::PROCESSOR, _processorPlugins, tsp);
+
+    // Create an index in directories where all plugins were loaded.
+    for (const auto& it : unindexed_dirs) {
+        if (incomplete_dirs.find(it.first) == incomplete_dirs.end()) {
+            saveIndexFile(it.first, it.second, descs, report);
+        }
+        else {
+            report.debug(u"some plugins are unknown in %s, no plugin index created", {it.first});
+        }
     }
 
     // Compute max name width of all plugins.
     size_t name_width = 0;
     if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
         if ((flags & LIST_INPUT) != 0) {
-            for (const auto& it : _inputPlugins) {
+            for (const auto& it : descs[PluginType::INPUT]) {
                 name_width = std::max(name_width, it.first.width());
             }
         }
         if ((flags & LIST_PACKET) != 0) {
-            for (const auto& it : _processorPlugins) {
+            for (const auto& it : descs[PluginType::PROCESSOR]) {
                 name_width = std::max(name_width, it.first.width());
             }
         }
         if ((flags & LIST_OUTPUT) != 0) {
-            for (const auto& it : _outputPlugins) {
+            for (const auto& it : descs[PluginType::OUTPUT]) {
                 name_width = std::max(name_width, it.first.width());
             }
         }
     }
 
-    // A minimal TSP, used to build temporary plugins.
-    ReportTSP tsp(report);
-
     // List capabilities.
     if ((flags & LIST_INPUT) != 0) {
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp input plugins:\n\n";
         }
-        for (const auto& it : _inputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : descs[PluginType::INPUT]) {
+            ListOnePlugin(out, it.first, it.second.description, name_width, flags);
         }
     }
 
@@ -277,10 +575,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp output plugins:\n\n";
         }
-        for (const auto& it : _outputPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : descs[PluginType::OUTPUT]) {
+            ListOnePlugin(out, it.first, it.second.description, name_width, flags);
         }
     }
 
@@ -288,10 +584,8 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
         if ((flags & (LIST_COMPACT | LIST_NAMES)) == 0) {
             out += u"\nList of tsp packet processor plugins:\n\n";
         }
-        for (const auto& it : _processorPlugins) {
-            Plugin* p = it.second(&tsp);
-            ListOnePlugin(out, it.first, p, name_width, flags);
-            delete p;
+        for (const auto& it : descs[PluginType::PROCESSOR]) {
+            ListOnePlugin(out, it.first, it.second.description, name_width, flags);
         }
     }
 
@@ -303,7 +597,7 @@ ts::UString ts::PluginRepository::listPlugins(bool loadAll, Report& report, int
 // List one plugin.
 //----------------------------------------------------------------------------
 
-void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags)
+void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags)
 {
     if ((flags & LIST_NAMES) != 0) {
         out += name;
@@ -312,14 +606,14 @@ void ts::PluginRepository::ListOnePlugin(UString& out, const UString& name, Plug
     else if ((flags & LIST_COMPACT) != 0) {
         out += name;
         out += u":";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
     else {
         out += u"  ";
         out += name.toJustifiedLeft(name_width + 1, u'.', false, 1);
         out += u" ";
-        out += plugin->getDescription();
+        out += description;
         out += u"\n";
     }
 }
@@ -17,6 +17,7 @@
 #include "tsOutputPlugin.h"
 #include "tsReport.h"
 #include "tsSingleton.h"
+#include "tsSharedLibrary.h"
 #include "tsVersionInfo.h"
 
 namespace ts {
@@ -151,6 +152,39 @@ namespace ts {
         //!
         void loadAllPlugins(Report& report);
 
+        //!
+        //! Set the directory of the plugin index files.
+        //!
+        //! A plugin index is a cache which describes all plugins in the shared libraries of a
+        //! directory of plugins: name, type, shared library file and description. It is created by
+        //! listPlugins() in a user-specific cache directory after loading all shared libraries of a
+        //! directory of plugins. When a valid index exists, listing plugins does not load the shared
+        //! libraries of that directory and searching a plugin by name directly loads the right shared library.
+        //!
+        //! An index is valid when it was created by the same version of TSDuck for the same directory
+        //! of plugins and it is more recent than the directory and all plugin shared libraries in it.
+        //!
+        //! The default directory is @c $XDG_CACHE_HOME/tsduck or @c $HOME/.cache/tsduck on Linux and BSD,
+        //! @c $HOME/Library/Caches/tsduck on macOS, @c \%LOCALAPPDATA\%\\tsduck on Windows.
+        //! The already loaded index files are forgotten and the index files are reloaded from the
+        //! new directory when necessary.
+        //!
+        //! @param [in] dir Directory of the plugin index files. If empty, use the default directory.
+        //!
+        void setIndexDirectory(const UString& dir);
+
+        //!
+        //! Get the name of the plugin index file for a directory of plugins.
+        //! @param [in] plugin_dir Directory of plugins.
+        //! @return Name of the plugin index file in the directory of plugin index files.
+        //! The file name is built from a CRC32 of the directory of plugins. The first two lines of
+        //! the file are <code>\# TSDuck plugin index <i>version</i></code> and <code>\# directory <i>plugin_dir</i></code>.
+        //! All other lines contain tab-separated fields, either @c library followed by the base name of
+        //! a shared library in the directory, or the plugin type (@c input, @c output, @c packet), the
+        //! plugin name, the base name of its shared library and the plugin description.
+        //!
+        UString indexFileName(const UString& plugin_dir) const;
+
         //!
         //! Flags for listPlugins().
         //!
@@ -171,7 +205,8 @@ namespace ts {
         //!
         //! List all tsp processors.
         //! This function is typically used to implement the <code>tsp -\-list-processors</code> option.
-        //! @param [in] loadAll When true, all available plugins are loaded first.
+        //! @param [in] loadAll When true, all available plugins are loaded first. Shared libraries which
+        //! are described in a valid plugin index are not loaded, the index is used instead.
         //! Ignored when dynamic loading of plugins is disabled.
         //! @param [in,out] report Where to report errors.
         //! @param [in] flags List options, an or'ed mask of ListFlags values.
@@ -216,16 +251,60 @@ namespace ts {
         typedef std::map<UString, ProcessorPluginFactory> ProcessorMap;
         typedef std::map<UString, OutputPluginFactory>    OutputMap;
 
+        // Description of a plugin, from a plugin index or from a registered plugin.
+        class PluginDesc
+        {
+        public:
+            UString file {};         // Shared library file, empty if statically linked.
+            UString description {};  // Plugin description.
+        };
+        typedef std::map<UString, PluginDesc> PluginDescMap;  // Index: plugin name.
+        typedef std::map<PluginType, PluginDescMap> PluginIndex;
+
         bool         _sharedLibraryAllowed = true;
         InputMap     _inputPlugins {};
         ProcessorMap _processorPlugins {};
         OutputMap    _outputPlugins {};
+        UString      _indexDirectory {};     // Directory of plugin index files.
+        bool         _indexLoaded = false;
+        PluginIndex  _index {};              // Content of all valid plugin index files.
+        std::set<UString> _indexedFiles {};  // Shared libraries which are described in a valid index.
+        bool         _loading = false;       // A shared library is being loaded.
+        size_t       _loadRegistrations = 0; // Number of plugin registrations during the load, including duplicates.
+        std::vector<std::pair<PluginType, UString>> _loadPlugins {};         // New plugins which were registered during the load.
+        std::set<UString> _knownFiles {};    // Loaded shared libraries with a known list of plugins.
+        std::map<std::pair<PluginType, UString>, UString> _pluginFiles {};  // Shared library of each registered plugin.
 
         template<typename FACTORY>
-        FACTORY getFactory(const UString& name, const UString& type, const std::map<UString,FACTORY>&, Report&);
+        FACTORY getFactory(const UString& name, PluginType type, const std::map<UString,FACTORY>&, Report&);
+
+        // Load a shared library, keep track of the plugins it registers.
+        // Return true if the list of plugins in this shared library is known. This is not the case
+        // when the library was already loaded by other means: its plugins were registered before.
+        bool loadPluginFile(const UString& file, Report& report);
+
+        // Start and end the load of a shared library, keep track of the plugins it registers.
+        void startLoad();
+        bool endLoad(const SharedLibrary& shlib);
+
+        // Record the shared library of a plugin which is registered.
+        void registerFile(PluginType type, const UString& name, bool added);
+
+        // Load all valid plugin index files, only once.
+        void loadIndex(Report& report);
+
+        // Load one plugin index file, return false if the index is invalid.
+        bool loadIndexFile(const UString& dir, Report& report);
+
+        // Build the list of plugins of one type, from registered plugins and index.
+        template<typename FACTORY>
+        void buildDescriptions(PluginDescMap& descs, PluginType type, const std::map<UString,FACTORY>& plugin_map, TSP& tsp);
+
+        // Save the index file of one directory, with the specified shared libraries.
+        void saveIndexFile(const UString& dir, const UStringList& libraries, const PluginIndex& index, Report& report);
 
         // List one plugin.
-        static void ListOnePlugin(UString& out, const UString& name, Plugin* plugin, size_t name_width, int flags);
+        static void ListOnePlugin(UString& out, const UString& name, const UString& description, size_t name_width, int flags);
     };
 }
 
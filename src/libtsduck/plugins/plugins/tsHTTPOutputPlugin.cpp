@@ -9,10 +9,12 @@
 #include "tsHTTPOutputPlugin.h"
 #include "tsPluginRepository.h"
 #include "tsVersionString.h"
+#include "tsReportBuffer.h"
+#include "tsNullReport.h"
 
 TS_REGISTER_OUTPUT_PLUGIN(u"http", ts::HTTPOutputPlugin);
 
-#define SERVER_BACKLOG  1  // One connection at a time
+#define SERVER_BACKLOG  1  // One connection at a time (single client mode)
 
 
 //----------------------------------------------------------------------------
@@ -24,8 +26,9 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
 {
     setIntro(u"The implemented HTTP server is rudimentary. "
              u"No SSL/TLS is supported, only the http: protocol is accepted.\n\n"
-             u"Only one client is accepted at a time. "
-             u"By default, tsp terminates if the client disconnects (see option --multiple-clients).\n\n"
+             u"By default, only one client is accepted at a time and "
+             u"tsp terminates if the client disconnects (see option --multiple-clients). "
+             u"With option --max-clients, several clients are served simultaneously.\n\n"
              u"The request \"GET /\" returns the transport stream content. "
              u"All other requests are considered as invalid (see option --ignore-bad-request). "
              u"There is no Content-Length response header since the size of the returned TS is unknown. "
@@ -35,10 +38,31 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
     help(u"buffer-size",
          u"Specifies the TCP socket send buffer size to the client connection (socket option).");
 
+    option(u"client-queue-size", 0, POSITIVE);
+    help(u"client-queue-size", u"count",
+         u"With --max-clients, specify the maximum number of TS packets which are queued for each client. "
+         u"When a client is too slow to receive the packets, the queue fills up and "
+         u"new packets are dropped for this client (see also --disconnect-slow-clients). "
+         u"The default is " + UString::Decimal(DEFAULT_CLIENT_QUEUE_SIZE) + u" packets.");
+
+    option(u"disconnect-slow-clients");
+    help(u"disconnect-slow-clients",
+         u"With --max-clients, disconnect a client when its queue of packets is full. "
+         u"By default, packets are dropped for this client until its queue has some free space.");
+
     option(u"ignore-bad-request");
     help(u"ignore-bad-request",
          u"Ignore invalid HTTP requests and unconditionally send the transport stream.");
 
+    option(u"max-clients", 0, INTEGER, 0, 1, 1, 1000);
+    help(u"max-clients",
+         u"Specify the maximum number of simultaneous clients. "
+         u"When greater than 1, each client receives the same transport stream, starting when it connects. "
+         u"The packets are shared between clients, without copy, and sent to each client by a dedicated thread. "
+         u"The plugin never terminates when a client disconnects and "
+         u"the transport stream is dropped when there is no client. "
+         u"The default is 1, only one client at a time.");
+
     option(u"multiple-clients", 'm');
     help(u"multiple-clients",
          u"Specifies that the server handle multiple clients, one after the other. "
@@ -52,7 +76,7 @@ ts::HTTPOutputPlugin::HTTPOutputPlugin(TSP* tsp_) :
     help(u"server",
          u"Specifies the local TCP port on which the plugin listens for incoming HTTP connections. "
          u"This option is mandatory. "
-         u"This plugin accepts only one HTTP connection at a time. "
+         u"By default, this plugin accepts only one HTTP connection at a time (see option --max-clients). "
          u"When present, the optional address shall specify a local IP address or host name. "
          u"By default, the server listens on all local interfaces.");
 }
@@ -69,6 +93,9 @@ bool ts::HTTPOutputPlugin::getOptions()
     _ignore_bad_request = present(u"ignore-bad-request");
     getSocketValue(_server_address, u"server");
     getIntValue(_tcp_buffer_size, u"buffer-size");
+    getIntValue(_max_clients, u"max-clients", 1);
+    getIntValue(_client_queue_size, u"client-queue-size", DEFAULT_CLIENT_QUEUE_SIZE);
+    _disconnect_slow = present(u"disconnect-slow-clients");
     return true;
 }
 
@@ -85,11 +112,17 @@ bool ts::HTTPOutputPlugin::start()
     if (!_server.reusePort(_reuse_port, *tsp) ||
         (_tcp_buffer_size > 0 && !_server.setSendBufferSize(_tcp_buffer_size, *tsp)) ||
         !_server.bind(_server_address, *tsp) ||
-        !_server.listen(SERVER_BACKLOG, *tsp))
+        !_server.listen(_max_clients > 1 ? int(_max_clients) : SERVER_BACKLOG, *tsp))
     {
         _server.close(*tsp);
         return false;
     }
+
+    // In multiple clients mode, accept clients in a separate thread.
+    if (_max_clients > 1) {
+        _terminate = false;
+        _acceptor.start();
+    }
     return true;
 }
 
@@ -100,6 +133,27 @@ bool ts::HTTPOutputPlugin::start()
 
 bool ts::HTTPOutputPlugin::stop()
 {
+    // In multiple clients mode, closing the server forces the acceptor thread to terminate.
+    if (_max_clients > 1) {
+        _terminate = true;
+        _server.close(NULLREP);
+        _acceptor.waitForTermination();
+
+        // Request all sessions to terminate, then wait for them, without holding the mutex.
+        std::list<ClientPtr> clients;
+        {
+            std::lock_guard<std::mutex> lock(_clients_mutex);
+            clients.swap(_clients);
+        }
+        for (const auto& client : clients) {
+            client->stop();
+        }
+        for (const auto& client : clients) {
+            client->waitForTermination();
+        }
+        return true;
+    }
+
     if (_client.isConnected()) {
         _client.disconnect(*tsp);
     }
@@ -117,6 +171,10 @@ bool ts::HTTPOutputPlugin::stop()
 
 bool ts::HTTPOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
 {
+    if (_max_clients > 1) {
+        return sendMultiple(buffer, packet_count);
+    }
+
     // Loop over multiple clients if necessary.
     for (;;) {
         // Establish one client connection, if none is connected.
@@ -131,7 +189,7 @@ bool ts::HTTPOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata*
             tsp->verbose(u"client connected from %s", {client_address});
 
             // Initialize the session, process request, send response headers.
-            if (startSession()) {
+            if (startSession(_client)) {
                 // Session initialized, we can start sending data.
                 break;
             }
@@ -163,12 +221,12 @@ bool ts::HTTPOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata*
 // Send a response header.
 //----------------------------------------------------------------------------
 
-bool ts::HTTPOutputPlugin::sendResponseHeader(const std::string& line)
+bool ts::HTTPOutputPlugin::sendResponseHeader(TCPConnection& client, const std::string& line)
 {
     tsp->debug(u"response header: %s", {line});
     std::string data(line);
     data += "\r\n";
-    return _client.send(data.data(), data.size(), *tsp);
+    return client.send(data.data(), data.size(), *tsp);
 }
 
 
@@ -176,7 +234,7 @@ bool ts::HTTPOutputPlugin::sendResponseHeader(const std::string& line)
 // Process request headers, send response headers.
 //----------------------------------------------------------------------------
 
-bool ts::HTTPOutputPlugin::startSession()
+bool ts::HTTPOutputPlugin::startSession(TCPConnection& client)
 {
     UString request;
     UString header(1, SPACE); // Need an initial non-empty value
@@ -189,7 +247,7 @@ bool ts::HTTPOutputPlugin::startSession()
         const size_t previous = data.size();
         size_t ret_size = 0;
         data.resize(previous + 512);
-        if (!_client.receive(data.data() + previous, data.size() - previous, ret_size, nullptr, *tsp)) {
+        if (!client.receive(data.data() + previous, data.size() - previous, ret_size, nullptr, *tsp)) {
             return false; // receive error
         }
         data.resize(previous + ret_size);
@@ -221,17 +279,196 @@ bool ts::HTTPOutputPlugin::startSession()
 
     if (!valid && !_ignore_bad_request) {
         tsp->error(u"invalid client request: %s", {request});
-        sendResponseHeader(is_get ? "HTTP/1.1 404 Not Found" : "HTTP/1.1 400 Bad Request");
-        sendResponseHeader("");
+        sendResponseHeader(client, is_get ? "HTTP/1.1 404 Not Found" : "HTTP/1.1 400 Bad Request");
+        sendResponseHeader(client, "");
         return false;
     }
     else {
         // Send the HTTP response headers.
-        sendResponseHeader("HTTP/1.1 200 OK");
-        sendResponseHeader("Server: TSDuck/" TS_VERSION_STRING);
-        sendResponseHeader("Content-Type: video/mp2t");
-        sendResponseHeader("Connection: close");
-        sendResponseHeader("");
+        sendResponseHeader(client, "HTTP/1.1 200 OK");
+        sendResponseHeader(client, "Server: TSDuck/" TS_VERSION_STRING);
+        sendResponseHeader(client, "Content-Type: video/mp2t");
+        sendResponseHeader(client, "Connection: close");
+        sendResponseHeader(client, "");
         return true;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Send packets in multiple clients mode.
+//----------------------------------------------------------------------------
+
+bool ts::HTTPOutputPlugin::sendMultiple(const TSPacket* buffer, size_t packet_count)
+{
+    std::lock_guard<std::mutex> lock(_clients_mutex);
+
+    // Cleanup completed sessions.
+    for (auto it = _clients.begin(); it != _clients.end(); ) {
+        if ((*it)->completed()) {
+            it = _clients.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Without client, the packets are lost, this is not an error.
+    if (!_clients.empty() && packet_count > 0) {
+        // One single copy of the packets, shared by all clients.
+        const ChunkPtr chunk(new TSPacketVector(buffer, buffer + packet_count));
+        for (const auto& client : _clients) {
+            if (!client->enqueue(chunk)) {
+                tsp->verbose(u"client %s is too slow, disconnecting", {client->address});
+                client->stop();
+            }
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Thread which accepts incoming clients in multiple clients mode.
+//----------------------------------------------------------------------------
+
+ts::HTTPOutputPlugin::Acceptor::Acceptor(HTTPOutputPlugin* plugin) :
+    _plugin(plugin)
+{
+}
+
+void ts::HTTPOutputPlugin::Acceptor::main()
+{
+    TSP* const tsp = _plugin->tsp;
+    tsp->debug(u"client acceptor thread started");
+
+    // Get accept errors in a buffer since some errors are normal on termination.
+    ReportBuffer<ts::null_mutex> error(tsp->maxSeverity());
+
+    for (;;) {
+        ClientPtr client(new Client(_plugin));
+        if (!_plugin->_server.accept(client->connection, client->address, error)) {
+            break;
+        }
+        tsp->verbose(u"client connected from %s", {client->address});
+
+        // Count active sessions. Only this thread adds sessions, the count cannot increase
+        // after releasing the mutex. No network I/O is performed while holding the mutex.
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(_plugin->_clients_mutex);
+            for (const auto& cl : _plugin->_clients) {
+                count += cl->completed() ? 0 : 1;
+            }
+        }
+        if (count >= _plugin->_max_clients) {
+            tsp->warning(u"too many clients, rejecting client %s", {client->address});
+            _plugin->sendResponseHeader(client->connection, "HTTP/1.1 503 Service Unavailable");
+            _plugin->sendResponseHeader(client->connection, "");
+            client->connection.disconnect(NULLREP);
+            client->connection.close(NULLREP);
+        }
+        else if (client->start()) {
+            std::lock_guard<std::mutex> lock(_plugin->_clients_mutex);
+            _plugin->_clients.push_back(client);
+        }
+    }
+
+    // If termination was requested, accept error is not an error.
+    if (!_plugin->_terminate && !error.empty()) {
+        tsp->error(error.messages());
+    }
+    tsp->debug(u"client acceptor thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// One client session in multiple clients mode.
+//----------------------------------------------------------------------------
+
+ts::HTTPOutputPlugin::Client::Client(HTTPOutputPlugin* plugin) :
+    _plugin(plugin)
+{
+}
+
+ts::HTTPOutputPlugin::Client::~Client()
+{
+    stop();
+    waitForTermination();
+}
+
+bool ts::HTTPOutputPlugin::Client::enqueue(const ChunkPtr& chunk)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_terminate) {
+        return true;
+    }
+    if (!_queue.empty() && _queued_packets + chunk->size() > _plugin->_client_queue_size) {
+        // Queue overflow, slow client. A chunk which is larger than the queue size is always
+        // accepted in an empty queue, otherwise the client would never receive anything.
+        if (_plugin->_disconnect_slow) {
+            return false;
+        }
+        if (_dropped_packets == 0) {
+            _plugin->tsp->verbose(u"client %s is too slow, dropping packets", {address});
+        }
+        _dropped_packets += chunk->size();
+    }
+    else {
+        _queue.push_back(chunk);
+        _queued_packets += chunk->size();
+        _enqueued.notify_one();
+    }
+    return true;
+}
+
+void ts::HTTPOutputPlugin::Client::stop()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_terminate) {
+        _terminate = true;
+        // Shut down the socket to unlock a session thread which is blocked in send() or receive().
+        // The socket is closed by the session thread only, under the mutex, after the session.
+        if (!_closed) {
+            connection.disconnect(NULLREP);
+        }
+        _enqueued.notify_one();
+    }
+}
+
+void ts::HTTPOutputPlugin::Client::main()
+{
+    TSP* const tsp = _plugin->tsp;
+
+    // Initialize the session, process request, send response headers.
+    if (_plugin->startSession(connection)) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            // Wait for a chunk of packets or termination.
+            _enqueued.wait(lock, [this]() { return _terminate || !_queue.empty(); });
+            if (_terminate) {
+                break;
+            }
+            const ChunkPtr chunk(_queue.front());
+            _queue.pop_front();
+
+            // Send the packets without holding the mutex.
+            lock.unlock();
+            const bool ok = connection.send(chunk->data(), chunk->size() * PKT_SIZE, NULLREP);
+            lock.lock();
+            _queued_packets -= chunk->size();
+            if (!ok) {
+                break;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        connection.disconnect(NULLREP);
+        connection.close(NULLREP);
+        _closed = true;
+    }
+    tsp->verbose(u"client %s disconnected, %'d dropped packets", {address, _dropped_packets});
+    _completed = true;
+}
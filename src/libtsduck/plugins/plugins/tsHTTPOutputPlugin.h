@@ -15,6 +15,7 @@
 #include "tsOutputPlugin.h"
 #include "tsTCPServer.h"
 #include "tsTCPConnection.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
@@ -31,22 +32,94 @@ namespace ts {
         virtual bool stop() override;
         virtual bool send(const TSPacket*, const TSPacketMetadata*, size_t) override;
 
+        //!
+        //! Default maximum number of TS packets in the queue of each client with -\-max-clients.
+        //!
+        static constexpr size_t DEFAULT_CLIENT_QUEUE_SIZE = 10000;
+
     private:
+        // In multiple clients mode, TS packets are shared by all clients, without per-client copy.
+        typedef SafePtr<TSPacketVector, std::mutex> ChunkPtr;
+
+        // Thread which accepts incoming clients in multiple clients mode.
+        class Acceptor : public Thread
+        {
+            TS_NOBUILD_NOCOPY(Acceptor);
+        public:
+            // Constructor.
+            Acceptor(HTTPOutputPlugin* plugin);
+
+            // Invoked in the context of the server thread.
+            virtual void main() override;
+
+        private:
+            HTTPOutputPlugin* const _plugin;
+        };
+
+        // One client session, with its own sender thread, in multiple clients mode.
+        class Client : public Thread
+        {
+            TS_NOBUILD_NOCOPY(Client);
+        public:
+            // Constructor and destructor.
+            Client(HTTPOutputPlugin* plugin);
+            virtual ~Client() override;
+
+            // Client connection, before the thread is started.
+            TCPConnection     connection {};
+            IPv4SocketAddress address {};
+
+            // Queue a chunk of packets, apply the slow client policy.
+            // Return false if the client must be disconnected.
+            bool enqueue(const ChunkPtr& chunk);
+
+            // Request the termination of the session, does not wait (use waitForTermination()).
+            void stop();
+
+            // Check if the session is completed (the thread is terminated or terminating).
+            bool completed() const { return _completed; }
+
+            // Invoked in the context of the client thread.
+            virtual void main() override;
+
+        private:
+            HTTPOutputPlugin* const _plugin;
+            std::mutex              _mutex {};            // Protect the following fields.
+            std::condition_variable _enqueued {};         // Signaled when a chunk is enqueued or on termination.
+            std::deque<ChunkPtr>    _queue {};            // Chunks to send.
+            size_t                  _queued_packets = 0;  // Number of packets in _queue.
+            PacketCounter           _dropped_packets = 0; // Number of dropped packets.
+            bool                    _terminate = false;   // Termination request.
+            bool                    _closed = false;      // The connection is closed by the session thread.
+            volatile bool           _completed = false;   // Thread is completed or about to.
+        };
+        typedef SafePtr<Client, std::mutex> ClientPtr;
+
         // Command line options:
         IPv4SocketAddress _server_address {};
         bool              _reuse_port = false;
         bool              _multiple_clients = false;
         bool              _ignore_bad_request = false;
+        bool              _disconnect_slow = false;
         size_t            _tcp_buffer_size = 0;
+        size_t            _max_clients = 1;
+        size_t            _client_queue_size = DEFAULT_CLIENT_QUEUE_SIZE;
 
         // Working data:
         TCPServer     _server {};
-        TCPConnection _client {};
+        TCPConnection _client {};            // Single client mode.
+        Acceptor      _acceptor {this};      // Multiple clients mode.
+        volatile bool _terminate = false;    // Terminate the acceptor thread.
+        std::mutex    _clients_mutex {};     // Protect _clients.
+        std::list<ClientPtr> _clients {};    // Multiple clients mode, active sessions.
+
+        // Send packets in multiple clients mode.
+        bool sendMultiple(const TSPacket*, size_t);
 
         // Process request headers from new client, send response headers.
-        bool startSession();
+        bool startSession(TCPConnection& client);
 
         // Send a response header.
-        bool sendResponseHeader(const std::string& line);
+        bool sendResponseHeader(TCPConnection& client, const std::string& line);
     };
 }
@@ -30,13 +30,26 @@ ts::ProcessorPlugin::ProcessorPlugin(TSP* tsp_, const UString& description, cons
          u"Other packets are transparently passed to the next plugin, without going through this one. "
          u"Several --only-label options may be specified. "
          u"This is a generic option which is defined in all packet processing plugins.");
+
+    // The option --threads is defined in all packet processing plugins.
+    option(u"threads", 0, INTEGER, 0, 1, 1, MAX_THREADS);
+    help(u"threads", u"count",
+         u"Process packets using the specified number of parallel instances of this plugin, each one in its own thread. "
+         u"This is possible only with plugins which are able to process independent subsets of the stream. "
+         u"With other plugins, this option is ignored. The default is one single instance. "
+         u"This is a generic option which is defined in all packet processing plugins.");
 }
 
 
 //----------------------------------------------------------------------------
-// Get the content of the --only-label options (packet processing plugins).
+// Get the content of the --only-label and --threads options.
 //----------------------------------------------------------------------------
 
+size_t ts::ProcessorPlugin::getThreadsOption() const
+{
+    return intValue<size_t>(u"threads", 1);
+}
+
 ts::TSPacketLabelSet ts::ProcessorPlugin::getOnlyLabelOption() const
 {
     TSPacketLabelSet labels;
@@ -59,6 +72,11 @@ size_t ts::ProcessorPlugin::getPacketWindowSize()
     return 0;
 }
 
+ts::ProcessorPlugin::ShardingMode ts::ProcessorPlugin::getShardingMode()
+{
+    return ShardingMode::NONE;
+}
+
 ts::ProcessorPlugin::Status ts::ProcessorPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     return TSP_OK;
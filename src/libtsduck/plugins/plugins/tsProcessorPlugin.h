@@ -135,6 +135,49 @@ namespace ts {
         //!
         virtual size_t processPacketWindow(TSPacketWindow& win);
 
+        //!
+        //! Parallel execution capability of a packet processor plugin.
+        //! @see getShardingMode()
+        //!
+        enum class ShardingMode {
+            NONE,     //!< The plugin cannot be executed by several threads (the default).
+            BY_PID,   //!< Several instances of the plugin can run in parallel, each of them receiving all packets of a subset of the PID's.
+            BY_BLOCK, //!< Several instances of the plugin can run in parallel, each of them receiving contiguous blocks of packets.
+        };
+
+        //!
+        //! Maximum value for the generic option -\-threads.
+        //!
+        static constexpr size_t MAX_THREADS = 64;
+
+        //!
+        //! Get the parallel execution capability of the plugin.
+        //!
+        //! This method shall be overriden by plugins which accept to be executed by several threads
+        //! in parallel (generic option -\-threads). This method is called by the application after
+        //! start(), the returned value may consequently depend on the command line options.
+        //!
+        //! When the option -\-threads is used with a value greater than one, the application creates
+        //! several instances of the plugin with the same command line options and each instance
+        //! processes a subset of the packets in its own thread, using processPacket(). The plugin
+        //! must not depend on packets which are not in its subset (ShardingMode::BY_PID: other PID's,
+        //! ShardingMode::BY_BLOCK: any other packet). The packet counters in the TSP interface
+        //! are updated after each group of packets only and are local to each instance.
+        //!
+        //! The "packet window method" is never used in parallel execution.
+        //!
+        //! @return The parallel execution capability of the plugin.
+        //! If this method is not overriden, the default implementation returns ShardingMode::NONE.
+        //!
+        virtual ShardingMode getShardingMode();
+
+        //!
+        //! Get the content of the --threads option.
+        //! The value of the option is fetched each time this method is called.
+        //! @return The requested number of parallel instances of the plugin, 1 by default.
+        //!
+        size_t getThreadsOption() const;
+
         //!
         //! Get the content of the --only-label options.
         //! The value of the option is fetched each time this method is called.
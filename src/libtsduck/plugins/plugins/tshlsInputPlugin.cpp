@@ -101,6 +101,15 @@ ts::hls::InputPlugin::InputPlugin(TSP* tsp_) :
          u"When the URL is a master playlist, select a content the resolution of which has a "
          u"lower height than the specified maximum.");
 
+    option(u"prefetch", 0, INTEGER, 0, 1, 0, 32);
+    help(u"prefetch", u"count",
+         u"Download up to the specified number of media segments in advance, in parallel, "
+         u"while the current segment is passed to the next plugin. "
+         u"Each parallel download uses its own thread and keeps its connection to the server "
+         u"from one segment to the next one. "
+         u"This reduces the impact of the latency of the server when starting each segment. "
+         u"By default, the media segments are downloaded one after the other.");
+
     option(u"save-files", 0, DIRECTORY);
     help(u"save-files",
          u"Specify a directory where all downloaded files, media segments and playlists, are saved "
@@ -146,7 +155,8 @@ bool ts::hls::InputPlugin::isRealTime()
 bool ts::hls::InputPlugin::getOptions()
 {
     _url.setURL(value(u""));
-    const UString saveDirectory(value(u"save-files"));
+    getValue(_saveDirectory, u"save-files");
+    getIntValue(_prefetchCount, u"prefetch");
     getIntValue(_maxSegmentCount, u"segment-count");
     getValue(_minRate, u"min-bitrate");
     getValue(_maxRate, u"max-bitrate");
@@ -207,8 +217,8 @@ bool ts::hls::InputPlugin::getOptions()
     }
 
     // Automatically save media segments and playlists.
-    setAutoSaveDirectory(saveDirectory);
-    _playlist.setAutoSaveDirectory(saveDirectory);
+    setAutoSaveDirectory(_saveDirectory);
+    _playlist.setAutoSaveDirectory(_saveDirectory);
 
     return true;
 }
@@ -351,6 +361,23 @@ bool ts::hls::InputPlugin::start()
 
     _segmentCount = 0;
 
+    // With prefetch, start the downloader threads. Segments are downloaded on demand.
+    if (_prefetchCount > 0) {
+        _terminate = false;
+        _window.clear();
+        _current.clear();
+        _currentOffset = 0;
+        for (size_t i = 0; i < _prefetchCount; ++i) {
+            const DownloaderPtr dl(new Downloader(this));
+            _downloaders.push_back(dl);
+            if (!dl->start()) {
+                stopPrefetch();
+                return false;
+            }
+        }
+        return true;
+    }
+
     // Invoke superclass.
     return AbstractHTTPInputPlugin::start();
 }
@@ -362,8 +389,15 @@ bool ts::hls::InputPlugin::start()
 
 bool ts::hls::InputPlugin::stop()
 {
-    // Invoke superclass first.
-    const bool stopped = AbstractHTTPInputPlugin::stop();
+    // With prefetch, terminate all downloads in progress. Otherwise, invoke superclass
+    // which was started in start(). This must be done before deleting the cookie file.
+    bool stopped = true;
+    if (_prefetchCount > 0) {
+        stopPrefetch();
+    }
+    else {
+        stopped = AbstractHTTPInputPlugin::stop();
+    }
 
     // Then delete the cookie file. Must be done after complete stop to avoid recreation.
     return deleteCookiesFile() && stopped;
@@ -371,10 +405,29 @@ bool ts::hls::InputPlugin::stop()
 
 
 //----------------------------------------------------------------------------
-// Called by AbstractHTTPInputPlugin to open an URL.
+// Abort the input operation currently in progress.
 //----------------------------------------------------------------------------
 
-bool ts::hls::InputPlugin::openURL(WebRequest& request)
+bool ts::hls::InputPlugin::abortInput()
+{
+    if (_prefetchCount > 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _toDownload.notify_all();
+        _downloaded.notify_all();
+        for (const auto& dl : _downloaders) {
+            dl->abort();
+        }
+    }
+    return AbstractHTTPInputPlugin::abortInput();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next media segment to play from the playlist.
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::nextSegment(MediaSegment& seg, bool reload, bool wait)
 {
     // Check if the playlist is completed
     bool completed =
@@ -386,7 +439,7 @@ bool ts::hls::InputPlugin::openURL(WebRequest& request)
         tsp->aborting();
 
     // If there is only one or zero remaining segment, try to reload the playlist.
-    if (!completed && _playlist.segmentCount() < 2 && _playlist.isUpdatable()) {
+    if (!completed && reload && _playlist.segmentCount() < 2 && _playlist.isUpdatable()) {
 
         // Reload the playlist, ignore errors, continue to play next segments.
         _playlist.reload(false, webArgs, *tsp);
@@ -396,7 +449,7 @@ bool ts::hls::InputPlugin::openURL(WebRequest& request)
         // can be produced as late as the estimated end time of the previous playlist. So, we retry
         // at regular intervals until we get new segments.
 
-        while (_playlist.segmentCount() == 0 && Time::CurrentUTC() <= _playlist.terminationUTC() && !tsp->aborting()) {
+        while (wait && _playlist.segmentCount() == 0 && Time::CurrentUTC() <= _playlist.terminationUTC() && !tsp->aborting()) {
             // The wait between two retries is half the target duration of a segment, with a minimum of 2 seconds.
             SleepThread(std::max<MilliSecond>(2000, (MilliSecPerSec * _playlist.targetDuration()) / 2));
             // This time, we stop on reload error.
@@ -404,23 +457,200 @@ bool ts::hls::InputPlugin::openURL(WebRequest& request)
                 break;
             }
         }
-
-        // End of playlist if we cannot find new segments.
-        completed = _playlist.segmentCount() == 0;
     }
 
+    // End of playlist if we cannot find new segments.
+    completed = completed || _playlist.segmentCount() == 0;
+
     if (completed) {
-        tsp->verbose(u"HLS playlist completed");
+        if (wait) {
+            tsp->verbose(u"HLS playlist completed");
+        }
         return false;
     }
 
     // Remove first segment from the playlist.
-    hls::MediaSegment seg;
     _playlist.popFirstSegment(seg);
     _segmentCount++;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Called by AbstractHTTPInputPlugin to open an URL.
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::openURL(WebRequest& request)
+{
+    // Get next segment from the playlist.
+    hls::MediaSegment seg;
+    if (!nextSegment(seg, true, true)) {
+        return false;
+    }
 
     // Open the segment.
     tsp->debug(u"downloading segment %s", {seg.urlString()});
     request.enableCookies(webArgs.cookiesFile);
     return request.open(seg.urlString());
 }
+
+
+//----------------------------------------------------------------------------
+// Input method.
+//----------------------------------------------------------------------------
+
+size_t ts::hls::InputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    // Without prefetch, the superclass downloads the segments one by one.
+    if (_prefetchCount == 0) {
+        return AbstractHTTPInputPlugin::receive(buffer, pkt_data, max_packets);
+    }
+
+    // Loop until a downloaded segment has some remaining packets.
+    // A trailing partial packet at end of segment is ignored.
+    while (_current.isNull() || _currentOffset + PKT_SIZE > _current->data.size()) {
+        if (!nextPrefetchedSegment()) {
+            return 0;
+        }
+    }
+
+    const size_t count = std::min(max_packets, (_current->data.size() - _currentOffset) / PKT_SIZE);
+    std::memcpy(buffer, _current->data.data() + _currentOffset, count * PKT_SIZE);
+    _currentOffset += count * PKT_SIZE;
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Fill the prefetch window and wait for the next downloaded segment.
+//----------------------------------------------------------------------------
+
+bool ts::hls::InputPlugin::nextPrefetchedSegment()
+{
+    _current.clear();
+    _currentOffset = 0;
+
+    // Fill the prefetch window with the next segments from the playlist. The window is modified
+    // by this thread only, the mutex is needed when modifying it, not when reading its size.
+    // Wait for new segments in the playlist only when the window is empty.
+    // The playlist is reloaded at most once per played segment.
+    bool reload = true;
+    while (_window.size() < _prefetchCount) {
+        MediaSegment media;
+        if (!nextSegment(media, reload, _window.empty())) {
+            break;
+        }
+        reload = false;
+        const SegmentPtr seg(new Segment);
+        seg->media = media;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _window.push_back(seg);
+        _toDownload.notify_one();
+    }
+
+    // Empty window means end of playlist.
+    if (_window.empty()) {
+        return false;
+    }
+
+    // Wait for the completion of the first segment in the window.
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _downloaded.wait(lock, [this]() { return _terminate || _window.front()->completed; });
+        if (_terminate) {
+            return false;
+        }
+        _current = _window.front();
+        _window.pop_front();
+    }
+
+    // Errors were already reported by the downloader. Like without prefetch, a failure to
+    // download a segment ends the session. A partial download is passed to the next plugin.
+    if (!_current->success && _current->data.empty()) {
+        return false;
+    }
+    tsp->verbose(u"downloaded %s, %'d bytes", {_current->media.urlString(), _current->data.size()});
+
+    // Save the segment when requested. Display errors but do not fail, this is just auto save.
+    const UString name(BaseName(URL(_current->media.urlString()).getPath()));
+    if (!_saveDirectory.empty() && !name.empty()) {
+        _current->data.saveToFile(_saveDirectory + fs::path::preferred_separator + name, tsp);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate all downloader threads.
+//----------------------------------------------------------------------------
+
+void ts::hls::InputPlugin::stopPrefetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _toDownload.notify_all();
+        _downloaded.notify_all();
+        for (const auto& dl : _downloaders) {
+            dl->abort();
+        }
+    }
+
+    // Deallocating the downloaders waits for their termination.
+    _downloaders.clear();
+    _window.clear();
+    _current.clear();
+    _currentOffset = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Downloader threads for prefetch.
+//----------------------------------------------------------------------------
+
+ts::hls::InputPlugin::Downloader::Downloader(InputPlugin* plugin) :
+    _plugin(plugin),
+    _request(*plugin->tsp)
+{
+}
+
+ts::hls::InputPlugin::Downloader::~Downloader()
+{
+    waitForTermination();
+}
+
+void ts::hls::InputPlugin::Downloader::main()
+{
+    _request.setArgs(_plugin->webArgs);
+    _request.setAutoRedirect(true);
+    _request.enableCookies(_plugin->webArgs.cookiesFile);
+
+    std::unique_lock<std::mutex> lock(_plugin->_mutex);
+    for (;;) {
+        // Wait for a segment to download or termination.
+        SegmentPtr seg;
+        while (!_plugin->_terminate) {
+            const auto it = std::find_if(_plugin->_window.begin(), _plugin->_window.end(), [](const SegmentPtr& s) { return !s->started; });
+            if (it != _plugin->_window.end()) {
+                seg = *it;
+                break;
+            }
+            _plugin->_toDownload.wait(lock);
+        }
+        if (_plugin->_terminate) {
+            break;
+        }
+        seg->started = true;
+
+        // Download the segment without holding the mutex. The segment is not accessed
+        // by the plugin thread until it is marked as completed.
+        lock.unlock();
+        _plugin->tsp->debug(u"prefetching segment %s", {seg->media.urlString()});
+        const bool success = _request.downloadBinaryContent(seg->media.urlString(), seg->data);
+        lock.lock();
+
+        seg->success = success;
+        seg->completed = true;
+        _plugin->_downloaded.notify_all();
+    }
+}
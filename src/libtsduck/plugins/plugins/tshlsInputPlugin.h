@@ -14,6 +14,7 @@
 #pragma once
 #include "tsAbstractHTTPInputPlugin.h"
 #include "tshlsPlayList.h"
+#include "tsThread.h"
 #include "tsURL.h"
 
 namespace ts {
@@ -25,6 +26,9 @@ namespace ts {
         //! The input plugin can read HLS playlists and media segments from local
         //! files or receive them in real time using HTTP or HTTPS.
         //!
+        //! With option -\-prefetch, the next media segments are downloaded in advance,
+        //! in parallel, by separate threads. The segments are passed to tsp in playout order.
+        //!
         class TSDUCKDLL InputPlugin: public AbstractHTTPInputPlugin
         {
             TS_PLUGIN_CONSTRUCTORS(InputPlugin);
@@ -34,6 +38,8 @@ namespace ts {
             virtual bool start() override;
             virtual bool stop() override;
             virtual bool isRealTime() override;
+            virtual bool abortInput() override;
+            virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
 
         protected:
             // Implementation of AbstractHTTPInputPlugin
@@ -60,10 +66,61 @@ namespace ts {
             UString  _altName {};
             UString  _altGroupId {};
             UString  _altLanguage {};
+            UString  _saveDirectory {};
+            size_t   _prefetchCount = 0;
+
+            // A media segment in the prefetch window.
+            class Segment
+            {
+            public:
+                MediaSegment media {};          // Segment description from the playlist.
+                ByteBlock    data {};           // Segment content.
+                bool         started = false;   // A downloader thread has started the download.
+                bool         completed = false; // The download is completed.
+                bool         success = false;   // The download is successful.
+            };
+            typedef SafePtr<Segment, std::mutex> SegmentPtr;
+
+            // Thread which downloads the media segments of the prefetch window.
+            // Each thread keeps its WebRequest and its connection from one segment to the next one.
+            class Downloader : public Thread
+            {
+                TS_NOBUILD_NOCOPY(Downloader);
+            public:
+                Downloader(InputPlugin* plugin);
+                virtual ~Downloader() override;
+                void abort() { _request.abort(); }
+            private:
+                InputPlugin* const _plugin;
+                WebRequest         _request;
+                virtual void main() override;
+            };
+            typedef SafePtr<Downloader, ts::null_mutex> DownloaderPtr;
 
             // Working data:
             size_t   _segmentCount = 0;
             PlayList _playlist {};
+
+            // Working data for prefetch:
+            std::mutex                 _mutex {};          // Protect the prefetch window.
+            std::condition_variable    _toDownload {};     // Signal downloaders: new segment in window or termination.
+            std::condition_variable    _downloaded {};     // Signal plugin thread: a segment is completed.
+            std::deque<SegmentPtr>     _window {};         // Prefetch window, in playout order.
+            bool                       _terminate = false; // Terminate downloaders.
+            std::vector<DownloaderPtr> _downloaders {};    // Downloader threads.
+            SegmentPtr                 _current {};        // Current segment, being passed to tsp.
+            size_t                     _currentOffset = 0; // Next byte to pass in current segment.
+
+            // Get the next media segment to play from the playlist.
+            // The playlist is reloaded when necessary if 'reload' is true.
+            // With 'wait', wait for new segments in live playlists.
+            bool nextSegment(MediaSegment& seg, bool reload, bool wait);
+
+            // Fill the prefetch window and wait for the next downloaded segment in _current.
+            bool nextPrefetchedSegment();
+
+            // Terminate all downloader threads.
+            void stopPrefetch();
         };
     }
 }
@@ -21,6 +21,7 @@ TS_REGISTER_OUTPUT_PLUGIN(u"hls", ts::hls::OutputPlugin);
 #define DEFAULT_OUT_LIVE_DURATION  5  // Default segment target duration for output live streams.
 #define DEFAULT_EXTRA_DURATION     2  // Default segment extra duration when intra image is not found.
 #define DEFAULT_LIVE_EXTRA_DEPTH   1  // Default additional segments to keep in live streams.
+#define FILE_QUEUE_SIZE          256  // Maximum number of pending file operations in the writer thread.
 
 
 //----------------------------------------------------------------------------
@@ -30,7 +31,8 @@ TS_REGISTER_OUTPUT_PLUGIN(u"hls", ts::hls::OutputPlugin);
 ts::hls::OutputPlugin::OutputPlugin(TSP* tsp_) :
     ts::OutputPlugin(tsp_, u"Generate HTTP Live Streaming (HLS) media", u"[options] filename"),
     _demux(duck, this),
-    _ccFixer(NoPID, tsp)
+    _ccFixer(NoPID, tsp),
+    _fileQueue(FILE_QUEUE_SIZE)
 {
     option(u"", 0, FILENAME, 1, 1);
     help(u"",
@@ -117,6 +119,17 @@ ts::hls::OutputPlugin::OutputPlugin(TSP* tsp_) :
          u"With --playlist, do not specify EXT-X-BITRATE tags for each segment in the playlist. "
          u"This optional tag is present by default.");
 
+    option(u"part-duration", 0, POSITIVE);
+    help(u"part-duration", u"milliseconds",
+         u"Generate a low-latency HLS (LL-HLS) output with partial segments of the specified duration. "
+         u"Each media segment is split into partial segments which are written in separate files, "
+         u"named after the media segment file with a '.partN' suffix before the extension. "
+         u"The playlist is rewritten after each partial segment, with EXT-X-PART tags for the recent partial segments "
+         u"and an EXT-X-PRELOAD-HINT tag for the partial segment in progress. "
+         u"Typical values are 200 to 1000 milliseconds. "
+         u"This option requires --playlist and --live or --event. "
+         u"With --live, obsolete partial segment files are deleted with their media segment.");
+
     option(u"playlist", 'p', FILENAME);
     help(u"playlist", u"filename",
          u"Specify the name of the playlist file. "
@@ -167,6 +180,7 @@ bool ts::hls::OutputPlugin::getOptions()
     getIntValue(_initialMediaSeq, u"start-media-sequence", 0);
     getIntValues(_closeLabels, u"label-close");
     getValues(_customTags, u"custom-tag");
+    getIntValue(_partDuration, u"part-duration");
 
     if (present(u"event")) {
         _playlistType = hls::PlayListType::EVENT;
@@ -187,6 +201,11 @@ bool ts::hls::OutputPlugin::getOptions()
         return false;
     }
 
+    if (_partDuration > 0 && (_playlistFile.empty() || _playlistType == hls::PlayListType::VOD)) {
+        tsp->error(u"option --part-duration requires --playlist and --live or --event");
+        return false;
+    }
+
     if (_sliceOnly && _alignFirstSegment) {
         tsp->error(u"options --slice-only and --align-first-segment are incompatible");
         return false;
@@ -225,17 +244,29 @@ bool ts::hls::OutputPlugin::start()
 
     // Initialize the segment and playlist files.
     _liveSegmentFiles.clear();
+    _segmentFiles.clear();
     _segStarted = false;
     _segClosePending = false;
-    if (_segmentFile.isOpen()) {
-        _segmentFile.close(*tsp);
-    }
+    _segmentName.clear();
+    _segmentPackets = 0;
+    _partName.clear();
+    _partIndex = 0;
+    _partPackets = 0;
+    _partIndependent = false;
+    _videoStart.clear();
+    _videoScan = false;
+    _pending.clear();
     if (!_playlistFile.empty()) {
         _playlist.reset(_playlistType, _playlistFile);
         _playlist.setTargetDuration(_targetDuration, *tsp);
         _playlist.setMediaSequence(_initialMediaSeq, *tsp);
+        _playlist.setPartTarget(_partDuration, *tsp);
     }
-    return true;
+
+    // Start the writer thread.
+    _writeError = false;
+    _writerStarted = _writer.start();
+    return _writerStarted;
 }
 
 
@@ -245,8 +276,96 @@ bool ts::hls::OutputPlugin::start()
 
 bool ts::hls::OutputPlugin::stop()
 {
-    // Simply close the current segment (and generate the corresponding playlist).
-    return closeCurrentSegment(true);
+    // Without writer thread, nobody would process the file requests.
+    if (!_writerStarted) {
+        _fileQueue.clear();
+        return true;
+    }
+
+    // Close the current segment (and generate the corresponding playlist).
+    closeCurrentSegment(true);
+
+    // Wait for the completion of all file operations.
+    postFileRequest(FileAction::TERMINATE);
+    _writer.waitForTermination();
+    _writerStarted = false;
+    return !_writeError;
+}
+
+
+//----------------------------------------------------------------------------
+// Post a request to the writer thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::postFileRequest(FileAction action, FileIndex file, const UString& name)
+{
+    FileQueue::MessagePtr req(new FileRequest);
+    req->action = action;
+    req->file = file;
+    req->name = name;
+    if (action == FileAction::WRITE) {
+        req->packets = _pending;
+    }
+    else if (action == FileAction::PUBLISH) {
+        req->playlist = new hls::PlayList(_playlist);
+    }
+    // Wait when the writer thread is late. This is the only case where the output is slowed down.
+    _fileQueue.enqueue(req);
+}
+
+
+//----------------------------------------------------------------------------
+// Send the pending packets to the writer thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::flushPackets()
+{
+    if (!_pending.isNull() && !_pending->empty()) {
+        // The same packets are shared by the segment and partial segment.
+        if (!_segmentName.empty()) {
+            postFileRequest(FileAction::WRITE, SEGMENT_FILE);
+        }
+        if (!_partName.empty()) {
+            postFileRequest(FileAction::WRITE, PART_FILE);
+        }
+    }
+    // Never reuse a vector of packets which was passed to the writer thread.
+    _pending.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current bitrate estimation.
+//----------------------------------------------------------------------------
+
+ts::BitRate ts::hls::OutputPlugin::currentBitRate() const
+{
+    return _pcrAnalyzer.bitrateIsValid() ? _pcrAnalyzer.bitrate188() : _previousBitrate;
+}
+
+
+//----------------------------------------------------------------------------
+// Send a copy of the playlist to the writer thread.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::publishPlayList()
+{
+    if (!_playlistFile.empty()) {
+
+        // Add custom tags.
+        _playlist.clearCustomTags();
+        for (const auto& tag : _customTags) {
+            _playlist.addCustomTag(tag);
+        }
+
+        // Use #EXT-X-INDEPENDENT-SEGMENTS if all segments are really independent.
+        if (!_sliceOnly) {
+            _playlist.addCustomTag(u"EXT-X-INDEPENDENT-SEGMENTS");
+        }
+
+        // Write the playlist file.
+        postFileRequest(FileAction::PUBLISH);
+    }
 }
 
 
@@ -262,12 +381,19 @@ bool ts::hls::OutputPlugin::createNextSegment()
     }
 
     // Generate a new segment file name.
-    const UString fileName(_nameGenerator.newFileName());
+    _segmentName = _nameGenerator.newFileName();
+    _segmentPackets = 0;
+    _segmentFiles.clear();
+    _segmentFiles.push_back(_segmentName);
 
     // Create the segment file.
-    tsp->verbose(u"creating media segment %s", {fileName});
-    if (!_segmentFile.open(fileName, TSFile::WRITE | TSFile::SHARED, *tsp)) {
-        return false;
+    tsp->verbose(u"creating media segment %s", {_segmentName});
+    postFileRequest(FileAction::OPEN, SEGMENT_FILE, _segmentName);
+
+    // In low-latency mode, create the first partial segment.
+    if (_partDuration > 0) {
+        _partIndex = 0;
+        createNextPart();
     }
 
     // Reset the PCR analysis in each segment to get to bitrate of this segment.
@@ -281,7 +407,84 @@ bool ts::hls::OutputPlugin::createNextSegment()
         return writePackets(_patPackets.data(), _patPackets.size()) && writePackets(_pmtPackets.data(), _pmtPackets.size());
     }
 
-    return true;
+    return !_writeError;
+}
+
+
+//----------------------------------------------------------------------------
+// Search the start of an intra image in the video PID.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::scanIntraImage(const TSPacket& pkt)
+{
+    if (!pkt.isClear()) {
+        _videoScan = false;
+    }
+    else if (pkt.getPUSI()) {
+        _videoStart.copy(pkt.getPayload(), pkt.getPayloadSize());
+        _videoScan = true;
+    }
+    else if (_videoScan) {
+        _videoStart.append(pkt.getPayload(), pkt.getPayloadSize());
+    }
+
+    if (_videoScan) {
+        if (PESPacket::FindIntraImage(_videoStart.data(), _videoStart.size(), _videoStreamType) != NPOS) {
+            // The intra image starts in this packet, in the current partial segment.
+            _partIndependent = true;
+            _videoScan = false;
+        }
+        else if (_videoStart.size() >= MAX_INTRA_SCAN_SIZE) {
+            // No intra image at the start of this PES packet.
+            _videoScan = false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Create the next partial segment file, close the current one.
+//----------------------------------------------------------------------------
+
+void ts::hls::OutputPlugin::createNextPart()
+{
+    closeCurrentPart();
+
+    // The partial segment file name is built from the segment file name: foo-000012.ts -> foo-000012.part3.ts
+    fs::path name(_segmentName);
+    const fs::path ext(name.extension());
+    name.replace_extension();
+    name += UString::Format(u".part%d", {_partIndex++});
+    name += ext;
+
+    _partName = name;
+    _partPackets = 0;
+    _partIndependent = false;
+    _segmentFiles.push_back(_partName);
+    tsp->debug(u"creating partial segment %s", {_partName});
+    postFileRequest(FileAction::OPEN, PART_FILE, _partName);
+
+    // Clients can request the partial segment in progress before it is referenced in the playlist.
+    _playlist.setPreloadHint(_partName);
+}
+
+void ts::hls::OutputPlugin::closeCurrentPart()
+{
+    if (!_partName.empty()) {
+        // Send the last packets of the partial segment and close it.
+        flushPackets();
+        postFileRequest(FileAction::CLOSE, PART_FILE);
+
+        // Declare the partial segment in the playlist.
+        hls::MediaPart part;
+        _playlist.buildURL(part, _partName);
+        const BitRate bitrate(currentBitRate());
+        part.duration = bitrate > 0 ? PacketInterval(bitrate, _partPackets) : _partDuration;
+        part.independent = _partIndependent;
+        _playlist.addPendingPart(part, *tsp);
+        _playlist.setPreloadHint(UString());
+        _partName.clear();
+    }
 }
 
 
@@ -293,23 +496,27 @@ bool ts::hls::OutputPlugin::createNextSegment()
 bool ts::hls::OutputPlugin::closeCurrentSegment(bool endOfStream)
 {
     // If no segment file is open, there is nothing to do.
-    if (!_segmentFile.isOpen()) {
-        return true;
+    if (_segmentName.empty()) {
+        return !_writeError;
     }
 
+    // Close the current partial segment, before the segment itself.
+    closeCurrentPart();
+
     // Get the segment file name and size (to be inserted in the playlist).
-    const UString segName(_segmentFile.getFileName());
-    const PacketCounter segPackets = _segmentFile.writePacketsCount();
+    const UString segName(_segmentName);
+    const PacketCounter segPackets = _segmentPackets;
 
     // Close the TS file.
-    if (!_segmentFile.close(*tsp)) {
-        return false;
-    }
+    flushPackets();
+    postFileRequest(FileAction::CLOSE, SEGMENT_FILE);
+    _segmentName.clear();
 
     // On live streams, we need to maintain a list of active segments.
     if (_liveDepth > 0) {
-        _liveSegmentFiles.push_back(segName);
+        _liveSegmentFiles.push_back(_segmentFiles);
     }
+    _segmentFiles.clear();
 
     // Create or regenerate the playlist file.
     if (!_playlistFile.empty()) {
@@ -347,54 +554,19 @@ bool ts::hls::OutputPlugin::closeCurrentSegment(bool endOfStream)
             _playlist.popFirstSegment();
         }
 
-        // Add custom tags.
-        _playlist.clearCustomTags();
-        for (const auto& tag : _customTags) {
-            _playlist.addCustomTag(tag);
-        }
-
-        // Use #EXT-X-INDEPENDENT-SEGMENTS if all segments are really independent.
-        if (!_sliceOnly) {
-            _playlist.addCustomTag(u"EXT-X-INDEPENDENT-SEGMENTS");
-        }
-
         // Write the playlist file.
-        if (!_playlist.saveFile(UString(), *tsp)) {
-            return false;
-        }
-
-        // WARNING: suggested improvement:
-        //   On Windows, if we overwrite the playlist file while a client is downloading it,
-        //   the file is locked by the HTTP server and the replacement will fail. We should
-        //   keep a list of failed deletions to retry these deletions later. On Unix systems,
-        //   we should not have the problem since the deletion succeeds even if the file
-        //   is already open (the file actually disappears when the file is closed).
+        publishPlayList();
     }
 
-    // Keep a list of segments we fail to delete (maybe because they are locked by the Web server).
-    UStringList failedDelete;
-
-    // On live streams, purge obsolete segment files.
+    // On live streams, purge obsolete segment files, with their partial segments.
     while (_liveDepth > 0 && _liveSegmentFiles.size() > _liveDepth + _liveExtraDepth) {
-
-        // Remove name of the file to delete from the list of active segment.
-        const UString name(_liveSegmentFiles.front());
-        _liveSegmentFiles.pop_front();
-
-        // Delete the segment file.
-        tsp->verbose(u"deleting obsolete segment file %s", {name});
-        if (!fs::remove(name, &ErrCodeReport(*tsp, u"error deleting", name)) && fs::exists(name)) {
-            // Failed to delete, keep it to retry later.
-            failedDelete.push_back(name);
+        for (const auto& name : _liveSegmentFiles.front()) {
+            postFileRequest(FileAction::REMOVE, SEGMENT_FILE, name);
         }
+        _liveSegmentFiles.pop_front();
     }
 
-    // Re-insert segments we failed to delete at head of list so that we will retry to delete them next time.
-    if (!failedDelete.empty()) {
-        _liveSegmentFiles.insert(_liveSegmentFiles.begin(), failedDelete.begin(), failedDelete.end());
-    }
-
-    return true;
+    return !_writeError;
 }
 
 
@@ -459,36 +631,26 @@ void ts::hls::OutputPlugin::handleTable(SectionDemux& demux, const BinaryTable&
 
 bool ts::hls::OutputPlugin::writePackets(const TSPacket* pkt, size_t packetCount)
 {
-    // Temporary packet buffer if a packet needs to be modified.
-    TSPacket tmp;
+    // The packets are copied in a buffer which is later passed to the writer thread.
+    if (_pending.isNull()) {
+        _pending = new TSPacketVector;
+    }
 
     // Loop on all packets.
     for (size_t i = 0; i < packetCount; ++i) {
+        _pending->push_back(pkt[i]);
 
-        // Address of the next packet to write.
-        const TSPacket* p = pkt + i;
-
-        // If the packet comes from the PAT or PMT, get a copy and fix continuity counter.
+        // If the packet comes from the PAT or PMT, fix continuity counter in the copy.
         if (!_sliceOnly) {
             const PID pid = pkt[i].getPID();
-            if (pid == PID_PAT) {
-                tmp = *p;
-                _ccFixer.feedPacket(tmp);
-                p = &tmp;
+            if (pid == PID_PAT || (_pmtPID != PID_NULL && pid == _pmtPID)) {
+                _ccFixer.feedPacket(_pending->back());
             }
-            else if (_pmtPID != PID_NULL && pid == _pmtPID) {
-                tmp = *p;
-                _ccFixer.feedPacket(tmp);
-                p = &tmp;
-            }
-        }
-
-        // Write the packet in the segment file.
-        if (!_segmentFile.writePackets(p, nullptr, 1, *tsp)) {
-            return false;
         }
     }
-    return true;
+    _segmentPackets += packetCount;
+    _partPackets += packetCount;
+    return !_writeError;
 }
 
 
@@ -499,7 +661,7 @@ bool ts::hls::OutputPlugin::writePackets(const TSPacket* pkt, size_t packetCount
 bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pktData, size_t packetCount)
 {
     const TSPacket* const lastPkt = pkt + packetCount;
-    bool ok = true;
+    bool ok = !_writeError;
 
     // Process packets one by one.
     while (ok && pkt < lastPkt) {
@@ -537,7 +699,7 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
             bool renewOnPUSI = false;
             if (_fixedSegmentSize > 0) {
                 // Each segment shall have a fixed size.
-                renewNow = _segmentFile.writePacketsCount() >= _fixedSegmentSize;
+                renewNow = _segmentPackets >= _fixedSegmentSize;
             }
             else if (!_segClosePending) {
                 if (pktData->hasAnyLabel(_closeLabels)) {
@@ -546,7 +708,7 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
                 }
                 else if (_pcrAnalyzer.bitrateIsValid()) {
                     // The segment file shall be closed when the estimated duration exceeds the target duration.
-                    const MilliSecond segDuration = PacketInterval(_pcrAnalyzer.bitrate188(), _segmentFile.writePacketsCount());
+                    const MilliSecond segDuration = PacketInterval(_pcrAnalyzer.bitrate188(), _segmentPackets);
                     _segClosePending = segDuration >= _targetDuration * MilliSecPerSec;
                     // With --intra-close, force renew on next PES packet if extra duration is exceeded.
                     renewOnPUSI = segDuration >= (_targetDuration + _maxExtraDuration) * MilliSecPerSec;
@@ -577,13 +739,119 @@ bool ts::hls::OutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pk
             }
 
             // Close current segment and recreate a new one when necessary.
+            ok = !renewNow || createNextSegment();
+
+            // In low-latency mode, start a new partial segment when the duration of the current
+            // one would exceed the target. The playlist is republished after each partial segment.
+            if (ok && !renewNow && _partDuration > 0) {
+                const BitRate bitrate(currentBitRate());
+                if (bitrate > 0 && PacketInterval(bitrate, _partPackets + 1) > _partDuration) {
+                    createNextPart();
+                    publishPlayList();
+                }
+            }
+
+            // A partial segment is independent when it contains the start of an intra image.
+            // The intra image may start a few packets after the start of the PES packet.
+            if (_partDuration > 0 && pkt->getPID() == _videoPID) {
+                scanIntraImage(*pkt);
+            }
+
             // Finally write the packet.
-            ok = (!renewNow || createNextSegment()) && writePackets(pkt, 1);
+            ok = ok && writePackets(pkt, 1);
         }
 
         // Process next packet.
         ++pkt;
         ++pktData;
     }
-    return ok;
+
+    // Pass all packets from this call to the writer thread.
+    flushPackets();
+    return ok && !_writeError;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer thread.
+//----------------------------------------------------------------------------
+
+ts::hls::OutputPlugin::Writer::Writer(OutputPlugin* plugin) :
+    _plugin(plugin)
+{
+}
+
+ts::hls::OutputPlugin::Writer::~Writer()
+{
+    waitForTermination();
+}
+
+void ts::hls::OutputPlugin::Writer::main()
+{
+    Report& report(*_plugin->tsp);
+    bool terminate = false;
+
+    while (!terminate) {
+        FileQueue::MessagePtr req;
+        _plugin->_fileQueue.dequeue(req);
+        bool ok = true;
+
+        switch (req->action) {
+            case FileAction::OPEN: {
+                TSFile& file(_files[req->file]);
+                if (file.isOpen()) {
+                    file.close(report);
+                }
+                ok = file.open(req->name, TSFile::WRITE | TSFile::SHARED, report);
+                break;
+            }
+            case FileAction::WRITE: {
+                TSFile& file(_files[req->file]);
+                ok = file.isOpen() && file.writePackets(req->packets->data(), nullptr, req->packets->size(), report);
+                break;
+            }
+            case FileAction::CLOSE: {
+                TSFile& file(_files[req->file]);
+                ok = !file.isOpen() || file.close(report);
+                break;
+            }
+            case FileAction::PUBLISH: {
+                ok = req->playlist->saveFile(UString(), report);
+                break;
+            }
+            case FileAction::REMOVE: {
+                // Retry files we previously failed to delete, then delete this one.
+                _failedRemove.push_back(req->name);
+                for (auto it = _failedRemove.begin(); it != _failedRemove.end(); ) {
+                    report.verbose(u"deleting obsolete segment file %s", {*it});
+                    if (!fs::remove(*it, &ErrCodeReport(report, u"error deleting", *it)) && fs::exists(*it)) {
+                        // Failed to delete, keep it to retry later.
+                        ++it;
+                    }
+                    else {
+                        it = _failedRemove.erase(it);
+                    }
+                }
+                break;
+            }
+            case FileAction::TERMINATE: {
+                for (auto& file : _files) {
+                    if (file.isOpen()) {
+                        file.close(report);
+                    }
+                }
+                terminate = true;
+                break;
+            }
+            default: {
+                assert(false);
+                break;
+            }
+        }
+
+        // The error will be reported by the plugin thread at next send().
+        if (!ok) {
+            _plugin->_writeError = true;
+        }
+    }
 }
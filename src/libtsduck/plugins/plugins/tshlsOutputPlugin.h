@@ -18,6 +18,8 @@
 #include "tsPCRAnalyzer.h"
 #include "tsContinuityAnalyzer.h"
 #include "tsFileNameGenerator.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 #include "tshlsPlayList.h"
 
 namespace ts {
@@ -31,6 +33,11 @@ namespace ts {
         //! playlists. To setup a complete HLS server, it is necessary to setup an
         //! external HTTP server such as Apache which simply serves these files.
         //!
+        //! All file operations (segment files, playlist, deletion of obsolete segments)
+        //! are performed by a separate writer thread. Thus, slow storage does not stall
+        //! the output of packets. With option -\-part-duration, a low-latency HLS output
+        //! is generated, with partial segments.
+        //!
         class TSDUCKDLL OutputPlugin: public ts::OutputPlugin, private TableHandlerInterface
         {
             TS_PLUGIN_CONSTRUCTORS(OutputPlugin);
@@ -59,6 +66,37 @@ namespace ts {
             size_t             _initialMediaSeq = 0;        // Initial media sequence value.
             UStringVector      _customTags {};              // Additional custom tags.
             TSPacketLabelSet   _closeLabels {};             // Close segment on packets with any of these labels.
+            MilliSecond        _partDuration = 0;           // Partial segment target duration (low-latency HLS).
+
+            // Asynchronous file operation, executed in order by the writer thread.
+            typedef SafePtr<TSPacketVector, std::mutex> PacketsPtr;
+            typedef SafePtr<hls::PlayList, std::mutex> PlayListPtr;
+            enum class FileAction {OPEN, WRITE, CLOSE, PUBLISH, REMOVE, TERMINATE};
+            enum FileIndex : size_t {SEGMENT_FILE, PART_FILE, FILE_COUNT};
+            class FileRequest
+            {
+            public:
+                FileAction  action = FileAction::TERMINATE;
+                FileIndex   file = SEGMENT_FILE;  // Target file for OPEN, WRITE, CLOSE.
+                UString     name {};              // File name for OPEN, REMOVE.
+                PacketsPtr  packets {};           // Packets to WRITE.
+                PlayListPtr playlist {};          // Playlist to PUBLISH.
+            };
+            typedef MessageQueue<FileRequest> FileQueue;
+
+            // The writer thread executes all file operations.
+            class Writer : public Thread
+            {
+                TS_NOBUILD_NOCOPY(Writer);
+            public:
+                Writer(OutputPlugin* plugin);
+                virtual ~Writer() override;
+            private:
+                OutputPlugin* const _plugin;
+                TSFile              _files[FILE_COUNT] {};  // Segment and partial segment files.
+                UStringList         _failedRemove {};       // Files we failed to delete (maybe locked by the Web server).
+                virtual void main() override;
+            };
 
             // Working data.
             FileNameGenerator  _nameGenerator {};           // Generate the segment file names.
@@ -70,12 +108,25 @@ namespace ts {
             uint8_t            _videoStreamType = ST_NULL;  // Stream type for video PID in PMT.
             bool               _segStarted = false;         // Generation of output segments has started.
             bool               _segClosePending = false;    // Close the current segment when possible.
-            TSFile             _segmentFile {};             // Output segment file.
-            UStringList        _liveSegmentFiles {};        // List of current segments in a live stream.
+            UString            _segmentName {};             // Current segment file name, empty if none.
+            PacketCounter      _segmentPackets = 0;         // Number of packets in current segment.
+            UString            _partName {};                // Current partial segment file name, empty if none.
+            size_t             _partIndex = 0;              // Index of current partial segment in current segment.
+            PacketCounter      _partPackets = 0;            // Number of packets in current partial segment.
+            bool               _partIndependent = false;    // Current partial segment contains an intra image.
+            ByteBlock          _videoStart {};              // Start of current video PES packet, until an intra image is found.
+            bool               _videoScan = false;          // Searching an intra image in _videoStart.
+            UStringList        _segmentFiles {};            // Files of current segment (segment and partial segments).
+            std::list<UStringList> _liveSegmentFiles {};    // Files of all current segments in a live stream.
             hls::PlayList      _playlist {};                // Generated playlist.
             PCRAnalyzer        _pcrAnalyzer {1, 4};         // PCR analyzer to compute bitrates. Minimum required: 1 PID, 4 PCR.
             BitRate            _previousBitrate = 0;        // Bitrate of previous segment.
             ContinuityAnalyzer _ccFixer;                    // To fix continuity counters in PAT and PMT PID's.
+            PacketsPtr         _pending {};                 // Packets to write in current segment and partial segment.
+            FileQueue          _fileQueue;                  // Queue of file operations for the writer thread.
+            Writer             _writer {this};              // Writer thread.
+            volatile bool      _writeError = false;         // A file operation failed in the writer thread.
+            bool               _writerStarted = false;      // The writer thread is running.
 
             // Create the next segment file (also close the previous one if necessary).
             bool createNextSegment();
@@ -83,6 +134,28 @@ namespace ts {
             // Close current segment file (also purge obsolete segment files and regenerate playlist).
             bool closeCurrentSegment(bool endOfStream);
 
+            // Maximum size of the start of a video PES packet which is searched for an intra image.
+            static constexpr size_t MAX_INTRA_SCAN_SIZE = 16 * PKT_SIZE;
+
+            // Search the start of an intra image in the video PID, in low-latency mode.
+            void scanIntraImage(const TSPacket& pkt);
+
+            // Create the next partial segment file, close the current one.
+            void createNextPart();
+            void closeCurrentPart();
+
+            // Current bitrate estimation.
+            BitRate currentBitRate() const;
+
+            // Post a request to the writer thread.
+            void postFileRequest(FileAction action, FileIndex file = SEGMENT_FILE, const UString& name = UString());
+
+            // Send the pending packets to the writer thread.
+            void flushPackets();
+
+            // Send a copy of the playlist to the writer thread.
+            void publishPlayList();
+
             // Implementation of TableHandlerInterface.
             virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
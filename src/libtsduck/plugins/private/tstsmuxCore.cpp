@@ -26,7 +26,8 @@ ts::tsmux::Core::Core(const MuxerArgs& opt, const PluginEventHandlerRegistry& ha
     _log(log),
     _opt(opt),
     _time_input_index(opt.timeInputIndex),
-    _inputs(_opt.inputs.size(), nullptr)
+    _inputs(_opt.inputs.size(), nullptr),
+    _ready_flags(_opt.inputs.size(), false)
 {
     // Preset common default options.
     _duck.restoreArgs(_opt.duckArgs);
@@ -185,16 +186,24 @@ void ts::tsmux::Core::main()
     _eit_pzer.reset();
 
     // Insertion interval for signalization.
-    const PacketCounter pat_interval = (_opt.outputBitRate / _opt.patBitRate).toInt();
-    const PacketCounter cat_interval = (_opt.outputBitRate / _opt.catBitRate).toInt();
-    const PacketCounter nit_interval = (_opt.outputBitRate / _opt.nitBitRate).toInt();
-    const PacketCounter sdt_interval = (_opt.outputBitRate / _opt.sdtBitRate).toInt();
-
-    // Reset signalization insertion.
-    PacketCounter next_pat_packet = 0;
-    PacketCounter next_cat_packet = 0;
-    PacketCounter next_nit_packet = 0;
-    PacketCounter next_sdt_packet = 0;
+    _psi_interval[SRC_PAT] = (_opt.outputBitRate / _opt.patBitRate).toInt();
+    _psi_interval[SRC_CAT] = (_opt.outputBitRate / _opt.catBitRate).toInt();
+    _psi_interval[SRC_NIT] = (_opt.outputBitRate / _opt.nitBitRate).toInt();
+    _psi_interval[SRC_SDT] = (_opt.outputBitRate / _opt.sdtBitRate).toInt();
+
+    // Reset the scheduler: all signalization is immediately due, input plugins are polled.
+    _schedule.clear();
+    _schedule_order = 0;
+    for (size_t i = 0; i < SRC_PSI_COUNT; ++i) {
+        _schedule.push_back(Due{0, PRIO_PSI, _schedule_order++, _inputs.size() + i});
+    }
+    std::make_heap(_schedule.begin(), _schedule.end(), std::greater<Due>());
+    _idle_inputs.assign(_inputs.size(), false);
+    _next_inputs.clear();
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        _next_inputs.push_back(i);
+    }
+    _null_packets = _pcr_packets = _pcr_delay = _pcr_max_delay = 0;
 
     // Insertion is cadenced using a monotonic clock.
     const Monotonic start(true);
@@ -206,9 +215,6 @@ void ts::tsmux::Core::main()
     // Keep track of terminated input plugins.
     _terminated_inputs.clear();
 
-    // Next input plugin to read from.
-    size_t input_index = 0;
-
     // Reset output packet counter.
     _output_packets = 0;
 
@@ -232,27 +238,8 @@ void ts::tsmux::Core::main()
 
             pkt_data.reset();
 
-            // This section selects packets to insert. Initially, the insertion strategy was very basic.
-            // To improve the muxing method, rework this section.
-
-            if (_output_packets >= next_pat_packet && _pat_pzer.getNextPacket(pkt)) {
-                // Got a PAT packet.
-                next_pat_packet += pat_interval;
-            }
-            else if (_output_packets >= next_cat_packet && _cat_pzer.getNextPacket(pkt)) {
-                // Got a CAT packet.
-                next_cat_packet += cat_interval;
-            }
-            else if (_output_packets >= next_nit_packet && _nit_pzer.getNextPacket(pkt)) {
-                // Got a NIT packet.
-                next_nit_packet += nit_interval;
-            }
-            else if (_output_packets >= next_sdt_packet && _sdt_bat_pzer.getNextPacket(pkt)) {
-                // Got an SDT packet.
-                next_sdt_packet += sdt_interval;
-            }
-            else if (getInputPacket(input_index, pkt, pkt_data)) {
-                // Got a packet from an input plugin.
+            if (getScheduledPacket(pkt, pkt_data)) {
+                // Got a due packet from an input plugin or an output PSI/SI.
             }
             else if (_eit_pzer.getNextPacket(pkt)) {
                 // Got an EIT packet. Note that EIT are muxed, not cycled. So, they are inserted when available.
@@ -261,6 +248,7 @@ void ts::tsmux::Core::main()
                 // Nothing is available, insert a null packet.
                 pkt = NullPacket;
                 pkt_data.setNullified(true);
+                _null_packets++;
             }
 
             // Output that packet.
@@ -286,36 +274,177 @@ void ts::tsmux::Core::main()
     // Or if the output thread terminated on error, we must terminate all input threads.
     stop();
 
+    // Report scheduling statistics. The delay of PCR packets after their due time is the PCR jitter which is
+    // introduced by the multiplexing (the PCR values are restamped according to their actual position).
+    const auto to_us = [this](PacketCounter packets) -> MicroSecond {
+        return _bitrate == 0 ? 0 : ((BitRate(packets) * PKT_SIZE_BITS * MicroSecPerSec) / _bitrate).toInt();
+    };
+    _log.verbose(u"output: %'d packets, %'d null packets, %'d PCR packets", {_output_packets, _null_packets, _pcr_packets});
+    if (_pcr_packets > 0) {
+        _log.verbose(u"PCR scheduling delay: average %'d packets (%'d us), max %'d packets (%'d us)",
+                     {_pcr_delay / _pcr_packets, to_us(_pcr_delay) / _pcr_packets, _pcr_max_delay, to_us(_pcr_max_delay)});
+    }
+
     _log.debug(u"core thread terminated");
 }
 
 
 //----------------------------------------------------------------------------
-// Get a packet from plugin at given index.
+// Order of packets in the scheduler.
 //----------------------------------------------------------------------------
 
-bool ts::tsmux::Core::getInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data)
+bool ts::tsmux::Core::Due::operator>(const Due& other) const
 {
-    bool success = false;
-    size_t plugin_count = 0;
-    do {
-        // Try to get a packet from current plugin.
-        success = _inputs[input_index]->getPacket(pkt, pkt_data);
+    if (packet != other.packet) {
+        return packet > other.packet;
+    }
+    else if (priority != other.priority) {
+        return priority > other.priority;
+    }
+    else {
+        return order > other.order;
+    }
+}
 
-        // Keep track of terminated input plugins.
-        if (!success && _inputs[input_index]->isTerminated()) {
-            _terminated_inputs.insert(input_index);
-            if (_terminated_inputs.size() >= _inputs.size()) {
-                // All input plugins are now terminated. Request global termination.
-                _terminate = true;
+
+//----------------------------------------------------------------------------
+// Get the packetizer of an output PSI/SI.
+//----------------------------------------------------------------------------
+
+ts::CyclingPacketizer& ts::tsmux::Core::psiPacketizer(size_t psi_index)
+{
+    switch (psi_index) {
+        case SRC_PAT: return _pat_pzer;
+        case SRC_CAT: return _cat_pzer;
+        case SRC_NIT: return _nit_pzer;
+        case SRC_SDT:
+        default: return _sdt_bat_pzer;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next due packet from the scheduler.
+//----------------------------------------------------------------------------
+
+bool ts::tsmux::Core::getScheduledPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    // Schedule the input plugins which sent a packet at the previous slot and the ones which received packets.
+    if (!_next_inputs.empty() || _inputs_ready) {
+        pollInputs();
+    }
+
+    while (!_terminate && !_schedule.empty() && _schedule.front().packet <= _output_packets) {
+
+        // Remove the earliest due source from the scheduler.
+        std::pop_heap(_schedule.begin(), _schedule.end(), std::greater<Due>());
+        Due next(_schedule.back());
+        _schedule.pop_back();
+
+        if (next.source < _inputs.size()) {
+            // Get the packet from the input plugin. The next packet of the plugin is fetched at the next slot:
+            // the due time of a PCR packet is computed from the position of the previous one, which must be
+            // in a previous slot.
+            Input& input(*_inputs[next.source]);
+            input.getPacket(pkt, pkt_data);
+            if (pkt.hasPCR()) {
+                const PacketCounter delay = _output_packets - next.packet;
+                _pcr_packets++;
+                _pcr_delay += delay;
+                _pcr_max_delay = std::max(_pcr_max_delay, delay);
+            }
+            _next_inputs.push_back(next.source);
+            return true;
+        }
+        else {
+            // Output PSI/SI. When there is no table yet, retry at the next packet.
+            const size_t psi = next.source - _inputs.size();
+            const bool got = psiPacketizer(psi).getNextPacket(pkt);
+            next.packet = got ? next.packet + _psi_interval[psi] : _output_packets + 1;
+            next.order = _schedule_order++;
+            _schedule.push_back(next);
+            std::push_heap(_schedule.begin(), _schedule.end(), std::greater<Due>());
+            if (got) {
+                return true;
             }
         }
+    }
+    return false;
+}
 
-        // Point to next plugin.
-        input_index = (input_index + 1) % _inputs.size();
 
-    } while (!_terminate && !success && ++plugin_count < _inputs.size());
-    return success;
+//----------------------------------------------------------------------------
+// Schedule the next packet from an input plugin.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::scheduleInput(size_t input_index)
+{
+    Input& input(*_inputs[input_index]);
+    if (input.fetchPacket()) {
+        _schedule.push_back(Due{input.dueTime(), input.priority(), _schedule_order++, input_index});
+        std::push_heap(_schedule.begin(), _schedule.end(), std::greater<Due>());
+    }
+    else if (input.isTerminated()) {
+        // Keep track of terminated input plugins.
+        _terminated_inputs.insert(input_index);
+        if (_terminated_inputs.size() >= _inputs.size()) {
+            // All input plugins are now terminated. Request global termination.
+            _terminate = true;
+        }
+    }
+    else {
+        // No packet available now, will poll again when the input thread notifies new packets.
+        _idle_inputs[input_index] = true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Notification of new packets from an input plugin thread.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::inputReceived(size_t input_index)
+{
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+    if (input_index < _ready_flags.size() && !_ready_flags[input_index]) {
+        _ready_flags[input_index] = true;
+        _ready_inputs.push_back(input_index);
+        _inputs_ready = true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Poll the input plugins which are not in the scheduler.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::pollInputs()
+{
+    // Input plugins which sent a packet at the previous slot.
+    for (auto index : _next_inputs) {
+        scheduleInput(index);
+    }
+    _next_inputs.clear();
+
+    // Idle input plugins which notified new packets. The notification flags are cleared before polling
+    // the plugins: packets which are received after that point will be notified again.
+    if (_inputs_ready) {
+        {
+            std::lock_guard<std::mutex> lock(_ready_mutex);
+            _polled_inputs.swap(_ready_inputs);
+            for (auto index : _polled_inputs) {
+                _ready_flags[index] = false;
+            }
+            _inputs_ready = false;
+        }
+        for (auto index : _polled_inputs) {
+            if (_idle_inputs[index]) {
+                _idle_inputs[index] = false;
+                scheduleInput(index);
+            }
+        }
+        _polled_inputs.clear();
+    }
 }
 
 
@@ -395,11 +524,12 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
     _terminated(false),
     _got_ts_id(false),
     _ts_id(0),
-    _input(_core._opt, core._handlers, index, _core._log),
+    _input(_core._opt, core._handlers, index, core, _core._log),
     _demux(_core._duck, this, nullptr),
     _eit_demux(_core._duck, nullptr, this),
     _pcr_merger(_core._duck),
     _nit(),
+    _has_next(false),
     _next_insertion(0),
     _next_packet(),
     _next_metadata(),
@@ -429,91 +559,94 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
 
 
 //----------------------------------------------------------------------------
-// Get one input packet. Return false when none is immediately available.
+// Fetch the next input packet to insert and compute its due time.
 //----------------------------------------------------------------------------
 
-bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+bool ts::tsmux::Core::Input::fetchPacket()
 {
-    // If there is a waiting packet, either return that packet or nothing.
-    if (_next_insertion > 0) {
-        if (_next_insertion <= _core._output_packets) {
-            // It is now time to return that packet.
-            _core._log.debug(u"input #%d, PID 0x%X (%<d), output packet %'d, restarting insertion", {_plugin_index, _next_packet.getPID(), _core._output_packets});
-            _next_insertion = 0;
-            pkt = _next_packet;
-            pkt_data = _next_metadata;
-            adjustPCR(pkt);
-            return true;
-        }
-        else {
-            // Not yet time to release a packet from that input stream.
+    while (!_has_next) {
+
+        // Get one packet from the input executor thread, non-blocking.
+        size_t ret_count = 0;
+        _terminated = _terminated || !_input.getPackets(&_next_packet, &_next_metadata, 1, ret_count, false);
+        if (_terminated || ret_count == 0) {
             return false;
         }
-    }
+        const PID pid = _next_packet.getPID();
 
-    // Get one packet from the input executor thread, non-blocking.
-    size_t ret_count = 0;
-    _terminated = _terminated || !_input.getPackets(&pkt, &pkt_data, 1, ret_count, false);
-    if (_terminated || ret_count == 0) {
-        return false;
-    }
-    const PID pid = pkt.getPID();
+        // Feed the two PSI/SI demux.
+        _demux.feedPacket(_next_packet);
+        _eit_demux.feedPacket(_next_packet);
 
-    // Feed the two PSI/SI demux.
-    _demux.feedPacket(pkt);
-    _eit_demux.feedPacket(pkt);
+        // If this is TDT/TOT PID, check if we need to pass it.
+        if (pid == PID_TDT && _core._time_input_index == NPOS) {
+            // Time PID not yet selected. If we find a time here, we will use that plugin.
+            Time utc;
+            if (_core.getUTC(utc, _next_packet)) {
+                // From now on, we will use that input plugin as time reference.
+                _core._time_input_index = _plugin_index;
+                _core._log.verbose(u"using input #%d as TDT/TOT reference", {_plugin_index});
+            }
+        }
 
-    // If this is TDT/TOT PID, check if we need to pass it.
-    if (pid == PID_TDT && _core._time_input_index == NPOS) {
-        // Time PID not yet selected. If we find a time here, we will use that plugin.
-        Time utc;
-        if (_core.getUTC(utc, pkt)) {
-            // From now on, we will use that input plugin as time reference.
-            _core._time_input_index = _plugin_index;
-            _core._log.verbose(u"using input #%d as TDT/TOT reference", {_plugin_index});
+        // Don't insert packets from predefined PID's, they are separately regenerated.
+        if (pid <= PID_DVB_LAST && (pid != PID_TDT || _core._time_input_index != _plugin_index)) {
+            continue;
         }
-    }
 
-    // If the packet contains a PCR, check if it is time to insert it in the output.
-    // PCR packets are inserted at the same (or similar) PCR interval as in the orginal stream.
-    if (pkt.hasPCR()) {
-        const auto clock = _pid_clocks.find(pid);
-        if (clock != _pid_clocks.end()) {
-            const uint64_t packet_pcr = pkt.getPCR();
-            if (packet_pcr < clock->second.pcr_value && !WrapUpPCR(clock->second.pcr_value, packet_pcr)) {
-                const uint64_t back = DiffPCR(packet_pcr, clock->second.pcr_value);
-                _core._log.verbose(u"input #%d, PID 0x%X (%<d), late packet by PCR %'d, %'s ms", {_plugin_index, pid, back, (back * MilliSecPerSec) / SYSTEM_CLOCK_FREQ});
-            }
-            else {
-                // Compute current PCR for previous packet in the output TS.
-                assert(_core._output_packets > clock->second.pcr_packet);
-                const uint64_t output_pcr = NextPCR(clock->second.pcr_value, _core._output_packets - clock->second.pcr_packet - 1, _core._bitrate);
-
-                // Compute difference between packet's PCR and current output PCR.
-                // If they differ by more than one second, we consider that there was a clock leap and
-                // we just let the packet pass without PCR adjustment. If the difference is less than
-                // one second, we consider that the PCR progression is valid and we synchronize on it.
-                if (AbsDiffPCR(packet_pcr, output_pcr) < SYSTEM_CLOCK_FREQ) {
-                    // Compute the theoretical position of the packet in the output stream.
-                    const PacketCounter target_packet = clock->second.pcr_packet + PacketDistanceFromPCR(_core._bitrate, DiffPCR(clock->second.pcr_value, packet_pcr));
-                    if (target_packet > _core._output_packets) {
-                        // This packet will be inserted later.
-                        _core._log.debug(u"input #%d, PID 0x%X (%<d), output packet %'d, delay packet by %'d packets", {_plugin_index, pid, _core._output_packets, target_packet - _core._output_packets});
-                        _next_insertion = target_packet;
-                        _next_packet = pkt;
-                        _next_metadata = pkt_data;
-                        return false;
+        // By default, the packet is due immediately.
+        _has_next = true;
+        _next_insertion = _core._output_packets;
+
+        // If the packet contains a PCR, compute when it is time to insert it in the output.
+        // PCR packets are inserted at the same (or similar) PCR interval as in the orginal stream.
+        if (_next_packet.hasPCR()) {
+            const auto clock = _pid_clocks.find(pid);
+            if (clock != _pid_clocks.end()) {
+                const uint64_t packet_pcr = _next_packet.getPCR();
+                if (packet_pcr < clock->second.pcr_value && !WrapUpPCR(clock->second.pcr_value, packet_pcr)) {
+                    const uint64_t back = DiffPCR(packet_pcr, clock->second.pcr_value);
+                    _core._log.verbose(u"input #%d, PID 0x%X (%<d), late packet by PCR %'d, %'s ms", {_plugin_index, pid, back, (back * MilliSecPerSec) / SYSTEM_CLOCK_FREQ});
+                }
+                else {
+                    // Compute current PCR for previous packet in the output TS.
+                    assert(_core._output_packets > clock->second.pcr_packet);
+                    const uint64_t output_pcr = NextPCR(clock->second.pcr_value, _core._output_packets - clock->second.pcr_packet - 1, _core._bitrate);
+
+                    // Compute difference between packet's PCR and current output PCR.
+                    // If they differ by more than one second, we consider that there was a clock leap and
+                    // we just let the packet pass without PCR adjustment. If the difference is less than
+                    // one second, we consider that the PCR progression is valid and we synchronize on it.
+                    if (AbsDiffPCR(packet_pcr, output_pcr) < SYSTEM_CLOCK_FREQ) {
+                        // Compute the theoretical position of the packet in the output stream.
+                        const PacketCounter target_packet = clock->second.pcr_packet + PacketDistanceFromPCR(_core._bitrate, DiffPCR(clock->second.pcr_value, packet_pcr));
+                        if (target_packet > _core._output_packets) {
+                            // This packet will be inserted later.
+                            _core._log.debug(u"input #%d, PID 0x%X (%<d), output packet %'d, delay packet by %'d packets", {_plugin_index, pid, _core._output_packets, target_packet - _core._output_packets});
+                            _next_insertion = target_packet;
+                        }
                     }
                 }
             }
         }
     }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the fetched packet for insertion in the output stream, now.
+//----------------------------------------------------------------------------
+
+void ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    assert(_has_next);
+    _has_next = false;
+    pkt = _next_packet;
+    pkt_data = _next_metadata;
 
     // Adjust and remember PCR values and position.
     adjustPCR(pkt);
-
-    // Don't return packets from predefined PID's, they are separately regenerated.
-    return pid > PID_DVB_LAST || (pid == PID_TDT && _core._time_input_index == _plugin_index);
 }
 
 
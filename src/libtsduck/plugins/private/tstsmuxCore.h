@@ -64,6 +64,13 @@ namespace ts {
             //!
             void waitForTermination();
 
+            //!
+            //! Called by an input plugin thread when it received packets or terminated.
+            //! An input plugin without available packet is scheduled again after this notification only.
+            //! @param [in] input_index Index of the input plugin.
+            //!
+            void inputReceived(size_t input_index);
+
         private:
             // Description of an input stream.
             class Input;
@@ -86,6 +93,25 @@ namespace ts {
                 PIDClock(uint64_t value = INVALID_PCR, PacketCounter packet = 0) : pcr_value(value), pcr_packet(packet) {}
             };
 
+            // The scheduler is a priority queue of the next due packet of each source. Input plugins are
+            // the sources 0 to N-1, followed by the packetizers of the output PSI/SI. The scheduler always
+            // selects the earliest due packet. On identical due time, the priority and then the scheduling
+            // order (FIFO) are used. When an input plugin has sent its packet, it is removed from the queue and
+            // polled again at the next output packet. When an input plugin has no packet available, it is idle,
+            // outside the queue, until its thread notifies new packets.
+            enum : size_t {SRC_PAT, SRC_CAT, SRC_NIT, SRC_SDT, SRC_PSI_COUNT};  // Offsets after the input plugins.
+            enum : int {PRIO_PSI, PRIO_PCR, PRIO_DATA};  // Priorities on identical due time, lower first.
+
+            class Due
+            {
+            public:
+                PacketCounter packet = 0;    // Index of the output packet at which the source is due.
+                int           priority = 0;  // Priority on identical due time, lower first.
+                uint64_t      order = 0;     // Scheduling order, first scheduled first served on identical due time.
+                size_t        source = 0;    // Source index.
+                bool operator>(const Due& other) const;
+            };
+
             // Core private members.
             const PluginEventHandlerRegistry& _handlers;
             Report&             _log;                      // Asynchronous log report.
@@ -112,12 +138,36 @@ namespace ts {
             std::map<PID,Origin>      _pid_origin {};      // Map of PID's to original input stream.
             std::map<uint16_t,Origin> _service_origin {};  // Map of service ids to original input stream.
 
+            // Scheduler state.
+            std::vector<Due>    _schedule {};              // Binary heap, earliest due packet first (std::push_heap with std::greater).
+            uint64_t            _schedule_order = 0;       // Scheduling order counter.
+            PacketCounter       _psi_interval[SRC_PSI_COUNT] {}; // Insertion interval of the output PSI/SI.
+            std::vector<size_t> _next_inputs {};           // Input plugins to poll at the next output packet.
+            std::vector<bool>   _idle_inputs {};           // Input plugins which wait for new packets, index by input.
+            std::vector<size_t> _polled_inputs {};         // Input plugins being polled after notification.
+            std::mutex          _ready_mutex {};           // Protect the notifications from input threads.
+            std::vector<size_t> _ready_inputs {};          // Input plugins which notified packets since last poll [_ready_mutex].
+            std::vector<bool>   _ready_flags {};           // Input plugins which are in _ready_inputs, index by input [_ready_mutex].
+            std::atomic<bool>   _inputs_ready {false};     // Some input plugins are in _ready_inputs.
+            PacketCounter       _null_packets = 0;         // Number of inserted null packets.
+            PacketCounter       _pcr_packets = 0;          // Number of output packets with PCR.
+            PacketCounter       _pcr_delay = 0;            // Accumulated delay of PCR packets after their due time, in packets.
+            PacketCounter       _pcr_max_delay = 0;        // Maximum delay of PCR packets after their due time, in packets.
+
             // Implementation of Thread.
             virtual void main() override;
 
-            // Get a packet from plugin at given index. If none is available, try next input and so on.
-            // Update the plugin index. Return false if all input plugins were tried without success.
-            bool getInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data);
+            // Get the next due packet from the scheduler. Return false if no packet is due.
+            bool getScheduledPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
+
+            // Schedule the next packet from an input plugin, if one is available.
+            void scheduleInput(size_t input_index);
+
+            // Poll the input plugins which sent a packet at the previous slot or notified new packets.
+            void pollInputs();
+
+            // Get the packetizer of an output PSI/SI.
+            CyclingPacketizer& psiPacketizer(size_t psi_index);
 
             // Try to extract a UTC time from a TDT or TOT in one TS packet.
             bool getUTC(Time& utc, const TSPacket& pkt);
@@ -155,8 +205,16 @@ namespace ts {
                 // Wait for the executor thread to terminate.
                 void waitForTermination() { _input.waitForTermination(); }
 
-                // Get one input packet. Return false when none is immediately available.
-                bool getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
+                // Fetch the next input packet to insert and compute its due time in the output stream.
+                // Return false when none is immediately available.
+                bool fetchPacket();
+
+                // Due time and scheduling priority of the fetched packet.
+                PacketCounter dueTime() const { return _next_insertion; }
+                int priority() const { return _next_packet.hasPCR() ? PRIO_PCR : PRIO_DATA; }
+
+                // Get the fetched packet for insertion in the output stream, now.
+                void getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
 
             private:
                 Core&            _core;           // Reference to the parent Core.
@@ -169,6 +227,7 @@ namespace ts {
                 SectionDemux     _eit_demux;      // Demux for EIT's.
                 PCRMerger        _pcr_merger;     // Adjust PCR in input packets to be synchronized with the output stream.
                 NIT              _nit;            // NIT waiting to be merged.
+                bool             _has_next;       // There is a fetched packet to insert.
                 PacketCounter    _next_insertion; // Insertion point of next packet.
                 TSPacket         _next_packet;    // Next packet to insert if already received but not yet inserted.
                 TSPacketMetadata _next_metadata;  // Associated metadata.
@@ -7,17 +7,19 @@
 //----------------------------------------------------------------------------
 
 #include "tstsmuxInputExecutor.h"
+#include "tstsmuxCore.h"
 
 
 //----------------------------------------------------------------------------
 // Constructor and destructor.
 //----------------------------------------------------------------------------
 
-ts::tsmux::InputExecutor::InputExecutor(const MuxerArgs& opt, const PluginEventHandlerRegistry& handlers, size_t index, Report& log) :
+ts::tsmux::InputExecutor::InputExecutor(const MuxerArgs& opt, const PluginEventHandlerRegistry& handlers, size_t index, Core& core, Report& log) :
     // Input threads have a high priority to be always ready to load incoming packets in the buffer.
     PluginExecutor(opt, handlers, PluginType::INPUT, opt.inputs[index], ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority()), log),
     _input(dynamic_cast<InputPlugin*>(PluginThread::plugin())),
-    _pluginIndex(index)
+    _pluginIndex(index),
+    _core(core)
 {
     // Make sure that the input plugins display their index.
     setLogName(UString::Format(u"%s[%d]", {pluginName(), _pluginIndex}));
@@ -129,10 +131,14 @@ void ts::tsmux::InputExecutor::main()
             count = _input->receive(&_packets[first], &_metadata[first], std::min(count, _opt.maxInputPackets));
             if (count > 0) {
                 // Packets successfully received.
-                std::unique_lock<std::recursive_mutex> lock(_mutex);
-                _packets_count += count;
-                // Signal that there are some new packets in the buffer.
-                _got_packets.notify_all();
+                {
+                    std::unique_lock<std::recursive_mutex> lock(_mutex);
+                    _packets_count += count;
+                    // Signal that there are some new packets in the buffer.
+                    _got_packets.notify_all();
+                }
+                // Notify the core, in case this input is waiting for packets.
+                _core.inputReceived(_pluginIndex);
             }
             else if (_opt.inputOnce) {
                 // Terminates when the input plugin terminates or fails.
@@ -149,7 +155,8 @@ void ts::tsmux::InputExecutor::main()
         }
     }
 
-    // Stop the plugin.
+    // Stop the plugin. Notify the core which will see the termination.
     _input->stop();
+    _core.inputReceived(_pluginIndex);
     debug(u"input thread terminated");
 }
@@ -18,6 +18,9 @@
 
 namespace ts {
     namespace tsmux {
+
+        class Core;
+
         //!
         //! Execution context of a tsmux input plugin.
         //! @ingroup plugin
@@ -31,9 +34,10 @@ namespace ts {
             //! @param [in] opt Command line options.
             //! @param [in] handlers Registry of event handlers.
             //! @param [in] index Input plugin index.
+            //! @param [in,out] core Multiplexer core instance, notified when new packets are received.
             //! @param [in,out] log Log report.
             //!
-            InputExecutor(const MuxerArgs& opt, const PluginEventHandlerRegistry& handlers, size_t index, Report& log);
+            InputExecutor(const MuxerArgs& opt, const PluginEventHandlerRegistry& handlers, size_t index, Core& core, Report& log);
 
             //!
             //! Virtual destructor.
@@ -61,6 +65,7 @@ namespace ts {
         private:
             InputPlugin* _input;         // Plugin API.
             const size_t _pluginIndex;   // Index of this input plugin.
+            Core&        _core;          // Multiplexer core instance.
 
             // Implementation of Thread.
             virtual void main() override;
@@ -32,15 +32,22 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, std
         _output = _input->ringPrevious<OutputExecutor>();
         assert(_output != nullptr);
 
-        // Loop on all plugins between inputs and outputs
+        // Loop on all plugins after the input, up to the output.
         PluginExecutor* proc = _input;
-        while ((proc = proc->ringNext<PluginExecutor>()) != _output) {
-            ProcessorExecutor* pe = dynamic_cast<ProcessorExecutor*>(proc);
-            assert(pe != nullptr);
-            _plugins.push_back(pe);
+        do {
+            proc = proc->ringNext<PluginExecutor>();
+            _plugins.push_back(proc);
+        } while (proc != _output);
+
+        // Additional output plugins are parallel branches of the main one, with their specific packet processors.
+        for (auto br : _output->branches()) {
+            proc = br;
+            do {
+                _plugins.push_back(proc);
+            } while ((proc = proc->ringNext<PluginExecutor>()) != br);
         }
     }
-    _log.debug(u"found %d packet processor plugins", {_plugins.size()});
+    _log.debug(u"found %d packet processor and output plugins", {_plugins.size()});
 
     // Register command handlers.
     _reference.setCommandLineHandler(this, &ControlServer::executeExit, u"exit");
@@ -194,10 +201,10 @@ ts::CommandStatus ts::tsp::ControlServer::executeSetLog(const UString& command,
 
     // Also set the log severity on each individual plugin.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
-    PluginExecutor* proc = _input;
-    do {
+    _input->setMaxSeverity(level);
+    for (auto proc : _plugins) {
         proc->setMaxSeverity(level);
-    } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
+    }
 
     return CommandStatus::SUCCESS;
 }
@@ -216,11 +223,9 @@ ts::CommandStatus ts::tsp::ControlServer::executeList(const UString& command, Ar
     }
 
     listOnePlugin(0, u'I', _input, args);
-    size_t index = 1;
     for (size_t i = 0; i < _plugins.size(); ++i) {
-        listOnePlugin(index++, u'P', _plugins[i], args);
+        listOnePlugin(i + 1, _plugins[i]->plugin()->type() == PluginType::OUTPUT ? u'O' : u'P', _plugins[i], args);
     }
-    listOnePlugin(index, u'O', _output, args);
 
     if (args.verbose()) {
         args.info(u"");
@@ -260,14 +265,11 @@ ts::CommandStatus ts::tsp::ControlServer::executeSuspendResume(bool state, Args&
     if (index > 0 && index <= _plugins.size()) {
         _plugins[index-1]->setSuspended(state);
     }
-    else if (index == _plugins.size() + 1) {
-        _output->setSuspended(state);
-    }
     else if (index == 0) {
         args.error(u"cannot suspend/resume the input plugin");
     }
     else {
-        args.error(u"invalid plugin index %d, specify 1 to %d", {index, _plugins.size() + 1});
+        args.error(u"invalid plugin index %d, specify 1 to %d", {index, _plugins.size()});
     }
     return CommandStatus::SUCCESS;
 }
@@ -283,7 +285,7 @@ ts::CommandStatus ts::tsp::ControlServer::executeRestart(const UString& command,
     UStringVector params;
     args.getValues(params);
     size_t index = 0;
-    if (params.empty() || !params[0].toInteger(index) || index > _plugins.size() + 1) {
+    if (params.empty() || !params[0].toInteger(index) || index > _plugins.size()) {
         args.error(u"invalid plugin index");
         return CommandStatus::ERROR;
     }
@@ -303,11 +305,8 @@ ts::CommandStatus ts::tsp::ControlServer::executeRestart(const UString& command,
     if (index == 0) {
         plugin = _input;
     }
-    else if (index <= _plugins.size()) {
-        plugin = _plugins[index-1];
-    }
     else {
-        plugin = _output;
+        plugin = _plugins[index-1];
     }
 
     // Restart the plugin.
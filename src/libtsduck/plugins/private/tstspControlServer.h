@@ -67,7 +67,7 @@ namespace ts {
             std::recursive_mutex& _global_mutex;
             InputExecutor*        _input = nullptr;
             OutputExecutor*       _output = nullptr;
-            std::vector<ProcessorExecutor*> _plugins {};  // Packet processing plugins
+            std::vector<PluginExecutor*> _plugins {};  // All packet processing and output plugins, in plugin index order
 
             // Implementation of Thread.
             virtual void main() override;
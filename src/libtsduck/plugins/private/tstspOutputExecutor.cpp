@@ -16,16 +16,18 @@
 ts::tsp::OutputExecutor::OutputExecutor(const TSProcessorArgs& options,
                                         const PluginEventHandlerRegistry& handlers,
                                         const PluginOptions& pl_options,
+                                        size_t plugin_index,
                                         const ThreadAttributes& attributes,
                                         std::recursive_mutex& global_mutex,
                                         Report* report) :
 
     PluginExecutor(options, handlers, PluginType::OUTPUT, pl_options, attributes, global_mutex, report),
-    _output(dynamic_cast<OutputPlugin*>(PluginThread::plugin()))
+    _output(dynamic_cast<OutputPlugin*>(PluginThread::plugin())),
+    _plugin_index(plugin_index)
 {
     if (options.log_plugin_index) {
-        // Make sure that plugins display their index. Output plugin is always last.
-        setLogName(UString::Format(u"%s[%d]", {pluginName(), options.plugins.size() + 1}));
+        // Make sure that plugins display their index.
+        setLogName(UString::Format(u"%s[%d]", {pluginName(), _plugin_index}));
     }
 }
 
@@ -41,8 +43,7 @@ ts::tsp::OutputExecutor::~OutputExecutor()
 
 size_t ts::tsp::OutputExecutor::pluginIndex() const
 {
-    // An input plugin is always last.
-    return pluginCount() - 1;
+    return _plugin_index;
 }
 
 
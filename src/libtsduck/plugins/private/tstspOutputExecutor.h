@@ -31,6 +31,7 @@ namespace ts {
             //! @param [in] options Command line options for tsp.
             //! @param [in] handlers Registry of event handlers.
             //! @param [in] pl_options Command line options for this plugin.
+            //! @param [in] plugin_index Index of this plugin in the chain, the input plugin being at index zero.
             //! @param [in] attributes Creation attributes for the thread executing this plugin.
             //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
             //! @param [in,out] report Where to report logs.
@@ -38,6 +39,7 @@ namespace ts {
             OutputExecutor(const TSProcessorArgs& options,
                            const PluginEventHandlerRegistry& handlers,
                            const PluginOptions& pl_options,
+                           size_t plugin_index,
                            const ThreadAttributes& attributes,
                            std::recursive_mutex& global_mutex,
                            Report* report);
@@ -52,6 +54,7 @@ namespace ts {
 
         private:
             OutputPlugin* _output = nullptr;
+            const size_t  _plugin_index;
 
             // Inherited from Thread
             virtual void main() override;
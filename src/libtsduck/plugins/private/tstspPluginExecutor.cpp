@@ -43,8 +43,12 @@ ts::tsp::PluginExecutor::~PluginExecutor()
 
 size_t ts::tsp::PluginExecutor::pluginCount() const
 {
-    // Input plugin, all processor plugins, output plugin.
-    return _options.plugins.size() + 2;
+    // Input plugin, all processor plugins, all output plugins and their specific processor plugins.
+    size_t count = _options.plugins.size() + _options.branch_outputs.size() + 2;
+    for (size_t i = 0; i < _options.branch_outputs.size() && i < _options.branch_plugins.size(); ++i) {
+        count += _options.branch_plugins[i].size();
+    }
+    return count;
 }
 
 
@@ -67,7 +71,54 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.notify_one();
+    previousExecutor()->_to_do.notify_one();
+    for (auto br : _branches) {
+        br->setAbort();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Attach a parallel branch to this plugin executor.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::addBranch(PluginExecutor* branch, PacketBuffer* buffer, PacketMetadataBuffer* metadata)
+{
+    if (branch != nullptr && branch != this && branch->_trunk == nullptr && branch->_branches.empty() &&
+        (branch->ringAlone() || (buffer != nullptr && metadata != nullptr)))
+    {
+        // All executors in the branch are attached to this trunk.
+        PluginExecutor* proc = branch;
+        do {
+            proc->_trunk = this;
+            proc->_branch_head = branch;
+        } while ((proc = proc->ringNext<PluginExecutor>()) != branch);
+
+        // A chain of executors needs a private copy of the packets.
+        if (!branch->ringAlone()) {
+            branch->_branch_buffer = buffer;
+            branch->_branch_metadata = metadata;
+        }
+        _branches.push_back(branch);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Previous and next executors in the ring.
+//----------------------------------------------------------------------------
+
+ts::tsp::PluginExecutor* ts::tsp::PluginExecutor::previousExecutor()
+{
+    // In a branch, the first executor receives its packets from the previous executor of the trunk.
+    return _trunk == nullptr || _branch_head == this ? (_trunk != nullptr ? _trunk : this)->ringPrevious<PluginExecutor>() : ringPrevious<PluginExecutor>();
+}
+
+ts::tsp::PluginExecutor* ts::tsp::PluginExecutor::nextExecutor()
+{
+    // In a branch, the last executor passes its packets to the next executor of the trunk.
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    return _trunk != nullptr && next == _branch_head ? _trunk->ringNext<PluginExecutor>() : next;
 }
 
 
@@ -95,7 +146,13 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
                                          const BitRate&        bitrate,
                                          BitRateConfidence     br_confidence)
 {
-    log(10, u"initBuffer(..., pkt_first = %'d, pkt_cnt = %'d, input_end = %s, aborted = %s, bitrate = %'d)", {pkt_first, pkt_cnt, input_end, aborted, bitrate});
+    trace<10>(u"initBuffer(..., pkt_first = %'d, pkt_cnt = %'d, input_end = %s, aborted = %s, bitrate = %'d)", pkt_first, pkt_cnt, input_end, aborted, bitrate);
+
+    // In a branch with a private buffer, the packets are copied at the same index in the private buffer.
+    if (_branch_buffer != nullptr) {
+        buffer = _branch_buffer;
+        metadata = _branch_metadata;
+    }
 
     _buffer = buffer;
     _metadata = metadata;
@@ -107,6 +164,20 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
     _br_confidence = br_confidence;
     _tsp_bitrate = bitrate;
     _tsp_bitrate_confidence = br_confidence;
+    _branch_passed = _all_passed = 0;
+    _pkt_copied = 0;
+
+    // All branches start with the same slice of buffer.
+    for (auto br : _branches) {
+        br->initBuffer(buffer, metadata, pkt_first, pkt_cnt, input_end, aborted, bitrate, br_confidence);
+    }
+
+    // The other executors of a branch start with an empty slice, at the same index.
+    if (_branch_head == this) {
+        for (PluginExecutor* proc = ringNext<PluginExecutor>(); proc != this; proc = proc->ringNext<PluginExecutor>()) {
+            proc->initBuffer(buffer, metadata, pkt_first, 0, input_end, aborted, bitrate, br_confidence);
+        }
+    }
 }
 
 
@@ -118,7 +189,7 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 {
     assert(count <= _pkt_cnt);
 
-    log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
+    trace<10>(u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", count, bitrate, input_end, aborted);
 
     // We access data under the protection of the global mutex.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
@@ -126,20 +197,26 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     // Update our buffer: we remove the first 'count' packets from the beginning of our slice of the buffer.
     _pkt_first = (_pkt_first + count) % _buffer->count();
     _pkt_cnt -= count;
+    _pkt_copied -= std::min(_pkt_copied, count);
+
+    // With parallel branches, the packets can be passed to the next processor in the ring only when
+    // the trunk and all branches have passed them. Pass only what the slowest one passed. Inside
+    // a branch, the packets are directly passed to the next executor of the branch.
+    PluginExecutor* const trunk = _trunk != nullptr ? _trunk : this;
+    if (!trunk->_branches.empty() && (_trunk == nullptr || ringNext<PluginExecutor>() == _branch_head)) {
+        (_trunk != nullptr ? _branch_head : this)->_branch_passed += count;
+        PacketCounter all_passed = trunk->_branch_passed;
+        for (auto br : trunk->_branches) {
+            all_passed = std::min(all_passed, br->_branch_passed);
+        }
+        count = size_t(all_passed - trunk->_all_passed);
+        trunk->_all_passed = all_passed;
+    }
 
     // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
-    PluginExecutor* next = ringNext<PluginExecutor>();
-    next->_pkt_cnt += count;
-
     // Propagate bitrate and end of input flag to next processor.
-    next->_bitrate = bitrate;
-    next->_br_confidence = br_confidence;
-    next->_input_end = next->_input_end || input_end;
-
-    // Wake the next processor when there is some new input data or end of input.
-    if (count > 0 || input_end) {
-        next->_to_do.notify_one();
-    }
+    PluginExecutor* next = nextExecutor();
+    next->receivePackets(count, bitrate, br_confidence, input_end);
 
     // Force to abort our processor when the next one is aborting. Already done in waitWork() but force immediately.
     // Don't do that if current is output and next is input because there is no propagation of packets from output back to input.
@@ -148,9 +225,18 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     }
 
     // Wake the previous processor when we abort (propagate abort conditions backward).
+    // When a branch aborts, the trunk and all other branches abort as well.
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.notify_one();
+        if (trunk != this) {
+            trunk->_tsp_aborting = true;
+        }
+        for (auto br : trunk->_branches) {
+            br->_tsp_aborting = true;
+            br->_to_do.notify_one();
+        }
+        trunk->_to_do.notify_one();
+        previousExecutor()->_to_do.notify_one();
     }
 
     // Return false when the current processor shall stop.
@@ -158,6 +244,29 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 }
 
 
+//----------------------------------------------------------------------------
+// Add packets at the end of the slice of the buffer of this executor and all its branches.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::receivePackets(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end)
+{
+    _pkt_cnt += count;
+    _bitrate = bitrate;
+    _br_confidence = br_confidence;
+    _input_end = _input_end || input_end;
+
+    // Wake the processor when there is some new input data or end of input.
+    if (count > 0 || input_end) {
+        _to_do.notify_one();
+    }
+
+    // All branches receive the same packets.
+    for (auto br : _branches) {
+        br->receivePackets(count, bitrate, br_confidence, input_end);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wait for packets to process or some error condition.
 //----------------------------------------------------------------------------
@@ -166,7 +275,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
                                        BitRate& bitrate, BitRateConfidence& br_confidence,
                                        bool& input_end, bool& aborted, bool &timeout)
 {
-    log(10, u"waitWork(min_pkt_cnt = %'d, ...)", {min_pkt_cnt});
+    trace<10>(u"waitWork(min_pkt_cnt = %'d, ...)", min_pkt_cnt);
 
     // Cannot allocate more than the buffer size.
     if (min_pkt_cnt > _buffer->count()) {
@@ -177,7 +286,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     // We access data under the protection of the global mutex.
     std::unique_lock<std::recursive_mutex> lock(_global_mutex);
 
-    PluginExecutor* next = ringNext<PluginExecutor>();
+    PluginExecutor* next = nextExecutor();
     timeout = false;
 
     // Loop until enough packets are available (or some error condition).
@@ -221,8 +330,28 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     // there is no propagation of packets from output back to input.
     aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
 
-    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
-        {min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
+    // In the first executor of a branch with a private buffer, get a copy of the new packets.
+    size_t copy_first = 0;
+    size_t copy_cnt = 0;
+    if (_branch_buffer != nullptr && pkt_cnt > _pkt_copied) {
+        copy_first = (_pkt_first + _pkt_copied) % _buffer->count();
+        copy_cnt = pkt_cnt - _pkt_copied;
+        _pkt_copied = pkt_cnt;
+    }
+
+    // The copy is done outside the global mutex. The source packets cannot be reused by the input plugin
+    // until this branch passes them and the target area in the private buffer belongs to this executor.
+    lock.unlock();
+    while (copy_cnt > 0) {
+        const size_t cnt = std::min(copy_cnt, _buffer->count() - copy_first);
+        TSPacket::Copy(_buffer->base() + copy_first, _trunk->_buffer->base() + copy_first, cnt);
+        TSPacketMetadata::Copy(_metadata->base() + copy_first, _trunk->_metadata->base() + copy_first, cnt);
+        copy_first = (copy_first + cnt) % _buffer->count();
+        copy_cnt -= cnt;
+    }
+
+    trace<10>(u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+        min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout);
 }
 
 
@@ -72,6 +72,38 @@ namespace ts {
                             const BitRate&        bitrate,
                             BitRateConfidence     br_confidence);
 
+            //!
+            //! Attach a parallel branch to this plugin executor.
+            //!
+            //! A branch is a chain of plugin executors which is not part of the ring. Its first executor receives
+            //! the same packets as this executor, at the same time, at the same indexes in the packet buffer. The
+            //! packets are passed to the next executor in the ring only when this executor and the last executor
+            //! of all branches have passed them. Therefore, the slowest branch drives the flow control.
+            //!
+            //! A branch which is made of one single executor directly reads the packets in the global buffer,
+            //! without copy. It shall only read the packets, never modify them. This is typically used to send
+            //! the same packets to several output plugins.
+            //!
+            //! When the branch contains more than one executor (typically some packet processors and an output),
+            //! the executors are linked in their own ring, the last one preceding the first one. They use a private
+            //! packet buffer, with the same size as the global one. The packets are copied at the same index in the
+            //! private buffer when the first executor of the branch gets them. The packet processors of the branch
+            //! can modify the packets without affecting the other branches.
+            //!
+            //! Must be executed in synchronous environment, before initBuffer().
+            //! @param [in,out] branch The first executor of the branch. It remains owned by the caller.
+            //! @param [in,out] buffer Private packet buffer of the branch. Must be non-null when the branch contains
+            //! more than one executor. It remains owned by the caller.
+            //! @param [in,out] metadata Private packet metadata buffer of the branch, same requirements as @a buffer.
+            //!
+            void addBranch(PluginExecutor* branch, PacketBuffer* buffer = nullptr, PacketMetadataBuffer* metadata = nullptr);
+
+            //!
+            //! Get the list of parallel branches which are attached to this plugin executor.
+            //! @return A constant reference to the list of branches.
+            //!
+            const std::vector<PluginExecutor*>& branches() const { return _branches; }
+
             //!
             //! Inform if all plugins should use defaults for real-time.
             //! @param [in] on True if all plugins should use defaults for real-time.
@@ -212,6 +244,24 @@ namespace ts {
             bool              _restart = false;    // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data {};    // How to restart the plugin
 
+            // Parallel branches. Only the "trunk" is part of the ring. Set before starting the threads.
+            std::vector<PluginExecutor*> _branches {};  // First executors of branches which are attached to this executor (in trunk only).
+            PluginExecutor*   _trunk = nullptr;    // When this executor is in a branch, the executor it is attached to.
+            PluginExecutor*   _branch_head = nullptr;  // When this executor is in a branch, the first executor of the branch.
+            PacketBuffer*     _branch_buffer = nullptr;  // Private packet buffer of a branch (in first executor of the branch only).
+            PacketMetadataBuffer* _branch_metadata = nullptr;  // Private packet metadata buffer of a branch (same).
+            PacketCounter     _branch_passed = 0;  // Total number of packets passed by this trunk or branch (in first executor of a branch) [*]
+            PacketCounter     _all_passed = 0;     // Total number of packets passed by all branches (in trunk only) [*]
+            size_t            _pkt_copied = 0;     // Number of packets at start of area which are already copied in the private buffer [*]
+
+            // Previous and next executors in the ring (relative to the trunk for the first and last executors of a branch).
+            PluginExecutor* previousExecutor();
+            PluginExecutor* nextExecutor();
+
+            // Add packets at the end of the slice of the buffer of this executor and all its branches.
+            // Must be called with the global mutex held.
+            void receivePackets(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end);
+
             // Description of a restart operation.
             class RestartData
             {
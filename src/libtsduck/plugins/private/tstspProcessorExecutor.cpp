@@ -16,14 +16,17 @@
 
 ts::tsp::ProcessorExecutor::ProcessorExecutor(const TSProcessorArgs& options,
                                               const PluginEventHandlerRegistry& handlers,
+                                              const PluginOptions& pl_options,
                                               size_t plugin_index,
                                               const ThreadAttributes& attributes,
                                               std::recursive_mutex& global_mutex,
                                               Report* report) :
 
-    PluginExecutor(options, handlers, PluginType::PROCESSOR, options.plugins[plugin_index], attributes, global_mutex, report),
+    PluginExecutor(options, handlers, PluginType::PROCESSOR, pl_options, attributes, global_mutex, report),
     _processor(dynamic_cast<ProcessorPlugin*>(PluginThread::plugin())),
-    _plugin_index(1 + plugin_index) // include first input plugin in the count
+    _pl_options(pl_options),
+    _plugin_index(plugin_index),
+    _log_report(report)
 {
     if (options.log_plugin_index) {
         // Make sure that plugins display their index.
@@ -69,8 +72,17 @@ void ts::tsp::ProcessorExecutor::main()
         window_size = _processor->getPacketWindowSize();
     }
 
-    // Perform the complete packet processing in individual-packet or packet-window mode.
-    if (window_size == 0) {
+    // Check if the plugin shall be executed by several threads.
+    const size_t thread_count = _processor->getThreadsOption();
+    if (thread_count > 1 && _processor->getShardingMode() == ProcessorPlugin::ShardingMode::NONE) {
+        verbose(u"this plugin cannot be executed in parallel, ignoring --threads %d", {thread_count});
+    }
+
+    // Perform the complete packet processing in individual-packet, packet-window or parallel mode.
+    if (thread_count > 1 && window_size == 0 && _processor->getShardingMode() != ProcessorPlugin::ShardingMode::NONE) {
+        processShardedPackets(thread_count);
+    }
+    else if (window_size == 0) {
         processIndividualPackets();
     }
     else {
@@ -414,3 +426,170 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
     debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
           {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
 }
+
+
+//----------------------------------------------------------------------------
+// Process packets using several parallel instances of the plugin.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::processShardedPackets(size_t thread_count)
+{
+    // Description of the packets to process, shared by all instances.
+    ProcessorShard::Job job;
+    job.mode = _processor->getShardingMode();
+    job.only_labels = _processor->getOnlyLabelOption();
+    job.shard_count = thread_count;
+
+    debug(u"parallel packet processing by %s using %d threads", {job.mode == ProcessorPlugin::ShardingMode::BY_PID ? u"PID" : u"block", thread_count});
+
+    // Create and start the additional instances of the plugin. Instance #0 is the main one, in this thread.
+    ThreadAttributes attributes;
+    getAttributes(attributes);
+    std::vector<ProcessorShardPtr> shards;
+    for (size_t i = 1; i < thread_count; ++i) {
+        ProcessorShardPtr shard(new ProcessorShard(this, _options.app_name, _pl_options, attributes, _log_report));
+        if (_options.log_plugin_index) {
+            shard->setLogName(UString::Format(u"%s[%d]#%d", {pluginName(), _plugin_index, i}));
+        }
+        else {
+            shard->setLogName(UString::Format(u"%s#%d", {pluginName(), i}));
+        }
+        if (!shard->startShard(_options.duck_args, realtime())) {
+            warning(u"error starting parallel instance #%d, using %d threads only", {i, i});
+            job.shard_count = i;
+            break;
+        }
+        shards.push_back(shard);
+    }
+
+    PacketCounter passed_packets = 0;
+    PacketCounter dropped_packets = 0;
+    PacketCounter nullified_packets = 0;
+    BitRate output_bitrate = _tsp_bitrate;
+    BitRateConfidence br_confidence = _tsp_bitrate_confidence;
+    bool bitrate_never_modified = true;
+    bool input_end = false;
+    bool aborted = false;
+
+    do {
+        // Wait for packets to process.
+        size_t pkt_first = 0;
+        size_t pkt_cnt = 0;
+        bool timeout = false;
+        waitWork(1, pkt_first, pkt_cnt, _tsp_bitrate, _tsp_bitrate_confidence, input_end, aborted, timeout);
+
+        // If bitrate was never modified by the plugin, always copy the input bitrate as output bitrate.
+        if (bitrate_never_modified) {
+            output_bitrate = _tsp_bitrate;
+            br_confidence = _tsp_bitrate_confidence;
+        }
+
+        // In case of abort on timeout or abort of next processor, notify previous and next plugin, then exit.
+        if (timeout || (aborted && !input_end)) {
+            passPackets(0, output_bitrate, br_confidence, true, true);
+            break;
+        }
+
+        // Exit thread if no more packet to process.
+        if (pkt_cnt == 0 && input_end) {
+            passPackets(0, output_bitrate, br_confidence, true, false);
+            break;
+        }
+
+        // Process restart requests. All instances are restarted with the same parameters.
+        bool restarted = false;
+        if (!processPendingRestart(restarted)) {
+            passPackets(0, output_bitrate, br_confidence, true, true);
+            break;
+        }
+        else if (restarted) {
+            UStringVector args;
+            _processor->getCommandArgs(args);
+            job.mode = _processor->getShardingMode();
+            job.only_labels = _processor->getOnlyLabelOption();
+            for (size_t i = 0; job.mode != ProcessorPlugin::ShardingMode::NONE && i < shards.size(); ++i) {
+                if (!shards[i]->restartShard(_options.duck_args, args)) {
+                    job.mode = ProcessorPlugin::ShardingMode::NONE;
+                }
+            }
+            if (job.mode == ProcessorPlugin::ShardingMode::NONE) {
+                warning(u"parallel processing no longer possible after restart, using one single thread");
+            }
+            job.shard_count = job.mode == ProcessorPlugin::ShardingMode::NONE ? 1 : 1 + shards.size();
+        }
+
+        // Do not process too many packets at once, the next plugin would wait too long.
+        if (_options.max_flush_pkt > 0 && pkt_cnt > _options.max_flush_pkt) {
+            pkt_cnt = _options.max_flush_pkt;
+            input_end = false;
+        }
+
+        // If the plugin is suspended, simply pass the packets to the next plugin.
+        if (_suspended) {
+            addNonPluginPackets(pkt_cnt);
+            aborted = !passPackets(pkt_cnt, output_bitrate, br_confidence, input_end, aborted);
+            continue;
+        }
+
+        // Dispatch the packets to all instances and process the first shard in this thread.
+        job.packets = _buffer->base() + pkt_first;
+        job.metadata = _metadata->base() + pkt_first;
+        job.count = pkt_cnt;
+        job.bitrate = _tsp_bitrate;
+        job.br_confidence = _tsp_bitrate_confidence;
+        for (size_t i = 1; i < job.shard_count; ++i) {
+            shards[i - 1]->submitJob(job, i);
+        }
+        ProcessorShard::Result result;
+        ProcessorShard::ProcessPackets(_processor, job, 0, result);
+
+        // Collect the results of all instances.
+        size_t end_index = result.end_index;
+        size_t plugin_packets = result.plugin_packets;
+        ProcessorPlugin* bitrate_source = result.new_bitrate ? _processor : nullptr;
+        passed_packets += result.passed_packets;
+        dropped_packets += result.dropped_packets;
+        nullified_packets += result.nullified_packets;
+        for (size_t i = 1; i < job.shard_count; ++i) {
+            const ProcessorShard::Result& res(shards[i - 1]->waitJob());
+            end_index = std::min(end_index, res.end_index);
+            plugin_packets += res.plugin_packets;
+            passed_packets += res.passed_packets;
+            dropped_packets += res.dropped_packets;
+            nullified_packets += res.nullified_packets;
+            if (bitrate_source == nullptr && res.new_bitrate) {
+                bitrate_source = dynamic_cast<ProcessorPlugin*>(shards[i - 1]->plugin());
+            }
+        }
+        addPluginPackets(plugin_packets);
+        addNonPluginPackets(pkt_cnt - plugin_packets);
+
+        // If one instance has signaled a new bitrate, get it.
+        if (bitrate_source != nullptr) {
+            const BitRate new_bitrate = bitrate_source->getBitrate();
+            if (new_bitrate != 0) {
+                bitrate_never_modified = false;
+                output_bitrate = new_bitrate;
+                br_confidence = bitrate_source->getBitrateConfidence();
+            }
+        }
+
+        // If one instance requested the termination, do not pass the packets after the first terminating one.
+        if (end_index != NPOS) {
+            debug(u"plugin requests termination");
+            input_end = aborted = true;
+            pkt_cnt = end_index;
+        }
+
+        aborted = !passPackets(pkt_cnt, output_bitrate, br_confidence, input_end, aborted);
+
+    } while (!input_end && !aborted);
+
+    // Terminate all additional instances.
+    for (const auto& shard : shards) {
+        shard->stopShard();
+    }
+
+    debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
+          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+}
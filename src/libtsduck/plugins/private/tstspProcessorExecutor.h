@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tstspPluginExecutor.h"
+#include "tstspProcessorShard.h"
 #include "tsProcessorPlugin.h"
 
 namespace ts {
@@ -30,13 +31,15 @@ namespace ts {
             //! Constructor.
             //! @param [in] options Command line options for tsp.
             //! @param [in] handlers Registry of event handlers.
-            //! @param [in] plugin_index Index of command line options for this plugin in @a options.
+            //! @param [in] pl_options Command line options for this plugin.
+            //! @param [in] plugin_index Index of this plugin in the chain, the input plugin being at index zero.
             //! @param [in] attributes Creation attributes for the thread executing this plugin.
             //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
             //! @param [in,out] report Where to report logs.
             //!
             ProcessorExecutor(const TSProcessorArgs& options,
                               const PluginEventHandlerRegistry& handlers,
+                              const PluginOptions& pl_options,
                               size_t plugin_index,
                               const ThreadAttributes& attributes,
                               std::recursive_mutex& global_mutex,
@@ -52,14 +55,17 @@ namespace ts {
 
         private:
             ProcessorPlugin* _processor = nullptr;
+            const PluginOptions _pl_options;  // Also used by parallel instances of the plugin.
             const size_t _plugin_index;
+            Report* const _log_report;  // Where to report logs, also used by parallel instances of the plugin.
 
             // Inherited from Thread
             virtual void main() override;
 
-            // Process packets one by one or using packet windows.
+            // Process packets one by one, using packet windows or using parallel instances of the plugin.
             void processIndividualPackets();
             void processPacketWindows(size_t window_size);
+            void processShardedPackets(size_t thread_count);
         };
     }
 }
@@ -0,0 +1,244 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstspProcessorShard.h"
+#include "tstspPluginExecutor.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::tsp::ProcessorShard::ProcessorShard(PluginExecutor* executor, const UString& app_name, const PluginOptions& pl_options, const ThreadAttributes& attributes, Report* report) :
+    PluginThread(report, app_name, PluginType::PROCESSOR, pl_options, attributes),
+    _executor(executor),
+    _processor(dynamic_cast<ProcessorPlugin*>(PluginThread::plugin()))
+{
+}
+
+ts::tsp::ProcessorShard::~ProcessorShard()
+{
+    stopShard();
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of TSP, delegated to the main executor.
+//----------------------------------------------------------------------------
+
+size_t ts::tsp::ProcessorShard::pluginIndex() const
+{
+    return _executor->pluginIndex();
+}
+
+size_t ts::tsp::ProcessorShard::pluginCount() const
+{
+    return _executor->pluginCount();
+}
+
+void ts::tsp::ProcessorShard::signalPluginEvent(uint32_t event_code, Object* plugin_data) const
+{
+    _executor->signalPluginEvent(event_code, plugin_data);
+}
+
+void ts::tsp::ProcessorShard::useJointTermination(bool on)
+{
+    _executor->useJointTermination(on);
+}
+
+void ts::tsp::ProcessorShard::jointTerminate()
+{
+    _executor->jointTerminate();
+}
+
+bool ts::tsp::ProcessorShard::useJointTermination() const
+{
+    return _executor->useJointTermination();
+}
+
+bool ts::tsp::ProcessorShard::thisJointTerminated() const
+{
+    return _executor->thisJointTerminated();
+}
+
+
+//----------------------------------------------------------------------------
+// Start, restart and stop the plugin instance and the thread.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::ProcessorShard::startShard(const DuckContext::SavedArgs& duck_args, bool realtime)
+{
+    if (_processor == nullptr) {
+        return false;
+    }
+    _use_realtime = realtime;
+    _processor->resetContext(duck_args);
+    if (!_processor->getOptions() || !_processor->start()) {
+        return false;
+    }
+    _started = true;
+    return Thread::start();
+}
+
+bool ts::tsp::ProcessorShard::restartShard(const DuckContext::SavedArgs& duck_args, const UStringVector& args)
+{
+    if (_processor == nullptr) {
+        return false;
+    }
+    if (_started) {
+        _processor->stop();
+    }
+    restartPluginSession();
+    _processor->resetContext(duck_args);
+    _processor->setFlags(_processor->getFlags() | Args::NO_HELP | Args::NO_EXIT_ON_ERROR);
+    _started = _processor->analyze(pluginName(), args, false) && _processor->getOptions() && _processor->start();
+    return _started;
+}
+
+void ts::tsp::ProcessorShard::stopShard()
+{
+    // Terminate the thread.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _to_do.notify_one();
+    }
+    waitForTermination();
+
+    // Then stop the plugin instance.
+    if (_started) {
+        _started = false;
+        _processor->stop();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Submit a job and wait for its completion.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorShard::submitJob(const Job& job, size_t shard_index)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _job = &job;
+    _shard_index = shard_index;
+    _result.clear();
+    _to_do.notify_one();
+}
+
+const ts::tsp::ProcessorShard::Result& ts::tsp::ProcessorShard::waitJob()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _job == nullptr; });
+    return _result;
+}
+
+
+//----------------------------------------------------------------------------
+// Shard thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorShard::main()
+{
+    debug(u"parallel packet processing thread started");
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        // Wait for a job or termination.
+        _to_do.wait(lock, [this]() { return _job != nullptr || _terminate; });
+        if (_terminate) {
+            break;
+        }
+
+        // Process the job without holding the mutex. The job and the result are not
+        // accessed by the executor thread until _job is reset to null.
+        const Job* job = _job;
+        lock.unlock();
+        _tsp_bitrate = job->bitrate;
+        _tsp_bitrate_confidence = job->br_confidence;
+        ProcessPackets(_processor, *job, _shard_index, _result);
+        addPluginPackets(_result.plugin_packets);
+        addNonPluginPackets(job->count - _result.plugin_packets);
+        lock.lock();
+
+        // Notify the completion of the job.
+        _job = nullptr;
+        _done.notify_one();
+    }
+
+    debug(u"parallel packet processing thread terminated after %'d packets", {pluginPackets()});
+}
+
+
+//----------------------------------------------------------------------------
+// Process the packets of one shard of a job.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorShard::ProcessPackets(ProcessorPlugin* plugin, const Job& job, size_t shard_index, Result& result)
+{
+    result.clear();
+
+    // With block sharding, compute the range of packets for this shard.
+    size_t first = 0;
+    size_t last = job.count;
+    if (job.mode == ProcessorPlugin::ShardingMode::BY_BLOCK) {
+        const size_t shard_size = (job.count + job.shard_count - 1) / job.shard_count;
+        first = std::min(job.count, shard_index * shard_size);
+        last = std::min(job.count, first + shard_size);
+    }
+
+    for (size_t index = first; index < last; ++index) {
+
+        TSPacket& pkt(job.packets[index]);
+        TSPacketMetadata& pkt_data(job.metadata[index]);
+
+        // Skip packets which were dropped by a previous packet processor.
+        // With PID sharding, skip packets which belong to another shard.
+        if (pkt.b[0] == 0 || (job.mode == ProcessorPlugin::ShardingMode::BY_PID && pkt.getPID() % job.shard_count != shard_index)) {
+            continue;
+        }
+
+        // Skip packets which are not in --only-label (if specified).
+        if (job.only_labels.any() && !pkt_data.hasAnyLabel(job.only_labels)) {
+            continue;
+        }
+
+        // Apply the processing routine to the packet
+        const bool was_null = pkt.getPID() == PID_NULL;
+        pkt_data.setFlush(false);
+        pkt_data.setBitrateChanged(false);
+        const ProcessorPlugin::Status status = plugin->processPacket(pkt, pkt_data);
+        result.plugin_packets++;
+
+        switch (status) {
+            case ProcessorPlugin::TSP_OK:
+                result.passed_packets++;
+                break;
+            case ProcessorPlugin::TSP_NULL:
+                pkt = NullPacket;
+                break;
+            case ProcessorPlugin::TSP_DROP:
+                pkt.b[0] = 0;
+                result.dropped_packets++;
+                break;
+            case ProcessorPlugin::TSP_END:
+                // Packets from this one shall not be passed to the next plugin.
+                result.end_index = index;
+                return;
+            default:
+                plugin->error(u"invalid packet processing status %d", {status});
+                break;
+        }
+
+        if (!was_null && pkt.getPID() == PID_NULL) {
+            pkt_data.setNullified(true);
+            result.nullified_packets++;
+        }
+        result.new_bitrate = result.new_bitrate || pkt_data.getBitrateChanged();
+    }
+}
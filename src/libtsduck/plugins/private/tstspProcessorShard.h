@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor: Parallel instance of a packet processor plugin
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPluginThread.h"
+#include "tsProcessorPlugin.h"
+
+namespace ts {
+    namespace tsp {
+
+        class PluginExecutor;
+
+        //!
+        //! Execution context of an additional parallel instance of a tsp packet processor plugin.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //!
+        //! When a packet processor plugin is executed with option -\-threads, the ProcessorExecutor
+        //! splits each group of packets it receives into "shards". The first shard is processed
+        //! by the main instance of the plugin, in the executor thread. Each other shard is processed
+        //! by a ProcessorShard, in its own thread, with its own instance of the plugin. Since all
+        //! packets are processed in place, in the global packet buffer, there is no need to reorder
+        //! them afterwards.
+        //!
+        //! @ingroup plugin
+        //!
+        class ProcessorShard: public PluginThread
+        {
+            TS_NOBUILD_NOCOPY(ProcessorShard);
+        public:
+            //!
+            //! Description of a group of packets to process, shared by all shards.
+            //!
+            class Job
+            {
+            public:
+                TSPacket*                      packets = nullptr;   //!< Address of first packet (contiguous area).
+                TSPacketMetadata*              metadata = nullptr;  //!< Address of metadata of first packet.
+                size_t                         count = 0;           //!< Number of packets in the area.
+                ProcessorPlugin::ShardingMode  mode = ProcessorPlugin::ShardingMode::BY_BLOCK; //!< How packets are distributed.
+                size_t                         shard_count = 1;     //!< Number of shards.
+                TSPacketLabelSet               only_labels {};      //!< Process only packets with these labels (if not empty).
+                BitRate                        bitrate = 0;         //!< Input bitrate.
+                BitRateConfidence              br_confidence = BitRateConfidence::LOW; //!< Input bitrate confidence.
+            };
+
+            //!
+            //! Result of the processing of one shard of a job.
+            //!
+            class Result
+            {
+            public:
+                size_t plugin_packets = 0;     //!< Number of packets which were submitted to the plugin.
+                size_t passed_packets = 0;     //!< Number of passed packets.
+                size_t dropped_packets = 0;    //!< Number of dropped packets.
+                size_t nullified_packets = 0;  //!< Number of nullified packets.
+                size_t end_index = NPOS;       //!< Index in the job of the packet which returned TSP_END (NPOS if none).
+                bool   new_bitrate = false;    //!< The plugin signalled a new bitrate.
+
+                //!
+                //! Reset the content of the result.
+                //!
+                void clear() { *this = Result(); }
+            };
+
+            //!
+            //! Constructor.
+            //! @param [in,out] executor The main plugin executor.
+            //! @param [in] app_name Application name, for help messages.
+            //! @param [in] pl_options Command line options for the plugin.
+            //! @param [in] attributes Creation attributes for the thread executing this plugin.
+            //! @param [in,out] report Where to report logs.
+            //!
+            ProcessorShard(PluginExecutor* executor, const UString& app_name, const PluginOptions& pl_options, const ThreadAttributes& attributes, Report* report);
+
+            //!
+            //! Destructor.
+            //! The thread is terminated and the plugin is stopped if necessary.
+            //!
+            virtual ~ProcessorShard() override;
+
+            //!
+            //! Decode the command line options, start the plugin instance and the thread.
+            //! Must be called from the executor thread, before submitting jobs.
+            //! @param [in] duck_args Default execution context of the plugin.
+            //! @param [in] realtime True if the plugin should use realtime defaults.
+            //! @return True on success, false on error.
+            //!
+            bool startShard(const DuckContext::SavedArgs& duck_args, bool realtime);
+
+            //!
+            //! Restart the plugin instance with new command line options.
+            //! Must be called from the executor thread, when no job is in progress.
+            //! @param [in] duck_args Default execution context of the plugin.
+            //! @param [in] args New command line arguments.
+            //! @return True on success, false on error.
+            //!
+            bool restartShard(const DuckContext::SavedArgs& duck_args, const UStringVector& args);
+
+            //!
+            //! Terminate the thread and stop the plugin instance.
+            //!
+            void stopShard();
+
+            //!
+            //! Submit a job to the thread. Return immediately.
+            //! @param [in] job The packets to process. Must remain valid until waitJob() returns.
+            //! @param [in] shard_index Index of the shard to process in the job.
+            //!
+            void submitJob(const Job& job, size_t shard_index);
+
+            //!
+            //! Wait for the completion of the previously submitted job.
+            //! @return A constant reference to the result of the job.
+            //!
+            const Result& waitJob();
+
+            //!
+            //! Process the packets of one shard of a job using a given plugin instance.
+            //! This static method is used by ProcessorShard threads and by the main executor.
+            //! The packet counters of the TSP object of the plugin are not modified.
+            //! @param [in,out] plugin The plugin instance to use.
+            //! @param [in] job The packets to process.
+            //! @param [in] shard_index Index of the shard to process in the job.
+            //! @param [out] result Result of the processing.
+            //!
+            static void ProcessPackets(ProcessorPlugin* plugin, const Job& job, size_t shard_index, Result& result);
+
+            // Implementation of TSP virtual methods, delegated to the main executor.
+            virtual size_t pluginIndex() const override;
+            virtual size_t pluginCount() const override;
+            virtual void signalPluginEvent(uint32_t event_code, Object* plugin_data = nullptr) const override;
+            virtual void useJointTermination(bool on) override;
+            virtual void jointTerminate() override;
+            virtual bool useJointTermination() const override;
+            virtual bool thisJointTerminated() const override;
+
+        private:
+            PluginExecutor* const   _executor;
+            ProcessorPlugin*        _processor;
+            bool                    _started = false;    // Plugin instance started.
+            std::mutex              _mutex {};           // Protect the following fields.
+            std::condition_variable _to_do {};           // Notify the shard thread of a new job or termination.
+            std::condition_variable _done {};            // Notify the executor of the end of a job.
+            const Job*              _job = nullptr;      // Job in progress, null when idle.
+            size_t                  _shard_index = 0;    // Shard to process in _job.
+            bool                    _terminate = false;  // Request thread termination.
+            Result                  _result {};          // Result of last job.
+
+            // Inherited from Thread
+            virtual void main() override;
+        };
+
+        //!
+        //! Safe pointer to a ProcessorShard (not thread-safe).
+        //!
+        typedef SafePtr<ProcessorShard, ts::null_mutex> ProcessorShardPtr;
+    }
+}
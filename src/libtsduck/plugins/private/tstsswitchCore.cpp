@@ -22,7 +22,9 @@ ts::tsswitch::Core::Core(const InputSwitcherArgs& opt, const PluginEventHandlerR
     _output(_opt, handlers, *this, _log), // load output plugin and analyze options
     _eventDispatcher(_opt, _log),
     _receiveWatchDog(this, _opt.receiveTimeout, 0, _log),
-    _curPlugin(_opt.firstInput)
+    _curPlugin(_opt.firstInput),
+    _switchRequest(_opt.firstInput),
+    _outPlugin(_opt.firstInput)
 {
     // Load all input plugins, analyze their options.
     for (size_t i = 0; i < _inputs.size(); ++i) {
@@ -73,6 +75,7 @@ bool ts::tsswitch::Core::start()
     // Start with the designated first input plugin.
     assert(_opt.firstInput < _inputs.size());
     _curPlugin = _opt.firstInput;
+    _switchRequest = _outPlugin = _opt.firstInput;
 
     // Start all input threads (but do not open the input "devices").
     bool success = true;
@@ -200,7 +203,11 @@ void ts::tsswitch::Core::setInputLocked(size_t index, bool abortCurrent)
             // The primary input is never stopped (and consequently never restarted).
             enqueue(Action(SUSPEND_TIMEOUT));
             if (_opt.fastSwitch || _curPlugin == _opt.primaryInput) {
-                enqueue(Action(NOTIF_CURRENT, _curPlugin, false));
+                // With --hot-standby, the previous plugin remains current, without packet loss,
+                // until the output thread switches at the synchronization point.
+                if (!_opt.hotStandby) {
+                    enqueue(Action(NOTIF_CURRENT, _curPlugin, false));
+                }
             }
             else {
                 enqueue(Action(ABORT_INPUT, _curPlugin, abortCurrent));
@@ -384,6 +391,12 @@ void ts::tsswitch::Core::execute(const Action& event)
             case SET_CURRENT: {
                 _eventDispatcher.signalNewInput(_curPlugin, action.index);
                 _curPlugin = action.index;
+                if (_opt.hotStandby) {
+                    // The switch will be done in the output thread at the next packet boundary.
+                    _switchRequestTime = Monotonic(true) - _startTime;
+                    _switchRequest.store(action.index, std::memory_order_release);
+                    _gotInput.notify_all();
+                }
                 break;
             }
             case WAIT_STARTED:
@@ -421,6 +434,10 @@ bool ts::tsswitch::Core::getOutputArea(size_t& pluginIndex, TSPacket*& first, TS
 {
     assert(pluginIndex < _inputs.size());
 
+    if (_opt.hotStandby) {
+        return getHotStandbyArea(pluginIndex, first, data, count);
+    }
+
     // Loop on _gotInput condition until the current input plugin has something to output.
     std::unique_lock<std::recursive_mutex> lock(_mutex);
     for (;;) {
@@ -444,6 +461,82 @@ bool ts::tsswitch::Core::getOutputArea(size_t& pluginIndex, TSPacket*& first, TS
 }
 
 
+//----------------------------------------------------------------------------
+// With --hot-standby, get some packets to output (called by output plugin).
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::Core::getHotStandbyArea(size_t& pluginIndex, TSPacket*& first, TSPacketMetadata*& data, size_t& count)
+{
+    for (;;) {
+        if (_terminate) {
+            pluginIndex = _outPlugin;
+            first = nullptr;
+            count = 0;
+            return false;
+        }
+
+        // Switch when the new input plugin reaches a synchronization point. The packets before it are dropped.
+        // Until then, continue to output the packets from the previous input plugin.
+        const size_t next = _switchRequest.load(std::memory_order_acquire);
+        if (next != _outPlugin && _inputs[next]->skipToSyncPoint(_opt.switchSync)) {
+            const NanoSecond latency = std::max<NanoSecond>(0, (Monotonic(true) - _startTime) - _switchRequestTime.load());
+            _switchCount++;
+            _switchLatency += latency;
+            _switchMaxLatency = std::max(_switchMaxLatency, latency);
+            _log.verbose(u"switched from input #%d to #%d, latency: %'d microseconds", {_outPlugin, next, latency / NanoSecPerMicroSec});
+            _outPlugin = next;
+            // Now, only the output plugin and a pending new input shall not lose packets.
+            const size_t request = _switchRequest.load(std::memory_order_acquire);
+            for (size_t i = 0; i < _inputs.size(); ++i) {
+                _inputs[i]->setCurrent(i == next || i == request);
+            }
+        }
+
+        // Drop packets from the input plugins in standby.
+        for (size_t i = 0; i < _inputs.size(); ++i) {
+            if (i != _outPlugin && i != next) {
+                _inputs[i]->discardOutput();
+            }
+        }
+
+        // Return when there is something to output in current plugin.
+        _inputs[_outPlugin]->getOutputArea(first, data, count);
+        if (count > 0) {
+            pluginIndex = _outPlugin;
+            return true;
+        }
+
+        // Nothing to output, wait for packets on any input plugin, a switch request or termination.
+        // The fence guarantees that either the input threads see the waiting indicator or we see their new packets.
+        std::unique_lock<std::recursive_mutex> lock(_mutex);
+        _outputWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ready = _terminate || _switchRequest.load() != next;
+        for (size_t i = 0; !ready && i < _inputs.size(); ++i) {
+            ready = _inputs[i]->hasOutput();
+        }
+        if (!ready) {
+            _gotInput.wait(lock);
+        }
+        _outputWaiting = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// With --hot-standby, wake up the output thread (called by input plugins).
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::Core::notifyOutput()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_outputWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _gotInput.notify_all();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Report output packets (called by output plugin).
 //----------------------------------------------------------------------------
@@ -599,6 +692,12 @@ void ts::tsswitch::Core::waitForTermination()
     // Wait for output termination.
     _output.waitForTermination();
 
+    // Report switch latency with --hot-standby.
+    if (_opt.hotStandby && _switchCount > 0) {
+        _log.verbose(u"%'d input switches, average latency: %'d microseconds, max: %'d microseconds",
+                     {_switchCount, _switchLatency / NanoSecond(_switchCount) / NanoSecPerMicroSec, _switchMaxLatency / NanoSecPerMicroSec});
+    }
+
     // Wait for all input termination.
     for (size_t i = 0; i < _inputs.size(); ++i) {
         _inputs[i]->waitForTermination();
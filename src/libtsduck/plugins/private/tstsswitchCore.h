@@ -126,6 +126,13 @@ namespace ts {
             //!
             bool outputSent(size_t pluginIndex, size_t count);
 
+            //!
+            //! With --hot-standby, called by an input plugin when it wrote packets in its buffer.
+            //! Wake up the output thread if it is waiting for packets. This is a lock-free operation
+            //! when the output thread is busy.
+            //!
+            void notifyOutput();
+
         private:
             // Upon reception of an event (end of input, remote command, etc), there
             // is a list of actions to execute which depends on the switch policy.
@@ -182,6 +189,19 @@ namespace ts {
             ActionQueue                 _actions {};        // Sequential queue list of actions to execute.
             ActionSet                   _events {};         // Pending events, waiting to be cleared.
 
+            // With --hot-standby, the switch is performed in the output thread, without lock.
+            const Monotonic             _startTime {true};      // Reference time for switch requests.
+            std::atomic<size_t>         _switchRequest;         // Index of the requested input plugin.
+            std::atomic<NanoSecond>     _switchRequestTime {0}; // Time of last switch request, relative to _startTime.
+            std::atomic<bool>           _outputWaiting {false}; // The output thread waits for packets.
+            size_t                      _outPlugin;             // Index of the input plugin in the output thread.
+            size_t                      _switchCount = 0;       // Number of switches in the output thread.
+            NanoSecond                  _switchLatency = 0;     // Accumulated switch latency.
+            NanoSecond                  _switchMaxLatency = 0;  // Maximum switch latency.
+
+            // With --hot-standby, get some packets to output, in the output thread.
+            bool getHotStandbyArea(size_t& pluginIndex, TSPacket*& first, TSPacketMetadata*& data, size_t& count);
+
             // Names of actions for debug messages.
             static const Enumeration _actionNames;
 
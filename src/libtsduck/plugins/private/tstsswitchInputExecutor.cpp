@@ -27,6 +27,12 @@ ts::tsswitch::InputExecutor::InputExecutor(const InputSwitcherArgs& opt,
     _buffer(opt.bufferedPackets),
     _metadata(opt.bufferedPackets)
 {
+    // With --hot-standby, packets are received and dropped when the ring is full.
+    if (_opt.hotStandby) {
+        _dropBuffer.resize(_opt.maxInputPackets);
+        _dropMetadata.resize(_opt.maxInputPackets);
+    }
+
     // Make sure that the input plugins display their index.
     setLogName(UString::Format(u"%s[%d]", {pluginName(), _pluginIndex}));
 }
@@ -96,6 +102,7 @@ void ts::tsswitch::InputExecutor::setCurrent(bool isCurrent)
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     _isCurrent = isCurrent;
+    _todo.notify_one();
 }
 
 
@@ -118,6 +125,16 @@ void ts::tsswitch::InputExecutor::terminateInput()
 
 void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMetadata*& data, size_t& count)
 {
+    if (_opt.hotStandby) {
+        // Lock-free ring, the tail is only modified by the output thread (this one).
+        const size_t tail = _ringTail.load(std::memory_order_relaxed);
+        const size_t index = tail % _buffer.size();
+        first = &_buffer[index];
+        data = &_metadata[index];
+        count = std::min(_ringHead.load(std::memory_order_acquire) - tail, _buffer.size() - index);
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     first = &_buffer[_outFirst];
     data = &_metadata[_outFirst];
@@ -134,6 +151,13 @@ void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMe
 
 void ts::tsswitch::InputExecutor::freeOutput(size_t count)
 {
+    if (_opt.hotStandby) {
+        assert(count <= _ringHead.load() - _ringTail.load());
+        _ringTail.fetch_add(count, std::memory_order_release);
+        notifyInput();
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     assert(count <= _outCount);
     _outFirst = (_outFirst + count) % _buffer.size();
@@ -143,6 +167,185 @@ void ts::tsswitch::InputExecutor::freeOutput(size_t count)
 }
 
 
+//----------------------------------------------------------------------------
+// With --hot-standby, drop packets in the ring (called by the output thread).
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::InputExecutor::discardOutput()
+{
+    if (hasOutput()) {
+        _ringTail.store(_ringHead.load(std::memory_order_acquire), std::memory_order_release);
+        notifyInput();
+    }
+}
+
+namespace {
+    // Get the PMT PID's from a PAT which starts and ends in one TS packet.
+    bool GetPMTPIDs(const ts::TSPacket& pkt, ts::PIDSet& pmts)
+    {
+        const uint8_t* data = pkt.getPayload();
+        const size_t size = pkt.getPayloadSize();
+        if (size < 1 || size < 1 + size_t(data[0]) + 3) {
+            return false;
+        }
+        const uint8_t* sec = data + 1 + data[0];
+        const size_t sec_size = 3 + (ts::GetUInt16(sec + 1) & 0x0FFF);
+        if (sec[0] != ts::TID_PAT || sec_size < 12 || sec + sec_size > data + size) {
+            return false;
+        }
+        pmts.reset();
+        for (const uint8_t* entry = sec + 8; entry + 4 <= sec + sec_size - 4; entry += 4) {
+            if (ts::GetUInt16(entry) != 0) {
+                pmts.set(ts::GetUInt16(entry + 2) & 0x1FFF);
+            }
+        }
+        return true;
+    }
+}
+
+bool ts::tsswitch::InputExecutor::skipToSyncPoint(InputSwitcherArgs::SwitchSync sync)
+{
+    const size_t head = _ringHead.load(std::memory_order_acquire);
+    size_t tail = _ringTail.load(std::memory_order_relaxed);
+    bool found = false;
+    bool wait = false;
+
+    while (!found && !wait && tail != head) {
+        const TSPacket& pkt(_buffer[tail % _buffer.size()]);
+        switch (sync) {
+            case InputSwitcherArgs::SwitchSync::PAT_PMT: {
+                // Switch at the start of a PAT when the start of one of its PMT's follows, before the next PAT.
+                // Wait for more packets while the PMT is not received and the ring is not full.
+                // When the PAT does not fit in one packet, the PMT PID's are unknown, switch at the PAT.
+                PIDSet pmts;
+                if (pkt.getPID() == PID_PAT && pkt.getPUSI()) {
+                    found = !GetPMTPIDs(pkt, pmts) || pmts.none();
+                    bool next_pat = false;
+                    for (size_t i = tail + 1; !found && !next_pat && i != head; ++i) {
+                        const TSPacket& next(_buffer[i % _buffer.size()]);
+                        found = next.getPUSI() && pmts.test(next.getPID());
+                        next_pat = next.getPUSI() && next.getPID() == PID_PAT;
+                    }
+                    wait = !found && !next_pat && head - tail < _buffer.size();
+                }
+                break;
+            }
+            case InputSwitcherArgs::SwitchSync::RANDOM_ACCESS:
+                found = pkt.getRandomAccessIndicator();
+                break;
+            case InputSwitcherArgs::SwitchSync::PACKET:
+            default:
+                found = true;
+                break;
+        }
+        if (!found && !wait) {
+            ++tail;
+        }
+    }
+
+    if (tail != _ringTail.load(std::memory_order_relaxed)) {
+        _ringTail.store(tail, std::memory_order_release);
+        notifyInput();
+    }
+    return found;
+}
+
+
+//----------------------------------------------------------------------------
+// With --hot-standby, wake up the input thread when waiting for free space.
+// The fence guarantees that either the input thread sees the modified tail
+// or we see its waiting indicator.
+//----------------------------------------------------------------------------
+
+void ts::tsswitch::InputExecutor::notifyInput()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_inputWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _todo.notify_one();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for a free area in the buffer (in the input thread).
+//----------------------------------------------------------------------------
+
+bool ts::tsswitch::InputExecutor::waitFreeArea(size_t& inFirst, size_t& inCount, bool& drop)
+{
+    if (_opt.hotStandby) {
+        return waitFreeRing(inFirst, inCount, drop);
+    }
+
+    // Wait for free buffer or stop.
+    drop = false;
+    std::unique_lock<std::recursive_mutex> lock(_mutex);
+    while (_outCount >= _buffer.size() && !_stopRequest && !_terminated) {
+        if (_isCurrent || !_opt.fastSwitch) {
+            // This is the current input, we must not lose packet.
+            // Wait for the output thread to free some packets.
+            _todo.wait(lock);
+        }
+        else {
+            // Not the current input plugin in --fast-switch mode.
+            // Drop older packets, free at most --max-input-packets.
+            assert(_outFirst < _buffer.size());
+            const size_t freeCount = std::min(_opt.maxInputPackets, _buffer.size() - _outFirst);
+            assert(freeCount <= _outCount);
+            _outFirst = (_outFirst + freeCount) % _buffer.size();
+            _outCount -= freeCount;
+        }
+    }
+    // Exit input when termination is requested.
+    if (_stopRequest || _terminated) {
+        debug(u"exiting session: stop request: %s, terminated: %s", {_stopRequest.load(), _terminated.load()});
+        return false;
+    }
+    // There is some free buffer, compute first index and size of receive area.
+    // The receive area is limited by end of buffer and max input size.
+    inFirst = (_outFirst + _outCount) % _buffer.size();
+    inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - _outCount, _buffer.size() - inFirst));
+    return true;
+}
+
+bool ts::tsswitch::InputExecutor::waitFreeRing(size_t& inFirst, size_t& inCount, bool& drop)
+{
+    // The head is only modified by the input thread (this one).
+    const size_t head = _ringHead.load(std::memory_order_relaxed);
+    size_t used = head - _ringTail.load(std::memory_order_acquire);
+
+    // Fast path, without lock: there is some free space.
+    if (used >= _buffer.size()) {
+        // The ring is full. The current input waits for the output thread, we must not lose packet.
+        // The other inputs continue to receive but drop the packets.
+        std::unique_lock<std::recursive_mutex> lock(_mutex);
+        _inputWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while ((used = head - _ringTail.load(std::memory_order_acquire)) >= _buffer.size() && _isCurrent && !_stopRequest && !_terminated) {
+            _todo.wait(lock);
+        }
+        _inputWaiting = false;
+    }
+
+    // Exit input when termination is requested.
+    if (_stopRequest || _terminated) {
+        debug(u"exiting session: stop request: %s, terminated: %s", {_stopRequest.load(), _terminated.load()});
+        return false;
+    }
+
+    drop = used >= _buffer.size();
+    if (drop) {
+        inFirst = 0;
+        inCount = _dropBuffer.size();
+    }
+    else {
+        inFirst = head % _buffer.size();
+        inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - used, _buffer.size() - inFirst));
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Invoked in the context of the plugin thread.
 //----------------------------------------------------------------------------
@@ -195,48 +398,26 @@ void ts::tsswitch::InputExecutor::main()
             // Input area (first packet index and packet count).
             size_t inFirst = 0;
             size_t inCount = 0;
+            bool drop = false;
 
-            // Initial sequence under mutex protection.
-            {
-                // Wait for free buffer or stop.
-                std::unique_lock<std::recursive_mutex> lock(_mutex);
-                while (_outCount >= _buffer.size() && !_stopRequest && !_terminated) {
-                    if (_isCurrent || !_opt.fastSwitch) {
-                        // This is the current input, we must not lose packet.
-                        // Wait for the output thread to free some packets.
-                        _todo.wait(lock);
-                    }
-                    else {
-                        // Not the current input plugin in --fast-switch mode.
-                        // Drop older packets, free at most --max-input-packets.
-                        assert(_outFirst < _buffer.size());
-                        const size_t freeCount = std::min(_opt.maxInputPackets, _buffer.size() - _outFirst);
-                        assert(freeCount <= _outCount);
-                        _outFirst = (_outFirst + freeCount) % _buffer.size();
-                        _outCount -= freeCount;
-                    }
-                }
-                // Exit input when termination is requested.
-                if (_stopRequest || _terminated) {
-                    debug(u"exiting session: stop request: %s, terminated: %s", {_stopRequest, _terminated});
-                    break;
-                }
-                // There is some free buffer, compute first index and size of receive area.
-                // The receive area is limited by end of buffer and max input size.
-                inFirst = (_outFirst + _outCount) % _buffer.size();
-                inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - _outCount, _buffer.size() - inFirst));
+            // Wait for free buffer or stop.
+            if (!waitFreeArea(inFirst, inCount, drop)) {
+                break;
             }
 
-            assert(inFirst < _buffer.size());
-            assert(inFirst + inCount <= _buffer.size());
+            // Receive area, in the buffer or in the drop area.
+            TSPacketVector& pkts(drop ? _dropBuffer : _buffer);
+            TSPacketMetadataVector& pktData(drop ? _dropMetadata : _metadata);
+            assert(inFirst < pkts.size());
+            assert(inFirst + inCount <= pkts.size());
 
             // Reset packet metadata.
             for (size_t n = inFirst; n < inFirst + inCount; ++n) {
-                _metadata[n].reset();
+                pktData[n].reset();
             }
 
             // Receive packets.
-            if ((inCount = _input->receive(&_buffer[inFirst], &_metadata[inFirst], inCount)) == 0) {
+            if ((inCount = _input->receive(&pkts[inFirst], &pktData[inFirst], inCount)) == 0) {
                 // End of input.
                 debug(u"received end of input from plugin");
                 break;
@@ -245,15 +426,23 @@ void ts::tsswitch::InputExecutor::main()
 
             // Fill input time stamps with monotonic clock if none was provided by the input plugin.
             // Only check the first returned packet. Assume that the input plugin generates time stamps for all or none.
-            if (!_metadata[inFirst].hasInputTimeStamp()) {
+            if (!pktData[inFirst].hasInputTimeStamp()) {
                 const NanoSecond current = Monotonic(true) - _start_time;
                 for (size_t n = 0; n < inCount; ++n) {
-                    _metadata[inFirst + n].setInputTimeStamp(current, NanoSecPerSec, TimeSource::TSP);
+                    pktData[inFirst + n].setInputTimeStamp(current, NanoSecPerSec, TimeSource::TSP);
                 }
             }
 
             // Signal the presence of received packets.
-            {
+            if (drop) {
+                trace<1>(u"buffer full, dropped %d packets", inCount);
+            }
+            else if (_opt.hotStandby) {
+                // Publish the packets to the output thread, without lock.
+                _ringHead.fetch_add(inCount, std::memory_order_seq_cst);
+                _core.notifyOutput();
+            }
+            else {
                 std::lock_guard<std::recursive_mutex> lock(_mutex);
                 _outCount += inCount;
             }
@@ -265,6 +454,16 @@ void ts::tsswitch::InputExecutor::main()
             // Wait for the output plugin to release the buffer.
             // In case of normal end of input (no stop, no terminate), wait for all output to be gone.
             std::unique_lock<std::recursive_mutex> lock(_mutex);
+            if (_opt.hotStandby) {
+                // There is no reset of the ring, the output thread drains it.
+                _inputWaiting = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (_ringHead.load() != _ringTail.load() && !_stopRequest && !_terminated) {
+                    debug(u"input terminated, waiting for output plugin to drain the buffer");
+                    _todo.wait(lock);
+                }
+                _inputWaiting = false;
+            }
             while (_outputInUse || (_outCount > 0 && !_stopRequest && !_terminated)) {
                 debug(u"input terminated, waiting for output plugin to release the buffer");
                 _todo.wait(lock);
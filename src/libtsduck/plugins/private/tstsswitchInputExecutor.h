@@ -80,6 +80,7 @@ namespace ts {
             //!
             //! Get the area of packet to output.
             //! Indirectly called from the output plugin when it needs some packets.
+            //! With --hot-standby, the packet buffer is a lock-free ring and this method never blocks.
             //! The input thread shall reserve this area since the output plugin
             //! will use it from another thread. When the output plugin completes
             //! its output and no longer need this area, it should call freeOutput().
@@ -97,6 +98,29 @@ namespace ts {
             //!
             void freeOutput(size_t count);
 
+            //!
+            //! With --hot-standby, check if there are packets in the buffer.
+            //! Must be called from the output thread only.
+            //! @return True if there are packets in the buffer.
+            //!
+            bool hasOutput() const { return _ringHead.load(std::memory_order_acquire) != _ringTail.load(std::memory_order_relaxed); }
+
+            //!
+            //! With --hot-standby, drop all packets in the buffer.
+            //! Must be called from the output thread only.
+            //!
+            void discardOutput();
+
+            //!
+            //! With --hot-standby, drop all packets in the buffer before a synchronization point.
+            //! Must be called from the output thread only.
+            //! @param [in] sync Type of synchronization point.
+            //! @return True if a synchronization point was found. It is the next packet to output.
+            //! False if no synchronization point was found. In that case, all packets were dropped,
+            //! except a possible synchronization point which is not yet complete.
+            //!
+            bool skipToSyncPoint(InputSwitcherArgs::SwitchSync sync);
+
             // Implementation of TSP.
             virtual size_t pluginIndex() const override;
 
@@ -110,12 +134,29 @@ namespace ts {
             bool                   _isCurrent = false;    // This plugin is the current input one.
             bool                   _outputInUse = false;  // The output part of the buffer is currently in use by the output plugin.
             bool                   _startRequest = false; // Start input requested.
-            bool                   _stopRequest = false;  // Stop input requested.
-            bool                   _terminated = false;   // Terminate thread.
+            std::atomic<bool>      _stopRequest {false};  // Stop input requested.
+            std::atomic<bool>      _terminated {false};   // Terminate thread.
             size_t                 _outFirst = 0;         // Index of first packet to output in _buffer.
             size_t                 _outCount = 0;         // Number of packets to output, not always contiguous, may wrap up.
             Monotonic              _start_time {true};    // Creation time in a monotonic clock, initialized with current system time.
 
+            // With --hot-standby, _buffer is a lock-free ring with one producer (the input thread)
+            // and one consumer (the output thread). The indexes are ever-increasing packet counters,
+            // modulo the buffer size. The mutex is only used to sleep when the ring is full.
+            std::atomic<size_t>    _ringHead {0};         // Total number of packets written by the input thread.
+            std::atomic<size_t>    _ringTail {0};         // Total number of packets released by the output thread.
+            std::atomic<bool>      _inputWaiting {false}; // The input thread waits for free space in the ring.
+            TSPacketVector         _dropBuffer {};        // Receive area when the ring is full in standby mode.
+            TSPacketMetadataVector _dropMetadata {};      // Metadata of _dropBuffer.
+
+            // Wait for a free area in the buffer, return false on stop or terminate.
+            // With --hot-standby, drop is set when the received packets shall be dropped.
+            bool waitFreeArea(size_t& inFirst, size_t& inCount, bool& drop);
+            bool waitFreeRing(size_t& inFirst, size_t& inCount, bool& drop);
+
+            // Wake up the input thread when waiting for free space in the ring.
+            void notifyInput();
+
             // Implementation of Thread.
             virtual void main() override;
         };
@@ -57,7 +57,7 @@ void ts::tsswitch::OutputExecutor::main()
 
     // Loop until there are packets to output.
     while (!_terminate && _core.getOutputArea(pluginIndex, first, metadata, count)) {
-        log(2, u"got %d packets from plugin %d, terminate: %s", {count, pluginIndex, _terminate});
+        trace<2>(u"got %d packets from plugin %d, terminate: %s", count, pluginIndex, _terminate);
         if (!_terminate && count > 0) {
 
             // Output the packets.
@@ -24,6 +24,9 @@ TSDUCKPY struct tspyInputSwitcherArgs
 {
     long fast_switch;         // Fast switch between input plugins.
     long delayed_switch;      // Delayed switch between input plugins.
+    long hot_standby;         // Lock-free switch in the output thread.
+    const uint8_t* switch_sync;          // Address of UTF-16 string buffer for switch synchronization with hot standby.
+    size_t         switch_sync_size;     // Size in bytes of switch_sync.
     long terminate;           // Terminate when one input plugin completes.
     long reuse_port;          // Reuse-port socket option.
     long first_input;         // Index of first input plugin.
@@ -124,6 +127,16 @@ TSDUCKPY bool tspyStartInputSwitcher(void* pyobj, const tspyInputSwitcherArgs* p
     args.terminate = bool(pyargs->terminate);
     args.fastSwitch = bool(pyargs->fast_switch);
     args.delayedSwitch = bool(pyargs->delayed_switch);
+    args.hotStandby = bool(pyargs->hot_standby);
+    const ts::UString sync(ts::py::ToString(pyargs->switch_sync, pyargs->switch_sync_size));
+    if (!sync.empty()) {
+        const int value = ts::InputSwitcherArgs::SwitchSyncNames.value(sync);
+        if (value == ts::Enumeration::UNKNOWN) {
+            isw->report().error(u"invalid switch synchronization \"%s\"", {sync});
+            return false;
+        }
+        args.switchSync = ts::InputSwitcherArgs::SwitchSync(value);
+    }
     args.reusePort = bool(pyargs->reuse_port);
     args.firstInput = size_t(std::max<long>(0, pyargs->first_input));
     args.primaryInput = pyargs->primary_input < 0 ? ts::NPOS : size_t(pyargs->primary_input);
@@ -1461,6 +1461,9 @@ class InputSwitcher(PluginEventHandlerRegistry):
         _fields_ = [
             ("fast_switch", ctypes.c_long),           # Fast switch between input plugins (bool).
             ("delayed_switch", ctypes.c_long),        # Delayed switch between input plugins (bool).
+            ("hot_standby", ctypes.c_long),           # Lock-free switch in the output thread (bool).
+            ("switch_sync", _c_uint8_p),              # Address of UTF-16 string buffer for switch synchronization.
+            ("switch_sync_size", ctypes.c_size_t),    # Size in bytes of switch_sync.
             ("terminate", ctypes.c_long),             # Terminate when one input plugin completes (bool).
             ("reuse_port", ctypes.c_long),            # Reuse-port socket option (bool).
             ("first_input", ctypes.c_long),           # Index of first input plugin.
@@ -1505,6 +1508,10 @@ class InputSwitcher(PluginEventHandlerRegistry):
         self.fast_switch = False
         ## Delayed switch between input plugins.
         self.delayed_switch = False
+        ## Lock-free switch in the output thread, all inputs are running (implies fast_switch).
+        self.hot_standby = False
+        ## With hot_standby, switch synchronization point: "packet", "pat-pmt" or "random-access".
+        self.switch_sync = "packet"
         ## Terminate when one input plugin completes.
         self.terminate = False
         ## Reuse-port socket option.
@@ -1564,6 +1571,10 @@ class InputSwitcher(PluginEventHandlerRegistry):
         args = self._tspyInputSwitcherArgs()
         args.fast_switch = ctypes.c_long(self.fast_switch)
         args.delayed_switch = ctypes.c_long(self.delayed_switch)
+        args.hot_standby = ctypes.c_long(self.hot_standby)
+        sync_buf = _InByteBuffer(self.switch_sync)
+        args.switch_sync = sync_buf.data_ptr()
+        args.switch_sync_size = sync_buf.size()
         args.terminate = ctypes.c_long(self.terminate)
         args.reuse_port = ctypes.c_long(self.reuse_port)
         args.first_input = ctypes.c_long(self.first_input)
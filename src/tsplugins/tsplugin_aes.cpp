@@ -42,6 +42,7 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual ShardingMode getShardingMode() override;
 
     private:
         // Command line options:
@@ -241,6 +242,19 @@ bool ts::AESPlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Parallel execution capability.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::ShardingMode ts::AESPlugin::getShardingMode()
+{
+    // When the PID's to scramble are explicitly specified, all packets are processed
+    // independently and any subset of the stream can be processed by a separate
+    // instance. When a service is specified, the PSI must be analyzed in sequence.
+    return _service_arg.hasId() || _service_arg.hasName() ? ShardingMode::NONE : ShardingMode::BY_BLOCK;
+}
+
+
 //----------------------------------------------------------------------------
 // Invoked by the demux when a complete table is available.
 //----------------------------------------------------------------------------
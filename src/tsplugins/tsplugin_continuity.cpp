@@ -27,6 +27,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
+        virtual ShardingMode getShardingMode() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -132,6 +133,19 @@ bool ts::ContinuityPlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Parallel execution capability.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::ShardingMode ts::ContinuityPlugin::getShardingMode()
+{
+    // Continuity counters are fixed independently in each PID. The messages contain packet
+    // indexes, which would be local to each instance: parallel execution when no message
+    // is displayed only.
+    return _fix && _log_level > tsp->maxSeverity() ? ShardingMode::BY_PID : ShardingMode::NONE;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
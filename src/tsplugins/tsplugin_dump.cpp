@@ -129,7 +129,7 @@ ts::ProcessorPlugin::Status ts::DumpPlugin::processPacket(TSPacket& pkt, TSPacke
             tsp->info(str);
         }
         else {
-            (*_out) << std::endl << "* Packet " << ts::UString::Decimal(tsp->pluginPackets()) << std::endl;
+            (*_out) << "\n* Packet " << ts::UString::Decimal(tsp->pluginPackets()) << '\n';
             pkt.display(*_out, _dump.dump_flags, 2, _dump.log_size);
             _add_endline = true;
         }
@@ -11,7 +11,8 @@
 //
 //  Definitions:
 //  - Main stream: the TS which is processed by tsp, including this plugin.
-//  - Merged stream: the additional TS which is read by this plugin through a pipe.
+//  - Merged stream: the additional TS which is read by this plugin through a pipe,
+//    or produced by an in-process chain of plugins (option --in-process).
 //
 //----------------------------------------------------------------------------
 
@@ -19,6 +20,12 @@
 #include "tsPCRMerger.h"
 #include "tsPSIMerger.h"
 #include "tsTSForkPipe.h"
+#include "tsTSProcessor.h"
+#include "tsArgsWithPlugins.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventContext.h"
+#include "tsPluginEventData.h"
+#include "tsReportWithPrefix.h"
 #include "tsTSPacketQueue.h"
 #include "tsPacketInsertionController.h"
 #include "tsThread.h"
@@ -33,7 +40,7 @@
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class MergePlugin: public ProcessorPlugin, private Thread
+    class MergePlugin: public ProcessorPlugin, private Thread, private PluginEventHandlerInterface
     {
         TS_PLUGIN_CONSTRUCTORS(MergePlugin);
     public:
@@ -46,6 +53,8 @@ namespace ts {
     private:
         // Command line options.
         UString          _command {};                                       // Command which generates the main stream.
+        bool             _in_process = false;                               // Run the command as an in-process tsp pipeline.
+        TSProcessorArgs  _proc_args {};                                     // In-process pipeline arguments.
         TSPacketFormat   _format = TSPacketFormat::AUTODETECT;              // Packet format on the pipe
         size_t           _max_queue = DEFAULT_MAX_QUEUED_PACKETS;           // Maximum number of queued packets.
         size_t           _accel_threshold = DEFAULT_MAX_QUEUED_PACKETS / 2; // Queue threshold after which insertion is accelerated.
@@ -74,6 +83,9 @@ namespace ts {
         PacketCounter _hold_count = 0;     // Number of times we didn't try to merge to perform smoothing insertion.
         PacketCounter _empty_count = 0;    // Number of times we could merge but there was no packet to merge.
         TSForkPipePtr _pipe {};            // Executed command.
+        std::mutex    _proc_mutex {};      // Protect access to _processor.
+        TSProcessor*  _processor = nullptr;  // In-process pipeline, when running.
+        ReportWithPrefix _proc_report {*tsp, u"merged stream: "};  // Log of the in-process pipeline.
         TSPacketQueue _queue {};           // TS packet queur from merge to main.
         PIDSet        _main_pids {};       // Set of detected PID's in main stream.
         PIDSet        _merge_pids {};      // Set of detected PID's in merged stream that we pass in main stream.
@@ -84,6 +96,12 @@ namespace ts {
         // Start/restart/stop the merge command.
         bool startStopCommand(bool do_close, bool do_start);
 
+        // Run the in-process pipeline until it terminates, with optional restarts (in the receiver thread).
+        void runProcessor();
+
+        // Receive the output packets of the in-process pipeline (in the pipeline output thread).
+        virtual void handlePluginEvent(const PluginEventContext& context) override;
+
         // There is one thread which receives packet from the created process and passes
         // them to the main plugin thread. The following method is the thread main code.
         virtual void main() override;
@@ -111,7 +129,8 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
 
     option(u"", 0, STRING, 1, 1);
     help(u"",
-         u"Specifies the command line to execute in the created process.");
+         u"Specifies the command line to execute in the created process. "
+         u"With --in-process, specifies the tsp command line which produces the merged stream.");
 
     option(u"acceleration-threshold", 0, UNSIGNED);
     help(u"acceleration-threshold",
@@ -143,6 +162,15 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
          u"Warning: this is a dangerous option which can result in an inconsistent "
          u"transport stream.");
 
+    option(u"in-process");
+    help(u"in-process",
+         u"Run the merged stream as a chain of plugins inside the tsp process, in a separate thread, "
+         u"instead of creating a process. The parameter is then a tsp command line, containing one input "
+         u"plugin and optional packet processor plugins, but no output plugin. The command name is ignored. "
+         u"Example: -P merge --in-process \"tsp -I ip 230.1.1.1:1234 -P pcrextract\". "
+         u"The output of the chain is directly passed to this plugin, without pipe and process "
+         u"switching. This is more efficient when many merge plugins are used on the same system.");
+
     option(u"incremental-pcr-restamp");
     help(u"incremental-pcr-restamp",
          u"When restamping PCR's from the merged TS into the main TS, compute each new "
@@ -251,6 +279,7 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
 bool ts::MergePlugin::getOptions()
 {
     getValue(_command);
+    _in_process = present(u"in-process");
     _no_wait = present(u"no-wait");
     const bool transparent = present(u"transparent");
     getIntValue(_max_queue, u"max-queue", DEFAULT_MAX_QUEUED_PACKETS);
@@ -275,6 +304,26 @@ bool ts::MergePlugin::getOptions()
         return false;
     }
 
+    // With --in-process, analyze the command as a tsp command line. The output is always this plugin.
+    if (_in_process) {
+        ArgsWithPlugins args(1, 1, 0, UNLIMITED_COUNT, 0, 0, u"Merged stream", u"[tsp-options]",
+                             Args::NO_EXIT_ON_ERROR | Args::NO_HELP | Args::NO_VERSION | Args::NO_CONFIG_FILE);
+        args.redirectReport(tsp);
+        _proc_args.defineArgs(args);
+        // The first word is the command name, it is ignored.
+        UStringVector argv;
+        _command.fromQuotedLine(argv);
+        if (!argv.empty()) {
+            argv.erase(argv.begin());
+        }
+        DuckContext proc_duck(tsp);
+        if (!args.analyze(u"merge", argv, false) || !_proc_args.loadArgs(proc_duck, args)) {
+            return false;
+        }
+        _proc_args.output.set(u"memory");
+        _proc_args.branch_outputs.clear();
+    }
+
     // Compute list of allowed PID's from the merged stream. Start with all PID's allowed.
     _allowed_pids.set();
 
@@ -393,7 +442,8 @@ bool ts::MergePlugin::start()
     _stopping = false;
 
     // Create pipe & process, then start the internal thread which receives the TS to merge.
-    return startStopCommand(false, true) && Thread::start();
+    // With --in-process, the pipeline is started by the internal thread.
+    return (_in_process || startStopCommand(false, true)) && Thread::start();
 }
 
 
@@ -410,9 +460,17 @@ bool ts::MergePlugin::stop()
     // Send the stop condition to the internal packet queue.
     _queue.stop();
 
-    // Close the pipe and terminate the created process.
+    // Close the pipe and terminate the created process, or abort the in-process pipeline.
     _stopping = true;
-    startStopCommand(true, false);
+    if (_in_process) {
+        std::lock_guard<std::mutex> lock(_proc_mutex);
+        if (_processor != nullptr) {
+            _processor->abort();
+        }
+    }
+    else {
+        startStopCommand(true, false);
+    }
 
     // Wait for actual thread termination.
     Thread::waitForTermination();
@@ -433,6 +491,13 @@ void ts::MergePlugin::main()
     // When zero, packet queue will compute it from the PCR.
     _queue.setBitrate(_user_bitrate);
 
+    // The in-process pipeline directly writes into the packet queue.
+    if (_in_process) {
+        runProcessor();
+        tsp->debug(u"receiver thread completed");
+        return;
+    }
+
     // Loop on packet reception until the plugin request to stop.
     bool success = true;
     while (success && !_queue.stopped()) {
@@ -483,6 +548,75 @@ void ts::MergePlugin::main()
 }
 
 
+//----------------------------------------------------------------------------
+// Run the in-process pipeline (in the receiver thread).
+//----------------------------------------------------------------------------
+
+void ts::MergePlugin::runProcessor()
+{
+    for (bool restart = false; !_stopping && !_queue.stopped(); restart = true) {
+
+        if (restart) {
+            if (!_restart) {
+                break;
+            }
+            std::this_thread::sleep_for(_restart_interval);
+            tsp->info(u"restarting merged stream");
+        }
+
+        // The output plugin of the pipeline is "memory", its output packets are passed to handlePluginEvent().
+        TSProcessor proc(_proc_report);
+        proc.registerEventHandler(this, PluginType::OUTPUT);
+        {
+            std::lock_guard<std::mutex> lock(_proc_mutex);
+            if (_stopping || !proc.start(_proc_args)) {
+                break;
+            }
+            _processor = &proc;
+        }
+        proc.waitForTermination();
+        {
+            std::lock_guard<std::mutex> lock(_proc_mutex);
+            _processor = nullptr;
+        }
+    }
+
+    // Signal end-of-file to plugin thread.
+    _queue.setEOF();
+}
+
+
+//----------------------------------------------------------------------------
+// Receive the output packets of the in-process pipeline.
+//----------------------------------------------------------------------------
+
+void ts::MergePlugin::handlePluginEvent(const PluginEventContext& context)
+{
+    PluginEventData* data = dynamic_cast<PluginEventData*>(context.pluginData());
+    if (data == nullptr) {
+        return;
+    }
+
+    // Copy the output packets of the pipeline directly in the inter-thread queue.
+    const uint8_t* packets = data->data();
+    size_t count = data->size() / PKT_SIZE;
+    while (count > 0) {
+        TSPacket* buffer = nullptr;
+        size_t buffer_size = 0;
+        if (!_queue.lockWriteBuffer(buffer, buffer_size)) {
+            // The plugin thread has signalled a stop condition, abort the pipeline.
+            data->setError();
+            return;
+        }
+        const size_t n = std::min(count, buffer_size);
+        TSPacket::Copy(buffer, packets, n);
+        _queue.releaseWriteBuffer(n);
+        packets += n * PKT_SIZE;
+        count -= n;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -48,8 +48,8 @@
 #include "tsPluginRepository.h"
 #include "tsSectionDemux.h"
 #include "tsBinaryTable.h"
-#include "tsPAT.h"
-#include "tsPMT.h"
+#include "tsPATView.h"
+#include "tsPMTView.h"
 #include "tsSafePtr.h"
 
 
@@ -306,21 +306,22 @@ void ts::PCRAdjustPlugin::handleTable(SectionDemux& demux, const BinaryTable& ta
 {
     switch (table.tableId()) {
         case TID_PAT: {
-            const PAT pat(duck, table);
+            const PATView pat(table);
             if (pat.isValid()) {
                 // Add all PMT PID's to the demux to grab all PMT's.
-                for (const auto& it : pat.pmts) {
-                    _demux.addPID(it.second);
+                for (const auto& it : pat.programs()) {
+                    _demux.addPID(it.pmtPID());
                 }
             }
             break;
         }
         case TID_PMT: {
-            const PMT pmt(duck, table);
-            if (pmt.isValid() && pmt.pcr_pid != PID_NULL) {
+            const PMTView pmt(table);
+            const PID pcr_pid = pmt.pcrPID();
+            if (pmt.isValid() && pcr_pid != PID_NULL) {
                 // Remember PCR PID for all components.
-                for (const auto& it : pmt.streams) {
-                    getContext(it.first)->pcr_ctx = getContext(pmt.pcr_pid);
+                for (const auto& it : pmt.streams()) {
+                    getContext(it.pid())->pcr_ctx = getContext(pcr_pid);
                 }
             }
             break;
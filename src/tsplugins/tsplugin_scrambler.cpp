@@ -419,6 +419,11 @@ bool ts::ScramblerPlugin::start()
             }
             tsp->debug(u"crypto-period duration: %'d ms, delay start: %'d ms", {_ecmg_args.cp_duration, _delay_start});
 
+            // In asynchronous mode, there is one pending ECM request per CryptoPeriod object at most.
+            // A new request on a CryptoPeriod waits for the completion of a previous one, never
+            // more than two ECM's are in the pipeline of the ECMG.
+            _ecmg.setMaxPendingRequests(_synchronous_ecmg ? 0 : 2);
+
             // Create first and second crypto-periods
             _cp[0].initCycle(this, 0);
             if (!_cp[0].initScramblerKey()) {
@@ -18,9 +18,8 @@
 #include "tsAlgorithm.h"
 #include "tsNames.h"
 #include "tsEITProcessor.h"
-#include "tsCADescriptor.h"
 #include "tsPAT.h"
-#include "tsPMT.h"
+#include "tsPMTView.h"
 #include "tsSDT.h"
 #include "tsBAT.h"
 #include "tsNIT.h"
@@ -37,6 +36,7 @@ namespace ts {
     public:
         // Implementation of plugin API
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -63,12 +63,12 @@ namespace ts {
         // Process specific tables and descriptors
         void processPAT(PAT&);
         void processSDT(SDT&);
-        void processPMT(PMT&);
+        void processPMT(const PMTView&);
         void processNITBAT(AbstractTransportListTable&);
         void processNITBATDescriptorList(DescriptorList&);
 
         // Mark all ECM PIDs from the specified descriptor list in the specified PID set
-        void addECMPID(const DescriptorList&, PIDSet&);
+        void addECMPID(const DescriptorLoopView&, PIDSet&);
     };
 }
 
@@ -144,8 +144,9 @@ bool ts::SVRemovePlugin::start()
         }
     }
 
-    // Initialize the EIT processing.
+    // Initialize the EIT processing. Since EIT's are only removed, they are processed in place.
     _eit_process.reset();
+    _eit_process.setInPlace(true);
 
     // Build a list of referenced PID's (except those in the removed service).
     // Prevent predefined PID's from being removed.
@@ -205,7 +206,7 @@ void ts::SVRemovePlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
         }
 
         case TID_PMT: {
-            PMT pmt(duck, table);
+            const PMTView pmt(table);
             if (pmt.isValid()) {
                 processPMT(pmt);
             }
@@ -410,26 +411,26 @@ void ts::SVRemovePlugin::processPAT(PAT& pat)
 //  This method processes a Program Map Table (PMT).
 //----------------------------------------------------------------------------
 
-void ts::SVRemovePlugin::processPMT(PMT& pmt)
+void ts::SVRemovePlugin::processPMT(const PMTView& pmt)
 {
     // Is this the PMT of the service to remove?
-    const bool removed_service = pmt.service_id == _service.getId();
+    const bool removed_service = pmt.serviceId() == _service.getId();
 
     // Mark PIDs as dropped or referenced.
     PIDSet& pid_set(removed_service ? _drop_pids : _ref_pids);
 
     // Mark all program-level ECM PID's
-    addECMPID(pmt.descs, pid_set);
+    addECMPID(pmt.descriptors(), pid_set);
 
     // Mark service's PCR PID (usually a referenced component or null PID)
-    pid_set.set(pmt.pcr_pid);
+    pid_set.set(pmt.pcrPID());
 
     // Loop on all elementary streams
-    for (const auto& it : pmt.streams) {
+    for (const auto& it : pmt.streams()) {
         // Mark component's PID
-        pid_set.set(it.first);
+        pid_set.set(it.pid());
         // Mark all component-level ECM PID's
-        addECMPID(it.second.descs, pid_set);
+        addECMPID(it.descriptors(), pid_set);
     }
 
     // When the service to remove has been analyzed, we are ready to filter PIDs
@@ -441,17 +442,14 @@ void ts::SVRemovePlugin::processPMT(PMT& pmt)
 // Mark all ECM PIDs from the descriptor list in the PID set
 //----------------------------------------------------------------------------
 
-void ts::SVRemovePlugin::addECMPID(const DescriptorList& dlist, PIDSet& pid_set)
+void ts::SVRemovePlugin::addECMPID(const DescriptorLoopView& dlist, PIDSet& pid_set)
 {
     // Loop on all CA descriptors
-    for (size_t index = dlist.search(DID_CA); index < dlist.count(); index = dlist.search(DID_CA, index + 1)) {
-        CADescriptor ca(duck, *dlist[index]);
-        if (!ca.isValid()) {
-            // Cannot deserialize a valid CA descriptor, ignore it
-        }
-        else {
-            // Standard CAS, only one PID in CA descriptor
-            pid_set.set(ca.ca_pid);
+    for (auto it = dlist.search(DID_CA); it != dlist.end(); it = dlist.search(DID_CA, ++it)) {
+        // Standard CAS, only one PID in CA descriptor: CA_system_id (16 bits), reserved (3 bits), CA_PID (13 bits).
+        // Ignore descriptors which are too short to be valid.
+        if ((*it).payloadSize() >= 4) {
+            pid_set.set(GetUInt16((*it).payload() + 2) & 0x1FFF);
         }
     }
 }
@@ -531,6 +529,27 @@ void ts::SVRemovePlugin::processNITBATDescriptorList(DescriptorList& dlist)
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::SVRemovePlugin::stop()
+{
+    if (!_ignore_eit) {
+        // EIT packets which are still delayed by the in-place processing cannot be output anymore.
+        TSPacket pkt;
+        size_t count = 0;
+        while (_eit_process.flushPacket(pkt, true)) {
+            count++;
+        }
+        if (count > 0) {
+            verbose(u"%d delayed EIT packets not output at end of stream", {count});
+        }
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -575,6 +594,10 @@ ts::ProcessorPlugin::Status ts::SVRemovePlugin::processPacket(TSPacket& pkt, TSP
     else if (!_ignore_eit && pid == PID_EIT) {
         _eit_process.processPacket(pkt);
     }
+    else if (!_ignore_eit && pid == PID_NULL) {
+        // Output delayed EIT packets in place of null packets.
+        _eit_process.flushPacket(pkt);
+    }
 
     return TSP_OK;
 }
@@ -36,6 +36,7 @@ namespace ts {
     public:
         // Implementation of plugin API
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -163,8 +164,9 @@ bool ts::SVRenamePlugin::start()
     _demux.reset();
     _demux.addPID(_old_service.hasName() ? PID_SDT : PID_PAT);
 
-    // Initialize the EIT processing.
+    // Initialize the EIT processing. Since EIT's are only renamed, they are updated in place.
     _eit_process.reset();
+    _eit_process.setInPlace(true);
 
     // No need to modify EIT's if there is no new service id.
     if (!_new_service.hasId()) {
@@ -187,6 +189,29 @@ bool ts::SVRenamePlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::SVRenamePlugin::stop()
+{
+    if (!_ignore_eit) {
+        // Packets cannot be output from stop(): the EIT packets which are still delayed by the
+        // in-place processing are lost. They are null packets in the output stream.
+        TSPacket pkt;
+        size_t count = 0;
+        while (_eit_process.flushPacket(pkt, true)) {
+            count++;
+        }
+        if (count > 0) {
+            verbose(u"%d delayed EIT packets not output at end of stream", {count});
+        }
+        _eit_process.reportStatistics();
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Invoked by the demux when a complete table is available.
 //----------------------------------------------------------------------------
@@ -566,6 +591,10 @@ ts::ProcessorPlugin::Status ts::SVRenamePlugin::processPacket(TSPacket& pkt, TSP
             _eit_process.processPacket(pkt);
         }
     }
+    else if (!_ignore_eit) {
+        // Use null packets to output EIT packets which were delayed by the in-place processing.
+        _eit_process.flushPacket(pkt);
+    }
 
     return TSP_OK;
 }
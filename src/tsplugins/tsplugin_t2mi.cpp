@@ -61,7 +61,8 @@ namespace ts {
         PacketCounter          _ts_count = 0;        // Number of extracted TS packets.
         T2MIDemux              _demux {duck, this};  // T2-MI demux.
         IdentifiedSet          _identified {};       // Map of identified PID's and PLP's.
-        std::deque<TSPacket>   _ts_queue {};         // Queue of demuxed TS packets.
+        TSPacketVector         _ts_queue {};         // Queue of demuxed TS packets (memory is reused).
+        size_t                 _ts_next = 0;         // Index of next packet to output in _ts_queue.
 
         // Inherited methods.
         virtual void handleT2MINewPID(T2MIDemux& demux, const PMT& pmt, PID pid, const T2MIDescriptor& desc) override;
@@ -184,6 +185,7 @@ bool ts::T2MIPlugin::start()
     // Reset the packet output.
     _identified.clear();
     _ts_queue.clear();
+    _ts_next = 0;
     _t2mi_count = 0;
     _ts_count = 0;
     _abort = false;
@@ -371,14 +373,23 @@ ts::ProcessorPlugin::Status ts::T2MIPlugin::processPacket(TSPacket& pkt, TSPacke
         // Without TS replacement, we simply pass all packets, unchanged.
         return TSP_OK;
     }
-    else if (_ts_queue.empty()) {
+    else if (_ts_next >= _ts_queue.size()) {
         // No extracted packet to output, drop current packet.
         return TSP_DROP;
     }
     else {
         // Replace the current packet with the next demux'ed TS packet.
-        pkt = _ts_queue.front();
-        _ts_queue.pop_front();
+        pkt = _ts_queue[_ts_next++];
+        if (_ts_next >= _ts_queue.size()) {
+            // Queue is now empty, keep the allocated memory for subsequent packets.
+            _ts_queue.clear();
+            _ts_next = 0;
+        }
+        else if (_ts_next >= 1000) {
+            // Many unused packets at head of queue, compress it.
+            _ts_queue.erase(_ts_queue.begin(), _ts_queue.begin() + _ts_next);
+            _ts_next = 0;
+        }
         _ts_count++;
         return TSP_OK;
     }
@@ -34,6 +34,7 @@ namespace ts {
     public:
         // Implementation of plugin API
         virtual bool start() override;
+        virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
@@ -127,8 +128,9 @@ bool ts::TSRenamePlugin::start()
     _demux.reset();
     _demux.addPID(PID_PAT);
 
-    // Initialize the EIT processing.
+    // Initialize the EIT processing. Since EIT's are only renamed, they are updated in place.
     _eit_process.reset();
+    _eit_process.setInPlace(true);
 
     // No need to modify EIT's if there is no new TS id and no new net id.
     if (!_set_ts_id && !_set_onet_id) {
@@ -147,6 +149,28 @@ bool ts::TSRenamePlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Stop method
+//----------------------------------------------------------------------------
+
+bool ts::TSRenamePlugin::stop()
+{
+    if (!_ignore_eit) {
+        // No packet can be output after the last one: count the lost delayed EIT packets.
+        TSPacket pkt;
+        size_t count = 0;
+        while (_eit_process.flushPacket(pkt, true)) {
+            count++;
+        }
+        if (count > 0) {
+            verbose(u"%d delayed EIT packets not output at end of stream", {count});
+        }
+        _eit_process.reportStatistics();
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Invoked by the demux when a complete table is available.
 //----------------------------------------------------------------------------
@@ -365,6 +389,10 @@ ts::ProcessorPlugin::Status ts::TSRenamePlugin::processPacket(TSPacket& pkt, TSP
     else if (!_ignore_eit && pid == PID_EIT) {
         _eit_process.processPacket(pkt);
     }
+    else if (!_ignore_eit && pid == PID_NULL) {
+        // Null packets are replaced with the delayed EIT packets, if any.
+        _eit_process.flushPacket(pkt);
+    }
 
     return TSP_OK;
 }
@@ -16,10 +16,15 @@
 #include "tsTSFile.h"
 #include "tsFileUtils.h"
 #include "tsjsonObject.h"
+#include "tsTSFileRegionComparator.h"
 TS_MAIN(MainCode);
 
 #define DEFAULT_BUFFERED_PACKETS 10000
 #define DEFAULT_MIN_REORDER          7
+#define DEFAULT_THREADS             ts::TSFileRegionComparator::DEFAULT_THREADS
+#define MAX_THREADS                 64
+#define FAST_MIN_PACKETS          1000  // Min number of identical packets to skip in fast mode.
+#define FAST_MAX_BACKOFF       1024000  // Max number of identical packets before retrying a skip after failures.
 
 
 //----------------------------------------------------------------------------
@@ -42,6 +47,8 @@ namespace ts {
         size_t           buffered_packets = 0;
         size_t           threshold_diff = 0;
         size_t           min_reorder = 0;
+        size_t           threads = 0;
+        bool             fast = false;
         bool             search_reorder = false;
         bool             dump = false;
         uint32_t         dump_flags = 0;
@@ -119,6 +126,20 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     option(u"subset");
     help(u"subset", u"Legacy option, same as --search-reorder");
 
+    option(u"no-fast", 0);
+    help(u"no-fast",
+         u"Disable the fast comparison of identical regions. "
+         u"By default, when the two files are regular files in TS format, large identical regions "
+         u"are compared by blocks in parallel threads and skipped. "
+         u"The packet by packet comparison is used only around differences. "
+         u"The fast comparison is always disabled with options which ignore some packet fields "
+         u"(--cc-ignore, --payload-only, --pcr-ignore, --pid-ignore).");
+
+    option(u"threads", 0, INTEGER, 0, 1, 1, MAX_THREADS);
+    help(u"threads", u"count",
+         u"Number of threads which compare identical regions in parallel. "
+         u"The default is " + UString::Decimal(DEFAULT_THREADS) + u".");
+
     option(u"threshold-diff", 't', INTEGER, 0, 1, 0, PKT_SIZE);
     help(u"threshold-diff", u"count",
          u"When used with --search-reorder, this value specifies the maximum number of "
@@ -138,11 +159,14 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     byte_offset = intValue<uint64_t>(u"byte-offset", intValue<uint64_t>(u"packet-offset", 0) * PKT_SIZE);
     getIntValue(threshold_diff, u"threshold-diff", 0);
     getIntValue(min_reorder, u"min-reorder", std::min<size_t>(DEFAULT_MIN_REORDER, buffered_packets));
+    getIntValue(threads, u"threads", DEFAULT_THREADS);
     search_reorder = present(u"subset") || present(u"search-reorder");
     payload_only = present(u"payload-only");
     pcr_ignore = present(u"pcr-ignore");
     pid_ignore = present(u"pid-ignore");
     cc_ignore = present(u"cc-ignore");
+    // The fast mode compares raw packets, it cannot be used when some fields are ignored.
+    fast = !present(u"no-fast") && buffered_packets > 1 && !payload_only && !pcr_ignore && !pid_ignore && !cc_ignore;
     continue_all = present(u"continue");
     quiet = present(u"quiet");
     normalized = !quiet && present(u"normalized");
@@ -257,6 +281,11 @@ void ts::PacketComparator::compare(const uint8_t* mem1, size_t size1, const uint
 {
     diff_count = 0;
     first_diff = end_diff = compared_size = std::min(size1, size2);
+    if (std::memcmp(mem1, mem2, compared_size) == 0) {
+        // Most packets are identical, avoid the byte by byte loop.
+        equal = size1 == size2;
+        return;
+    }
     for (size_t i = 0; i < compared_size; i++) {
         if (mem1[i] != mem2[i]) {
             diff_count++;
@@ -284,7 +313,8 @@ namespace ts {
 
         // Get the file name and total read packet count.
         UString fileName() const { return _file.getDisplayFileName(); }
-        PacketCounter readPacketsCount() const { return _file.readPacketsCount(); }
+        fs::path filePath() const { return _file.getFileName(); }
+        PacketCounter readPacketsCount() const { return _skipped + _file.readPacketsCount(); }
 
         // Check if current packet is after end of file.
         bool eof() const { return _end_of_file && _packet_count == 0; }
@@ -322,6 +352,16 @@ namespace ts {
         // Check if we are in a missing area. Return either 0 or the number of missing packets. Reset the missing area.
         PacketCounter wasInMissingArea();
 
+        // Check if the file can be read by blocks from the current packet in fast mode.
+        bool canSkip() const;
+
+        // Byte offset in the file of a packet in fast mode and size of the file in bytes.
+        uint64_t byteOffset(PacketCounter index) const { return _opt.byte_offset + index * PKT_SIZE; }
+        uint64_t fileSize() const;
+
+        // Skip identical packets in fast mode, with the count of packets per PID in the skipped area.
+        void skip(PacketCounter count, const std::vector<PacketCounter>& pid_count);
+
     private:
         // Metadata for one packet in the buffer.
         struct PacketData {
@@ -339,6 +379,8 @@ namespace ts {
         PacketCounter               _missing_start = NONE; // If not NONE, we are inside a zone of missing packets (missing in the other file).
         PacketCounter               _missing_packets = 0;  // Total numner of missing packets.
         PacketCounter               _missing_chunks = 0;   // Number of holes, missing chunks.
+        PacketCounter               _skipped = 0;          // Number of packets which were skipped in fast mode, without being read.
+        bool                        _regular = false;      // The file is a regular file, open in rewindable mode.
         bool                        _end_of_file = false;  // End of file or error encountered.
 
         // Dummy value for no packet index.
@@ -359,8 +401,58 @@ ts::FileToCompare::FileToCompare(TSCompareOptions& opt, const UString& filename)
     _opt(opt),
     _packets_buffer(_opt.buffered_packets),
     _packets_data(_opt.buffered_packets),
-    _end_of_file(!_file.openRead(filename, 1, _opt.byte_offset, _opt, _opt.format))
+    _regular(_opt.fast && fs::is_regular_file(filename, &ErrCodeReport()))
+{
+    // Regular files are open in rewindable mode to skip identical regions in fast mode.
+    _end_of_file = _regular ? !_file.openRead(filename, _opt.byte_offset, _opt, _opt.format) : !_file.openRead(filename, 1, _opt.byte_offset, _opt, _opt.format);
+    fillBuffer();
+}
+
+
+// Check if the file can be read by blocks from the current packet in fast mode.
+bool ts::FileToCompare::canSkip() const
+{
+    // The file format is known after the first read.
+    if (!_regular || _file.packetFormat() != TSPacketFormat::TS || _missing_start != NONE || eof()) {
+        return false;
+    }
+    // Packets which were already matched out of order must be processed by the packet by packet comparison.
+    for (PacketCounter i = 0; i < _packet_count; ++i) {
+        if (packetData(_packet_index + i).ignore) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Size of the file in bytes.
+uint64_t ts::FileToCompare::fileSize() const
+{
+    const std::uintmax_t size = fs::file_size(_file.getFileName(), &ErrCodeReport());
+    return size == FS_ERROR ? 0 : uint64_t(size);
+}
+
+
+// Skip identical packets in fast mode.
+void ts::FileToCompare::skip(PacketCounter count, const std::vector<PacketCounter>& pid_count)
 {
+    // The skipped area includes all packets in the buffer, which were already counted in their PID.
+    assert(count >= _packet_count);
+    for (PacketCounter i = 0; i < _packet_count; ++i) {
+        _by_pid[packet(_packet_index + i).getPID()]--;
+    }
+    for (PID pid = 0; pid < pid_count.size(); ++pid) {
+        if (pid_count[pid] > 0) {
+            _by_pid[pid] += pid_count[pid];
+        }
+    }
+
+    // Restart reading after the skipped area.
+    _skipped += count - _packet_count;
+    _packet_index += count;
+    _packet_count = 0;
+    _end_of_file = !_file.seek(_packet_index, _opt);
     fillBuffer();
 }
 
@@ -390,7 +482,7 @@ void ts::FileToCompare::fillBuffer()
         readContiguousPackets();
         // Wrap up and read more at beginning of buffer if necessary.
         if (!_end_of_file && _packet_count < _packets_buffer.size()) {
-            assert(_packet_index % _packets_buffer.size() == 0);
+            assert((_packet_index + _packet_count) % _packets_buffer.size() == 0);
             readContiguousPackets();
         }
     }
@@ -512,6 +604,13 @@ namespace ts {
         FileToCompare     _file1;
         json::Object      _jroot {};
         PacketCounter     _diff_count = 0;
+        TSFileRegionComparator _regions;
+        PacketCounter     _equal_run = 0;                 // Number of consecutive identical packets.
+        PacketCounter     _fast_min = FAST_MIN_PACKETS;   // Number of consecutive identical packets before trying a skip.
+
+        // Skip identical regions in fast mode, when the two files are synchronized.
+        // Return true if a region was skipped.
+        bool fastForward();
 
         void displayHeader();
         void displayFinal();
@@ -530,7 +629,8 @@ namespace ts {
 ts::FileComparator::FileComparator(TSCompareOptions& opt) :
     _opt(opt),
     _file0(_opt, _opt.filename0),
-    _file1(_opt, _opt.filename1)
+    _file1(_opt, _opt.filename1),
+    _regions(_opt.threads)
 {
     // No need to go further if at least one file is on error or empty.
     if (_file0.eof() || _file1.eof()) {
@@ -542,7 +642,16 @@ ts::FileComparator::FileComparator(TSCompareOptions& opt) :
     // Read and compare all packets in the files.
     // Stop at first difference in quiet mode (only report if equal) or not --continue.
     while (!_file0.eof() && !_file1.eof() && (_diff_count == 0 || (!_opt.quiet && _opt.continue_all))) {
+        // After a long enough sequence of identical packets, try to skip an identical region.
+        // When no region can be skipped, wait for longer sequences before trying again.
+        if (_opt.fast && _equal_run >= _fast_min) {
+            _fast_min = fastForward() ? FAST_MIN_PACKETS : std::min<PacketCounter>(2 * _fast_min, FAST_MAX_BACKOFF);
+            if (_file0.eof() || _file1.eof()) {
+                break;
+            }
+        }
         const PacketComparator comp(_file0.packet(), _file1.packet(), _opt);
+        _equal_run = comp.equal ? _equal_run + 1 : 0;
         if (comp.equal) {
             // Current packets are identical.
             displayMissingChunk(0, _file0, 1, _file1);
@@ -620,6 +729,38 @@ ts::FileComparator::FileComparator(TSCompareOptions& opt) :
 }
 
 
+// Skip identical regions in fast mode.
+bool ts::FileComparator::fastForward()
+{
+    _equal_run = 0;
+    if (!_file0.canSkip() || !_file1.canSkip()) {
+        return false;
+    }
+
+    // Maximum number of packets to compare.
+    const PacketCounter index0 = _file0.packetIndex();
+    const PacketCounter index1 = _file1.packetIndex();
+    const uint64_t size0 = _file0.fileSize();
+    const uint64_t size1 = _file1.fileSize();
+    const uint64_t start0 = _file0.byteOffset(index0);
+    const uint64_t start1 = _file1.byteOffset(index1);
+    const PacketCounter max_count = size0 <= start0 || size1 <= start1 ? 0 : std::min(size0 - start0, size1 - start1) / PKT_SIZE;
+
+    // Compare by large blocks in parallel threads, until a difference is found.
+    std::vector<PacketCounter> pid_count;
+    const PacketCounter equal_count = _regions.compare(_file0.filePath(), start0, _file1.filePath(), start1, max_count, &pid_count);
+
+    // Skip the identical region when it is larger than the buffers.
+    if (equal_count >= FAST_MIN_PACKETS && equal_count >= _file0.packetCount() && equal_count >= _file1.packetCount()) {
+        _opt.debug(u"skipping %'d identical packets at index %'d", {equal_count, index0});
+        _file0.skip(equal_count, pid_count);
+        _file1.skip(equal_count, pid_count);
+        return true;
+    }
+    return false;
+}
+
+
 // Display initial headers.
 void ts::FileComparator::displayHeader()
 {
@@ -119,7 +119,7 @@ namespace {
         for (ts::PacketCounter packet_index = 0; packet_index < opt.max_packets && file.readPackets(&pkt, nullptr, 1, opt) > 0; packet_index++) {
             if (opt.dump.pids.test(pkt.getPID())) {
                 if (!opt.dump.log) {
-                    out << std::endl << "* Packet " << ts::UString::Decimal(packet_index) << std::endl;
+                    out << "\n* Packet " << ts::UString::Decimal(packet_index) << '\n';
                 }
                 pkt.display(out, opt.dump.dump_flags, opt.dump.log ? 0 : 2, opt.dump.log_size);
             }
@@ -162,17 +162,19 @@ namespace {
 
         // Raw dump of file
         const uint32_t flags = (opt.dump.dump_flags & 0x0000FFFF) | ts::UString::BPL | ts::UString::WIDE_OFFSET;
-        const size_t MAX_RAW_BPL = 16;
         const size_t raw_bpl = (flags & ts::UString::BINARY) ? 8 : 16;  // Bytes per line in raw mode
+        const size_t RAW_LINES = 1024;  // Number of lines to format at once.
+        std::vector<char> buffer(raw_bpl * RAW_LINES);
+        std::string text;
         size_t offset = 0;
         while (*in) {
-            int c;
-            size_t size;
-            uint8_t buffer[MAX_RAW_BPL];
-            for (size = 0; size < raw_bpl && (c = in->get()) != EOF; size++) {
-                buffer[size] = uint8_t(c);
-            }
-            out << ts::UString::Dump(buffer, size, flags, 0, raw_bpl, offset);
+            // Read a large block and dump it at once. The output is identical to a line by line
+            // dump as long as the block size is a multiple of the number of bytes per line.
+            in->read(buffer.data(), std::streamsize(buffer.size()));
+            const size_t size = size_t(in->gcount());
+            text.clear();
+            ts::UString::AppendDump(text, buffer.data(), size, flags, 0, raw_bpl, offset);
+            out << text;
             offset += size;
         }
     }
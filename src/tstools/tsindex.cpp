@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Build or display the time index of transport stream files
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsTSFile.h"
+#include "tsTSFileIndexer.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        bool                  list = false;        // List existing index.
+        ts::MilliSecond       interval = 0;        // Min interval between entries.
+        ts::TSPacketFormat    format = ts::TSPacketFormat::AUTODETECT;
+        std::vector<fs::path> files {};            // TS file names.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"Build or display the time index of transport stream files", u"[options] filename ...")
+{
+    DefineTSPacketFormatInputOption(*this);
+
+    option(u"", 0, FILENAME, 1, UNLIMITED_COUNT);
+    help(u"",
+         u"Transport stream files to index. For each file, the time index is created "
+         u"in a file with the same name plus a \".tsidx\" extension.");
+
+    option(u"interval", 'i', POSITIVE);
+    help(u"interval", u"milliseconds",
+         u"Minimum interval between two entry points, in milliseconds of PCR time. "
+         u"The default is " + ts::UString::Decimal(ts::TSFileIndexer::DEFAULT_INTERVAL) + u" milliseconds.");
+
+    option(u"list", 'l');
+    help(u"list", u"Display the content of the existing time index of each file instead of building it.");
+
+    analyze(argc, argv);
+
+    getPathValues(files);
+    getIntValue(interval, u"interval", ts::TSFileIndexer::DEFAULT_INTERVAL);
+    list = present(u"list");
+    format = LoadTSPacketFormatInputOption(*this);
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Display the time index of a file.
+//----------------------------------------------------------------------------
+
+namespace {
+    void ListIndex(Options& opt, const fs::path& file)
+    {
+        ts::TSFileIndex index;
+        if (!index.load(ts::TSFileIndex::IndexFileName(file), opt)) {
+            return;
+        }
+        std::cout << ts::UString::Format(u"%s: %'d entries, %d-byte packets", {file, index.entries().size(), index.packetSize()}) << std::endl;
+        for (const auto& e : index.entries()) {
+            std::cout << ts::UString::Format(u"  packet: %12d, PCR: %s, PTS: %s, UTC: %s",
+                                             {e.packet,
+                                              e.pcr == ts::INVALID_PCR ? u"unknown" : ts::UString::Format(u"0x%011X", {e.pcr}),
+                                              e.pts == ts::INVALID_PTS ? u"unknown" : ts::UString::Format(u"0x%09X", {e.pts}),
+                                              e.utc < 0 ? u"unknown" : e.utcTime().format(ts::Time::ALL)})
+                      << std::endl;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Build the time index of a file.
+//----------------------------------------------------------------------------
+
+namespace {
+    void BuildIndex(Options& opt, const fs::path& file)
+    {
+        ts::TSFile input;
+        if (!input.openRead(file, 1, 0, opt, opt.format)) {
+            return;
+        }
+
+        ts::TSFileIndexer indexer;
+        indexer.setInterval(opt.interval);
+
+        // The packet format is known after the first read, the index is open then.
+        ts::TSPacketVector buffer(1000);
+        ts::PacketCounter index = 0;
+        size_t count = 0;
+        while ((count = input.readPackets(buffer.data(), nullptr, buffer.size(), opt)) > 0) {
+            if (index == 0 && input.packetFormat() == ts::TSPacketFormat::COMPACT) {
+                opt.error(u"%s: files in compact format cannot be indexed", {file});
+                break;
+            }
+            if (index == 0 && !indexer.open(ts::TSFileIndex::IndexFileName(file), input.packetHeaderSize() + ts::PKT_SIZE + input.packetTrailerSize(), false, opt)) {
+                break;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                indexer.feedPacket(buffer[i], index++);
+            }
+        }
+
+        opt.verbose(u"%s: %'d packets, %'d index entries", {file, index, indexer.entryCount()});
+        indexer.close();
+        input.close(opt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+
+    for (const auto& file : opt.files) {
+        if (opt.list) {
+            ListIndex(opt, file);
+        }
+        else {
+            BuildIndex(opt, file);
+        }
+    }
+
+    return opt.gotErrors() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
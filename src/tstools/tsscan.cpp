@@ -23,6 +23,8 @@
 #include "tsTransportStreamId.h"
 #include "tsDescriptorList.h"
 #include "tsFileUtils.h"
+#include "tsThread.h"
+#include "tsOrderedJobOutput.h"
 TS_MAIN(MainCode);
 
 #define DEFAULT_PSI_TIMEOUT   10000 // ms
@@ -61,6 +63,7 @@ namespace {
         ts::UString       channel_file {};
         bool              update_channel_file = false;
         bool              default_channel_file = false;
+        ts::UStringVector parallel_devices {};
     };
 }
 
@@ -148,6 +151,13 @@ ScanOptions::ScanOptions(int argc, char *argv[]) :
          u"With this option, tsscan checks all offsets and reports that the signal is at offset +1. "
          u"By default, tsscan reports that the signal is found at the central frequency of the channel (offset zero).");
 
+    option(u"parallel-device", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"parallel-device", u"name",
+         u"Specify an additional tuner device to scan in parallel with the main one. "
+         u"The device name has the same format as with option --device-name, including XML tuner emulator configurations. "
+         u"All tuners use the same reception parameters and the channels to scan are distributed among them. "
+         u"Several options --parallel-device can be specified.");
+
     option(u"psi-timeout", 0, UNSIGNED);
     help(u"psi-timeout", u"milliseconds",
          u"Specifies the timeout, in milli-seconds, for PSI/SI table collection. "
@@ -212,6 +222,7 @@ ScanOptions::ScanOptions(int argc, char *argv[]) :
     list_services     = present(u"service-list");
     global_services   = present(u"global-service-list");
     psi_timeout       = intValue<ts::MilliSecond>(u"psi-timeout", DEFAULT_PSI_TIMEOUT);
+    getValues(parallel_devices, u"parallel-device");
 
     const bool save_channel_file = present(u"save-channels");
     update_channel_file = present(u"update-channels");
@@ -230,6 +241,46 @@ ScanOptions::ScanOptions(int argc, char *argv[]) :
 }
 
 
+//----------------------------------------------------------------------------
+// Log of one tuner. The messages are kept and later reported through the
+// log of the application, in the order of the scanning jobs.
+//----------------------------------------------------------------------------
+
+class TunerReport: public ts::Report
+{
+    TS_NOBUILD_NOCOPY(TunerReport);
+public:
+    // List of logged messages with their severity.
+    typedef ts::OrderedJobOutput::MessageList MessageList;
+
+    // Constructor.
+    TunerReport(int max_severity) : ts::Report(max_severity) {}
+
+    // Move all logged messages into a list.
+    void moveMessages(MessageList& messages) { messages.swap(_messages); _messages.clear(); }
+
+    // Report all logged messages on another report.
+    void flush(ts::Report& report);
+
+private:
+    MessageList _messages {};
+    virtual void writeLog(int severity, const ts::UString& message) override;
+};
+
+void TunerReport::writeLog(int severity, const ts::UString& message)
+{
+    _messages.push_back(std::make_pair(severity, message));
+}
+
+void TunerReport::flush(ts::Report& report)
+{
+    for (const auto& msg : _messages) {
+        report.log(msg.first, msg.second);
+    }
+    _messages.clear();
+}
+
+
 //----------------------------------------------------------------------------
 // UHF/VHF-band offset scanner: Scan offsets around a specific channel and
 // determine offset with the best signal.
@@ -240,7 +291,7 @@ class OffsetScanner
     TS_NOBUILD_NOCOPY(OffsetScanner);
 public:
     // Constructor: Perform scanning. Keep signal tuned on best offset.
-    OffsetScanner(ScanOptions& opt, ts::Tuner& tuner, uint32_t channel);
+    OffsetScanner(ScanOptions& opt, ts::Report& report, ts::Tuner& tuner, uint32_t channel);
 
     // Check if signal found and which offset is the best one.
     bool signalFound() const { return _signal_found; }
@@ -250,6 +301,7 @@ public:
 
 private:
     ScanOptions&       _opt;
+    ts::Report&        _report;
     ts::Tuner&         _tuner;
     const uint32_t     _channel;
     bool               _signal_found = false;
@@ -276,12 +328,13 @@ private:
 // Perform scanning. Keep signal tuned on best offset
 //----------------------------------------------------------------------------
 
-OffsetScanner::OffsetScanner(ScanOptions& opt, ts::Tuner& tuner, uint32_t channel) :
+OffsetScanner::OffsetScanner(ScanOptions& opt, ts::Report& report, ts::Tuner& tuner, uint32_t channel) :
     _opt(opt),
+    _report(report),
     _tuner(tuner),
     _channel(channel)
 {
-    _opt.verbose(u"scanning channel %'d, %'d Hz", {_channel, _opt.hfband->frequency(_channel)});
+    _report.verbose(u"scanning channel %'d, %'d Hz", {_channel, _opt.hfband->frequency(_channel)});
 
     if (_opt.no_offset) {
         // Only try the central frequency
@@ -339,7 +392,7 @@ void OffsetScanner::buildTuningParameters(ts::ModulationArgs& params, int32_t of
     // Force frequency in tuning parameters.
     // Other tuning parameters from command line (or default values).
     params = _opt.tuner_args;
-    params.resolveDeliverySystem(_tuner.deliverySystems(), _opt);
+    params.resolveDeliverySystem(_tuner.deliverySystems(), _report);
     params.frequency = _opt.hfband->frequency(_channel, offset);
     params.setDefaultValues();
 }
@@ -362,7 +415,7 @@ bool OffsetScanner::tune(int32_t offset, ts::ModulationArgs& params)
 
 bool OffsetScanner::tryOffset(int32_t offset)
 {
-    _opt.debug(u"trying offset %d", {offset});
+    _report.debug(u"trying offset %d", {offset});
 
     // Tune to transponder and start signal acquisition.
     // Signal locking timeout is applied in start().
@@ -379,7 +432,7 @@ bool OffsetScanner::tryOffset(int32_t offset)
     // If we don't scan offsets, there is no need to consider signal strength, just use the central offset.
     if (ok && !_opt.no_offset) {
 
-        _opt.verbose(u"%s, %s", {_opt.hfband->description(_channel, offset), state});
+        _report.verbose(u"%s, %s", {_opt.hfband->description(_channel, offset), state});
 
         if (state.signal_strength.has_value()) {
             const int64_t strength = state.signal_strength.value().value;
@@ -432,28 +485,155 @@ public:
     void main();
 
 private:
+    // One tuner with its own TSDuck context and its own log. With several tuners, each additional one
+    // runs in its own thread. The log of the tuner is reported with the output of each scanning job.
+    class TunerContext: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(TunerContext);
+    public:
+        TunerContext(ScanContext& scan, const ts::UString& device_name);
+        virtual ~TunerContext() override;
+
+        TunerReport     report;
+        ts::DuckContext duck {&report};
+        ts::Tuner       tuner {duck};
+
+        // Open and configure the tuner.
+        bool open();
+
+        // Process scanning jobs until there is no more.
+        void processJobs();
+
+    private:
+        ScanContext&  _scan;
+        ts::TunerArgs _tuner_args;
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+    typedef ts::SafePtr<TunerContext, ts::null_mutex> TunerContextPtr;
+
     ScanOptions&    _opt;
-    ts::Tuner       _tuner;
-    ts::ServiceList _services;
-    ts::ChannelFile _channels;
+    std::mutex      _mutex {};        // Protect all fields below during parallel scanning.
+    ts::ServiceList _services {};     // Global list of services.
+    ts::ChannelFile _channels {};     // Channels file content.
+    size_t          _job_count = 0;   // Total number of scanning jobs (UHF/VHF channels or NIT transponders).
+    size_t          _next_job = 0;    // Index of next job to start.
+    ts::OrderedJobOutput _job_output {_opt, std::cout}; // Log and output of completed jobs, in the order of the jobs.
+    std::vector<ts::ModulationArgs> _transponders {}; // Transponders to scan in NIT-based scanning.
+    std::vector<TunerContextPtr> _tuners {};        // All tuners, the first one is used by the main thread.
 
     // Analyze a TS and generate relevant info.
-    void scanTS(std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams);
+    void scanTS(TunerContext& tctx, std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams);
 
-    // UHF/VHF-band scanning
-    void hfBandScan();
+    // Scanning jobs, can be executed by several tuners in parallel.
+    bool nextJob(size_t& index);
+    void jobCompleted(size_t index, TunerReport& report, const std::string& output);
+    void runJobs();
 
-    // NIT-based scanning
-    void nitScan();
+    // UHF/VHF-band scanning of one channel.
+    void hfBandScan(TunerContext& tctx, uint32_t chan, std::ostream& strm);
+
+    // NIT-based scanning: collect transponders, then scan one transponder.
+    bool nitCollect();
+    void nitScan(TunerContext& tctx, ts::ModulationArgs& params, std::ostream& strm);
 };
 
 // Contructor.
 ScanContext::ScanContext(ScanOptions& opt) :
-    _opt(opt),
-    _tuner(_opt.duck),
-    _services(),
-    _channels()
+    _opt(opt)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Tuner context.
+//----------------------------------------------------------------------------
+
+ScanContext::TunerContext::TunerContext(ScanContext& scan, const ts::UString& device_name) :
+    report(scan._opt.maxSeverity()),
+    _scan(scan),
+    _tuner_args(scan._opt.tuner_args)
+{
+    // Each tuner uses a copy of the global TSDuck context, TSDuck contexts are not thread-safe.
+    ts::DuckContext::SavedArgs args;
+    _scan._opt.duck.saveArgs(args);
+    duck.restoreArgs(args);
+    _tuner_args.device_name = device_name;
+}
+
+ScanContext::TunerContext::~TunerContext()
+{
+    // Report the last messages, all threads are terminated at this point.
+    waitForTermination();
+    tuner.close();
+    report.flush(_scan._opt);
+}
+
+bool ScanContext::TunerContext::open()
+{
+    tuner.setSignalTimeoutSilent(true);
+    return _tuner_args.configureTuner(tuner);
+}
+
+void ScanContext::TunerContext::main()
 {
+    processJobs();
+}
+
+void ScanContext::TunerContext::processJobs()
+{
+    size_t index = 0;
+    while (_scan.nextJob(index)) {
+        std::ostringstream strm;
+        if (_scan._opt.uhf_scan || _scan._opt.vhf_scan) {
+            _scan.hfBandScan(*this, _scan._opt.first_channel + uint32_t(index), strm);
+        }
+        else {
+            _scan.nitScan(*this, _scan._transponders[index], strm);
+        }
+        _scan.jobCompleted(index, report, strm.str());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Scanning jobs.
+//----------------------------------------------------------------------------
+
+// Get the index of the next job to execute. Return false when there is no more job.
+bool ScanContext::nextJob(size_t& index)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_next_job >= _job_count) {
+        return false;
+    }
+    index = _next_job++;
+    return true;
+}
+
+// Report the log and output of a completed job. They are displayed in the order of the jobs.
+void ScanContext::jobCompleted(size_t index, TunerReport& report, const std::string& output)
+{
+    TunerReport::MessageList messages;
+    report.moveMessages(messages);
+    _job_output.jobCompleted(index, messages, output);
+}
+
+// Execute all jobs, using all tuners in parallel.
+void ScanContext::runJobs()
+{
+    _next_job = 0;
+    _job_output.reset();
+
+    // Additional tuners run in their own thread. The first tuner runs in the main thread.
+    for (size_t i = 1; i < _tuners.size(); ++i) {
+        _tuners[i]->start();
+    }
+    _tuners[0]->processJobs();
+    for (size_t i = 1; i < _tuners.size(); ++i) {
+        _tuners[i]->waitForTermination();
+    }
 }
 
 
@@ -461,13 +641,13 @@ ScanContext::ScanContext(ScanOptions& opt) :
 // Analyze a TS and generate relevant info.
 //----------------------------------------------------------------------------
 
-void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams)
+void ScanContext::scanTS(TunerContext& tctx, std::ostream& strm, const ts::UString& margin, ts::ModulationArgs& tparams)
 {
     const bool get_services = _opt.list_services || _opt.global_services;
 
     // Collect info from the TS.
     // Use "PAT only" when we do not need the services or channels file.
-    ts::TSScanner info(_opt.duck, _tuner, _opt.psi_timeout, !get_services && _opt.channel_file.empty());
+    ts::TSScanner info(tctx.duck, tctx.tuner, _opt.psi_timeout, !get_services && _opt.channel_file.empty());
 
     // Get tuning parameters again, as TSScanner waits for a lock.
     // Also keep the original frequency and polarity since satellite tuners can only report the intermediate frequency.
@@ -501,10 +681,10 @@ void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Modu
     }
 
     // Reset TS description in channels file.
-    ts::ChannelFile::TransportStreamPtr ts_info;
     if (!_opt.channel_file.empty()) {
+        std::lock_guard<std::mutex> lock(_mutex);
         ts::ChannelFile::NetworkPtr net_info(_channels.networkGetOrCreate(net_id, ts::TunerTypeOf(tparams.delivery_system.value_or(ts::DS_UNDEFINED))));
-        ts_info = net_info->tsGetOrCreate(ts_id);
+        ts::ChannelFile::TransportStreamPtr ts_info(net_info->tsGetOrCreate(ts_id));
         ts_info->clear(); // reset all services in TS.
         ts_info->onid = sdt.isNull() ? 0 : sdt->onetw_id;
         ts_info->tune = tparams;
@@ -516,13 +696,9 @@ void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Modu
     }
 
     // Display or collect services
-    if (get_services || !ts_info.isNull()) {
+    if (get_services || !_opt.channel_file.empty()) {
         ts::ServiceList srvlist;
         if (info.getServices(srvlist)) {
-            if (!ts_info.isNull()) {
-                // Add all services in the channels info.
-                ts_info->addServices(srvlist);
-            }
             if (_opt.list_services) {
                 // Display services for this TS
                 srvlist.sort(ts::Service::Sort1);
@@ -530,6 +706,11 @@ void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Modu
                 ts::Service::Display(strm, margin, srvlist);
                 strm << std::endl;
             }
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_opt.channel_file.empty()) {
+                // Add all services in the channels info.
+                _channels.networkGetOrCreate(net_id, ts::TunerTypeOf(tparams.delivery_system.value_or(ts::DS_UNDEFINED)))->tsGetOrCreate(ts_id)->addServices(srvlist);
+            }
             if (_opt.global_services) {
                 // Add collected services in global service list
                 _services.insert(_services.end(), srvlist.begin(), srvlist.end());
@@ -540,55 +721,54 @@ void ScanContext::scanTS(std::ostream& strm, const ts::UString& margin, ts::Modu
 
 
 //----------------------------------------------------------------------------
-// UHF/VHF-band scanning
+// UHF/VHF-band scanning of one channel.
 //----------------------------------------------------------------------------
 
-void ScanContext::hfBandScan()
+void ScanContext::hfBandScan(TunerContext& tctx, uint32_t chan, std::ostream& strm)
 {
-    // Loop on all selected UHF channels
-    for (uint32_t chan = _opt.first_channel; chan <= _opt.last_channel; ++chan) {
-
-        // Scan all offsets surrounding the channel.
-        OffsetScanner offscan(_opt, _tuner, chan);
-        if (offscan.signalFound()) {
-
-            // A channel was found, report its characteristics.
-            ts::SignalState state;
-            _tuner.getSignalState(state);
-            std::cout << "* " << _opt.hfband->description(chan, offscan.bestOffset()) << ", " << state.toString() << std::endl;
-
-            // Analyze PSI/SI if required.
-            ts::ModulationArgs tparams;
-            offscan.getTunerParameters(tparams);
-            scanTS(std::cout, u"  ", tparams);
-        }
+    // Scan all offsets surrounding the channel.
+    OffsetScanner offscan(_opt, tctx.report, tctx.tuner, chan);
+    if (offscan.signalFound()) {
+
+        // A channel was found, report its characteristics.
+        ts::SignalState state;
+        tctx.tuner.getSignalState(state);
+        strm << "* " << _opt.hfband->description(chan, offscan.bestOffset()) << ", " << state.toString() << std::endl;
+
+        // Analyze PSI/SI if required.
+        ts::ModulationArgs tparams;
+        offscan.getTunerParameters(tparams);
+        scanTS(tctx, strm, u"  ", tparams);
     }
 }
 
 
 //----------------------------------------------------------------------------
-// NIT-based scanning
+// NIT-based scanning: collect the transponders from the reference one.
 //----------------------------------------------------------------------------
 
-void ScanContext::nitScan()
+bool ScanContext::nitCollect()
 {
+    TunerContext& tctx(*_tuners[0]);
+
     // Tune to the reference transponder.
-    if (!_tuner.tune(_opt.tuner_args)) {
-        return;
+    if (!tctx.tuner.tune(_opt.tuner_args)) {
+        return false;
     }
 
     // Collect info on reference transponder.
-    ts::TSScanner info(_opt.duck, _tuner, _opt.psi_timeout, false);
+    ts::TSScanner info(tctx.duck, tctx.tuner, _opt.psi_timeout, false);
 
     // Get the collected NIT
     ts::SafePtr<ts::NIT> nit;
     info.getNIT(nit);
     if (nit.isNull()) {
-        _opt.error(u"cannot scan network, no NIT found on specified transponder");
-        return;
+        tctx.report.error(u"cannot scan network, no NIT found on specified transponder");
+        return false;
     }
 
     // Process each TS descriptor list in the NIT.
+    _transponders.clear();
     for (const auto& it : nit->transports) {
 
         const ts::TransportStreamId& tsid(it.first);
@@ -597,24 +777,35 @@ void ScanContext::nitScan()
         for (size_t i = 0; i < dlist.count(); ++i) {
             // Try to get delivery system information from current descriptor
             ts::ModulationArgs params;
-            if (params.fromDeliveryDescriptor(_opt.duck, *dlist[i], tsid.transport_stream_id)) {
+            if (params.fromDeliveryDescriptor(tctx.duck, *dlist[i], tsid.transport_stream_id)) {
                 // Got a delivery descriptor, this is the description of one transponder.
                 // Copy the local reception parameters (LNB, etc.) from the command line options
                 // (we use the same reception equipment).
                 params.copyLocalReceptionParameters(_opt.tuner_args);
-                // Tune to this transponder.
-                _opt.debug(u"* tuning to " + params.toPluginOptions(true));
-                if (_tuner.tune(params)) {
-                    // Report channel characteristics
-                    ts::SignalState state;
-                    _tuner.getSignalState(state);
-                    std::cout << "* Frequency: " << params.shortDescription(_opt.duck) << ", " << state.toString() << std::endl;
-                    // Analyze PSI/SI if required
-                    scanTS(std::cout, u"  ", params);
-                }
+                _transponders.push_back(params);
             }
         }
     }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// NIT-based scanning of one transponder.
+//----------------------------------------------------------------------------
+
+void ScanContext::nitScan(TunerContext& tctx, ts::ModulationArgs& params, std::ostream& strm)
+{
+    // Tune to this transponder.
+    tctx.report.debug(u"* tuning to " + params.toPluginOptions(true));
+    if (tctx.tuner.tune(params)) {
+        // Report channel characteristics
+        ts::SignalState state;
+        tctx.tuner.getSignalState(state);
+        strm << "* Frequency: " << params.shortDescription(tctx.duck) << ", " << state.toString() << std::endl;
+        // Analyze PSI/SI if required
+        scanTS(tctx, strm, u"  ", params);
+    }
 }
 
 
@@ -624,10 +815,17 @@ void ScanContext::nitScan()
 
 void ScanContext::main()
 {
-    // Initialize tuner.
-    _tuner.setSignalTimeoutSilent(true);
-    if (!_opt.tuner_args.configureTuner(_tuner)) {
-        return;
+    // Initialize all tuners. The first one is defined by the tuner options.
+    _tuners.push_back(new TunerContext(*this, _opt.tuner_args.device_name));
+    for (const auto& name : _opt.parallel_devices) {
+        _tuners.push_back(new TunerContext(*this, name));
+    }
+    for (const auto& tctx : _tuners) {
+        const bool ok = tctx->open();
+        tctx->report.flush(_opt);
+        if (!ok) {
+            return;
+        }
     }
 
     // Pre-load the existing channel file.
@@ -635,17 +833,26 @@ void ScanContext::main()
         return;
     }
 
-    // Main processing depends on scanning method.
+    // Build the list of scanning jobs, depending on scanning method.
     if (_opt.uhf_scan || _opt.vhf_scan) {
-        hfBandScan();
+        _job_count = _opt.last_channel < _opt.first_channel ? 0 : _opt.last_channel - _opt.first_channel + 1;
     }
     else if (_opt.nit_scan) {
-        nitScan();
+        // The reference transponder is scanned in the main thread, before the parallel jobs.
+        const bool ok = nitCollect();
+        _tuners[0]->report.flush(_opt);
+        if (!ok) {
+            return;
+        }
+        _job_count = _transponders.size();
     }
     else {
         _opt.fatal(u"inconsistent options, internal error");
     }
 
+    // Scan all channels or transponders, distributed over all tuners.
+    runJobs();
+
     // Report global list of services if required
     if (_opt.global_services) {
         _services.sort(ts::Service::Sort1);
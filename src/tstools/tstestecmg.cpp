@@ -20,6 +20,7 @@
 #include "tsAsyncReport.h"
 #include "tsNullReport.h"
 #include "tsSingleDataStatistics.h"
+#include "tsTime.h"
 TS_MAIN(MainCode);
 
 
@@ -50,6 +51,7 @@ namespace {
         uint16_t              first_ecm_id = 0;
         size_t                cw_size = 0;
         size_t                max_ecm = 0;
+        size_t                pipeline = 0;
         ts::Second            max_seconds = 0;
         int                   log_protocol = 0;
         int                   log_data = 0;
@@ -132,6 +134,14 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
          u"Stop the test after the specified number of seconds. "
          u"By default, the test endlessly runs.");
 
+    option(u"pipeline", 'p', Args::POSITIVE);
+    help(u"pipeline", u"count",
+         u"Load-test mode: keep the specified number of CW_provision requests pending on each stream. "
+         u"The requests are sent back-to-back, without waiting for the crypto-period duration. "
+         u"Each ECM_response immediately triggers a new request on the same stream. "
+         u"This mode measures the maximum ECM throughput of the ECMG, for instance against "
+         u"a local tsecmg. By default, one request is sent per crypto-period and per stream.");
+
     option(u"streams-per-channel", 's', Args::UINT16);
     help(u"streams-per-channel",
          u"Specify the number of streams to open in each channel. "
@@ -166,6 +176,7 @@ CmdOptions::CmdOptions(int argc, char *argv[]) :
     getIntValue(stat_interval, u"statistics-interval", 10);
     getIntValue(max_ecm, u"max-ecm");
     getIntValue(max_seconds, u"max-seconds");
+    getIntValue(pipeline, u"pipeline", 0);
     log_protocol = present(u"log-protocol") ? intValue<int>(u"log-protocol", ts::Severity::Info) : ts::Severity::Debug;
     log_data = present(u"log-data") ? intValue<int>(u"log-data", ts::Severity::Info) : log_protocol;
 
@@ -214,6 +225,10 @@ namespace {
         // Wait until next event. Return false on termination request.
         bool waitEvent(uint16_t& channel_id, uint16_t& stream_id);
 
+        // Count a request which is sent without event (pipeline mode). Return false when the
+        // maximum number of requests is reached, the termination is then automatically posted.
+        bool acceptRequest();
+
     private:
         // Description of one queued event.
         class Event
@@ -236,6 +251,7 @@ namespace {
         std::condition_variable _condition {};
         std::list<Event>        _events {};
         size_t                  _request_count = 0;
+        std::atomic<size_t>     _pipelined_count {0};
 
         // Enqueue an event.
         void enqueue(const Event& event);
@@ -272,6 +288,20 @@ void EventQueue::enqueue(const Event& event)
     }
 }
 
+// Count a request in pipeline mode.
+bool EventQueue::acceptRequest()
+{
+    if (_opt.max_ecm == 0) {
+        return true;
+    }
+    const size_t count = ++_pipelined_count;
+    if (count == _opt.max_ecm + 1) {
+        _report.debug(u"reached maximum number of requests");
+        postTermination(ts::Time::Epoch);
+    }
+    return count <= _opt.max_ecm;
+}
+
 // Wait until next event. Return false on termination request.
 bool EventQueue::waitEvent(uint16_t& channel_id, uint16_t& stream_id)
 {
@@ -339,8 +369,11 @@ namespace {
         ResponseStat               _instant_response {};
         ResponseStat               _global_response {};
 
+        ts::Time                   _global_start {ts::Time::CurrentUTC()};
+        ts::Time                   _instant_start {_global_start};
+
         // Report statistics. Must be called with mutex held.
-        void reportStatistics(const ResponseStat& stat);
+        void reportStatistics(const ResponseStat& stat, const ts::Time& since);
     };
 }
 
@@ -367,10 +400,12 @@ void CmdStatistics::oneResponse(ts::MilliSecond time)
 }
 
 // Report statistics. Must be called with mutex held.
-void CmdStatistics::reportStatistics(const ResponseStat& stat)
+void CmdStatistics::reportStatistics(const ResponseStat& stat, const ts::Time& since)
 {
-    _report.info(u"req: %'d, ecm: %'d, response mean: %s ms, min: %d, max: %d, dev: %s",
+    const ts::MilliSecond duration = ts::Time::CurrentUTC() - since;
+    _report.info(u"req: %'d, ecm: %'d, ecm/s: %'d, response mean: %s ms, min: %d, max: %d, dev: %s",
                  {_request_count.load(), _global_response.count(),
+                  duration <= 0 ? 0 : (stat.count() * ts::MilliSecPerSec) / duration,
                   stat.meanString(0, 3), stat.minimum(), stat.maximum(),
                   stat.standardDeviationString(0, 3)});
 }
@@ -387,13 +422,14 @@ void CmdStatistics::main()
             _condition.wait_for(lock, std::chrono::seconds(std::chrono::seconds::rep(_opt.stat_interval)));
         }
         if (!_terminate) {
-            reportStatistics(_instant_response);
+            reportStatistics(_instant_response, _instant_start);
             _instant_response.reset();
+            _instant_start = ts::Time::CurrentUTC();
         }
     }
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        reportStatistics(_global_response);
+        reportStatistics(_global_response, _global_start);
     }
 }
 
@@ -447,7 +483,7 @@ namespace {
             bool     ready = false;
             bool     closing = false;
             uint16_t cp_number = 0;
-            ts::Time start_request {};
+            std::map<uint16_t, ts::Time> pending {};  // start time of pending requests, indexed by CP_number
 
             Stream() = default;
         };
@@ -466,6 +502,7 @@ namespace {
         std::recursive_mutex        _mutex {};        // protect subsequent fields
         std::condition_variable_any _completed {};    // signalled by reception thread when all streams are closed.
         std::vector<Stream>         _streams {};
+        bool                        _terminating = false;
 
         // Check the validity of a received message.
         bool checkChannelMessage(const ts::tlv::ChannelMessage* mp, const ts::UChar* message_name);
@@ -556,6 +593,12 @@ bool ECMGConnection::checkStreamMessage(const ts::tlv::StreamMessage* mp, const
 // Terminate the session and wait for termination.
 void ECMGConnection::terminate()
 {
+    // Stop sending new requests in pipeline mode.
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _terminating = true;
+    }
+
     // Close all sessions.
     if (_conn.isConnected()) {
 
@@ -633,7 +676,11 @@ bool ECMGConnection::sendRequest(uint16_t stream_id)
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     const size_t index = stream_id - _opt.first_ecm_stream_id;
-    if (stream_id < _opt.first_ecm_stream_id || index >= _streams.size() || !_streams[index].ready) {
+    if (_opt.pipeline > 0 && (_terminating || !_events.acceptRequest())) {
+        // Pipeline mode, the test is terminating, silently ignore the request.
+        return true;
+    }
+    else if (stream_id < _opt.first_ecm_stream_id || index >= _streams.size() || !_streams[index].ready) {
         _logger.report().error(u"invalid stream id: %d", {stream_id});
         return false;
     }
@@ -653,7 +700,7 @@ bool ECMGConnection::sendRequest(uint16_t stream_id)
         }
 
         // Register the message.
-        _streams[index].start_request = ts::Time::CurrentUTC();
+        _streams[index].pending[msg.CP_number] = ts::Time::CurrentUTC();
         _stat.oneRequest();
 
         // Send the message.
@@ -709,8 +756,11 @@ void ECMGConnection::main()
                     if (!stream.ready) {
                         // This is a response to stream_setup.
                         stream.ready = true;
-                        // Start sending requests to this stream.
-                        ok = sendRequest(mp->stream_id);
+                        // Start sending requests to this stream, fill the pipeline in load-test mode.
+                        const size_t count = std::max<size_t>(1, _opt.pipeline);
+                        for (size_t i = 0; ok && i < count; ++i) {
+                            ok = sendRequest(mp->stream_id);
+                        }
                         // Setup the next stream.
                         if (ok && next_stream_index < _streams.size()) {
                             ok = sendStreamSetup(uint16_t(_first_stream_id + next_stream_index++));
@@ -744,15 +794,25 @@ void ECMGConnection::main()
                 if (checkStreamMessage(mp, u"ECM_response")) {
                     std::lock_guard<std::recursive_mutex> lock(_mutex);
                     Stream& stream(_streams[mp->stream_id - _first_stream_id]);
-                    if (!stream.ready || stream.start_request == ts::Time::Epoch) {
-                        _logger.report().error(u"unexpected ECM response, channel_id %d, stream id %d", {mp->channel_id, mp->stream_id});
+                    const auto req = stream.pending.find(mp->CP_number);
+                    if (req == stream.pending.end()) {
+                        if (!stream.closing) {
+                            _logger.report().error(u"unexpected ECM response, channel_id %d, stream id %d, CP number %d", {mp->channel_id, mp->stream_id, mp->CP_number});
+                        }
                     }
                     else {
                         // Log current request response time.
-                        _stat.oneResponse(ts::Time::CurrentUTC() - stream.start_request);
-                        // Schedule next request.
-                        _events.postRequest(stream.start_request + _opt.cp_duration * ts::MilliSecPerSec, mp->channel_id, mp->stream_id);
-                        stream.start_request = ts::Time::Epoch;
+                        const ts::Time start_request(req->second);
+                        stream.pending.erase(req);
+                        _stat.oneResponse(ts::Time::CurrentUTC() - start_request);
+                        if (_opt.pipeline > 0) {
+                            // Load-test mode, immediately send the next request.
+                            ok = !stream.ready || sendRequest(mp->stream_id);
+                        }
+                        else {
+                            // Schedule next request.
+                            _events.postRequest(start_request + _opt.cp_duration * ts::MilliSecPerSec, mp->channel_id, mp->stream_id);
+                        }
                     }
                 }
                 break;
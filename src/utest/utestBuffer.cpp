@@ -67,6 +67,7 @@ public:
     void testGetInt64BE();
     void testGetInt64LE();
     void testGetBitsSigned();
+    void testGetBitsAllAlignments();
     void testPutBCD();
     void testGetBCD();
     void testTryGetASCII();
@@ -133,6 +134,7 @@ public:
     TSUNIT_TEST(testGetInt64BE);
     TSUNIT_TEST(testGetInt64LE);
     TSUNIT_TEST(testGetBitsSigned);
+    TSUNIT_TEST(testGetBitsAllAlignments);
     TSUNIT_TEST(testPutBCD);
     TSUNIT_TEST(testGetBCD);
     TSUNIT_TEST(testTryGetASCII);
@@ -1158,6 +1160,50 @@ void BufferTest::testGetBitsSigned()
     TSUNIT_EQUAL(-1, b.getBits<int>(2));
 }
 
+void BufferTest::testGetBitsAllAlignments()
+{
+    // Compare getBits() and unaligned getUIntNN() with a bit-by-bit reference at all alignments,
+    // including the end of the buffer where the 64-bit window cannot be loaded.
+    static const uint8_t data[] = {0x5A, 0xC3, 0x96, 0x0F, 0xF1, 0x2E, 0x87, 0x3C, 0xD4, 0x69, 0xB5, 0x1D};
+
+    for (bool big_endian : {true, false}) {
+        ts::Buffer b(data, sizeof(data));
+        ts::Buffer ref(data, sizeof(data));
+        if (!big_endian) {
+            b.setLittleEndian();
+            ref.setLittleEndian();
+        }
+        for (size_t offset = 0; offset < 8 * sizeof(data); ++offset) {
+            for (size_t bits = 1; bits <= 64 && offset + bits <= 8 * sizeof(data); ++bits) {
+                TSUNIT_ASSERT(b.readSeek(offset / 8, offset % 8));
+                TSUNIT_ASSERT(ref.readSeek(offset / 8, offset % 8));
+                uint64_t expected = 0;
+                for (size_t i = 0; i < bits; ++i) {
+                    const uint64_t bit = ref.getBit();
+                    expected = big_endian ? ((expected << 1) | bit) : (expected | (bit << i));
+                }
+                TSUNIT_EQUAL(expected, b.getBits<uint64_t>(bits));
+                TSUNIT_EQUAL(offset + bits, b.currentReadBitOffset());
+                TSUNIT_ASSERT(!b.readError());
+
+                // Unaligned integer accessors use the same realignment.
+                if (bits % 8 == 0 && bits <= 32) {
+                    TSUNIT_ASSERT(b.readSeek(offset / 8, offset % 8));
+                    const uint64_t value = bits == 8 ? b.getUInt8() : bits == 16 ? b.getUInt16() : bits == 24 ? b.getUInt24() : b.getUInt32();
+                    TSUNIT_EQUAL(expected, value);
+                    TSUNIT_EQUAL(offset + bits, b.currentReadBitOffset());
+                }
+            }
+        }
+
+        // Reading past the end sets the error state and does not move.
+        TSUNIT_ASSERT(b.readSeek(sizeof(data) - 1, 3));
+        TSUNIT_EQUAL(0, b.getBits<uint32_t>(6));
+        TSUNIT_ASSERT(b.readError());
+        TSUNIT_EQUAL(8 * sizeof(data) - 5, b.currentReadBitOffset());
+    }
+}
+
 
 void BufferTest::testPutBCD()
 {
@@ -26,9 +26,11 @@ public:
     virtual void afterTest() override;
 
     void testCRC();
+    void testLinear();
 
     TSUNIT_TEST_BEGIN(CRC32Test);
     TSUNIT_TEST(testCRC);
+    TSUNIT_TEST(testLinear);
     TSUNIT_TEST_END();
 };
 
@@ -183,3 +185,20 @@ void CRC32Test::testCRC()
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+void CRC32Test::testLinear()
+{
+    // The XOR of the CRC32 of two data areas of the same size is the CRC32 with zero initial value of their XOR.
+    const TestData& d1(all_data[4]);
+    const TestData& d2(all_data[5]);
+    TSUNIT_ASSERT(d2.data_size >= d1.data_size);
+
+    uint8_t diff[sizeof(d1.data)];
+    for (size_t i = 0; i < d1.data_size; ++i) {
+        diff[i] = d1.data[i] ^ d2.data[i];
+    }
+    ts::CRC32 c;
+    c.resetZero();
+    c.add(diff, d1.data_size);
+    TSUNIT_EQUAL(d1.crc ^ ts::CRC32(d2.data, d1.data_size).value(), c.value());
+}
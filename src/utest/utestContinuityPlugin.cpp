@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the "continuity" plugin.
+//
+//  The "continuity" plugin is loaded from its shared library. This test is
+//  not part of the static version of the unitary tests.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ContinuityPluginTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testParallelFix();
+
+    TSUNIT_TEST_BEGIN(ContinuityPluginTest);
+    TSUNIT_TEST(testParallelFix);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(ContinuityPluginTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void ContinuityPluginTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void ContinuityPluginTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Memory input and output.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    constexpr ts::PID FIRST_PID = 100;
+    constexpr size_t  PID_COUNT = 7;
+
+    // Event handler for a memory input plugin: packets on several PID's, all with continuity counter zero.
+    // The packet index is stored in the last 4 bytes of each packet.
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(size_t count) : _count(count) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            while (data != nullptr && _next < _count && data->remainingSize() >= ts::PKT_SIZE) {
+                ts::TSPacket pkt;
+                pkt.init(ts::PID(FIRST_PID + (_next * 13 / 5) % PID_COUNT), 0, 0xFF);
+                ts::PutUInt32(pkt.b + ts::PKT_SIZE - 4, uint32_t(_next));
+                data->append(pkt.b, ts::PKT_SIZE);
+                _next++;
+            }
+        }
+
+    private:
+        const size_t _count;
+        size_t       _next = 0;
+    };
+
+    // Event handler for a memory output plugin: fill a vector of packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output) : _output(output) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                const size_t count = data->size() / ts::PKT_SIZE;
+                const size_t index = _output.size();
+                _output.resize(index + count);
+                ts::TSPacket::Copy(&_output[index], data->data(), count);
+            }
+        }
+
+    private:
+        ts::TSPacketVector& _output;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void ContinuityPluginTest::testParallelFix()
+{
+    // With --fix and no message, the continuity counters are fixed by 4 instances of the plugin,
+    // each of them processing a subset of the PID's. The packets of each PID are processed in order
+    // by the same instance: the continuity counters are consecutive in each PID.
+    constexpr size_t packet_count = 20000;
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"ContinuityPluginTest::testParallelFix";
+    opt.input = {u"memory", {}};
+    opt.plugins = {
+        {u"continuity", {u"--fix", u"--threads", u"4"}},
+    };
+    opt.output = {u"memory", {}};
+
+    Input input(packet_count);
+    ts::TSPacketVector output;
+    Output out(output);
+
+    ts::TSProcessor tsproc(CERR);
+    tsproc.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsproc.registerEventHandler(&out, ts::PluginType::OUTPUT);
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // All packets are received in order, with consecutive continuity counters in each PID.
+    TSUNIT_EQUAL(packet_count, output.size());
+    size_t next_cc[PID_COUNT] = {};
+    for (size_t i = 0; i < output.size(); ++i) {
+        const ts::PID pid = output[i].getPID();
+        TSUNIT_EQUAL(i, ts::GetUInt32(output[i].b + ts::PKT_SIZE - 4));
+        TSUNIT_ASSERT(pid >= FIRST_PID && pid < FIRST_PID + PID_COUNT);
+        TSUNIT_EQUAL(next_cc[pid - FIRST_PID], output[i].getCC());
+        next_cc[pid - FIRST_PID] = (next_cc[pid - FIRST_PID] + 1) & ts::CC_MASK;
+    }
+}
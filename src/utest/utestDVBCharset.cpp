@@ -11,6 +11,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCharset.h"
+#include "tsDVBCharTableUTF8.h"
+#include "tsDuckContext.h"
 #include "tsByteBlock.h"
 #include "tsunit.h"
 
@@ -26,10 +28,14 @@ public:
 
     void testRepository();
     void testDVB();
+    void testASCIIRuns();
+    void testDecodeCache();
 
     TSUNIT_TEST_BEGIN(DVBCharsetTest);
     TSUNIT_TEST(testRepository);
     TSUNIT_TEST(testDVB);
+    TSUNIT_TEST(testASCIIRuns);
+    TSUNIT_TEST(testDecodeCache);
     TSUNIT_TEST_END();
 };
 
@@ -81,3 +87,56 @@ void DVBCharsetTest::testDVB()
     TSUNIT_EQUAL(str1, ts::DVBCharset::DVB.decoded(dvb1, sizeof(dvb1)));
     TSUNIT_ASSERT(ts::ByteBlock(dvb1, sizeof(dvb1)) == ts::DVBCharset::DVB.encoded(str1.toDecomposedDiacritical()));
 }
+
+void DVBCharsetTest::testASCIIRuns()
+{
+    // Long ASCII runs, not multiple of 8, with non-ASCII characters at various positions.
+    static const uint8_t dvb1[] = {
+        'T', 'h', 'e', ' ', 'q', 'u', 'i', 'c', 'k', ' ', 'b', 'r', 'o', 'w', 'n', ' ', 'f', 'o', 'x', 0x8A,
+        'c', 'a', 'f', 0xC2, 'e', ' ', 'j', 'u', 'm', 'p', 's', ' ', 'o', 'v', 'e', 'r', 0x7F, '!',
+    };
+    const ts::UString str1(ts::UString(u"The quick brown fox\ncaf") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE + u" jumps over!");
+    TSUNIT_EQUAL(str1, ts::DVBCharset::DVB.decoded(dvb1, sizeof(dvb1)));
+
+    // Same thing in UTF-8, with a table code.
+    static const uint8_t utf8[] = {
+        0x15, 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 0xC3, 0xA9, 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S',
+    };
+    const ts::UString str2(ts::UString(u"ABCDEFGHIJ") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE + u"KLMNOPQRS");
+    TSUNIT_EQUAL(str2, ts::DVBCharset::DVB.decoded(utf8, sizeof(utf8)));
+    TSUNIT_EQUAL(u"ABCDEFGHIJ", ts::DVBCharTableUTF8::RAW_UTF_8.decoded(utf8 + 1, 10));
+    TSUNIT_EQUAL(u"", ts::DVBCharTableUTF8::RAW_UTF_8.decoded(utf8 + 1, 0));
+}
+
+void DVBCharsetTest::testDecodeCache()
+{
+    ts::DuckContext duck;
+    TSUNIT_EQUAL(0, duck.decodeCacheSize());
+
+    static const uint8_t name1[] = {'N', 'e', 'w', 's', ' ', 'a', 't', ' ', 'e', 'i', 'g', 'h', 't'};
+    static const uint8_t name2[] = {0x15, 'C', 'a', 'f', 0xC3, 0xA9};
+    static const uint8_t name3[] = {'W', 'e', 'a', 't', 'h', 'e', 'r'};
+    const ts::UString cafe(ts::UString(u"Caf") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE);
+
+    duck.setDecodeCacheSize(2);
+    TSUNIT_EQUAL(2, duck.decodeCacheSize());
+
+    // Repeated decodings with a cache smaller than the number of distinct strings.
+    for (int i = 0; i < 5; ++i) {
+        TSUNIT_EQUAL(u"News at eight", duck.decoded(name1, sizeof(name1)));
+        TSUNIT_EQUAL(cafe, duck.decoded(name2, sizeof(name2)));
+        TSUNIT_EQUAL(u"Weather", duck.decoded(name3, sizeof(name3)));
+        TSUNIT_EQUAL(u"Weather", duck.decoded(name3, sizeof(name3)));
+        TSUNIT_EQUAL(u"", duck.decoded(name3, 0));
+    }
+
+    // A cached string is not reused with another character set.
+    static const uint8_t latin[] = {'a', 0xE9};
+    ts::UString str;
+    TSUNIT_ASSERT(duck.decode(str, latin, sizeof(latin)));
+    const ts::UString latin_default(str);
+    TSUNIT_ASSERT(duck.decode(str, latin, sizeof(latin), &ts::DVBCharTableUTF8::RAW_UTF_8));
+    TSUNIT_ASSERT(str != latin_default || latin_default.empty());
+    TSUNIT_ASSERT(duck.decode(str, latin, sizeof(latin)));
+    TSUNIT_EQUAL(latin_default, str);
+}
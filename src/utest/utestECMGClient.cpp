@@ -0,0 +1,294 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::ECMGClient.
+//
+//----------------------------------------------------------------------------
+
+#include "tsECMGClient.h"
+#include "tsECMGClientArgs.h"
+#include "tsECMGSCS.h"
+#include "tsTCPServer.h"
+#include "tstlvConnection.h"
+#include "tstlvLogger.h"
+#include "tsIPUtils.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "utestTSUnitThread.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ECMGClientTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testPipelinedRequests();
+
+    TSUNIT_TEST_BEGIN(ECMGClientTest);
+    TSUNIT_TEST(testPipelinedRequests);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(ECMGClientTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void ECMGClientTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void ECMGClientTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// A fake ECMG and ECM handlers.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    constexpr uint16_t PORT_NUMBER = 12348;
+    constexpr ts::MilliSecond REPLY_DELAY = 200;
+
+    // A fake ECMG, running in a thread, accepting one client.
+    // The ECM_datagram of each response contains the index of the corresponding CW_provision.
+    // The responses are sent out of order:
+    // - After 5 requests: reply to requests 4, 2, 0, 3, 1.
+    // - After 7 requests: wait REPLY_DELAY milliseconds and reply to request 6.
+    // - After 8 requests: reply to requests 5 and 7.
+    class FakeECMG: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(FakeECMG);
+    public:
+        explicit FakeECMG(const ts::ecmgscs::Protocol& protocol) :
+            utest::TSUnitThread(),
+            _protocol(protocol)
+        {
+            TSUNIT_ASSERT(_server.open(CERR));
+            TSUNIT_ASSERT(_server.reusePort(true, CERR));
+            TSUNIT_ASSERT(_server.bind(ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, PORT_NUMBER), CERR));
+            TSUNIT_ASSERT(_server.listen(1, CERR));
+        }
+
+        virtual ~FakeECMG() override
+        {
+            waitForTermination();
+            _server.close(NULLREP);
+        }
+
+        virtual void test() override
+        {
+            ts::tlv::Connection<> conn(_protocol, true, 3);
+            ts::IPv4SocketAddress client;
+            TSUNIT_ASSERT(_server.accept(conn, client, CERR));
+
+            std::vector<ts::ecmgscs::CWProvision> requests;
+            // The final disconnection from the client is not an error.
+            ts::tlv::MessagePtr msg;
+            while (conn.receive(msg, nullptr, NULLREP)) {
+                switch (msg->tag()) {
+                    case ts::ecmgscs::Tags::channel_setup: {
+                        ts::ecmgscs::ChannelStatus resp(_protocol);
+                        resp.channel_id = dynamic_cast<ts::ecmgscs::ChannelSetup*>(msg.pointer())->channel_id;
+                        resp.section_TSpkt_flag = true;
+                        resp.CW_per_msg = 2;
+                        resp.lead_CW = 1;
+                        resp.max_comp_time = 100;
+                        TSUNIT_ASSERT(conn.send(resp, _logger));
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::stream_setup: {
+                        const ts::ecmgscs::StreamSetup* const req = dynamic_cast<ts::ecmgscs::StreamSetup*>(msg.pointer());
+                        ts::ecmgscs::StreamStatus resp(_protocol);
+                        resp.channel_id = req->channel_id;
+                        resp.stream_id = req->stream_id;
+                        resp.ECM_id = req->ECM_id;
+                        TSUNIT_ASSERT(conn.send(resp, _logger));
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::CW_provision: {
+                        requests.push_back(*dynamic_cast<ts::ecmgscs::CWProvision*>(msg.pointer()));
+                        if (requests.size() == 5) {
+                            for (size_t index : {size_t(4), size_t(2), size_t(0), size_t(3), size_t(1)}) {
+                                reply(conn, requests, index);
+                            }
+                        }
+                        else if (requests.size() == 7) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(REPLY_DELAY));
+                            reply(conn, requests, 6);
+                        }
+                        else if (requests.size() == 8) {
+                            reply(conn, requests, 5);
+                            reply(conn, requests, 7);
+                        }
+                        break;
+                    }
+                    case ts::ecmgscs::Tags::stream_close_request: {
+                        const ts::ecmgscs::StreamCloseRequest* const req = dynamic_cast<ts::ecmgscs::StreamCloseRequest*>(msg.pointer());
+                        ts::ecmgscs::StreamCloseResponse resp(_protocol);
+                        resp.channel_id = req->channel_id;
+                        resp.stream_id = req->stream_id;
+                        TSUNIT_ASSERT(conn.send(resp, _logger));
+                        break;
+                    }
+                    default: {
+                        break;
+                    }
+                }
+            }
+            TSUNIT_EQUAL(8, requests.size());
+            conn.disconnect(NULLREP);
+            conn.close(NULLREP);
+        }
+
+    private:
+        const ts::ecmgscs::Protocol& _protocol;
+        ts::tlv::Logger _logger {ts::Severity::Debug, &CERR};
+        ts::TCPServer   _server {};
+
+        // Send the ECM_response for one request.
+        void reply(ts::tlv::Connection<>& conn, const std::vector<ts::ecmgscs::CWProvision>& requests, size_t index)
+        {
+            ts::ecmgscs::ECMResponse resp(_protocol);
+            resp.channel_id = requests[index].channel_id;
+            resp.stream_id = requests[index].stream_id;
+            resp.CP_number = requests[index].CP_number;
+            resp.ECM_datagram.assign(1, uint8_t(index));
+            TSUNIT_ASSERT(conn.send(resp, _logger));
+        }
+    };
+
+    // Count the completed ECM requests, the test waits for a given count.
+    class Completion
+    {
+        TS_NOCOPY(Completion);
+    public:
+        Completion() = default;
+
+        void signal()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _count++;
+            _condition.notify_all();
+        }
+
+        bool wait(size_t count)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _condition.wait_for(lock, std::chrono::seconds(5), [this, count]() { return _count >= count; });
+        }
+
+    private:
+        std::mutex _mutex {};
+        std::condition_variable _condition {};
+        size_t _count = 0;
+    };
+
+    // The handler of one ECM request records the response it receives.
+    class Request: public ts::ECMGClientHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Request);
+    public:
+        Request(Completion& completion, uint16_t cp) : cp_number(cp), _completion(completion) {}
+
+        const uint16_t cp_number;
+        size_t         calls = 0;
+        uint16_t       received_cp = 0;
+        ts::ByteBlock  ecm {};
+
+        virtual void handleECM(const ts::ecmgscs::ECMResponse& response) override
+        {
+            calls++;
+            received_cp = response.CP_number;
+            ecm = response.ECM_datagram;
+            _completion.signal();
+        }
+
+    private:
+        Completion& _completion;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void ECMGClientTest::testPipelinedRequests()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    ts::ecmgscs::Protocol protocol;
+    FakeECMG ecmg(protocol);
+    ecmg.start();
+
+    ts::ECMGClientArgs args;
+    args.ecmg_address = ts::IPv4SocketAddress(ts::IPv4Address::LocalHost, PORT_NUMBER);
+    args.super_cas_id = 0x12345678;
+    args.cp_duration = 10000;
+    args.ecm_channel_id = 1;
+    args.ecm_stream_id = 2;
+    args.ecm_id = 3;
+
+    ts::ECMGClient client(protocol);
+    ts::ecmgscs::ChannelStatus channel_status(protocol);
+    ts::ecmgscs::StreamStatus stream_status(protocol);
+    TSUNIT_ASSERT(client.connect(args, channel_status, stream_status, nullptr, ts::tlv::Logger(ts::Severity::Debug, &CERR)));
+    TSUNIT_EQUAL(1, channel_status.channel_id);
+    TSUNIT_EQUAL(2, stream_status.stream_id);
+
+    const ts::ByteBlock cw1(8, 0x11);
+    const ts::ByteBlock cw2(8, 0x22);
+    Completion completion;
+    std::vector<std::unique_ptr<Request>> requests;
+    for (int cp : {1, 2, 7, 7, 3, 10, 11, 12}) {
+        requests.emplace_back(new Request(completion, uint16_t(cp)));
+    }
+
+    // Five requests in flight, two of them for the same crypto-period, answered out of order.
+    for (size_t i = 0; i < 5; ++i) {
+        TSUNIT_ASSERT(client.submitECM(requests[i]->cp_number, cw1, cw2, ts::ByteBlock(), 100, requests[i].get()));
+    }
+    TSUNIT_ASSERT(completion.wait(5));
+    TSUNIT_EQUAL(0, client.pendingRequests());
+
+    // At most two pending requests: the third submission waits for a response.
+    client.setMaxPendingRequests(2);
+    TSUNIT_ASSERT(client.submitECM(requests[5]->cp_number, cw1, cw2, ts::ByteBlock(), 100, requests[5].get()));
+    TSUNIT_ASSERT(client.submitECM(requests[6]->cp_number, cw1, cw2, ts::ByteBlock(), 100, requests[6].get()));
+    TSUNIT_EQUAL(2, client.pendingRequests());
+    const auto start = std::chrono::steady_clock::now();
+    TSUNIT_ASSERT(client.submitECM(requests[7]->cp_number, cw1, cw2, ts::ByteBlock(), 100, requests[7].get()));
+    const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    debug() << "ECMGClientTest: submitECM() blocked during " << waited << " ms" << std::endl;
+    TSUNIT_ASSERT(waited >= REPLY_DELAY / 2);
+    TSUNIT_ASSERT(completion.wait(8));
+    TSUNIT_EQUAL(0, client.pendingRequests());
+
+    // Each handler received exactly the response to its own request.
+    for (size_t i = 0; i < requests.size(); ++i) {
+        TSUNIT_EQUAL(1, requests[i]->calls);
+        TSUNIT_EQUAL(requests[i]->cp_number, requests[i]->received_cp);
+        TSUNIT_EQUAL(1, requests[i]->ecm.size());
+        TSUNIT_EQUAL(i, requests[i]->ecm[0]);
+    }
+
+    TSUNIT_ASSERT(client.disconnect());
+}
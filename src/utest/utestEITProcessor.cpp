@@ -0,0 +1,265 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::EITProcessor
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITProcessor.h"
+#include "tsOneShotPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsDuckContext.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITProcessorTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testInPlace();
+    void testLastSection();
+    void testInvalidCRC();
+
+    TSUNIT_TEST_BEGIN(EITProcessorTest);
+    TSUNIT_TEST(testInPlace);
+    TSUNIT_TEST(testLastSection);
+    TSUNIT_TEST(testInvalidCRC);
+    TSUNIT_TEST_END();
+
+private:
+    // Section counters of an EIT processor.
+    struct Counters
+    {
+        ts::SectionCounter input = 0;
+        ts::SectionCounter modified = 0;
+        ts::SectionCounter removed = 0;
+        uint64_t wrong_crc = 0;  // Output sections with an invalid CRC32.
+    };
+
+    // Build an input EIT PID with sections of various sizes, for several services.
+    // The sections in bad_crc get an invalid CRC32. Trailing packets without section are optionally added.
+    static void BuildInput(ts::DuckContext& duck, ts::TSPacketVector& packets, bool trailing = true, std::initializer_list<size_t> bad_crc = {});
+
+    // Process packets with an EIT processor, return the list of valid output sections.
+    // With flush, the delayed packets are output at end of input.
+    static void Process(ts::DuckContext& duck, bool in_place, bool flush, const ts::TSPacketVector& input, ts::SectionPtrVector& output, Counters& counters);
+};
+
+TSUNIT_REGISTER(EITProcessorTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void EITProcessorTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void EITProcessorTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Helper methods.
+//----------------------------------------------------------------------------
+
+void EITProcessorTest::BuildInput(ts::DuckContext& duck, ts::TSPacketVector& packets, bool trailing, std::initializer_list<size_t> bad_crc)
+{
+    ts::OneShotPacketizer pzer(duck, ts::PID_EIT);
+    for (size_t i = 0; i < 60; ++i) {
+        // Service ids 0x0101, 0x0102, 0x0103, payload from 6 to 600 bytes.
+        const uint16_t srv_id = uint16_t(0x0101 + i % 3);
+        ts::ByteBlock payload(6 + (i * 37) % 600, uint8_t(i));
+        ts::PutUInt16(payload.data(), 0x0010);      // transport_stream_id
+        ts::PutUInt16(payload.data() + 2, 0x0020);  // original_network_id
+        payload[4] = uint8_t(i / 3);                // segment_last_section_number
+        payload[5] = ts::TID_EIT_S_ACT_MIN;         // last_table_id
+        ts::SectionPtr section(new ts::Section(ts::TID_EIT_S_ACT_MIN, true, srv_id, 0, true, uint8_t(i / 3), uint8_t(i / 3), payload.data(), payload.size()));
+        if (std::find(bad_crc.begin(), bad_crc.end(), i) != bad_crc.end()) {
+            section->setVersion(1, false);
+        }
+        pzer.addSection(section);
+    }
+    pzer.getPackets(packets);
+
+    // Add trailing packets without section to flush the processors.
+    uint8_t cc = packets.empty() ? 0 : packets.back().getCC();
+    for (size_t i = 0; trailing && i < 100; ++i) {
+        ts::TSPacket pkt;
+        pkt.init(ts::PID_EIT, cc = (cc + 1) & ts::CC_MASK, 0xFF);
+        packets.push_back(pkt);
+    }
+}
+
+void EITProcessorTest::Process(ts::DuckContext& duck, bool in_place, bool flush, const ts::TSPacketVector& input, ts::SectionPtrVector& output, Counters& counters)
+{
+    class Collector: public ts::SectionHandlerInterface
+    {
+    public:
+        ts::SectionPtrVector& sections;
+        explicit Collector(ts::SectionPtrVector& s) : sections(s) {}
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override
+        {
+            if (section.tableId() != ts::TID_ST) {
+                sections.push_back(ts::SectionPtr(new ts::Section(section, ts::ShareMode::COPY)));
+            }
+        }
+    };
+
+    Collector collector(output);
+    ts::SectionDemux demux(duck, nullptr, &collector);
+    demux.addPID(ts::PID_EIT);
+
+    ts::EITProcessor proc(duck);
+    proc.setInPlace(in_place);
+    proc.removeService(0x0102);
+    ts::Service old_srv(0x0103);
+    ts::Service new_srv(0x0203);
+    new_srv.setTSId(0x0030);
+    proc.renameService(old_srv, new_srv);
+
+    // The continuity counters of the output EIT PID must be contiguous.
+    bool has_cc = false;
+    uint8_t cc = 0;
+    const auto output_packet = [&](const ts::TSPacket& pkt) {
+        if (pkt.getPID() == ts::PID_EIT) {
+            TSUNIT_ASSERT(!has_cc || pkt.getCC() == ((cc + 1) & ts::CC_MASK));
+            cc = pkt.getCC();
+            has_cc = true;
+        }
+        demux.feedPacket(pkt);
+    };
+
+    output.clear();
+    ts::TSPacket pkt;
+    for (const auto& ipkt : input) {
+        pkt = ipkt;
+        proc.processPacket(pkt);
+        output_packet(pkt);
+    }
+    while (flush && proc.flushPacket(pkt, true)) {
+        output_packet(pkt);
+    }
+    counters.input = proc.inputSectionCount();
+    counters.modified = proc.modifiedSectionCount();
+    counters.removed = proc.removedSectionCount();
+
+    ts::SectionDemux::Status status;
+    demux.getStatus(status);
+    counters.wrong_crc = status.wrong_crc;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void EITProcessorTest::testInPlace()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildInput(duck, input);
+
+    ts::SectionPtrVector repack;
+    ts::SectionPtrVector inplace;
+    Counters counters;
+
+    Process(duck, false, false, input, repack, counters);
+    TSUNIT_EQUAL(60, counters.input);
+    TSUNIT_EQUAL(20, counters.modified);
+    TSUNIT_EQUAL(20, counters.removed);
+    TSUNIT_EQUAL(40, repack.size());
+
+    Process(duck, true, false, input, inplace, counters);
+    TSUNIT_EQUAL(60, counters.input);
+    TSUNIT_EQUAL(20, counters.modified);
+    TSUNIT_EQUAL(20, counters.removed);
+    TSUNIT_EQUAL(40, inplace.size());
+
+    // The in-place and repacketized sections must be identical, including the CRC32.
+    for (size_t i = 0; i < repack.size() && i < inplace.size(); ++i) {
+        TSUNIT_ASSERT(*repack[i] == *inplace[i]);
+        TSUNIT_ASSERT(repack[i]->tableIdExtension() != 0x0102);
+        TSUNIT_ASSERT(repack[i]->tableIdExtension() != 0x0103);
+        if (repack[i]->tableIdExtension() == 0x0203) {
+            TSUNIT_EQUAL(0x0030, ts::GetUInt16(repack[i]->payload()));
+        }
+    }
+}
+
+void EITProcessorTest::testLastSection()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector padded;
+    ts::TSPacketVector input;
+    BuildInput(duck, padded);
+    BuildInput(duck, input, false);
+
+    ts::SectionPtrVector repack;
+    ts::SectionPtrVector inplace;
+    Counters counters;
+    Process(duck, false, false, padded, repack, counters);
+    TSUNIT_EQUAL(40, repack.size());
+
+    // Without trailing packets, the packets of the last section are still delayed at end of input.
+    Process(duck, true, false, input, inplace, counters);
+    TSUNIT_EQUAL(60, counters.input);
+    TSUNIT_EQUAL(39, inplace.size());
+
+    // The last section survives when the delayed packets are flushed.
+    Process(duck, true, true, input, inplace, counters);
+    TSUNIT_EQUAL(60, counters.input);
+    TSUNIT_EQUAL(20, counters.modified);
+    TSUNIT_EQUAL(20, counters.removed);
+    TSUNIT_EQUAL(40, inplace.size());
+    for (size_t i = 0; i < repack.size() && i < inplace.size(); ++i) {
+        TSUNIT_ASSERT(*repack[i] == *inplace[i]);
+    }
+}
+
+void EITProcessorTest::testInvalidCRC()
+{
+    // Sections 30 (kept), 31 (removed) and 32 (renamed) have an invalid CRC32.
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildInput(duck, input, true, {30, 31, 32});
+
+    ts::SectionPtrVector repack;
+    ts::SectionPtrVector inplace;
+    Counters counters;
+
+    Process(duck, false, false, input, repack, counters);
+    TSUNIT_EQUAL(57, counters.input);
+    TSUNIT_EQUAL(19, counters.modified);
+    TSUNIT_EQUAL(19, counters.removed);
+    TSUNIT_EQUAL(0, counters.wrong_crc);
+    TSUNIT_EQUAL(38, repack.size());
+
+    // In place, the CRC32 of removed sections is not checked.
+    Process(duck, true, false, input, inplace, counters);
+    TSUNIT_EQUAL(58, counters.input);
+    TSUNIT_EQUAL(19, counters.modified);
+    TSUNIT_EQUAL(20, counters.removed);
+    TSUNIT_EQUAL(0, counters.wrong_crc);
+    TSUNIT_EQUAL(38, inplace.size());
+
+    for (size_t i = 0; i < repack.size() && i < inplace.size(); ++i) {
+        TSUNIT_ASSERT(*repack[i] == *inplace[i]);
+        TSUNIT_ASSERT(repack[i]->version() == 0);
+    }
+}
@@ -11,6 +11,11 @@
 //----------------------------------------------------------------------------
 
 #include "tshlsPlayList.h"
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsWebRequest.h"
+#include "utestTSUnitHTTPServer.h"
 #include "tsunit.h"
 
 
@@ -29,6 +34,8 @@ public:
     void testMediaPlaylist();
     void testBuildMasterPlaylist();
     void testBuildMediaPlaylist();
+    void testBuildLowLatencyPlaylist();
+    void testPrefetch();
 
     TSUNIT_TEST_BEGIN(HLSTest);
     TSUNIT_TEST(testMasterPlaylist);
@@ -36,6 +43,8 @@ public:
     TSUNIT_TEST(testMediaPlaylist);
     TSUNIT_TEST(testBuildMasterPlaylist);
     TSUNIT_TEST(testBuildMediaPlaylist);
+    TSUNIT_TEST(testBuildLowLatencyPlaylist);
+    TSUNIT_TEST(testPrefetch);
     TSUNIT_TEST_END();
 
 private:
@@ -369,3 +378,134 @@ void HLSTest::testBuildMediaPlaylist()
 
     TSUNIT_EQUAL(refContent2, pl.textContent());
 }
+
+void HLSTest::testBuildLowLatencyPlaylist()
+{
+    ts::hls::PlayList pl;
+    pl.reset(ts::hls::PlayListType::LIVE, u"/c/test/path/master/test.m3u8");
+
+    TSUNIT_ASSERT(pl.setTargetDuration(2));
+    TSUNIT_ASSERT(pl.setPartTarget(1000));
+    TSUNIT_EQUAL(1000, pl.partTarget());
+
+    ts::hls::MediaPart part;
+    part.relativeURI = u"/c/test/path/segments/seg-0001.part0.ts";
+    part.duration = 1000;
+    part.independent = true;
+    TSUNIT_ASSERT(pl.addPendingPart(part));
+    part.relativeURI = u"/c/test/path/segments/seg-0001.part1.ts";
+    part.duration = 960;
+    part.independent = false;
+    TSUNIT_ASSERT(pl.addPendingPart(part));
+    TSUNIT_EQUAL(2, pl.pendingPartCount());
+
+    ts::hls::MediaSegment seg;
+    seg.relativeURI = u"/c/test/path/segments/seg-0001.ts";
+    seg.duration = 1960;
+    TSUNIT_ASSERT(pl.addSegment(seg));
+    TSUNIT_EQUAL(0, pl.pendingPartCount());
+
+    part.relativeURI = u"/c/test/path/segments/seg-0002.part0.ts";
+    part.duration = 1000;
+    part.independent = true;
+    TSUNIT_ASSERT(pl.addPendingPart(part));
+    pl.setPreloadHint(u"/c/test/path/segments/seg-0002.part1.ts");
+
+    static const ts::UChar* const refContent =
+        u"#EXTM3U\n"
+        u"#EXT-X-VERSION:6\n"
+        u"#EXT-X-TARGETDURATION:2\n"
+        u"#EXT-X-MEDIA-SEQUENCE:0\n"
+        u"#EXT-X-PART-INF:PART-TARGET=1.000\n"
+        u"#EXT-X-SERVER-CONTROL:PART-HOLD-BACK=3.000\n"
+        u"#EXT-X-PART:DURATION=1.000,URI=\"../segments/seg-0001.part0.ts\",INDEPENDENT=YES\n"
+        u"#EXT-X-PART:DURATION=0.960,URI=\"../segments/seg-0001.part1.ts\"\n"
+        u"#EXTINF:1.960,\n"
+        u"../segments/seg-0001.ts\n"
+        u"#EXT-X-PART:DURATION=1.000,URI=\"../segments/seg-0002.part0.ts\",INDEPENDENT=YES\n"
+        u"#EXT-X-PRELOAD-HINT:TYPE=PART,URI=\"../segments/seg-0002.part1.ts\"\n";
+
+    TSUNIT_EQUAL(refContent, pl.textContent());
+}
+
+namespace {
+    // Event handler for a memory output plugin: fill a vector of packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output) : _output(output) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                const size_t count = data->size() / ts::PKT_SIZE;
+                const size_t index = _output.size();
+                _output.resize(index + count);
+                ts::TSPacket::Copy(&_output[index], data->data(), count);
+            }
+        }
+
+    private:
+        ts::TSPacketVector& _output;
+    };
+}
+
+void HLSTest::testPrefetch()
+{
+    if (!ts::WebRequest::IsSupported()) {
+        debug() << "HLSTest::testPrefetch: no Web support, skipped" << std::endl;
+        return;
+    }
+
+    // Local HTTP server with a VoD media playlist. The packet index is stored in the last 4 bytes of each packet.
+    constexpr size_t segment_count = 8;
+    constexpr size_t segment_packets = 20;
+    utest::TSUnitHTTPServer server(12349);
+    std::string playlist("#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:0\n");
+    for (size_t seg = 0; seg < segment_count; ++seg) {
+        std::string content;
+        for (size_t i = 0; i < segment_packets; ++i) {
+            const size_t index = seg * segment_packets + i;
+            ts::TSPacket pkt;
+            pkt.init(0x0100, uint8_t(index & ts::CC_MASK), 0xFF);
+            ts::PutUInt32(pkt.b + ts::PKT_SIZE - 4, uint32_t(index));
+            content.append(reinterpret_cast<const char*>(pkt.b), ts::PKT_SIZE);
+        }
+        const std::string name("segment-" + std::to_string(seg) + ".ts");
+        server.resources["/" + name] = content;
+        playlist.append("#EXTINF:2.0,\n" + name + "\n");
+    }
+    playlist.append("#EXT-X-ENDLIST\n");
+    server.resources["/playlist.m3u8"] = playlist;
+    TSUNIT_ASSERT(server.start());
+
+    // Receive the HLS stream with two prefetch downloaders.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"HLSTest::testPrefetch";
+    opt.input = {u"hls", {server.url(u"/playlist.m3u8"), u"--prefetch", u"2"}};
+    opt.output = {u"memory", {}};
+
+    ts::TSPacketVector output;
+    Output out(output);
+    ts::TSProcessor tsproc(CERR);
+    tsproc.registerEventHandler(&out, ts::PluginType::OUTPUT);
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    debug() << "HLSTest::testPrefetch: " << output.size() << " packets, " << server.requestCount() << " requests, "
+            << server.connectionCount() << " connections" << std::endl;
+
+    // All segments are received in order.
+    TSUNIT_EQUAL(segment_count * segment_packets, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_EQUAL(i, ts::GetUInt32(output[i].b + ts::PKT_SIZE - 4));
+    }
+
+    // All segments are downloaded by the two downloaders, each one keeping its connection.
+    // The playlist is downloaded on its own connection.
+    TSUNIT_ASSERT(server.requestCount() >= segment_count + 1);
+    TSUNIT_ASSERT(server.connectionCount() <= 3);
+    server.stop();
+}
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the "http" output plugin with multiple clients.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSProcessor.h"
+#include "tsTCPConnection.h"
+#include "tsIPUtils.h"
+#include "tsSysUtils.h"
+#include "tsNullReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class HTTPOutputPluginTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testMultipleClients();
+
+    TSUNIT_TEST_BEGIN(HTTPOutputPluginTest);
+    TSUNIT_TEST(testMultipleClients);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(HTTPOutputPluginTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void HTTPOutputPluginTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void HTTPOutputPluginTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Connect to the server, send a request, return the response headers and the first bytes of content.
+    bool Request(ts::TCPConnection& client, uint16_t port, std::string& response)
+    {
+        response.clear();
+        const ts::IPv4SocketAddress server(ts::IPv4Address::LocalHost, port);
+        if (!client.open(CERR) || !client.connect(server, CERR)) {
+            return false;
+        }
+        const std::string request("GET / HTTP/1.1\r\n\r\n");
+        if (!client.send(request.data(), request.size(), CERR)) {
+            return false;
+        }
+        // Read until the end of the response headers and at least one packet of content, or disconnection.
+        char buffer[1024];
+        size_t size = 0;
+        size_t end = std::string::npos;
+        while ((end == std::string::npos || response.size() < end + 4 + ts::PKT_SIZE) && client.receive(buffer, sizeof(buffer), size, nullptr, NULLREP)) {
+            response.append(buffer, size);
+            end = response.find("\r\n\r\n");
+        }
+        return !response.empty();
+    }
+}
+
+void HTTPOutputPluginTest::testMultipleClients()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+    const uint16_t port = 12347;
+
+    // As in tsp, sending to a disconnected client shall not kill the process.
+    ts::IgnorePipeSignal();
+
+    // Endless stream of null packets, to at most two clients.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"HTTPOutputPluginTest::testMultipleClients";
+    opt.input = {u"null", {}};
+    opt.output = {u"http", {u"--server", ts::UString::Format(u"127.0.0.1:%d", {port}), u"--max-clients", u"2", u"--client-queue-size", u"1000"}};
+
+    ts::TSProcessor tsproc(CERR);
+    TSUNIT_ASSERT(tsproc.start(opt));
+
+    // Two clients receive the stream.
+    ts::TCPConnection client1;
+    ts::TCPConnection client2;
+    std::string response;
+    TSUNIT_ASSERT(Request(client1, port, response));
+    debug() << "HTTPOutputPluginTest::testMultipleClients: client 1 response size: " << response.size() << std::endl;
+    TSUNIT_ASSERT(response.find("HTTP/1.1 200 OK\r\n") == 0);
+    TSUNIT_EQUAL(ts::SYNC_BYTE, uint8_t(response[response.find("\r\n\r\n") + 4]));
+    TSUNIT_ASSERT(Request(client2, port, response));
+    TSUNIT_ASSERT(response.find("HTTP/1.1 200 OK\r\n") == 0);
+
+    // A third client is rejected.
+    ts::TCPConnection client3;
+    TSUNIT_ASSERT(Request(client3, port, response));
+    TSUNIT_ASSERT(response.find("HTTP/1.1 503 Service Unavailable\r\n") == 0);
+    client3.close(NULLREP);
+
+    // The two clients no longer read the stream. Their sessions are blocked in send() when
+    // the socket buffers are full. Terminating the plugin shall not wait for these clients.
+    ts::SleepThread(200);
+    tsproc.abort();
+    tsproc.waitForTermination();
+
+    // The sessions were disconnected by the server.
+    char buffer[1024];
+    size_t size = 0;
+    while (client1.receive(buffer, sizeof(buffer), size, nullptr, NULLREP)) {
+    }
+    while (client2.receive(buffer, sizeof(buffer), size, nullptr, NULLREP)) {
+    }
+    client1.close(NULLREP);
+    client2.close(NULLREP);
+}
@@ -0,0 +1,312 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::InputSwitcher (tsswitch engine)
+//
+//----------------------------------------------------------------------------
+
+#include "tsInputSwitcher.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsOneShotPacketizer.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsCerrReport.h"
+#include "tsSysUtils.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class InputSwitcherTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testHotStandby();
+    void testSyncRandomAccess();
+    void testSyncPATPMT();
+
+    TSUNIT_TEST_BEGIN(InputSwitcherTest);
+    TSUNIT_TEST(testHotStandby);
+    TSUNIT_TEST(testSyncRandomAccess);
+    TSUNIT_TEST(testSyncPATPMT);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(InputSwitcherTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void InputSwitcherTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void InputSwitcherTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Controlled memory inputs and output.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // PID's of the two input streams. The second one contains a service with a PMT.
+    constexpr ts::PID PID_INPUT0 = 0x0100;
+    constexpr ts::PID PID_INPUT1 = 0x0200;
+    constexpr ts::PID PID_PMT1 = 0x0300;
+
+    // Get the packet index in a test packet. It is stored in the last 4 bytes of each packet.
+    size_t PacketIndex(const ts::TSPacket& pkt)
+    {
+        return ts::GetUInt32(pkt.b + ts::PKT_SIZE - 4);
+    }
+
+    // Event handler for a memory input plugin. The test releases the packets up to some index.
+    // The packets are on one PID, except some special packets which are provided by the test.
+    // The event handlers are serialized and must not block the other plugins. When no packet
+    // is released, the input returns a null packet after a short delay. Without delay, an idle
+    // input would continuously hold the lock of the event handlers and starve the other plugins.
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(ts::PID pid) : _pid(pid) {}
+
+        // Special packets at some indexes.
+        std::map<size_t, ts::TSPacket> special {};
+
+        // Release packets up to an index (excluded).
+        void release(size_t limit)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _limit = limit;
+        }
+
+        // Terminate the input.
+        void end()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _end = true;
+        }
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (data != nullptr && !_end && _next >= _limit) {
+                data->append(ts::NullPacket.b, ts::PKT_SIZE);
+                ts::SleepThread(1);
+            }
+            while (data != nullptr && !_end && _next < _limit && data->remainingSize() >= ts::PKT_SIZE) {
+                ts::TSPacket pkt;
+                const auto it = special.find(_next);
+                if (it != special.end()) {
+                    pkt = it->second;
+                }
+                else {
+                    pkt.init(_pid, uint8_t(_next & ts::CC_MASK), 0xFF);
+                }
+                ts::PutUInt32(pkt.b + ts::PKT_SIZE - 4, uint32_t(_next));
+                data->append(pkt.b, ts::PKT_SIZE);
+                _next++;
+            }
+        }
+
+    private:
+        const ts::PID           _pid;
+        std::mutex              _mutex {};
+        size_t                  _next = 0;
+        size_t                  _limit = 0;
+        bool                    _end = false;
+    };
+
+    // Event handler for a memory output plugin: fill a vector of packets, except null packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOCOPY(Output);
+    public:
+        Output() = default;
+
+        // Wait until some number of packets are received, with a timeout of 5 seconds.
+        bool wait(size_t count)
+        {
+            for (int i = 0; i < 500; ++i) {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_packets.size() >= count) {
+                        return true;
+                    }
+                }
+                ts::SleepThread(10);
+            }
+            return false;
+        }
+
+        // Get a copy of the received packets.
+        ts::TSPacketVector packets()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _packets;
+        }
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(data->data());
+                for (size_t count = data->size() / ts::PKT_SIZE; count > 0; --count, ++pkt) {
+                    if (pkt->getPID() != ts::PID_NULL) {
+                        _packets.push_back(*pkt);
+                    }
+                }
+            }
+        }
+
+    private:
+        std::mutex         _mutex {};
+        ts::TSPacketVector _packets {};
+    };
+
+    // Switch from input 0 to input 1 with --hot-standby. Return the index of the first packet of input 1 in output.
+    // Scenario: input 0 sends 100 packets, input 1 (standby) sends 50 packets, switch to input 1. With a switch
+    // synchronization, input 0 sends 50 more packets. Then input 1 sends 50 more packets. The output shall contain
+    // the packets of input 0, followed by the end of input 1, starting at the synchronization point.
+    size_t HotStandbySwitch(ts::InputSwitcherArgs::SwitchSync sync, Input& input1)
+    {
+        ts::InputSwitcherArgs args;
+        args.appName = u"InputSwitcherTest";
+        args.hotStandby = true;
+        args.switchSync = sync;
+        args.bufferedPackets = ts::InputSwitcherArgs::DEFAULT_BUFFERED_PACKETS;
+        args.maxInputPackets = ts::InputSwitcherArgs::DEFAULT_MAX_INPUT_PACKETS;
+        args.inputs.push_back({u"memory", {}});
+        args.inputs.push_back({u"memory", {}});
+        args.output = {u"memory", {}};
+
+        Input input0(PID_INPUT0);
+        Output output;
+        ts::InputSwitcher sw(CERR);
+        sw.registerEventHandler(&output, ts::PluginType::OUTPUT);
+        ts::PluginEventHandlerRegistry::Criteria crit0(ts::PluginType::INPUT);
+        ts::PluginEventHandlerRegistry::Criteria crit1(ts::PluginType::INPUT);
+        crit0.plugin_index = 0;
+        crit1.plugin_index = 1;
+        sw.registerEventHandler(&input0, crit0);
+        sw.registerEventHandler(&input1, crit1);
+        TSUNIT_ASSERT(sw.start(args));
+
+        // The switcher is stopped before checking the results, a failed assertion shall not leave it running.
+        input0.release(100);
+        const bool received0 = output.wait(100);
+        input1.release(50);
+        sw.setInput(1);
+
+        // Without synchronization point in input 1, the output continues on input 0.
+        const size_t count0 = sync == ts::InputSwitcherArgs::SwitchSync::PACKET ? 100 : 150;
+        input0.release(count0);
+        const bool received1 = output.wait(count0);
+        input1.release(100);
+
+        // Wait for the last packet of input 1.
+        size_t first = ts::NPOS;
+        ts::TSPacketVector packets;
+        for (int i = 0; i < 500; ++i) {
+            packets = output.packets();
+            if (!packets.empty() && packets.back().getPID() != PID_INPUT0 && PacketIndex(packets.back()) == 99) {
+                break;
+            }
+            ts::SleepThread(10);
+        }
+
+        input0.end();
+        input1.end();
+        sw.stop();
+        sw.waitForTermination();
+        TSUNIT_ASSERT(received0);
+        TSUNIT_ASSERT(received1);
+
+        // The packets of input 0, then the packets of input 1, in order, up to the last one.
+        TSUNIT_ASSERT(packets.size() > count0);
+        for (size_t i = 0; i < count0; ++i) {
+            TSUNIT_EQUAL(PID_INPUT0, packets[i].getPID());
+            TSUNIT_EQUAL(i, PacketIndex(packets[i]));
+        }
+        first = PacketIndex(packets[count0]);
+        for (size_t i = count0; i < packets.size(); ++i) {
+            TSUNIT_ASSERT(packets[i].getPID() != PID_INPUT0);
+            TSUNIT_EQUAL(first + i - count0, PacketIndex(packets[i]));
+        }
+        TSUNIT_EQUAL(99, PacketIndex(packets.back()));
+        return first;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void InputSwitcherTest::testHotStandby()
+{
+    // The switch occurs at the first packet in the ring of input 1, after the switch request.
+    // The packets which were released before the switch request may have been dropped or not.
+    Input input1(PID_INPUT1);
+    const size_t first = HotStandbySwitch(ts::InputSwitcherArgs::SwitchSync::PACKET, input1);
+    debug() << "InputSwitcherTest::testHotStandby: first packet from input 1: " << first << std::endl;
+    TSUNIT_ASSERT(first <= 50);
+}
+
+void InputSwitcherTest::testSyncRandomAccess()
+{
+    Input input1(PID_INPUT1);
+    ts::TSPacket pkt;
+    pkt.init(PID_INPUT1, 0, 0xFF);
+    TSUNIT_ASSERT(pkt.setRandomAccessIndicator(true));
+    input1.special[70] = pkt;
+    TSUNIT_EQUAL(70, HotStandbySwitch(ts::InputSwitcherArgs::SwitchSync::RANDOM_ACCESS, input1));
+}
+
+void InputSwitcherTest::testSyncPATPMT()
+{
+    // PAT of input 1, with one service.
+    ts::DuckContext duck;
+    ts::PAT pat(0, true, 1);
+    pat.pmts[1] = PID_PMT1;
+    ts::BinaryTable table;
+    pat.serialize(duck, table);
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT, true);
+    pzer.addTable(table);
+    ts::TSPacketVector pat_packets;
+    pzer.getPackets(pat_packets);
+    TSUNIT_EQUAL(1, pat_packets.size());
+
+    // Start of the PMT (the content is not used).
+    ts::TSPacket pmt;
+    pmt.init(PID_PMT1, 0, 0xFF);
+    pmt.setPUSI(true);
+
+    // The PAT at 55 is not followed by the PMT before the next PAT at 60. The PMT follows at 80.
+    Input input1(PID_INPUT1);
+    input1.special[55] = pat_packets[0];
+    input1.special[60] = pat_packets[0];
+    input1.special[80] = pmt;
+
+    TSUNIT_EQUAL(60, HotStandbySwitch(ts::InputSwitcherArgs::SwitchSync::PAT_PMT, input1));
+}
@@ -12,6 +12,7 @@
 
 #include "tsMemory.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 
 //----------------------------------------------------------------------------
@@ -74,6 +75,8 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testLocatePattern();
+    void testLocateZeroZero();
 
     TSUNIT_TEST_BEGIN(MemoryTest);
     TSUNIT_TEST(testGetUInt8);
@@ -126,6 +129,8 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testLocatePattern);
+    TSUNIT_TEST(testLocateZeroZero);
     TSUNIT_TEST_END();
 };
 
@@ -510,3 +515,87 @@ void MemoryTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, 0x908F8E8D8C8B8A89);
     TSUNIT_EQUAL(0, std::memcmp(out, _bytes + 0x89, 8));
 }
+
+void MemoryTest::testLocatePattern()
+{
+    static const uint8_t pat1[] = {0x45};
+    static const uint8_t pat2[] = {0x45, 0x46, 0x47};
+    static const uint8_t pat3[] = {0x45, 0x47};
+
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), pat1, sizeof(pat1)) == _bytes + 0x45);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), pat2, sizeof(pat2)) == _bytes + 0x45);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), pat3, sizeof(pat3)) == nullptr);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, 0x47, pat2, sizeof(pat2)) == nullptr);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, 0x48, pat2, sizeof(pat2)) == _bytes + 0x45);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), pat1, 0) == nullptr);
+
+    static const uint8_t data[] = {0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x05, 0x00, 0x00, 0x01, 0x09, 0x00};
+    static const uint8_t start1[] = {0x00, 0x00, 0x01};
+    static const uint8_t start2[] = {0x00, 0x00, 0x01, 0x09};
+    static const uint8_t start3[] = {0x00, 0x00, 0x01, 0x09, 0x00, 0x00};
+
+    TSUNIT_ASSERT(ts::LocatePattern(data, sizeof(data), start1, sizeof(start1)) == data + 5);
+    TSUNIT_ASSERT(ts::LocatePattern(data, sizeof(data), start2, sizeof(start2)) == data + 9);
+    TSUNIT_ASSERT(ts::LocatePattern(data, sizeof(data), start3, sizeof(start3)) == nullptr);
+}
+
+void MemoryTest::testLocateZeroZero()
+{
+    // Build a pseudo video payload: no 00 00 sequence except start codes at known places.
+    std::vector<uint8_t> data(100000);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < data.size(); ++i) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = uint8_t(seed >> 16);
+        if (i >= 2 && data[i] <= 0x03 && data[i-1] == 0x00 && data[i-2] == 0x00) {
+            data[i] = 0x04;
+        }
+        else if (i >= 1 && data[i] == 0x00 && data[i-1] == 0x00) {
+            data[i] = 0x03; // emulation prevention
+        }
+    }
+    static const size_t starts[] = {0, 17, 31, 35, 1000, 1015, 50001, 99990, 99997};
+    for (auto off : starts) {
+        data[off] = data[off+1] = 0x00;
+        data[off+2] = 0x01;
+        if (off > 0 && data[off-1] == 0x00) {
+            data[off-1] = 0x05;
+        }
+        if (off + 3 < data.size() && data[off+3] <= 0x03) {
+            data[off+3] = 0x05;
+        }
+    }
+
+    // Check all start codes, from all possible alignments.
+    for (size_t skip = 0; skip < 48; ++skip) {
+        const uint8_t* p = data.data() + skip;
+        size_t size = data.size() - skip;
+        for (auto off : starts) {
+            if (off >= skip) {
+                const uint8_t* next = ts::LocateZeroZero(p, size, 0x01);
+                TSUNIT_ASSERT(next == data.data() + off);
+                size -= next + 1 - p;
+                p = next + 1;
+            }
+        }
+        TSUNIT_ASSERT(ts::LocateZeroZero(p, size, 0x01) == nullptr);
+    }
+    TSUNIT_ASSERT(ts::LocateZeroZero(data.data(), data.size(), 0x00) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data.data(), 2, 0x01) == nullptr);
+    TSUNIT_ASSERT(ts::LocateZeroZero(data.data(), 3, 0x01) == data.data());
+    TSUNIT_ASSERT(ts::LocateZeroZero(data.data() + 99997, 3, 0x01) == data.data() + 99997);
+
+    // Support for benchmarking.
+    utest::TSUnitBenchmark bench(u"TSUNIT_LOCATE_ITERATIONS");
+    size_t count = 0;
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        count = 0;
+        for (const uint8_t* p = data.data(); (p = ts::LocateZeroZero(p, data.data() + data.size() - p, 0x01)) != nullptr; ++p) {
+            count++;
+        }
+    }
+    bench.stop();
+    TSUNIT_EQUAL(sizeof(starts) / sizeof(starts[0]), count);
+    bench.report(u"MemoryTest::testLocateZeroZero");
+}
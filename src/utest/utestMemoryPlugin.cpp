@@ -14,6 +14,8 @@
 #include "tsPluginEventData.h"
 #include "tsTSProcessor.h"
 #include "tsAsyncReport.h"
+#include "tsArgsWithPlugins.h"
+#include "tsDuckContext.h"
 #include "tsunit.h"
 
 
@@ -28,9 +30,15 @@ public:
     virtual void afterTest() override;
 
     void testAll();
+    void testBranchOutputs();
+    void testBranchProcessors();
+    void testBranchArgs();
 
     TSUNIT_TEST_BEGIN(MemoryPluginTest);
     TSUNIT_TEST(testAll);
+    TSUNIT_TEST(testBranchOutputs);
+    TSUNIT_TEST(testBranchProcessors);
+    TSUNIT_TEST(testBranchArgs);
     TSUNIT_TEST_END();
 };
 
@@ -233,3 +241,134 @@ void MemoryPluginTest::testAll()
     TSUNIT_EQUAL(0, std::memcmp(&output_packets[0], REF_PACKETS, ts::PKT_SIZE * REF_PACKETS_COUNT));
     TSUNIT_EQUAL(u"", log_buffer);
 }
+
+void MemoryPluginTest::testBranchOutputs()
+{
+    ts::UString log_buffer;
+    TestReport log(log_buffer);
+
+    ts::TSPacketVector output_packets1;
+    ts::TSPacketVector output_packets2;
+    Input input(REF_PACKETS, REF_PACKETS_COUNT);
+    Output output1(output_packets1);
+    Output output2(output_packets2);
+
+    // Two outputs, no packet processor: the outputs are at index 1 and 2 in the chain.
+    ts::TSProcessorArgs opt;
+    opt.input = {u"memory", {}};
+    opt.output = {u"memory", {}};
+    opt.branch_outputs = {{u"memory", {}}};
+
+    ts::PluginEventHandlerRegistry::Criteria crit1;
+    ts::PluginEventHandlerRegistry::Criteria crit2;
+    crit1.plugin_index = 1;
+    crit2.plugin_index = 2;
+
+    ts::TSProcessor tsp(log);
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output1, crit1);
+    tsp.registerEventHandler(&output2, crit2);
+
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+
+    TSUNIT_EQUAL(REF_PACKETS_COUNT, output_packets1.size());
+    TSUNIT_EQUAL(REF_PACKETS_COUNT, output_packets2.size());
+    TSUNIT_EQUAL(0, std::memcmp(&output_packets1[0], REF_PACKETS, ts::PKT_SIZE * REF_PACKETS_COUNT));
+    TSUNIT_EQUAL(0, std::memcmp(&output_packets2[0], REF_PACKETS, ts::PKT_SIZE * REF_PACKETS_COUNT));
+    TSUNIT_EQUAL(u"", log_buffer);
+}
+
+void MemoryPluginTest::testBranchProcessors()
+{
+    ts::UString log_buffer;
+    TestReport log(log_buffer);
+
+    // Many packets in a small buffer to exercise the wrap-up of the buffers.
+    constexpr size_t packets_count = 5000;
+    ts::TSPacketVector input_packets(packets_count);
+    for (size_t i = 0; i < packets_count; ++i) {
+        input_packets[i].init(100, uint8_t(i), 0xFF);
+        ts::PutUInt32(input_packets[i].b + ts::PKT_SIZE - 4, uint32_t(i));
+    }
+
+    ts::TSPacketVector output_packets1;
+    ts::TSPacketVector output_packets2;
+    ts::TSPacketVector output_packets3;
+    Input input(&input_packets[0], packets_count);
+    Output output1(output_packets1);
+    Output output2(output_packets2);
+    Output output3(output_packets3);
+
+    // Main output without processor. The second output replaces the first 10 packets with null packets.
+    // The third output removes the first 50 packets. The packets are modified in the branches only.
+    ts::TSProcessorArgs opt;
+    opt.ts_buffer_size = ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+    opt.input = {u"memory", {}};
+    opt.output = {u"memory", {}};
+    opt.branch_outputs = {{u"memory", {}}, {u"memory", {}}};
+    opt.branch_plugins = {
+        {{u"skip", {u"--stuffing", u"10"}}},
+        {{u"skip", {u"20"}}, {u"skip", {u"30"}}},
+    };
+
+    // Plugin indexes: input (0), output1 (1), skip (2), output2 (3), skip (4), skip (5), output3 (6).
+    ts::PluginEventHandlerRegistry::Criteria crit1;
+    ts::PluginEventHandlerRegistry::Criteria crit2;
+    ts::PluginEventHandlerRegistry::Criteria crit3;
+    crit1.plugin_index = 1;
+    crit2.plugin_index = 3;
+    crit3.plugin_index = 6;
+
+    ts::TSProcessor tsp(log);
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output1, crit1);
+    tsp.registerEventHandler(&output2, crit2);
+    tsp.registerEventHandler(&output3, crit3);
+
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+
+    TSUNIT_EQUAL(packets_count, output_packets1.size());
+    TSUNIT_EQUAL(packets_count, output_packets2.size());
+    TSUNIT_EQUAL(packets_count - 50, output_packets3.size());
+    TSUNIT_EQUAL(0, std::memcmp(&output_packets1[0], &input_packets[0], ts::PKT_SIZE * packets_count));
+    for (size_t i = 0; i < 10; ++i) {
+        TSUNIT_EQUAL(ts::PID_NULL, output_packets2[i].getPID());
+    }
+    TSUNIT_EQUAL(0, std::memcmp(&output_packets2[10], &input_packets[10], ts::PKT_SIZE * (packets_count - 10)));
+    TSUNIT_EQUAL(0, std::memcmp(&output_packets3[0], &input_packets[50], ts::PKT_SIZE * (packets_count - 50)));
+    TSUNIT_EQUAL(u"", log_buffer);
+}
+
+void MemoryPluginTest::testBranchArgs()
+{
+    ts::ArgsWithPlugins args;
+    ts::DuckContext duck(&args);
+    ts::TSProcessorArgs opt;
+    opt.defineArgs(args);
+
+    // Packet processors between two outputs are specific to the second one. All others are common.
+    TSUNIT_ASSERT(args.analyze(u"tsp", {u"-I", u"null", u"-P", u"a", u"-O", u"drop", u"-P", u"b", u"-P", u"c", u"-O", u"file", u"x.ts",
+                                        u"-O", u"drop", u"-P", u"d", u"-O", u"file", u"y.ts", u"-P", u"e"}, false));
+    TSUNIT_ASSERT(opt.loadArgs(duck, args));
+
+    TSUNIT_EQUAL(u"null", opt.input.name);
+    TSUNIT_EQUAL(u"drop", opt.output.name);
+    TSUNIT_EQUAL(2, opt.plugins.size());
+    TSUNIT_EQUAL(u"a", opt.plugins[0].name);
+    TSUNIT_EQUAL(u"e", opt.plugins[1].name);
+    TSUNIT_EQUAL(3, opt.branch_outputs.size());
+    TSUNIT_EQUAL(u"file", opt.branch_outputs[0].name);
+    TSUNIT_EQUAL(1, opt.branch_outputs[0].args.size());
+    TSUNIT_EQUAL(u"x.ts", opt.branch_outputs[0].args[0]);
+    TSUNIT_EQUAL(u"drop", opt.branch_outputs[1].name);
+    TSUNIT_EQUAL(u"file", opt.branch_outputs[2].name);
+    TSUNIT_EQUAL(3, opt.branch_plugins.size());
+    TSUNIT_EQUAL(2, opt.branch_plugins[0].size());
+    TSUNIT_EQUAL(u"b", opt.branch_plugins[0][0].name);
+    TSUNIT_EQUAL(u"c", opt.branch_plugins[0][1].name);
+    TSUNIT_EQUAL(0, opt.branch_plugins[1].size());
+    TSUNIT_EQUAL(1, opt.branch_plugins[2].size());
+    TSUNIT_EQUAL(u"d", opt.branch_plugins[2][0].name);
+}
@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the "merge" plugin.
+//
+//  The "merge" plugin is loaded from its shared library. This test is not
+//  part of the static version of the unitary tests.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MergePluginTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testInProcess();
+
+    TSUNIT_TEST_BEGIN(MergePluginTest);
+    TSUNIT_TEST(testInProcess);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(MergePluginTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void MergePluginTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void MergePluginTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Memory input and output.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Event handler for a memory input plugin: null packets, up to a maximum count.
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(size_t count) : _count(count) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            while (data != nullptr && _next < _count && data->remainingSize() >= ts::PKT_SIZE) {
+                data->append(ts::NullPacket.b, ts::PKT_SIZE);
+                _next++;
+            }
+        }
+
+    private:
+        const size_t _count;
+        size_t       _next = 0;
+    };
+
+    // Event handler for a memory output plugin: keep non-null packets only.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output) : _output(output) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(data->data());
+                for (size_t count = data->size() / ts::PKT_SIZE; count > 0; --count, ++pkt) {
+                    if (pkt->getPID() != ts::PID_NULL) {
+                        _output.push_back(*pkt);
+                    }
+                }
+            }
+        }
+
+    private:
+        ts::TSPacketVector& _output;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void MergePluginTest::testInProcess()
+{
+    // The main stream contains null packets only. The merged stream is produced by an in-process
+    // pipeline which crafts 100 packets on PID 0x200. The null packets of the main stream are
+    // replaced by the merged packets and the processing terminates after the last merged packet.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"MergePluginTest::testInProcess";
+    opt.input = {u"memory", {}};
+    opt.plugins = {
+        {u"merge", {u"--in-process", u"--terminate", u"--no-smoothing", u"--no-pcr-restamp", u"tsp -I craft --count 100 --pid 0x200"}},
+    };
+    opt.output = {u"memory", {}};
+
+    Input input(100000);
+    ts::TSPacketVector output;
+    Output out(output);
+
+    ts::TSProcessor tsproc(CERR);
+    tsproc.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsproc.registerEventHandler(&out, ts::PluginType::OUTPUT);
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // All merged packets are received, in order.
+    debug() << "MergePluginTest::testInProcess: " << output.size() << " merged packets" << std::endl;
+    TSUNIT_EQUAL(100, output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_EQUAL(0x0200, output[i].getPID());
+        TSUNIT_EQUAL(i % 16, output[i].getCC());
+    }
+}
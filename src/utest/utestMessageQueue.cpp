@@ -12,6 +12,7 @@
 
 #include "tsMessageQueue.h"
 #include "tsMessagePriorityQueue.h"
+#include "tsMessageRing.h"
 #include "tsMonotonic.h"
 #include "tsSysUtils.h"
 #include "tsunit.h"
@@ -31,11 +32,17 @@ public:
     void testConstructor();
     void testQueue();
     void testPriorityQueue();
+    void testRingOverflow();
+    void testRingProducers();
+    void testRingInPlace();
 
     TSUNIT_TEST_BEGIN(MessageQueueTest);
     TSUNIT_TEST(testConstructor);
     TSUNIT_TEST(testQueue);
     TSUNIT_TEST(testPriorityQueue);
+    TSUNIT_TEST(testRingOverflow);
+    TSUNIT_TEST(testRingProducers);
+    TSUNIT_TEST(testRingInPlace);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision = 0;
@@ -241,3 +248,125 @@ void MessageQueueTest::testPriorityQueue()
 
     TSUNIT_ASSERT(!queue.dequeue(msg, 0));
 }
+
+typedef ts::MessageRing<int> TestRing;
+
+void MessageQueueTest::testRingOverflow()
+{
+    TestRing ring(3);
+    TSUNIT_EQUAL(4, ring.capacity());
+    TSUNIT_EQUAL(0, ring.overflowCount());
+
+    int msg = 0;
+    TSUNIT_ASSERT(!ring.dequeue(msg, 0));
+    TSUNIT_ASSERT(!ring.dequeue(msg, 20));
+
+    TSUNIT_ASSERT(ring.enqueue(1));
+    TSUNIT_ASSERT(ring.enqueue(2));
+    TSUNIT_ASSERT(ring.enqueue(3));
+    TSUNIT_ASSERT(ring.enqueue(4));
+    TSUNIT_ASSERT(!ring.enqueue(5));
+    TSUNIT_ASSERT(!ring.enqueue(6, 20));
+    TSUNIT_EQUAL(2, ring.overflowCount());
+
+    TSUNIT_ASSERT(ring.dequeue(msg, 0));
+    TSUNIT_EQUAL(1, msg);
+    TSUNIT_ASSERT(ring.enqueue(7));
+    TSUNIT_EQUAL(2, ring.overflowCount());
+
+    for (int expected : {2, 3, 4, 7}) {
+        TSUNIT_ASSERT(ring.dequeue(msg, 0));
+        TSUNIT_EQUAL(expected, msg);
+    }
+    TSUNIT_ASSERT(!ring.dequeue(msg, 0));
+}
+
+// Thread for testRingProducers()
+namespace {
+    class MessageRingProducer: public utest::TSUnitThread
+    {
+    private:
+        TestRing& _ring;
+        int _id;
+        int _count;
+    public:
+        MessageRingProducer(TestRing& ring, int id, int count) :
+            utest::TSUnitThread(),
+            _ring(ring),
+            _id(id),
+            _count(count)
+        {
+        }
+
+        virtual ~MessageRingProducer() override
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            // Wait for free space when the ring is full, no message is lost.
+            for (int i = 0; i < _count; ++i) {
+                TSUNIT_ASSERT(_ring.enqueue((_id << 16) | i, ts::Infinite));
+            }
+        }
+    };
+}
+
+void MessageQueueTest::testRingProducers()
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int COUNT = 5000;
+
+    TestRing ring(16);
+    std::vector<int> next(PRODUCERS, 0);
+    std::vector<ts::SafePtr<MessageRingProducer>> threads;
+
+    for (int id = 0; id < PRODUCERS; ++id) {
+        threads.push_back(new MessageRingProducer(ring, id, COUNT));
+        TSUNIT_ASSERT(threads.back()->start());
+    }
+
+    // Messages from each producer must be received in order.
+    int msg = 0;
+    for (int i = 0; i < PRODUCERS * COUNT; ++i) {
+        TSUNIT_ASSERT(ring.dequeue(msg, 10000));
+        const int id = msg >> 16;
+        TSUNIT_ASSERT(id >= 0 && id < PRODUCERS);
+        TSUNIT_EQUAL(next[id], msg & 0xFFFF);
+        next[id]++;
+    }
+    TSUNIT_ASSERT(!ring.dequeue(msg, 0));
+    TSUNIT_EQUAL(0, ring.overflowCount());
+}
+
+void MessageQueueTest::testRingInPlace()
+{
+    ts::MessageRing<ts::UString> ring(2);
+    TSUNIT_EQUAL(2, ring.capacity());
+
+    // The consumer message has a large buffer, it is recycled in the ring when a message is received.
+    ts::UString msg;
+    msg.reserve(1000);
+    size_t capacity = 0;
+    const auto fill = [&capacity](ts::UString& slot) { capacity = slot.capacity(); slot.assign(u"foo"); };
+
+    TSUNIT_ASSERT(ring.enqueueInPlace(fill));
+    TSUNIT_ASSERT(capacity < 1000);
+    TSUNIT_ASSERT(ring.dequeue(msg, 0));
+    TSUNIT_EQUAL(u"foo", msg);
+
+    TSUNIT_ASSERT(ring.enqueueInPlace(fill));
+    TSUNIT_ASSERT(capacity < 1000);
+    TSUNIT_ASSERT(ring.enqueueInPlace(fill));
+    TSUNIT_ASSERT(capacity >= 1000);
+    TSUNIT_ASSERT(!ring.enqueueInPlace(fill));
+    TSUNIT_EQUAL(1, ring.overflowCount());
+
+    TSUNIT_ASSERT(ring.dequeue(msg, 0));
+    TSUNIT_EQUAL(u"foo", msg);
+    TSUNIT_ASSERT(ring.dequeue(msg, 0));
+    TSUNIT_EQUAL(u"foo", msg);
+    TSUNIT_ASSERT(msg.capacity() >= 1000);
+    TSUNIT_ASSERT(!ring.dequeue(msg, 0));
+}
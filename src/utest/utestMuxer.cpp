@@ -0,0 +1,255 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::Muxer (tsmux engine)
+//
+//----------------------------------------------------------------------------
+
+#include "tsMuxer.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsAsyncReport.h"
+#include "tsSysUtils.h"
+#include "tsEnvironment.h"
+#include "tsTime.h"
+#include "utestTSUnitBenchmark.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MuxerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testConsecutivePCR();
+    void testBenchmark();
+
+    TSUNIT_TEST_BEGIN(MuxerTest);
+    TSUNIT_TEST(testConsecutivePCR);
+    TSUNIT_TEST(testBenchmark);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(MuxerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void MuxerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void MuxerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Synthetic input streams and output collection.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Event handler for a memory input plugin: synthetic stream on one PID.
+    // The packet index is stored in the last 4 bytes of each packet.
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        // PCR every pcr_interval packets, PCR values are computed at the specified bitrate.
+        Input(ts::PID pid, size_t count, size_t pcr_interval, const ts::BitRate& bitrate) :
+            _pid(pid), _count(count), _pcr_interval(pcr_interval), _bitrate(bitrate) {}
+
+        // PCR value of a packet index.
+        uint64_t pcr(size_t index) const { return ((ts::BitRate(index) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / _bitrate).toInt(); }
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            while (data != nullptr && _next < _count && data->remainingSize() >= ts::PKT_SIZE) {
+                ts::TSPacket pkt;
+                pkt.init(_pid, uint8_t(_next & ts::CC_MASK), 0xFF);
+                if (_next % _pcr_interval == 0) {
+                    pkt.setPCR(pcr(_next), true);
+                }
+                ts::PutUInt32(pkt.b + ts::PKT_SIZE - 4, uint32_t(_next));
+                data->append(pkt.b, ts::PKT_SIZE);
+                _next++;
+            }
+        }
+
+    private:
+        const ts::PID     _pid;
+        const size_t      _count;
+        const size_t      _pcr_interval;
+        const ts::BitRate _bitrate;
+        size_t            _next = 0;
+    };
+
+    // Event handler for a memory output plugin: fill a vector of packets.
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& output) : _output(output) {}
+
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override
+        {
+            ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+            if (data != nullptr) {
+                const size_t count = data->size() / ts::PKT_SIZE;
+                const size_t index = _output.size();
+                _output.resize(index + count);
+                ts::TSPacket::Copy(&_output[index], data->data(), count);
+            }
+        }
+
+    private:
+        ts::TSPacketVector& _output;
+    };
+
+    // Multiplex synthetic inputs (PID 0x100 + index) using memory plugins.
+    void Mux(std::vector<ts::SafePtr<Input>>& inputs, const ts::BitRate& bitrate, ts::TSPacketVector& output)
+    {
+        ts::MuxerArgs args;
+        args.appName = u"MuxerTest";
+        args.outputBitRate = bitrate;
+        args.inputOnce = args.outputOnce = true;
+        args.output = {u"memory", {}};
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            args.inputs.push_back({u"memory", {}});
+        }
+
+        ts::AsyncReport report(tsunit::Test::debugMode() ? ts::Severity::Verbose : ts::Severity::Info);
+        ts::Muxer mux(report);
+        Output out(output);
+        mux.registerEventHandler(&out, ts::PluginType::OUTPUT);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            ts::PluginEventHandlerRegistry::Criteria crit(ts::PluginType::INPUT);
+            crit.plugin_index = i;
+            mux.registerEventHandler(inputs[i].pointer(), crit);
+        }
+        TSUNIT_ASSERT(mux.start(args));
+        mux.waitForTermination();
+    }
+
+    // Check the multiplexed packets of each input and compute the PCR jitter in PCR units.
+    // The jitter is the difference between the PCR intervals in input and output.
+    void CheckOutput(const std::vector<ts::SafePtr<Input>>& inputs, const ts::BitRate& bitrate, const ts::TSPacketVector& output,
+                     size_t& pcr_count, uint64_t& pcr_jitter, uint64_t& max_jitter)
+    {
+        pcr_count = 0;
+        pcr_jitter = max_jitter = 0;
+        std::vector<size_t> next(inputs.size(), 0);
+        std::vector<size_t> last_pcr_input(inputs.size(), ts::NPOS);
+        std::vector<size_t> last_pcr_output(inputs.size(), ts::NPOS);
+        for (size_t out = 0; out < output.size(); ++out) {
+            const ts::TSPacket& pkt(output[out]);
+            const size_t i = pkt.getPID() - 0x100;
+            if (i < inputs.size()) {
+                // All packets from an input are present, in order.
+                const size_t index = ts::GetUInt32(pkt.b + ts::PKT_SIZE - 4);
+                TSUNIT_EQUAL(next[i], index);
+                next[i]++;
+                if (pkt.hasPCR()) {
+                    if (last_pcr_input[i] != ts::NPOS) {
+                        const uint64_t in = inputs[i]->pcr(index) - inputs[i]->pcr(last_pcr_input[i]);
+                        const uint64_t out_pcr = ((ts::BitRate(out - last_pcr_output[i]) * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / bitrate).toInt();
+                        const uint64_t jitter = in > out_pcr ? in - out_pcr : out_pcr - in;
+                        pcr_count++;
+                        pcr_jitter += jitter;
+                        max_jitter = std::max(max_jitter, jitter);
+                    }
+                    last_pcr_input[i] = index;
+                    last_pcr_output[i] = out;
+                }
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// Consecutive PCR packets on the same PID: the next PCR packet is scheduled
+// after the position of the previous one in the output stream.
+void MuxerTest::testConsecutivePCR()
+{
+    const ts::BitRate input_bitrate = 2000000;
+    const ts::BitRate output_bitrate = 10000000;
+
+    std::vector<ts::SafePtr<Input>> inputs;
+    inputs.push_back(new Input(0x100, 200, 1, input_bitrate));
+
+    ts::TSPacketVector output;
+    Mux(inputs, output_bitrate, output);
+
+    size_t pcr_count = 0;
+    uint64_t pcr_jitter = 0;
+    uint64_t max_jitter = 0;
+    CheckOutput(inputs, output_bitrate, output, pcr_count, pcr_jitter, max_jitter);
+    debug() << "MuxerTest::testConsecutivePCR: output packets: " << output.size() << ", PCR intervals: " << pcr_count
+            << ", max jitter: " << max_jitter << std::endl;
+    TSUNIT_ASSERT(pcr_count > 0);
+}
+
+// Benchmark: N synthetic inputs, report the PCR jitter and the CPU throughput.
+// The number of inputs is defined by TSUNIT_MUX_INPUTS, the number of packets per input by TSUNIT_MUX_ITERATIONS.
+void MuxerTest::testBenchmark()
+{
+    utest::TSUnitBenchmark bench(u"TSUNIT_MUX_ITERATIONS");
+    size_t input_count = 0;
+    if (!ts::GetEnvironment(u"TSUNIT_MUX_INPUTS").toInteger(input_count) || input_count == 0) {
+        input_count = 8;
+    }
+    const size_t packet_count = 500 * bench.iterations;
+
+    // Each input is 4 Mb/s with a PCR every 10 packets, with enough free space in output.
+    const ts::BitRate input_bitrate = 4000000;
+    const ts::BitRate output_bitrate = input_bitrate * int(input_count) * 3 / 2;
+
+    std::vector<ts::SafePtr<Input>> inputs;
+    for (size_t i = 0; i < input_count; ++i) {
+        inputs.push_back(new Input(ts::PID(0x100 + i), packet_count, 10, input_bitrate));
+    }
+
+    ts::TSPacketVector output;
+    const ts::Time start(ts::Time::CurrentUTC());
+    const ts::MilliSecond cpu_start = ts::GetProcessCpuTime();
+    bench.start();
+    Mux(inputs, output_bitrate, output);
+    bench.stop();
+    const ts::MilliSecond cpu = ts::GetProcessCpuTime() - cpu_start;
+    const ts::MilliSecond duration = ts::Time::CurrentUTC() - start;
+
+    size_t pcr_count = 0;
+    uint64_t pcr_jitter = 0;
+    uint64_t max_jitter = 0;
+    CheckOutput(inputs, output_bitrate, output, pcr_count, pcr_jitter, max_jitter);
+    TSUNIT_ASSERT(pcr_count > 0);
+
+    const auto to_us = [](uint64_t pcr) { return (pcr * ts::MicroSecPerSec) / ts::SYSTEM_CLOCK_FREQ; };
+    debug() << ts::UString::Format(u"MuxerTest::testBenchmark: %d inputs, %'d output packets in %'d ms, %'d ms CPU (%'d packets/CPU-second)",
+                                   {input_count, output.size(), duration, cpu, cpu == 0 ? 0 : (output.size() * ts::MilliSecPerSec) / cpu})
+            << std::endl
+            << ts::UString::Format(u"MuxerTest::testBenchmark: PCR jitter: average %'d us, max %'d us",
+                                   {to_us(pcr_jitter / pcr_count), to_us(max_jitter)})
+            << std::endl;
+    bench.report(u"MuxerTest::testBenchmark");
+}
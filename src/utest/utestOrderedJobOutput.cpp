@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::OrderedJobOutput.
+//
+//----------------------------------------------------------------------------
+
+#include "tsOrderedJobOutput.h"
+#include "tsReportBuffer.h"
+#include "utestTSUnitThread.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class OrderedJobOutputTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testOutOfOrder();
+    void testParallelJobs();
+
+    TSUNIT_TEST_BEGIN(OrderedJobOutputTest);
+    TSUNIT_TEST(testOutOfOrder);
+    TSUNIT_TEST(testParallelJobs);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(OrderedJobOutputTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void OrderedJobOutputTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void OrderedJobOutputTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Complete a fake job: one log message and one line of output.
+    void CompleteJob(ts::OrderedJobOutput& out, size_t index)
+    {
+        ts::OrderedJobOutput::MessageList messages;
+        messages.push_back(std::make_pair(ts::Severity::Info, ts::UString::Format(u"log %d", {index})));
+        out.jobCompleted(index, messages, ts::UString::Format(u"out %d\n", {index}).toUTF8());
+        TSUNIT_ASSERT(messages.empty());
+    }
+
+    // Expected log and output of jobs 0 to count-1.
+    ts::UString ExpectedLog(size_t count)
+    {
+        ts::UStringList lines;
+        for (size_t i = 0; i < count; ++i) {
+            lines.push_back(ts::UString::Format(u"log %d", {i}));
+        }
+        return ts::UString::Join(lines, u"\n");
+    }
+
+    std::string ExpectedOutput(size_t count)
+    {
+        std::string str;
+        for (size_t i = 0; i < count; ++i) {
+            str.append(ts::UString::Format(u"out %d\n", {i}).toUTF8());
+        }
+        return str;
+    }
+}
+
+void OrderedJobOutputTest::testOutOfOrder()
+{
+    ts::ReportBuffer<> log;
+    std::ostringstream strm;
+    ts::OrderedJobOutput out(log, strm);
+
+    // Jobs 2 and 1 complete before job 0, nothing is displayed.
+    CompleteJob(out, 2);
+    CompleteJob(out, 1);
+    TSUNIT_EQUAL(0, out.nextOutput());
+    TSUNIT_ASSERT(log.empty());
+    TSUNIT_EQUAL("", strm.str());
+
+    // Job 0 completes, jobs 0, 1, 2 are displayed in order.
+    CompleteJob(out, 0);
+    TSUNIT_EQUAL(3, out.nextOutput());
+    TSUNIT_EQUAL(ExpectedLog(3), log.messages());
+    TSUNIT_EQUAL(ExpectedOutput(3), strm.str());
+
+    // Job 4 waits for job 3.
+    CompleteJob(out, 4);
+    TSUNIT_EQUAL(3, out.nextOutput());
+    TSUNIT_EQUAL(ExpectedOutput(3), strm.str());
+    CompleteJob(out, 3);
+    TSUNIT_EQUAL(5, out.nextOutput());
+    TSUNIT_EQUAL(ExpectedLog(5), log.messages());
+    TSUNIT_EQUAL(ExpectedOutput(5), strm.str());
+
+    // After reset, pending jobs are dropped and the numbering restarts at zero.
+    CompleteJob(out, 1);
+    out.reset();
+    TSUNIT_EQUAL(0, out.nextOutput());
+    log.clear();
+    strm.str(std::string());
+    CompleteJob(out, 0);
+    TSUNIT_EQUAL(1, out.nextOutput());
+    TSUNIT_EQUAL(ExpectedLog(1), log.messages());
+    TSUNIT_EQUAL(ExpectedOutput(1), strm.str());
+}
+
+namespace {
+    // Fake parallel jobs: each thread takes the next job index and completes it after a
+    // delay which depends on the job, so that the jobs complete out of order.
+    class JobThread: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(JobThread);
+    public:
+        JobThread(ts::OrderedJobOutput& out, std::atomic<size_t>& next_job, size_t job_count) :
+            utest::TSUnitThread(),
+            _out(out),
+            _next_job(next_job),
+            _job_count(job_count)
+        {
+        }
+
+        virtual ~JobThread() override
+        {
+            waitForTermination();
+        }
+
+        virtual void test() override
+        {
+            for (size_t index = _next_job++; index < _job_count; index = _next_job++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(((_job_count - index) * 7) % 11));
+                CompleteJob(_out, index);
+            }
+        }
+
+    private:
+        ts::OrderedJobOutput& _out;
+        std::atomic<size_t>&  _next_job;
+        const size_t          _job_count;
+    };
+}
+
+void OrderedJobOutputTest::testParallelJobs()
+{
+    constexpr size_t job_count = 40;
+    ts::ReportBuffer<> log;
+    std::ostringstream strm;
+    ts::OrderedJobOutput out(log, strm);
+    std::atomic<size_t> next_job {0};
+    {
+        JobThread t1(out, next_job, job_count);
+        JobThread t2(out, next_job, job_count);
+        JobThread t3(out, next_job, job_count);
+        JobThread t4(out, next_job, job_count);
+        t1.start();
+        t2.start();
+        t3.start();
+        t4.start();
+    }
+    TSUNIT_EQUAL(job_count, out.nextOutput());
+    TSUNIT_EQUAL(ExpectedLog(job_count), log.messages());
+    TSUNIT_EQUAL(ExpectedOutput(job_count), strm.str());
+}
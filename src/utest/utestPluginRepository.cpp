@@ -11,6 +11,11 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsApplicationSharedLibrary.h"
+#include "tsFileUtils.h"
+#include "tsEnvironment.h"
+#include "tsSysUtils.h"
+#include "tsVersionInfo.h"
 #include "tsNullReport.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
@@ -29,12 +34,19 @@ public:
     void testRegistrations();
     void testEmbedded();
     void testLoaded();
+    void testList();
+    void testIndex();
 
     TSUNIT_TEST_BEGIN(PluginRepositoryTest);
     TSUNIT_TEST(testRegistrations);
     TSUNIT_TEST(testEmbedded);
     TSUNIT_TEST(testLoaded);
+    TSUNIT_TEST(testList);
+    TSUNIT_TEST(testIndex);
     TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempDir {};
 };
 
 TSUNIT_REGISTER(PluginRepositoryTest);
@@ -47,11 +59,16 @@ TSUNIT_REGISTER(PluginRepositoryTest);
 // Test suite initialization method.
 void PluginRepositoryTest::beforeTest()
 {
+    if (_tempDir.empty()) {
+        _tempDir = ts::TempFile(u"");
+    }
+    fs::remove_all(_tempDir, &ts::ErrCodeReport());
 }
 
 // Test suite cleanup method.
 void PluginRepositoryTest::afterTest()
 {
+    fs::remove_all(_tempDir, &ts::ErrCodeReport());
 }
 
 
@@ -111,3 +128,127 @@ void PluginRepositoryTest::testLoaded()
     TSUNIT_ASSERT(repo.getOutput(u"merge", report) == nullptr);
     TSUNIT_ASSERT(repo.getProcessor(u"merge", report) != nullptr);
 }
+
+void PluginRepositoryTest::testList()
+{
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    ts::PluginRepository& repo(ts::PluginRepository::Instance());
+
+    ts::UStringVector names;
+    repo.listPlugins(false, report, ts::PluginRepository::LIST_OUTPUT | ts::PluginRepository::LIST_NAMES).split(names, u'\n', true, true);
+    debug() << "PluginRepositoryTest::testList: output names: " << ts::UString::Join(names) << std::endl;
+    TSUNIT_ASSERT(names.size() >= repo.outputCount());
+    TSUNIT_ASSERT(ts::UString(u"drop").isContainedSimilarIn(names));
+    TSUNIT_ASSERT(ts::UString(u"file").isContainedSimilarIn(names));
+
+    ts::UStringVector lines;
+    repo.listPlugins(false, report, ts::PluginRepository::LIST_INPUT | ts::PluginRepository::LIST_COMPACT).split(lines, u'\n', true, true);
+    TSUNIT_ASSERT(lines.size() >= repo.inputCount());
+    for (const auto& line : lines) {
+        // Compact format is "name:description", with a non-empty description.
+        const size_t colon = line.find(u':');
+        TSUNIT_ASSERT(colon != ts::NPOS);
+        TSUNIT_ASSERT(colon > 0);
+        TSUNIT_ASSERT(colon + 1 < line.length());
+    }
+}
+
+void PluginRepositoryTest::testIndex()
+{
+    ts::Report& report(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    ts::PluginRepository& repo(ts::PluginRepository::Instance());
+
+    // Locate a plugin shared library which is not loaded by other tests.
+    const ts::UString lib_name(ts::UString(u"tsplugin_aes") + ts::SHARED_LIBRARY_SUFFIX);
+    ts::UString lib_file;
+    ts::UStringList dirs;
+    ts::ApplicationSharedLibrary::GetSearchPath(dirs, ts::PLUGINS_PATH_ENVIRONMENT_VARIABLE);
+    for (const auto& dir : dirs) {
+        if (lib_file.empty() && fs::exists(dir + fs::path::preferred_separator + lib_name)) {
+            lib_file = dir + fs::path::preferred_separator + lib_name;
+        }
+    }
+    if (lib_file.empty()) {
+        debug() << "PluginRepositoryTest::testIndex: " << lib_name << " not found, skipped" << std::endl;
+        return;
+    }
+
+    // A private directory of plugins, first in the search path, and a private directory of index files.
+    const ts::UString plugin_dir(_tempDir + fs::path::preferred_separator + u"plugins");
+    const ts::UString plugin_file(plugin_dir + fs::path::preferred_separator + lib_name);
+    const ts::UString index_dir(_tempDir + fs::path::preferred_separator + u"cache");
+    TSUNIT_ASSERT(fs::create_directories(plugin_dir));
+    TSUNIT_ASSERT(fs::copy_file(lib_file, plugin_file));
+    const ts::UString previous_path(ts::GetEnvironment(ts::PLUGINS_PATH_ENVIRONMENT_VARIABLE));
+    ts::SetEnvironment(ts::PLUGINS_PATH_ENVIRONMENT_VARIABLE, plugin_dir);
+    repo.setIndexDirectory(index_dir);
+
+    const ts::UString index_file(repo.indexFileName(plugin_dir));
+    debug() << "PluginRepositoryTest::testIndex: index file: " << index_file << std::endl;
+    TSUNIT_EQUAL(index_dir, ts::DirectoryName(index_file));
+    TSUNIT_ASSERT(!fs::exists(index_file));
+    TSUNIT_ASSERT(repo.indexFileName(plugin_dir) != repo.indexFileName(index_dir));
+
+    // Index creation: listing all plugins loads the shared library and creates the index.
+    ts::UString list(repo.listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_NAMES));
+    TSUNIT_ASSERT(list.contain(u"aes\n"));
+    TSUNIT_ASSERT(fs::exists(index_file));
+    ts::UStringVector lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, index_file));
+    TSUNIT_ASSERT(lines.size() >= 4);
+    TSUNIT_EQUAL(u"# TSDuck plugin index " + ts::VersionInfo::GetVersion(), lines[0]);
+    TSUNIT_EQUAL(u"# directory " + plugin_dir, lines[1]);
+    TSUNIT_EQUAL(u"library\t" + lib_name, lines[2]);
+    TSUNIT_ASSERT(lines[3].startWith(u"packet\taes\t" + lib_name + u"\t"));
+
+    // Validation: a valid index is used and not rewritten. The file modification times have a
+    // one-second resolution, move the index back in time to detect a rewrite.
+    const auto now(fs::file_time_type::clock::now());
+    fs::last_write_time(plugin_dir, now - std::chrono::seconds(20));
+    fs::last_write_time(plugin_file, now - std::chrono::seconds(20));
+    fs::last_write_time(index_file, now - std::chrono::seconds(10));
+    const ts::Time index_time(ts::GetFileModificationTimeUTC(index_file));
+    repo.setIndexDirectory(index_dir);
+    list = repo.listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_NAMES);
+    TSUNIT_ASSERT(list.contain(u"aes\n"));
+    TSUNIT_ASSERT(ts::GetFileModificationTimeUTC(index_file) == index_time);
+
+    // Stale detection: a shared library which is more recent than the index invalidates it.
+    fs::last_write_time(plugin_file, fs::file_time_type::clock::now());
+    repo.setIndexDirectory(index_dir);
+    list = repo.listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_NAMES);
+    TSUNIT_ASSERT(list.contain(u"aes\n"));
+    TSUNIT_ASSERT(ts::GetFileModificationTimeUTC(index_file) > index_time);
+
+    // Loading: the plugin descriptions come from a valid index.
+    ts::SleepThread(20);
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({
+        lines[0], lines[1], lines[2],
+        u"packet\tutestfake\t" + lib_name + u"\tFake plugin from index"
+    }), index_file));
+    repo.setIndexDirectory(index_dir);
+    list = repo.listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_COMPACT);
+    TSUNIT_ASSERT(list.contain(u"utestfake:Fake plugin from index\n"));
+
+    // An index from another version is ignored and rebuilt.
+    ts::SleepThread(20);
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringVector({
+        u"# TSDuck plugin index 0.0-0", lines[1], lines[2],
+        u"packet\tutestfake\t" + lib_name + u"\tFake plugin from index"
+    }), index_file));
+    repo.setIndexDirectory(index_dir);
+    list = repo.listPlugins(true, report, ts::PluginRepository::LIST_PACKET | ts::PluginRepository::LIST_COMPACT);
+    TSUNIT_ASSERT(!list.contain(u"utestfake"));
+    TSUNIT_ASSERT(ts::UString::Load(lines, index_file));
+    TSUNIT_ASSERT(!lines.empty());
+    TSUNIT_EQUAL(u"# TSDuck plugin index " + ts::VersionInfo::GetVersion(), lines[0]);
+
+    // Restore the default environment.
+    if (previous_path.empty()) {
+        ts::DeleteEnvironment(ts::PLUGINS_PATH_ENVIRONMENT_VARIABLE);
+    }
+    else {
+        ts::SetEnvironment(ts::PLUGINS_PATH_ENVIRONMENT_VARIABLE, previous_path);
+    }
+    repo.setIndexDirectory(ts::UString());
+}
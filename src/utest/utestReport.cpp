@@ -14,6 +14,7 @@
 #include "tsReportFile.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
+#include "utestTSUnitBenchmark.h"
 #include "tsunit.h"
 
 
@@ -33,6 +34,9 @@ public:
     void testByName();
     void testByStream();
     void testErrCodeReport();
+    void testVariadic();
+    void testTrace();
+    void testDroppedMessages();
 
     TSUNIT_TEST_BEGIN(ReportTest);
     TSUNIT_TEST(testSeverity);
@@ -41,6 +45,9 @@ public:
     TSUNIT_TEST(testByName);
     TSUNIT_TEST(testByStream);
     TSUNIT_TEST(testErrCodeReport);
+    TSUNIT_TEST(testVariadic);
+    TSUNIT_TEST(testTrace);
+    TSUNIT_TEST(testDroppedMessages);
     TSUNIT_TEST_END();
 
 private:
@@ -323,3 +330,77 @@ void ReportTest::testErrCodeReport()
     TSUNIT_ASSERT(!log.empty());
     TSUNIT_ASSERT(log.messages().startWith(u"Error: isdir " + nodir + u":"));
 }
+
+// Test case: printf-like interface without initializer list.
+void ReportTest::testVariadic()
+{
+    ts::ReportBuffer<> log(ts::Severity::Debug);
+    const ts::UString str(u"abc");
+
+    log.log(ts::Severity::Info, u"info %d %s", 1, str);
+    log.debug(u"debug %d-%d", 2, 3);
+    log.warning(ts::UString(u"warning %s"), u"def");
+    log.error(u"error 0x%X", 0x1234);
+    log.log(2, u"dropped %d", 4);
+    log.info(u"100%");
+    TSUNIT_EQUAL(u"info 1 abc\n"
+                 u"Debug: debug 2-3\n"
+                 u"Warning: warning def\n"
+                 u"Error: error 0x00001234\n"
+                 u"100%",
+                 log.messages());
+}
+
+// Test case: traces with compile-time debug levels.
+void ReportTest::testTrace()
+{
+    ts::ReportBuffer<> log(2);
+
+    log.trace<1>(u"trace %d", 1);
+    log.trace<2>(u"trace %d %s", 2, u"two");
+    log.trace<3>(u"trace %d", 3);
+    log.trace<2>(u"trace 2%%");
+    TSUNIT_EQUAL(u"Debug: trace 1\n"
+                 u"Debug[2]: trace 2 two\n"
+                 u"Debug[2]: trace 2%",
+                 log.messages());
+}
+
+// Test case: cost of messages which are dropped because of their severity.
+void ReportTest::testDroppedMessages()
+{
+    // Support for benchmarking.
+    utest::TSUnitBenchmark bench1(u"TSUNIT_REPORT_ITERATIONS");
+    utest::TSUnitBenchmark bench2(u"TSUNIT_REPORT_ITERATIONS");
+    utest::TSUnitBenchmark bench3(u"TSUNIT_REPORT_ITERATIONS");
+
+    ts::ReportBuffer<> log(ts::Severity::Info);
+    const ts::UString str(u"abc");
+
+    // Initializer list: arguments are built before checking the severity.
+    bench1.start();
+    for (size_t i = 0; i < bench1.iterations; ++i) {
+        log.debug(u"packet %d, name %s, flag %s", {i, str, true});
+    }
+    bench1.stop();
+
+    // Variadic arguments: the severity is checked first.
+    bench2.start();
+    for (size_t i = 0; i < bench2.iterations; ++i) {
+        log.debug(u"packet %d, name %s, flag %s", i, str, true);
+    }
+    bench2.stop();
+
+    // Traces: compiled out or checked first.
+    bench3.start();
+    for (size_t i = 0; i < bench3.iterations; ++i) {
+        log.trace<10>(u"packet %d, name %s, flag %s", i, str, true);
+    }
+    bench3.stop();
+
+    bench1.report(u"ReportTest::testDroppedMessages, initializer list");
+    bench2.report(u"ReportTest::testDroppedMessages, variadic");
+    bench3.report(u"ReportTest::testDroppedMessages, trace");
+
+    TSUNIT_ASSERT(log.empty());
+}
@@ -21,12 +21,23 @@
 #include "tsxmlElement.h"
 #include "tsDuckContext.h"
 #include "tsCerrReport.h"
+#include "tsPSIRepository.h"
+#include "tsTablePatchXML.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_pat1_xml.h"
 #include "tables/psi_pat1_sections.h"
 #include "tables/psi_pmt_scte35_xml.h"
 #include "tables/psi_pmt_scte35_sections.h"
+#include "tables/psi_bat_cplus_sections.h"
+#include "tables/psi_bat_tvnum_sections.h"
+#include "tables/psi_cat_r3_sections.h"
+#include "tables/psi_nit_tntv23_sections.h"
+#include "tables/psi_pmt_hevc_sections.h"
+#include "tables/psi_pmt_planete_sections.h"
+#include "tables/psi_sdt_r3_sections.h"
+#include "tables/psi_tot_tnt_sections.h"
 
 
 //----------------------------------------------------------------------------
@@ -50,6 +61,8 @@ public:
     void testMultiSectionsCAT();
     void testMultiSectionsAtProgramLevelPMT();
     void testMultiSectionsAtStreamLevelPMT();
+    void testDeserializeBenchmark();
+    void testPatchXML();
 
     TSUNIT_TEST_BEGIN(SectionFileTest);
     TSUNIT_TEST(testConfigurationFile);
@@ -63,6 +76,8 @@ public:
     TSUNIT_TEST(testMultiSectionsCAT);
     TSUNIT_TEST(testMultiSectionsAtProgramLevelPMT);
     TSUNIT_TEST(testMultiSectionsAtStreamLevelPMT);
+    TSUNIT_TEST(testDeserializeBenchmark);
+    TSUNIT_TEST(testPatchXML);
     TSUNIT_TEST_END();
 
 private:
@@ -739,3 +754,106 @@ void SectionFileTest::testMemory()
     TSUNIT_EQUAL(0, std::memcmp(out2, psi_pat1_sections, sizeof(psi_pat1_sections)));
     TSUNIT_EQUAL(0, std::memcmp(out2 + 32, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
 }
+
+void SectionFileTest::testDeserializeBenchmark()
+{
+    // Corpus of real tables, deserialized in loop. Set TSUNIT_DESERIALIZE_ITERATIONS to run a benchmark.
+    struct Corpus {
+        const uint8_t* data;
+        size_t size;
+    };
+    static const Corpus corpus[] = {
+        {psi_pat1_sections, sizeof(psi_pat1_sections)},
+        {psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)},
+        {psi_pmt_hevc_sections, sizeof(psi_pmt_hevc_sections)},
+        {psi_pmt_planete_sections, sizeof(psi_pmt_planete_sections)},
+        {psi_cat_r3_sections, sizeof(psi_cat_r3_sections)},
+        {psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections)},
+        {psi_bat_cplus_sections, sizeof(psi_bat_cplus_sections)},
+        {psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections)},
+        {psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections)},
+        {psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections)},
+    };
+
+    ts::DuckContext duck;
+    ts::SectionFile file(duck);
+    for (const auto& c : corpus) {
+        TSUNIT_ASSERT(file.loadBuffer(c.data, c.size));
+    }
+    TSUNIT_EQUAL(10, file.tablesCount());
+
+    // Allocate one table object per binary table.
+    std::vector<ts::AbstractTablePtr> tables;
+    for (const auto& bin : file.tables()) {
+        const ts::PSIRepository::TableFactory fac = ts::PSIRepository::Instance().getTableFactory(bin->tableId(), duck.standards(), bin->sourcePID());
+        TSUNIT_ASSERT(fac != nullptr);
+        tables.push_back(fac());
+    }
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_DESERIALIZE_ITERATIONS");
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        for (size_t i = 0; i < tables.size(); ++i) {
+            tables[i]->deserialize(duck, *file.tables()[i]);
+        }
+    }
+    bench.stop();
+    bench.report(u"SectionFileTest::testDeserializeBenchmark");
+
+    for (const auto& table : tables) {
+        TSUNIT_ASSERT(table->isValid());
+    }
+}
+
+void SectionFileTest::testPatchXML()
+{
+    ts::DuckContext duck(&report());
+    ts::SectionFile file(duck);
+    TSUNIT_ASSERT(file.loadBuffer(psi_pat1_sections, sizeof(psi_pat1_sections)));
+    TSUNIT_ASSERT(file.loadBuffer(psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
+    TSUNIT_EQUAL(2, file.tablesCount());
+    const ts::BinaryTable& pat_ref(*file.tables()[0]);
+    const ts::BinaryTable& pmt_ref(*file.tables()[1]);
+
+    ts::TablePatchXML patch(duck);
+    patch.addPatchFileName(u"<?xml version='1.0' encoding='UTF-8'?><tsduck><PAT x-update-transport_stream_id='0x1234'/></tsduck>");
+    TSUNIT_ASSERT(patch.loadPatchFiles());
+    TSUNIT_EQUAL(0, patch.cacheSize());
+    patch.setCacheSize(16);
+
+    // Patch the PAT twice, the second time comes from the cache.
+    ts::BinaryTable pat1(pat_ref, ts::ShareMode::COPY);
+    TSUNIT_ASSERT(patch.applyPatches(pat1));
+    TSUNIT_ASSERT(pat1.isValid());
+    ts::PAT pat(duck, pat1);
+    TSUNIT_ASSERT(pat.isValid());
+    TSUNIT_EQUAL(0x1234, pat.ts_id);
+    TSUNIT_EQUAL(4, pat.pmts.size());
+
+    ts::BinaryTable pat2(pat_ref, ts::ShareMode::COPY);
+    TSUNIT_ASSERT(patch.applyPatches(pat2));
+    TSUNIT_ASSERT(pat2.isValid());
+    TSUNIT_ASSERT(pat1 == pat2);
+    TSUNIT_ASSERT(pat1.sectionAt(0) != pat2.sectionAt(0));
+
+    // The PMT cannot be modified by the patch, it is left unchanged.
+    ts::BinaryTable pmt1(pmt_ref, ts::ShareMode::SHARE);
+    TSUNIT_ASSERT(patch.applyPatches(pmt1));
+    TSUNIT_ASSERT(pmt1.sectionAt(0) == pmt_ref.sectionAt(0));
+
+    // Same results without cache.
+    patch.setCacheSize(0);
+    ts::BinaryTable pat3(pat_ref, ts::ShareMode::COPY);
+    TSUNIT_ASSERT(patch.applyPatches(pat3));
+    TSUNIT_ASSERT(pat1 == pat3);
+
+    // A patch which deletes the table.
+    ts::TablePatchXML del(duck);
+    del.addPatchFileName(u"<?xml version='1.0' encoding='UTF-8'?><tsduck><PAT x-node='delete'/></tsduck>");
+    TSUNIT_ASSERT(del.loadPatchFiles());
+    for (int i = 0; i < 2; ++i) {
+        ts::BinaryTable table(pat_ref, ts::ShareMode::COPY);
+        TSUNIT_ASSERT(del.applyPatches(table));
+        TSUNIT_ASSERT(!table.isValid());
+    }
+}
@@ -0,0 +1,246 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::T2MIDemux
+//
+//----------------------------------------------------------------------------
+
+#include "tsT2MIDemux.h"
+#include "tsT2MIHandlerInterface.h"
+#include "tsT2MIPacket.h"
+#include "tsDuckContext.h"
+#include "tsByteBlock.h"
+#include "tsCRC32.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class T2MIDemuxTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSplitPackets();
+    void testLostSync();
+
+    TSUNIT_TEST_BEGIN(T2MIDemuxTest);
+    TSUNIT_TEST(testSplitPackets);
+    TSUNIT_TEST(testLostSync);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(T2MIDemuxTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void T2MIDemuxTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void T2MIDemuxTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Build synthetic T2-MI streams.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    constexpr ts::PID T2MI_PID = 0x0100;
+
+    // TS packets to encapsulate in a PLP: PID 100 + plp, the packet index is in the payload.
+    ts::TSPacket SourcePacket(uint8_t plp, size_t index)
+    {
+        ts::TSPacket pkt;
+        pkt.init(ts::PID(100 + plp), uint8_t(index & ts::CC_MASK), uint8_t(index));
+        ts::PutUInt32(pkt.b + 4, uint32_t(index));
+        return pkt;
+    }
+
+    // Build the baseband frames of a PLP, one per data field size.
+    // The TS packets are encapsulated without sync byte (high efficiency mode).
+    void BuildFrames(std::vector<ts::ByteBlock>& frames, uint8_t plp, size_t packet_count, const std::vector<size_t>& sizes)
+    {
+        ts::ByteBlock stream;
+        for (size_t i = 0; i < packet_count; ++i) {
+            stream.append(SourcePacket(plp, i).b + 1, ts::PKT_SIZE - 1);
+        }
+        size_t offset = 0;
+        for (size_t i = 0; offset < stream.size(); ++i) {
+            const size_t dfl = std::min(sizes[i % sizes.size()], stream.size() - offset);
+            // Distance to the first packet start in the data field, in bits.
+            const size_t first = (offset + ts::PKT_SIZE - 2) / (ts::PKT_SIZE - 1) * (ts::PKT_SIZE - 1);
+            const uint16_t syncd = first < offset + dfl ? uint16_t(8 * (first - offset)) : 0xFFFF;
+            ts::ByteBlock frame(ts::T2_BBHEADER_SIZE, 0);
+            frame[0] = 0xF0;  // MATYPE-1: TS/GS = 11 (TS), SIS, CCM
+            ts::PutUInt16(frame.data() + 4, uint16_t(8 * dfl));
+            frame[6] = ts::SYNC_BYTE;
+            ts::PutUInt16(frame.data() + 7, syncd);
+            frame.append(stream.data() + offset, dfl);
+            frames.push_back(frame);
+            offset += dfl;
+        }
+    }
+
+    // Append a baseband frame T2-MI packet to a T2-MI stream.
+    void AppendT2MI(ts::ByteBlock& t2mi, std::vector<size_t>& starts, uint8_t plp, const ts::ByteBlock& frame)
+    {
+        starts.push_back(t2mi.size());
+        const size_t start = t2mi.size();
+        const size_t payload_size = 3 + frame.size();
+        t2mi.appendUInt8(uint8_t(ts::T2MIPacketType::BASEBAND_FRAME));
+        t2mi.appendUInt8(uint8_t(starts.size()));  // packet count
+        t2mi.appendUInt16(0);                      // superframe index, rfu
+        t2mi.appendUInt16(uint16_t(8 * payload_size));
+        t2mi.appendUInt8(0);                       // frame index
+        t2mi.appendUInt8(plp);
+        t2mi.appendUInt8(0);                       // intl_frame_start, rfu
+        t2mi.append(frame);
+        t2mi.appendUInt32(ts::CRC32(t2mi.data() + start, t2mi.size() - start).value());
+    }
+
+    // Packetize a T2-MI stream in TS packets. The pointer field of each PUSI packet
+    // points to the first T2-MI packet starting in the TS packet.
+    void Packetize(ts::TSPacketVector& packets, const ts::ByteBlock& t2mi, const std::vector<size_t>& starts)
+    {
+        size_t offset = 0;
+        size_t next = 0;
+        uint8_t cc = 0;
+        while (offset < t2mi.size()) {
+            ts::TSPacket pkt;
+            pkt.init(T2MI_PID, cc, 0xFF);
+            cc = (cc + 1) & ts::CC_MASK;
+            while (next < starts.size() && starts[next] < offset) {
+                next++;
+            }
+            size_t size = ts::PKT_SIZE - 4;
+            uint8_t* data = pkt.b + 4;
+            if (next < starts.size() && starts[next] < offset + size - 1) {
+                pkt.setPUSI(true);
+                *data++ = uint8_t(starts[next] - offset);
+                size--;
+            }
+            size = std::min(size, t2mi.size() - offset);
+            std::memcpy(data, t2mi.data() + offset, size);
+            offset += size;
+            packets.push_back(pkt);
+        }
+    }
+
+    // Build a T2-MI stream with two PLP's and frames which split TS packets.
+    // PLP 1 has small frames, without packet start (syncd = 0xFFFF).
+    void BuildStream(ts::TSPacketVector& packets, size_t packet_count)
+    {
+        std::vector<ts::ByteBlock> frames0;
+        std::vector<ts::ByteBlock> frames1;
+        BuildFrames(frames0, 0, packet_count, {400, 1000, 187, 250});
+        BuildFrames(frames1, 1, packet_count, {100, 60, 27, 500});
+
+        ts::ByteBlock t2mi;
+        std::vector<size_t> starts;
+        for (size_t i = 0; i < frames0.size() || i < frames1.size(); ++i) {
+            if (i < frames0.size()) {
+                AppendT2MI(t2mi, starts, 0, frames0[i]);
+            }
+            if (i < frames1.size()) {
+                AppendT2MI(t2mi, starts, 1, frames1[i]);
+            }
+        }
+        Packetize(packets, t2mi, starts);
+    }
+
+    // Collect the demuxed TS packets.
+    class Collector : public ts::T2MIHandlerInterface
+    {
+    public:
+        size_t t2mi_count = 0;
+        std::map<uint8_t, ts::TSPacketVector> packets {};
+
+        virtual void handleT2MINewPID(ts::T2MIDemux&, const ts::PMT&, ts::PID, const ts::T2MIDescriptor&) override {}
+        virtual void handleT2MIPacket(ts::T2MIDemux&, const ts::T2MIPacket&) override { t2mi_count++; }
+        virtual void handleTSPacket(ts::T2MIDemux&, const ts::T2MIPacket& t2mi, const ts::TSPacket& ts) override
+        {
+            packets[t2mi.plp()].push_back(ts);
+        }
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void T2MIDemuxTest::testSplitPackets()
+{
+    ts::TSPacketVector input;
+    BuildStream(input, 50);
+    debug() << "T2MIDemuxTest::testSplitPackets: " << input.size() << " TS packets" << std::endl;
+
+    ts::DuckContext duck;
+    Collector collector;
+    ts::T2MIDemux demux(duck, &collector);
+    demux.addPID(T2MI_PID);
+    for (const auto& pkt : input) {
+        demux.feedPacket(pkt);
+    }
+
+    TSUNIT_ASSERT(collector.t2mi_count > 0);
+    TSUNIT_EQUAL(2, collector.packets.size());
+    for (uint8_t plp = 0; plp < 2; ++plp) {
+        const ts::TSPacketVector& pkts(collector.packets[plp]);
+        TSUNIT_EQUAL(50, pkts.size());
+        for (size_t i = 0; i < pkts.size(); ++i) {
+            TSUNIT_ASSERT(pkts[i] == SourcePacket(plp, i));
+        }
+    }
+}
+
+void T2MIDemuxTest::testLostSync()
+{
+    ts::TSPacketVector input;
+    BuildStream(input, 100);
+
+    // Drop a TS packet in the middle of the T2-MI stream.
+    input.erase(input.begin() + input.size() / 2);
+
+    ts::DuckContext duck;
+    Collector collector;
+    ts::T2MIDemux demux(duck, &collector);
+    demux.addPID(T2MI_PID);
+    for (const auto& pkt : input) {
+        demux.feedPacket(pkt);
+    }
+
+    // Each PLP loses some packets. All demuxed packets are valid, in order, and the demux
+    // resynchronizes on the next T2-MI packet, up to the last packet of the stream.
+    for (uint8_t plp = 0; plp < 2; ++plp) {
+        const ts::TSPacketVector& pkts(collector.packets[plp]);
+        debug() << "T2MIDemuxTest::testLostSync: PLP " << int(plp) << ": " << pkts.size() << " TS packets" << std::endl;
+        TSUNIT_ASSERT(pkts.size() > 50);
+        TSUNIT_ASSERT(pkts.size() < 100);
+        size_t previous = 0;
+        for (size_t i = 0; i < pkts.size(); ++i) {
+            const size_t index = ts::GetUInt32(pkts[i].b + 4);
+            TSUNIT_ASSERT(i == 0 || index > previous);
+            TSUNIT_ASSERT(pkts[i] == SourcePacket(plp, index));
+            previous = index;
+        }
+        TSUNIT_EQUAL(99, previous);
+    }
+}
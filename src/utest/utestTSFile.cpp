@@ -11,6 +11,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSFile.h"
+#include "tsTSFileIndexer.h"
+#include "tsTSFileRegionComparator.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsCerrReport.h"
@@ -34,6 +36,9 @@ public:
     void testDuck();
     void testStuffingRead();
     void testStuffingWrite();
+    void testIndex();
+    void testCompact();
+    void testRegionComparator();
 
     TSUNIT_TEST_BEGIN(TSFileTest);
     TSUNIT_TEST(testTS);
@@ -41,10 +46,14 @@ public:
     TSUNIT_TEST(testDuck);
     TSUNIT_TEST(testStuffingRead);
     TSUNIT_TEST(testStuffingWrite);
+    TSUNIT_TEST(testIndex);
+    TSUNIT_TEST(testCompact);
+    TSUNIT_TEST(testRegionComparator);
     TSUNIT_TEST_END();
 
 private:
     fs::path _tempFileName {};
+    fs::path _tempFileName2 {};
 };
 
 TSUNIT_REGISTER(TSFileTest);
@@ -59,14 +68,19 @@ void TSFileTest::beforeTest()
 {
     if (_tempFileName.empty()) {
         _tempFileName = ts::TempFile(u".ts");
+        _tempFileName2 = ts::TempFile(u".ts");
     }
     fs::remove(_tempFileName, &ts::ErrCodeReport());
+    fs::remove(_tempFileName2, &ts::ErrCodeReport());
+    fs::remove(ts::TSFileIndex::IndexFileName(_tempFileName), &ts::ErrCodeReport());
 }
 
 // Test suite cleanup method.
 void TSFileTest::afterTest()
 {
     fs::remove(_tempFileName, &ts::ErrCodeReport());
+    fs::remove(_tempFileName2, &ts::ErrCodeReport());
+    fs::remove(ts::TSFileIndex::IndexFileName(_tempFileName), &ts::ErrCodeReport());
 }
 
 
@@ -366,3 +380,208 @@ void TSFileTest::testStuffingWrite()
     TSUNIT_EQUAL(184, packets[5].getPayloadSize());
     TSUNIT_EQUAL(0xFF, packets[5].getPayload()[0]);
 }
+
+void TSFileTest::testIndex()
+{
+    const fs::path index_name(ts::TSFileIndex::IndexFileName(_tempFileName));
+    const ts::Time base(2023, 6, 1, 12, 0, 0);
+    debug() << "TSFileTest::testIndex: index file: " << index_name << std::endl;
+
+    // 1000 packets, 10 ms each, a PCR every 10 packets.
+    ts::TSFileIndexer indexer;
+    TSUNIT_ASSERT(indexer.open(index_name, ts::PKT_SIZE, false, CERR));
+    TSUNIT_ASSERT(indexer.isOpen());
+    for (size_t i = 0; i < 1000; ++i) {
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(100);
+        if (i % 10 == 0) {
+            TSUNIT_ASSERT(pkt.setPCR(i * (ts::SYSTEM_CLOCK_FREQ / 100), true));
+        }
+        indexer.feedPacket(pkt, i, base + ts::MilliSecond(i * 10));
+    }
+    TSUNIT_EQUAL(10, indexer.entryCount());
+    indexer.close();
+    TSUNIT_EQUAL(ts::TSFileIndex::HEADER_SIZE + 10 * ts::TSFileIndex::ENTRY_SIZE, fs::file_size(index_name, &ts::ErrCodeReport(CERR)));
+
+    ts::TSFileIndex index;
+    TSUNIT_ASSERT(index.load(index_name, CERR));
+    TSUNIT_EQUAL(ts::PKT_SIZE, index.packetSize());
+    TSUNIT_EQUAL(10, index.entries().size());
+    TSUNIT_EQUAL(300, index.entries()[3].packet);
+    TSUNIT_EQUAL(3 * ts::SYSTEM_CLOCK_FREQ, index.entries()[3].pcr);
+    TSUNIT_EQUAL(ts::INVALID_PTS, index.entries()[3].pts);
+    TSUNIT_ASSERT(base + 3000 == index.entries()[3].utcTime());
+    TSUNIT_ASSERT(base == index.firstTime());
+
+    ts::TSFileIndex::Entry entry;
+    TSUNIT_ASSERT(index.searchPCR(0, entry));
+    TSUNIT_EQUAL(0, entry.packet);
+    TSUNIT_ASSERT(index.searchPCR(5 * ts::SYSTEM_CLOCK_FREQ + 1000, entry));
+    TSUNIT_EQUAL(500, entry.packet);
+    TSUNIT_ASSERT(index.searchPCR(100 * ts::SYSTEM_CLOCK_FREQ, entry));
+    TSUNIT_EQUAL(900, entry.packet);
+
+    TSUNIT_ASSERT(!index.searchTime(base - 1, entry));
+    TSUNIT_ASSERT(index.searchTime(base + 7999, entry));
+    TSUNIT_EQUAL(700, entry.packet);
+    TSUNIT_ASSERT(index.searchTime(base + 8000, entry));
+    TSUNIT_EQUAL(800, entry.packet);
+
+    // Append mode, PCR discontinuity, random access points only.
+    TSUNIT_ASSERT(indexer.open(index_name, ts::PKT_SIZE, true, CERR));
+    for (size_t i = 0; i < 300; ++i) {
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(200);
+        if (i % 10 == 0) {
+            TSUNIT_ASSERT(pkt.setPCR(i * (ts::SYSTEM_CLOCK_FREQ / 100), true));
+        }
+        if (i == 5 || i == 155 || i == 250) {
+            TSUNIT_ASSERT(pkt.setRandomAccessIndicator(true));
+        }
+        indexer.feedPacket(pkt, 1000 + i);
+    }
+    TSUNIT_EQUAL(3, indexer.entryCount());
+    indexer.close();
+
+    TSUNIT_ASSERT(index.load(index_name, CERR));
+    TSUNIT_EQUAL(13, index.entries().size());
+    TSUNIT_EQUAL(1000, index.entries()[10].packet);
+    TSUNIT_EQUAL(1155, index.entries()[11].packet);
+    TSUNIT_EQUAL(150 * (ts::SYSTEM_CLOCK_FREQ / 100), index.entries()[11].pcr);
+    TSUNIT_ASSERT(index.entries()[11].utc < 0);
+    TSUNIT_EQUAL(1250, index.entries()[12].packet);
+
+    // Another PCR discontinuity, with PCR's after the first segment.
+    TSUNIT_ASSERT(indexer.open(index_name, ts::PKT_SIZE, true, CERR));
+    for (size_t i = 0; i < 500; ++i) {
+        ts::TSPacket pkt(ts::NullPacket);
+        pkt.setPID(300);
+        if (i % 10 == 0) {
+            TSUNIT_ASSERT(pkt.setPCR(20 * ts::SYSTEM_CLOCK_FREQ + i * (ts::SYSTEM_CLOCK_FREQ / 100), true));
+        }
+        indexer.feedPacket(pkt, 1300 + i);
+    }
+    indexer.close();
+    TSUNIT_ASSERT(index.load(index_name, CERR));
+    TSUNIT_EQUAL(18, index.entries().size());
+
+    // Search across PCR discontinuities: the first segment which contains the PCR is used.
+    TSUNIT_ASSERT(index.searchPCR(2 * ts::SYSTEM_CLOCK_FREQ, entry));
+    TSUNIT_EQUAL(200, entry.packet);
+    TSUNIT_ASSERT(index.searchPCR(20 * ts::SYSTEM_CLOCK_FREQ, entry));
+    TSUNIT_EQUAL(1300, entry.packet);
+    TSUNIT_ASSERT(index.searchPCR(22 * ts::SYSTEM_CLOCK_FREQ + 55 * (ts::SYSTEM_CLOCK_FREQ / 100), entry));
+    TSUNIT_EQUAL(1500, entry.packet);
+    TSUNIT_ASSERT(index.searchPCR(100 * ts::SYSTEM_CLOCK_FREQ, entry));
+    TSUNIT_EQUAL(900, entry.packet);
+}
+
+void TSFileTest::testCompact()
+{
+    // Data packets, runs of identical stuffing, stuffing with changing CC, stuffing which cannot be compacted.
+    ts::TSPacketVector packets(200);
+    ts::TSPacketMetadataVector mdata(packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        if (i < 20 || (i >= 120 && i < 130) || i >= 190) {
+            packets[i].setPID(ts::PID(100 + i % 3));
+            packets[i].b[10] = uint8_t(i);
+        }
+        else if (i >= 150 && i < 160) {
+            packets[i].setCC(uint8_t(i & 0x0F));
+        }
+        else if (i == 170) {
+            packets[i].b[100] = 0x00;
+        }
+        mdata[i].setInputTimeStamp(1000 + i * 7, ts::SYSTEM_CLOCK_FREQ, ts::TimeSource::PCR);
+        mdata[i].setLabel(i % 4);
+    }
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR, ts::TSPacketFormat::COMPACT));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), mdata.data(), packets.size(), CERR));
+    TSUNIT_EQUAL(packets.size(), file.writePacketsCount());
+    TSUNIT_ASSERT(file.close(CERR));
+
+    // Append a second copy, the stream header must not be repeated.
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE | ts::TSFile::APPEND, CERR, ts::TSPacketFormat::COMPACT));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), mdata.data(), packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    const std::uintmax_t size = fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR));
+    debug() << "TSFileTest::testCompact: file size: " << size << ", TS size: " << (2 * packets.size() * ts::PKT_SIZE) << std::endl;
+    TSUNIT_ASSERT(size < 2 * packets.size() * ts::PKT_SIZE);
+
+    // Read with auto-detection, twice with rewind, must be bit-exact.
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 2, 0, CERR));
+    ts::TSPacketVector inpackets(packets.size());
+    ts::TSPacketMetadataVector inmdata(packets.size());
+    for (size_t iter = 0; iter < 4; ++iter) {
+        size_t count = 0;
+        while (count < inpackets.size()) {
+            const size_t ret = file.readPackets(&inpackets[count], &inmdata[count], std::min<size_t>(33, inpackets.size() - count), CERR);
+            TSUNIT_ASSERT(ret > 0);
+            count += ret;
+        }
+        TSUNIT_EQUAL(ts::TSPacketFormat::COMPACT, file.packetFormat());
+        for (size_t i = 0; i < packets.size(); ++i) {
+            TSUNIT_ASSERT(packets[i] == inpackets[i]);
+            TSUNIT_EQUAL(mdata[i].getInputTimeStamp(), inmdata[i].getInputTimeStamp());
+            TSUNIT_ASSERT(inmdata[i].hasLabel(i % 4));
+        }
+    }
+    TSUNIT_EQUAL(0, file.readPackets(inpackets.data(), inmdata.data(), inpackets.size(), CERR));
+    TSUNIT_EQUAL(4 * packets.size(), file.readPacketsCount());
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+void TSFileTest::testRegionComparator()
+{
+    // First file: 1000 packets on 3 PID's. Second file: 10 leading packets, same packets, one different packet.
+    ts::TSPacketVector packets(1000);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(100 + i % 3));
+        packets[i].setCC(uint8_t(i & 0x0F));
+        ts::PutUInt32(packets[i].b + 10, uint32_t(i));
+    }
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    packets[777].b[100] ^= 0xFF;
+    TSUNIT_ASSERT(file.open(_tempFileName2, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data() + packets.size() - 10, nullptr, 10, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    const uint64_t offset = 10 * ts::PKT_SIZE;
+    std::vector<ts::PacketCounter> pids;
+
+    // Single thread, single chunk.
+    const ts::TSFileRegionComparator comp1(1, 1000000);
+    TSUNIT_EQUAL(1000, comp1.compare(_tempFileName, 0, _tempFileName, 0, 1000, &pids));
+    TSUNIT_EQUAL(ts::PID_MAX, pids.size());
+    TSUNIT_EQUAL(334, pids[100]);
+    TSUNIT_EQUAL(333, pids[101]);
+    TSUNIT_EQUAL(333, pids[102]);
+    TSUNIT_EQUAL(0, pids[103]);
+    TSUNIT_EQUAL(777, comp1.compare(_tempFileName, 0, _tempFileName2, offset, 1000));
+    TSUNIT_EQUAL(0, comp1.compare(_tempFileName, 0, _tempFileName2, 0, 1000));
+
+    // Several threads, several rounds, difference in the middle of a round.
+    const ts::TSFileRegionComparator comp3(3, 50);
+    TSUNIT_EQUAL(777, comp3.compare(_tempFileName, 0, _tempFileName2, offset, 1000, &pids));
+    TSUNIT_EQUAL(259, pids[100]);
+    TSUNIT_EQUAL(259, pids[101]);
+    TSUNIT_EQUAL(259, pids[102]);
+    TSUNIT_EQUAL(500, comp3.compare(_tempFileName, 0, _tempFileName2, offset, 500, &pids));
+    TSUNIT_EQUAL(167, pids[100]);
+    TSUNIT_EQUAL(222, comp3.compare(_tempFileName, 778 * ts::PKT_SIZE, _tempFileName2, offset + 778 * ts::PKT_SIZE, 1000));
+
+    // Truncated files: stop at end of file.
+    TSUNIT_EQUAL(1000, comp3.compare(_tempFileName, 0, _tempFileName, 0, 1200));
+    TSUNIT_EQUAL(990, comp3.compare(_tempFileName, offset, _tempFileName, offset, 1000));
+}
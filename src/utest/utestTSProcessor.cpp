@@ -27,9 +27,11 @@ public:
     virtual void afterTest() override;
 
     void testProcessing();
+    void testParallelProcessing();
 
     TSUNIT_TEST_BEGIN(TSProcessorTest);
     TSUNIT_TEST(testProcessing);
+    TSUNIT_TEST(testParallelProcessing);
     TSUNIT_TEST_END();
 };
 
@@ -150,6 +152,35 @@ TestPlugin::Status TestPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMeta
 }
 
 
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class which can be executed in parallel.
+// Each instance counts its packets in a global counter.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ParallelTestPlugin : ts::ProcessorPlugin
+    {
+    public:
+        // Constructor.
+        ParallelTestPlugin(ts::TSP* t) : ts::ProcessorPlugin(t, u"Parallel test plugin", u"[options]") { instances++; }
+
+        // Implementation of plugin API.
+        virtual ShardingMode getShardingMode() override { return ShardingMode::BY_BLOCK; }
+        virtual Status processPacket(ts::TSPacket&, ts::TSPacketMetadata&) override { packets++; return TSP_OK; }
+
+        // A factory static method which creates an instance of that class.
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP* t) { return new ParallelTestPlugin(t); }
+
+        // Global counters, for all instances.
+        static std::atomic<size_t> instances;
+        static std::atomic<size_t> packets;
+    };
+
+    std::atomic<size_t> ParallelTestPlugin::instances {0};
+    std::atomic<size_t> ParallelTestPlugin::packets {0};
+}
+
+
 //----------------------------------------------------------------------------
 // A test plugin event handler.
 // We don't do the TSUNIT assertions in the event handler (called in plugin
@@ -297,3 +328,26 @@ void TSProcessorTest::testProcessing()
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+void TSProcessorTest::testParallelProcessing()
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test2", ParallelTestPlugin::CreateInstance);
+    ParallelTestPlugin::instances = 0;
+    ParallelTestPlugin::packets = 0;
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testParallelProcessing";
+    opt.input = {u"null", {u"10000"}};
+    opt.plugins = {
+        {u"test2", {u"--threads", u"4"}},
+    };
+    opt.output = {u"drop"};
+
+    ts::TSProcessor tsproc(CERR);
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // All packets were processed exactly once, by one of the 4 instances.
+    TSUNIT_EQUAL(4, ParallelTestPlugin::instances.load());
+    TSUNIT_EQUAL(10000, ParallelTestPlugin::packets.load());
+}
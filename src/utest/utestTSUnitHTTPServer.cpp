@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "utestTSUnitHTTPServer.h"
+#include "tsIPUtils.h"
+#include "tsNullReport.h"
+#include "tsCerrReport.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors
+//----------------------------------------------------------------------------
+
+utest::TSUnitHTTPServer::TSUnitHTTPServer(uint16_t port) :
+    _port(port)
+{
+}
+
+utest::TSUnitHTTPServer::~TSUnitHTTPServer()
+{
+    stop();
+}
+
+utest::TSUnitHTTPServer::Session::~Session()
+{
+    // Unblock the session thread before waiting for it, the connection is used by the thread.
+    client.disconnect(NULLREP);
+    waitForTermination();
+    client.close(NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the URL of a resource on this server.
+//----------------------------------------------------------------------------
+
+ts::UString utest::TSUnitHTTPServer::url(const ts::UString& path) const
+{
+    return ts::UString::Format(u"http://127.0.0.1:%d%s", {_port, path});
+}
+
+
+//----------------------------------------------------------------------------
+// Start and stop the server.
+//----------------------------------------------------------------------------
+
+bool utest::TSUnitHTTPServer::start()
+{
+    const ts::IPv4SocketAddress addr(ts::IPv4Address::LocalHost, _port);
+    if (_started ||
+        !ts::IPInitialize(CERR) ||
+        !_server.open(CERR) ||
+        !_server.reusePort(true, CERR) ||
+        !_server.bind(addr, CERR) ||
+        !_server.listen(16, CERR))
+    {
+        _server.close(NULLREP);
+        return false;
+    }
+    _terminate = false;
+    _connections = _requests = 0;
+    _started = TSUnitThread::start();
+    return _started;
+}
+
+void utest::TSUnitHTTPServer::stop()
+{
+    if (_started) {
+        // Closing the server socket unblocks the acceptor thread.
+        _terminate = true;
+        _server.close(NULLREP);
+        waitForTermination();
+        _started = false;
+    }
+    // The acceptor thread is terminated, no new session can be added.
+    // Deallocating the sessions disconnects the clients and waits for the session threads.
+    _sessions.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the statistics of the server.
+//----------------------------------------------------------------------------
+
+size_t utest::TSUnitHTTPServer::connectionCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _connections;
+}
+
+size_t utest::TSUnitHTTPServer::requestCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _requests;
+}
+
+
+//----------------------------------------------------------------------------
+// Acceptor thread.
+//----------------------------------------------------------------------------
+
+void utest::TSUnitHTTPServer::test()
+{
+    while (!_terminate) {
+        SessionPtr session(new Session(*this));
+        ts::IPv4SocketAddress addr;
+        if (!_server.accept(session->client, addr, NULLREP)) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _connections++;
+        _sessions.push_back(session);
+        session->start();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Session thread: process all requests from one persistent connection.
+//----------------------------------------------------------------------------
+
+void utest::TSUnitHTTPServer::Session::test()
+{
+    std::string input;
+    char buffer[1024];
+    size_t size = 0;
+
+    for (;;) {
+        // Read the complete request header. There is no request body with GET.
+        size_t end = std::string::npos;
+        while ((end = input.find("\r\n\r\n")) == std::string::npos) {
+            if (!client.receive(buffer, sizeof(buffer), size, nullptr, NULLREP)) {
+                return;
+            }
+            input.append(buffer, size);
+        }
+        const std::string request(input.substr(0, end));
+        input.erase(0, end + 4);
+
+        // Request line: "GET /path HTTP/1.1".
+        const size_t start = request.find(' ') + 1;
+        const std::string path(request.substr(start, request.find(' ', start) - start));
+        {
+            std::lock_guard<std::mutex> lock(_server._mutex);
+            _server._requests++;
+        }
+
+        // Resources are not modified while the server is running, no need to lock.
+        std::string response;
+        const auto it = _server.resources.find(path);
+        if (it == _server.resources.end()) {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        }
+        else {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(it->second.size()) + "\r\n\r\n" + it->second;
+        }
+        if (!client.send(response.data(), response.size(), NULLREP)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2023, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Minimal local HTTP server for TSUnit.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "utestTSUnitThread.h"
+#include "tsTCPServer.h"
+#include "tsTCPConnection.h"
+#include "tsSafePtr.h"
+
+namespace utest {
+    //!
+    //! Minimal local HTTP server for TSUnit.
+    //!
+    //! The server listens on the local host and serves static resources from memory.
+    //! The connections are persistent (HTTP/1.1 keep-alive), each connection is handled
+    //! in its own thread. The server counts the connections and requests, allowing tests
+    //! to check the reuse of connections by HTTP clients.
+    //!
+    class TSUnitHTTPServer : private TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(TSUnitHTTPServer);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] port TCP port on the local host.
+        //!
+        TSUnitHTTPServer(uint16_t port);
+
+        //!
+        //! Destructor, stop the server.
+        //!
+        virtual ~TSUnitHTTPServer() override;
+
+        //!
+        //! Resources of the server, indexed by path (e.g. "/index.html").
+        //! Must not be modified while the server is started.
+        //!
+        std::map<std::string, std::string> resources {};
+
+        //!
+        //! Get the URL of a resource on this server.
+        //! @param [in] path Resource path, starting with a slash.
+        //! @return The complete URL.
+        //!
+        ts::UString url(const ts::UString& path) const;
+
+        //!
+        //! Start the server.
+        //! @return True on success, false on error.
+        //!
+        bool start();
+
+        //!
+        //! Stop the server and disconnect all clients.
+        //!
+        void stop();
+
+        //!
+        //! Get the number of accepted connections.
+        //! @return The number of accepted connections since start.
+        //!
+        size_t connectionCount() const;
+
+        //!
+        //! Get the number of received requests.
+        //! @return The number of received requests since start, on all connections.
+        //!
+        size_t requestCount() const;
+
+    private:
+        // Thread for one client connection.
+        class Session : public TSUnitThread
+        {
+            TS_NOBUILD_NOCOPY(Session);
+        public:
+            Session(TSUnitHTTPServer& server) : _server(server) {}
+            virtual ~Session() override;
+            ts::TCPConnection client {};
+            virtual void test() override;
+        private:
+            TSUnitHTTPServer& _server;
+        };
+        typedef ts::SafePtr<Session> SessionPtr;
+
+        const uint16_t          _port;
+        ts::TCPServer           _server {};
+        mutable std::mutex      _mutex {};
+        volatile bool           _terminate = false;
+        bool                    _started = false;
+        size_t                  _connections = 0;
+        size_t                  _requests = 0;
+        std::list<SessionPtr>   _sessions {};
+
+        // Acceptor thread.
+        virtual void test() override;
+    };
+}
@@ -20,6 +20,13 @@
 #include "tsTSDT.h"
 #include "tsEIT.h"
 #include "tsAIT.h"
+#include "tsPATView.h"
+#include "tsPMTView.h"
+#include "tsNITView.h"
+#include "tsSDTView.h"
+#include "tsEITView.h"
+#include "tsShortEventDescriptor.h"
+#include "tsStreamIdentifierDescriptor.h"
 #include "tsCADescriptor.h"
 #include "tsAVCVideoDescriptor.h"
 #include "tsDVBAC3Descriptor.h"
@@ -52,6 +59,8 @@ public:
     void testTOT();
     void testTSDT();
     void testCleanupPrivateDescriptors();
+    void testDescriptorListArea();
+    void testTableViews();
 
     TSUNIT_TEST_BEGIN(TableTest);
     TSUNIT_TEST(testAssignPMT);
@@ -65,6 +74,8 @@ public:
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testTSDT);
     TSUNIT_TEST(testCleanupPrivateDescriptors);
+    TSUNIT_TEST(testDescriptorListArea);
+    TSUNIT_TEST(testTableViews);
     TSUNIT_TEST_END();
 };
 
@@ -347,3 +358,205 @@ void TableTest::testCleanupPrivateDescriptors()
     TSUNIT_EQUAL(1, dlist.count());
     TSUNIT_EQUAL(ts::DID_SERVICE, dlist[0]->tag());
 }
+
+void TableTest::testDescriptorListArea()
+{
+    // Descriptors from a binary area are views in one shared area.
+    static const uint8_t data[] = {
+        0x48, 0x03, 0x01, 0x41, 0x42,  // raw service_descriptor (not deserialized here)
+        0x52, 0x01, 0x07,              // stream_identifier_descriptor
+        0xF0, 0x00,                    // empty private descriptor
+        0x0A,                          // truncated descriptor
+    };
+    ts::DescriptorList dlist(nullptr);
+    TSUNIT_ASSERT(!dlist.add(data, sizeof(data)));
+    TSUNIT_EQUAL(3, dlist.count());
+    TSUNIT_ASSERT(dlist.add(data, sizeof(data) - 1));
+    TSUNIT_EQUAL(6, dlist.count());
+
+    TSUNIT_EQUAL(0x48, dlist[0]->tag());
+    TSUNIT_EQUAL(5, dlist[0]->size());
+    TSUNIT_EQUAL(3, dlist[0]->payloadSize());
+    TSUNIT_EQUAL(0x52, dlist[1]->tag());
+    TSUNIT_EQUAL(0x07, dlist[1]->payload()[0]);
+    TSUNIT_EQUAL(0xF0, dlist[2]->tag());
+    TSUNIT_EQUAL(0, dlist[2]->payloadSize());
+    TSUNIT_ASSERT(*dlist[1] == *dlist[4]);
+    TSUNIT_ASSERT(*dlist[0] != *dlist[1]);
+
+    // Modifying one descriptor does not modify the others from the same area.
+    dlist[1]->payload()[0] = 0x09;
+    TSUNIT_EQUAL(0x09, dlist[1]->payload()[0]);
+    TSUNIT_EQUAL(0x52, dlist[1]->tag());
+    TSUNIT_EQUAL(0x07, dlist[4]->payload()[0]);
+    TSUNIT_ASSERT(*dlist[1] != *dlist[4]);
+
+    dlist[0]->resizePayload(1);
+    TSUNIT_EQUAL(3, dlist[0]->size());
+    TSUNIT_EQUAL(0x01, dlist[0]->content()[1]);
+    TSUNIT_EQUAL(0x52, dlist[1]->tag());
+
+    dlist[2]->replacePayload(data, 2);
+    TSUNIT_EQUAL(0xF0, dlist[2]->tag());
+    TSUNIT_EQUAL(2, dlist[2]->payloadSize());
+    TSUNIT_EQUAL(0x48, dlist[2]->payload()[0]);
+    TSUNIT_EQUAL(5, dlist[3]->size());
+
+    // Copies of views are private.
+    ts::Descriptor copy;
+    copy.copy(*dlist[5]);
+    TSUNIT_ASSERT(copy == *dlist[5]);
+    TSUNIT_EQUAL(0xF0, copy.tag());
+
+    // A descriptor which shares a complete data block follows the modifications of the block.
+    ts::ByteBlockPtr bbp(new ts::ByteBlock({0x52, 0x01, 0x07}));
+    ts::Descriptor shared(bbp, ts::ShareMode::SHARE);
+    TSUNIT_EQUAL(3, shared.size());
+    bbp->appendUInt16(0x0809);
+    (*bbp)[1] = 0x03;
+    TSUNIT_EQUAL(5, shared.size());
+    TSUNIT_EQUAL(3, shared.payloadSize());
+    TSUNIT_EQUAL(0x09, shared.payload()[2]);
+
+    // An invalid descriptor is empty.
+    shared.invalidate();
+    TSUNIT_ASSERT(!shared.isValid());
+    TSUNIT_EQUAL(0, shared.size());
+}
+
+void TableTest::testTableViews()
+{
+    ts::DuckContext duck;
+
+    // PAT with enough programs to span two sections.
+    ts::PAT pat(1, true, 0x1234, 0x0020);
+    for (uint16_t id = 1; id <= 300; ++id) {
+        pat.pmts[id] = ts::PID(0x0100 + id);
+    }
+    ts::BinaryTable bin;
+    TSUNIT_ASSERT(pat.serialize(duck, bin));
+    TSUNIT_EQUAL(2, bin.sectionCount());
+
+    ts::PATView patv(bin);
+    TSUNIT_ASSERT(patv.isValid());
+    TSUNIT_EQUAL(0x1234, patv.tsId());
+    TSUNIT_EQUAL(0x0020, patv.nitPID());
+    TSUNIT_EQUAL(300, patv.programs().count());
+    uint16_t expected_id = 1;
+    for (const auto& prog : patv.programs()) {
+        TSUNIT_EQUAL(expected_id, prog.serviceId());
+        TSUNIT_EQUAL(0x0100 + expected_id, prog.pmtPID());
+        expected_id++;
+    }
+
+    // A view on another table is invalid and empty.
+    ts::PMTView badv(bin);
+    TSUNIT_ASSERT(!badv.isValid());
+    TSUNIT_ASSERT(badv.streams().empty());
+
+    // PMT.
+    ts::PMT pmt(2, true, 0x0101, 0x0200);
+    pmt.descs.add(duck, ts::CADescriptor(0x0100, 0x0300));
+    pmt.streams[0x0200].stream_type = 0x1B;
+    pmt.streams[0x0201].stream_type = 0x03;
+    pmt.streams[0x0201].descs.add(duck, ts::StreamIdentifierDescriptor(0x12));
+    TSUNIT_ASSERT(pmt.serialize(duck, bin));
+
+    ts::PMTView pmtv(bin);
+    TSUNIT_ASSERT(pmtv.isValid());
+    TSUNIT_EQUAL(0x0101, pmtv.serviceId());
+    TSUNIT_EQUAL(0x0200, pmtv.pcrPID());
+    TSUNIT_EQUAL(1, pmtv.descriptors().count());
+    TSUNIT_EQUAL(ts::DID_CA, (*pmtv.descriptors().begin()).tag());
+    TSUNIT_EQUAL(2, pmtv.streams().count());
+    auto pmt_it = pmtv.streams().begin();
+    TSUNIT_EQUAL(0x1B, (*pmt_it).streamType());
+    TSUNIT_EQUAL(0x0200, (*pmt_it).pid());
+    TSUNIT_ASSERT((*pmt_it).descriptors().empty());
+    ++pmt_it;
+    TSUNIT_EQUAL(0x03, (*pmt_it).streamType());
+    TSUNIT_EQUAL(0x0201, (*pmt_it).pid());
+    const ts::DescriptorLoopView sdescs((*pmt_it).descriptors());
+    TSUNIT_ASSERT(sdescs.search(ts::DID_STREAM_ID) != sdescs.end());
+    TSUNIT_EQUAL(0x12, (*sdescs.search(ts::DID_STREAM_ID)).payload()[0]);
+    TSUNIT_ASSERT(sdescs.search(ts::DID_CA) == sdescs.end());
+    ts::DescriptorList dlist(nullptr);
+    TSUNIT_ASSERT(sdescs.addTo(dlist));
+    TSUNIT_EQUAL(1, dlist.count());
+    TSUNIT_ASSERT(++pmt_it == pmtv.streams().end());
+
+    // SDT.
+    ts::SDT sdt(true, 3, true, 0x1234, 0x20FA);
+    sdt.services[0x0101].EITpf_present = true;
+    sdt.services[0x0101].running_status = 4;
+    sdt.services[0x0101].setName(duck, u"Service One", 0x19);
+    sdt.services[0x0101].setProvider(duck, u"Provider");
+    sdt.services[0x0102].CA_controlled = true;
+    TSUNIT_ASSERT(sdt.serialize(duck, bin));
+
+    ts::SDTView sdtv(bin);
+    TSUNIT_ASSERT(sdtv.isValid());
+    TSUNIT_ASSERT(sdtv.isActual());
+    TSUNIT_EQUAL(0x1234, sdtv.tsId());
+    TSUNIT_EQUAL(0x20FA, sdtv.onetwId());
+    TSUNIT_EQUAL(2, sdtv.services().count());
+    auto sdt_it = sdtv.services().begin();
+    TSUNIT_EQUAL(0x0101, (*sdt_it).serviceId());
+    TSUNIT_ASSERT((*sdt_it).EITpf());
+    TSUNIT_ASSERT(!(*sdt_it).EITs());
+    TSUNIT_EQUAL(4, (*sdt_it).runningStatus());
+    TSUNIT_ASSERT(!(*sdt_it).CAControlled());
+    TSUNIT_EQUAL(0x19, (*sdt_it).serviceType());
+    TSUNIT_EQUAL(u"Service One", (*sdt_it).name(duck));
+    TSUNIT_EQUAL(u"Provider", (*sdt_it).provider(duck));
+    ++sdt_it;
+    TSUNIT_EQUAL(0x0102, (*sdt_it).serviceId());
+    TSUNIT_ASSERT((*sdt_it).CAControlled());
+    TSUNIT_EQUAL(0, (*sdt_it).serviceType());
+    TSUNIT_EQUAL(u"", (*sdt_it).name(duck));
+
+    // NIT.
+    ts::NIT nit(false, 4, true, 0x3344);
+    nit.descs.add(duck, ts::CADescriptor(0x0100, 0x0300));
+    nit.transports[ts::TransportStreamId(0x0001, 0x20FA)].descs.add(duck, ts::StreamIdentifierDescriptor(0x12));
+    nit.transports[ts::TransportStreamId(0x0002, 0x20FA)];
+    TSUNIT_ASSERT(nit.serialize(duck, bin));
+
+    ts::NITView nitv(bin);
+    TSUNIT_ASSERT(nitv.isValid());
+    TSUNIT_ASSERT(!nitv.isActual());
+    TSUNIT_EQUAL(0x3344, nitv.networkId());
+    TSUNIT_EQUAL(1, nitv.descriptors().count());
+    TSUNIT_EQUAL(2, nitv.transportStreams().count());
+    auto nit_it = nitv.transportStreams().begin();
+    TSUNIT_EQUAL(0x0001, (*nit_it).tsId());
+    TSUNIT_EQUAL(0x20FA, (*nit_it).onetwId());
+    TSUNIT_EQUAL(1, (*nit_it).descriptors().count());
+    ++nit_it;
+    TSUNIT_EQUAL(0x0002, (*nit_it).tsId());
+    TSUNIT_ASSERT((*nit_it).descriptors().empty());
+
+    // EIT.
+    ts::EIT eit(true, true, 0, 5, true, 0x0101, 0x1234, 0x20FA);
+    ts::EIT::Event& ev(eit.events.newEntry());
+    ev.event_id = 0x4321;
+    ev.start_time = ts::Time(2023, 5, 17, 20, 45, 10);
+    ev.duration = 5400 + 23;
+    ev.running_status = 4;
+    ev.descs.add(duck, ts::ShortEventDescriptor(u"fre", u"Event title", u"Event text"));
+    TSUNIT_ASSERT(eit.serialize(duck, bin));
+
+    ts::EITView eitv(bin);
+    TSUNIT_ASSERT(eitv.isValid());
+    TSUNIT_EQUAL(0x0101, eitv.serviceId());
+    TSUNIT_EQUAL(0x1234, eitv.tsId());
+    TSUNIT_EQUAL(0x20FA, eitv.onetwId());
+    TSUNIT_EQUAL(1, eitv.events().count());
+    const ts::EITView::Event evv(*eitv.events().begin());
+    TSUNIT_EQUAL(0x4321, evv.eventId());
+    TSUNIT_ASSERT(evv.startTime() == ts::Time(2023, 5, 17, 20, 45, 10));
+    TSUNIT_EQUAL(5423, evv.duration());
+    TSUNIT_EQUAL(4, evv.runningStatus());
+    TSUNIT_ASSERT(!evv.CAControlled());
+    TSUNIT_EQUAL(u"Event title", evv.title(duck));
+}
@@ -30,12 +30,14 @@ public:
     void testEMMG();
     void testECMGError();
     void testEMMGError();
+    void testReuseBuffer();
 
     TSUNIT_TEST_BEGIN(TagLengthValueTest);
     TSUNIT_TEST(testECMG);
     TSUNIT_TEST(testEMMG);
     TSUNIT_TEST(testECMGError);
     TSUNIT_TEST(testEMMGError);
+    TSUNIT_TEST(testReuseBuffer);
     TSUNIT_TEST_END();
 };
 
@@ -329,3 +331,71 @@ void TagLengthValueTest::testEMMGError()
     debug() << "TagLengthValueTest::testEMMGError: dump" << std::endl << str << std::endl;
     TSUNIT_EQUAL(refString, str);
 }
+
+void TagLengthValueTest::testReuseBuffer()
+{
+    ts::ecmgscs::Protocol protocol;
+    ts::ecmgscs::CWProvision refMessage(protocol);
+    refMessage.channel_id = 2;
+    refMessage.stream_id = 3;
+    refMessage.CP_number = 5;
+    refMessage.has_access_criteria = true;
+    refMessage.access_criteria = ts::ByteBlock({0xAA, 0xBB});
+    refMessage.CP_CW_combination.push_back(ts::ecmgscs::CPCWCombination(5, ts::ByteBlock({0x01, 0x02, 0x03, 0x04})));
+    refMessage.CP_CW_combination.push_back(ts::ecmgscs::CPCWCombination(6, ts::ByteBlock({0x05, 0x06, 0x07, 0x08})));
+
+    static const uint8_t refData[] = {
+        0x03,
+        0x02, 0x01, 0x00, 0x2C,
+        0x00, 0x0E, 0x00, 0x02, 0x00, 0x02,
+        0x00, 0x0F, 0x00, 0x02, 0x00, 0x03,
+        0x00, 0x12, 0x00, 0x02, 0x00, 0x05,
+        0x00, 0x0D, 0x00, 0x02, 0xAA, 0xBB,
+        0x00, 0x14, 0x00, 0x06, 0x00, 0x05, 0x01, 0x02, 0x03, 0x04,
+        0x00, 0x14, 0x00, 0x06, 0x00, 0x06, 0x05, 0x06, 0x07, 0x08,
+    };
+
+    // Serialize in a plain ByteBlock, without safe pointer.
+    ts::ByteBlock data;
+    {
+        ts::tlv::Serializer zer(data);
+        refMessage.serialize(zer);
+    }
+    debug() << "TagLengthValueTest::testReuseBuffer: serialized:" << std::endl
+            << ts::UString::Dump(data, ts::UString::HEXA, 2) << std::endl;
+    TSUNIT_EQUAL(sizeof(refData), data.size());
+    TSUNIT_EQUAL(0, std::memcmp(refData, data.data(), sizeof(refData)));
+
+    // Same result with a safe pointer.
+    ts::ByteBlockPtr ptr(new ts::ByteBlock);
+    ts::tlv::Serializer pzer(ptr);
+    refMessage.serialize(pzer);
+    TSUNIT_ASSERT(*ptr == data);
+
+    // Serialize a message of the same size in the same buffer: no reallocation.
+    const uint8_t* const base = data.data();
+    refMessage.CP_number = 7;
+    data.clear();
+    {
+        ts::tlv::Serializer zer(data);
+        refMessage.serialize(zer);
+    }
+    TSUNIT_EQUAL(sizeof(refData), data.size());
+    TSUNIT_ASSERT(data.data() == base);
+    TSUNIT_EQUAL(7, ts::GetUInt16(data.data() + 21));
+
+    // Deserialize the second message.
+    ts::tlv::MessageFactory fac(data, protocol);
+    ts::tlv::MessagePtr msg(fac.factory());
+    TSUNIT_ASSERT(!msg.isNull());
+    TSUNIT_EQUAL(ts::ecmgscs::Tags::CW_provision, msg->tag());
+    ts::ecmgscs::CWProvision* cwp = dynamic_cast<ts::ecmgscs::CWProvision*>(msg.pointer());
+    TSUNIT_ASSERT(cwp != nullptr);
+    TSUNIT_EQUAL(2, cwp->channel_id);
+    TSUNIT_EQUAL(3, cwp->stream_id);
+    TSUNIT_EQUAL(7, cwp->CP_number);
+    TSUNIT_ASSERT(cwp->access_criteria == refMessage.access_criteria);
+    TSUNIT_EQUAL(2, cwp->CP_CW_combination.size());
+    TSUNIT_EQUAL(6, cwp->CP_CW_combination[1].CP);
+    TSUNIT_ASSERT(cwp->CP_CW_combination[1].CW == refMessage.CP_CW_combination[1].CW);
+}
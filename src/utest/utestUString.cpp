@@ -1374,6 +1374,31 @@ void UStringTest::testHexaDump()
         u"0010.0000 0010.0001 0010.0010 0010.0011 0010.0100 0010.0101   !\"#$%\n"
         u"0010.0110 0010.0111 0010.1000 0010.1001                      &'()\n";
     TSUNIT_EQUAL(ref8, hex8);
+
+    // Direct UTF-8 dumps must be identical to the UTF-16 ones.
+    std::string utf8;
+    ts::UString::AppendDump(utf8, refBytes, 40);
+    TSUNIT_EQUAL(hex1.toUTF8(), utf8);
+
+    utf8 = "prefix ";
+    ts::UString::AppendDump(utf8, refBytes + 32, 22, ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET | ts::UString::BPL, 4, 10, 32);
+    TSUNIT_EQUAL("prefix " + hex4.toUTF8(), utf8);
+
+    utf8.clear();
+    ts::UString::AppendDump(utf8, refBytes + 32, 20, ts::UString::HEXA | ts::UString::C_STYLE);
+    TSUNIT_EQUAL(hex6.toUTF8(), utf8);
+
+    utf8.clear();
+    ts::UString::AppendDump(utf8, refBytes + 32, 10, ts::UString::BIN_NIBBLE | ts::UString::ASCII);
+    TSUNIT_EQUAL(hex8.toUTF8(), utf8);
+
+    utf8.clear();
+    ts::UString::AppendDump(utf8, refBytes, sizeof(refBytes), ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET | ts::UString::WIDE_OFFSET, 2, 78, 0x12345678);
+    TSUNIT_EQUAL(ts::UString::Dump(refBytes, sizeof(refBytes), ts::UString::HEXA | ts::UString::ASCII | ts::UString::OFFSET | ts::UString::WIDE_OFFSET, 2, 78, 0x12345678).toUTF8(), utf8);
+
+    utf8.clear();
+    ts::UString::AppendDump(utf8, refBytes + 32, 12, ts::UString::COMPACT);
+    TSUNIT_EQUAL("202122232425262728292A2B", utf8);
 }
 
 void UStringTest::testArgMixIn()
@@ -19,6 +19,7 @@
 #include "tsReportBuffer.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
+#include "utestTSUnitHTTPServer.h"
 #include "tsunit.h"
 
 
@@ -36,6 +37,7 @@ public:
     void testGoogle();
     void testReadMeFile();
     void testNoRedirection();
+    void testReuse();
     void testNonExistentHost();
     void testInvalidURL();
 
@@ -44,6 +46,7 @@ public:
     TSUNIT_TEST(testGoogle);
     TSUNIT_TEST(testReadMeFile);
     TSUNIT_TEST(testNoRedirection);
+    TSUNIT_TEST(testReuse);
     TSUNIT_TEST(testNonExistentHost);
     TSUNIT_TEST(testInvalidURL);
     TSUNIT_TEST_END();
@@ -210,6 +213,35 @@ void WebRequestTest::testNoRedirection()
     TSUNIT_ASSERT(request.finalURL() != request.originalURL());
 }
 
+void WebRequestTest::testReuse()
+{
+    if (!ts::WebRequest::IsSupported()) {
+        debug() << "WebRequestTest::testReuse: no Web support, skipped" << std::endl;
+        return;
+    }
+
+    // Local HTTP server with persistent connections.
+    utest::TSUnitHTTPServer server(12348);
+    server.resources["/file1"] = "content of file 1";
+    server.resources["/file2"] = "content of file 2, a bit longer";
+    TSUNIT_ASSERT(server.start());
+
+    // Successive downloads using the same request object reuse the same connection.
+    ts::WebRequest request(report());
+    ts::ByteBlock data1, data2;
+    TSUNIT_ASSERT(request.downloadBinaryContent(server.url(u"/file1"), data1));
+    TSUNIT_EQUAL(200, request.httpStatus());
+    TSUNIT_ASSERT(!request.isOpen());
+    TSUNIT_ASSERT(request.downloadBinaryContent(server.url(u"/file2"), data2));
+    TSUNIT_EQUAL(200, request.httpStatus());
+    TSUNIT_ASSERT(data1 == ts::ByteBlock(server.resources["/file1"].data(), server.resources["/file1"].size()));
+    TSUNIT_ASSERT(data2 == ts::ByteBlock(server.resources["/file2"].data(), server.resources["/file2"].size()));
+
+    TSUNIT_EQUAL(2, server.requestCount());
+    TSUNIT_EQUAL(1, server.connectionCount());
+    server.stop();
+}
+
 void WebRequestTest::testNonExistentHost()
 {
     ts::ReportBuffer<> rep;